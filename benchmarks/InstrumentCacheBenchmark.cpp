@@ -0,0 +1,117 @@
+// Saves a 5000-symbol exchange to InstrumentCache and reports what startup pays
+// for it: Open (map and validate the file), Find on the mapped records and CopyTo
+// into the updater's map. Also reports the serialisation SaveAsync does on the
+// calling thread.
+
+#include "editor/InstrumentCache.h"
+#include "editor/InstrumentRegistry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace gui::editor;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    const char* const QUOTES[] = {"USDT", "USDC", "BTC", "ETH", "EUR"};
+
+    double Microseconds(Clock::duration elapsed)
+    {
+        return std::chrono::duration<double, std::micro>(elapsed).count();
+    }
+
+    std::unordered_map<std::string, InstrumentData> MakeInstruments(size_t count)
+    {
+        std::unordered_map<std::string, InstrumentData> instruments;
+        for (size_t i = 0; i < count; i++)
+        {
+            InstrumentData instrument;
+            instrument.baseAsset = "AS" + std::to_string(i);
+            instrument.quoteAsset = QUOTES[i % 5];
+            instrument.symbol = instrument.baseAsset + instrument.quoteAsset;
+            instrument.exchange = "Binance";
+            instrument.minOrderSize = 0.001;
+            instrument.maxOrderSize = 9000.0;
+            instrument.tickSize = 0.01;
+            instrument.lotSize = 0.001;
+            instrument.pricePrecision = 2 + static_cast<int>(i % 6);
+            instrument.quantityPrecision = 3 + static_cast<int>(i % 5);
+            instrument.tradingEnabled = i % 50 != 0;
+            instrument.tradingStatus = instrument.tradingEnabled ? "TRADING" : "BREAK";
+            instruments.emplace(instrument.symbol, std::move(instrument));
+        }
+        return instruments;
+    }
+}
+
+int main()
+{
+    constexpr size_t SYMBOLS = 5000;
+    constexpr int ROUNDS = 20;
+    const std::string directory = (std::filesystem::temp_directory_path() / "instrument-cache-benchmark").string();
+    const std::unordered_map<std::string, InstrumentData> instruments = MakeInstruments(SYMBOLS);
+
+    InstrumentCache cache(directory);
+    double save = 1e300;
+    for (int round = 0; round < ROUNDS; round++)
+    {
+        const auto start = Clock::now();
+        cache.SaveAsync("Binance", instruments);
+        save = std::min(save, Microseconds(Clock::now() - start));
+        cache.WaitForSave();
+    }
+    if (cache.GetLastSaveFailed())
+    {
+        std::fprintf(stderr, "Could not write %s\n", cache.GetPath("Binance").c_str());
+        return 1;
+    }
+
+    // Best of several rounds: the file is in the page cache, as it is on a restart
+    double open = 1e300;
+    double copy = 1e300;
+    double find = 1e300;
+    size_t copied = 0;
+    size_t found = 0;
+    std::vector<std::string> probes;
+    for (size_t i = 0; i < SYMBOLS; i += 7)
+        probes.push_back("AS" + std::to_string(i) + QUOTES[i % 5]);
+    for (int round = 0; round < ROUNDS; round++)
+    {
+        auto start = Clock::now();
+        if (!cache.Open("Binance"))
+        {
+            std::fprintf(stderr, "Could not open %s\n", cache.GetPath("Binance").c_str());
+            return 1;
+        }
+        open = std::min(open, Microseconds(Clock::now() - start));
+
+        InstrumentData instrument;
+        found = 0;
+        start = Clock::now();
+        for (const std::string& symbol : probes)
+            found += cache.Find(symbol, instrument) ? 1 : 0;
+        find = std::min(find, Microseconds(Clock::now() - start) * 1000.0 / static_cast<double>(probes.size()));
+
+        std::unordered_map<std::string, InstrumentData> loaded;
+        start = Clock::now();
+        copied = cache.CopyTo(loaded);
+        copy = std::min(copy, Microseconds(Clock::now() - start));
+        cache.Close();
+    }
+
+    std::printf("%zu symbols, best of %d\n", SYMBOLS, ROUNDS);
+    std::printf("Open (map + validate): %.1f us\n", open);
+    std::printf("Find on mapped records: %.1f ns/lookup (%zu of %zu found)\n", find, found, probes.size());
+    std::printf("CopyTo map: %.1f us (%zu instruments)\n", copy, copied);
+    std::printf("SaveAsync serialisation on the caller: %.1f us\n", save);
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
@@ -0,0 +1,105 @@
+// Replays a synthetic L2 delta stream through PriceLadderBook and reports the
+// per-update cost. The stream models a liquid pair: the touch random-walks, most
+// updates change quantities within a few ticks of it, some delete levels and a
+// few land deep in the book. The target is 100k updates/s per book.
+
+#include "editor/PriceLadderBook.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace gui::editor;
+
+namespace
+{
+    struct Delta
+    {
+        bool isBid;
+        Decimal price;
+        Decimal quantity;
+    };
+
+    constexpr int64_t TICK = 1000000; // 0.01 at scale 8
+
+    std::vector<Delta> MakeStream(size_t count, uint32_t seed)
+    {
+        std::mt19937_64 random(seed);
+        std::uniform_int_distribution<int> percent(0, 99);
+        std::geometric_distribution<int> nearTouch(0.15); // Mostly the first few levels
+        std::uniform_int_distribution<int> deep(50, 3000);
+        std::uniform_int_distribution<int64_t> quantity(1, 500000000);
+
+        std::vector<Delta> stream;
+        stream.reserve(count);
+        int64_t mid = 3000000; // Ticks: 30000.00
+        for (size_t i = 0; i < count; i++)
+        {
+            // The touch moves by a tick on about one update in twenty
+            const int move = percent(random);
+            if (move < 3)
+                mid--;
+            else if (move > 96)
+                mid++;
+
+            Delta delta;
+            delta.isBid = (random() & 1) != 0;
+            const int roll = percent(random);
+            const int distance = roll < 90 ? 1 + nearTouch(random) : deep(random);
+            const int64_t tick = delta.isBid ? mid - distance : mid + distance;
+            delta.price = Decimal(tick * TICK);
+            delta.quantity = roll < 70 || roll >= 90 ? Decimal(quantity(random)) : Decimal(); // 20% deletes
+            stream.push_back(delta);
+        }
+        return stream;
+    }
+
+    double Run(PriceLadderBook& book, const std::vector<Delta>& stream)
+    {
+        NormalizedOrderbookLevel best;
+        uint64_t checksum = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (const Delta& delta : stream)
+        {
+            book.SetLevel(delta.isBid, delta.price, delta.quantity, 1);
+            // Consumers read the touch after every update
+            if (book.GetBestBid(best))
+                checksum += static_cast<uint64_t>(best.price.units);
+            if (book.GetBestAsk(best))
+                checksum += static_cast<uint64_t>(best.price.units);
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        if (checksum == 42)
+            std::printf(" ");
+        return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(stream.size());
+    }
+}
+
+int main()
+{
+    constexpr size_t UPDATES = 2000000;
+    const std::vector<Delta> stream = MakeStream(UPDATES, 20250906);
+
+    PriceLadderBook book;
+    book.SetTickUnits(TICK);
+    Run(book, stream); // Warm-up: fills the ladder and the overflow tree
+
+    const double nsPerUpdate = Run(book, stream);
+    std::printf("SetLevel + best bid/ask: %.1f ns/update, %.2f M updates/s per book (target 0.1 M/s)\n",
+                nsPerUpdate, 1000.0 / nsPerUpdate);
+
+    std::vector<NormalizedOrderbookLevel> top;
+    top.reserve(20);
+    constexpr int COPIES = 200000;
+    const auto start = std::chrono::steady_clock::now();
+    size_t copied = 0;
+    for (int i = 0; i < COPIES; i++)
+        copied += book.CopyTop((i & 1) != 0, 20, top);
+    const double nsPerCopy =
+        std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / COPIES;
+    std::printf("CopyTop(20): %.1f ns/copy (%zu levels per side)\n", nsPerCopy, copied / COPIES);
+    std::printf("Levels held: %zu bids, %zu asks\n", book.GetLevelCount(true), book.GetLevelCount(false));
+    return 0;
+}
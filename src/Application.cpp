@@ -2,11 +2,17 @@
 
 #include "explorer/ExplorerDialog.h"
 
+#include "editor/OrderStore.h"
+#include "editor/StateJournal.h"
+#include "editor/StateUpdaters.h"
+#include "editor/WalletValuation.h"
+
 #include "window/StartupWindow.h"
 #include "window/ConnectionPanel.h"
 #include "window/ExchangeControlPanel.h"
 #include "window/ExchangeEditor.h"
 
+#include <chrono>
 #include <stdio.h>
 
 namespace gui {
@@ -71,6 +77,21 @@ bool Application::Initialize()
         return false;
     }
     
+    // Restore orders and balances from the last run before any updater starts
+    editor::StateJournal& journal = editor::GetStateJournal();
+    std::vector<editor::WalletState> wallets;
+    editor::JournalRecoveryStats recovery;
+    if (journal.Recover(editor::GetOrderStore(), wallets, &recovery))
+    {
+        printf("Recovered %llu snapshot and %llu journal records in %.1f ms\n",
+               static_cast<unsigned long long>(recovery.snapshotRecords),
+               static_cast<unsigned long long>(recovery.journalRecords), recovery.elapsedMs);
+    }
+    for (const editor::WalletState& wallet : wallets)
+        editor::GetWalletValuation().SyncWallet(wallet);
+    if (!journal.Start())
+        printf("Failed to open the state journal; order state will not survive a restart\n");
+    
     printf("Application initialized successfully\n");
     return true;
 }
@@ -79,6 +100,14 @@ void Application::Render()
 {
     UpdateState();
     RenderCurrentWindow();
+    
+    // Orders changed this frame go to the journal writer in one batch
+    editor::StateJournal& journal = editor::GetStateJournal();
+    journal.CaptureOrders(editor::GetOrderStore());
+    journal.EvictTerminal(editor::GetOrderStore(), std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    if (journal.ShouldSnapshot())
+        journal.WriteSnapshot(editor::GetOrderStore());
 }
 
 void Application::UpdateState()
@@ -258,6 +287,7 @@ void Application::Shutdown()
         m_exchangeControlPanel->Shutdown();
     if (m_exchangeEditor)
         m_exchangeEditor->Shutdown();
+    editor::GetStateJournal().Stop();
         
     printf("Application shutdown complete\n");
 }
@@ -0,0 +1,354 @@
+#include "BarAggregator.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace gui
+{
+    namespace editor
+    {
+        const char* BarTimeframeToString(BarTimeframe timeframe)
+        {
+            switch (timeframe)
+            {
+                case BarTimeframe::Second1: return "1s";
+                case BarTimeframe::Minute1: return "1m";
+                case BarTimeframe::Minute5: return "5m";
+                case BarTimeframe::Hour1:   return "1h";
+            }
+            return "?";
+        }
+
+        double OhlcvBar::GetVwap(int quantityScale) const
+        {
+            const double totalVolume = volume.ToDouble(quantityScale);
+            return totalVolume > 0.0 ? notional / totalVolume : 0.0;
+        }
+
+        void OhlcvBar::AddTrade(Decimal price, Decimal quantity, double tradeNotional, bool isBuy)
+        {
+            if (tradeCount == 0)
+            {
+                open = high = low = price;
+            }
+            else
+            {
+                high = std::max(high, price);
+                low = std::min(low, price);
+            }
+            close = price;
+            volume += quantity;
+            if (isBuy)
+                buyVolume += quantity;
+            notional += tradeNotional;
+            tradeCount++;
+        }
+
+        void OhlcvBar::Merge(const OhlcvBar& later)
+        {
+            if (later.tradeCount == 0)
+                return;
+            if (tradeCount == 0)
+            {
+                const int64_t start = startNs;
+                *this = later;
+                startNs = start;
+                return;
+            }
+            high = std::max(high, later.high);
+            low = std::min(low, later.low);
+            close = later.close;
+            volume += later.volume;
+            buyVolume += later.buyVolume;
+            notional += later.notional;
+            tradeCount += later.tradeCount;
+        }
+
+        namespace
+        {
+            constexpr int64_t SECOND_NS = BarPeriodNs(BarTimeframe::Second1);
+        }
+
+        BarAggregator::BarAggregator(size_t historyBars, int64_t latenessNs)
+            : m_historyBars(0)
+            , m_latenessNs(0)
+            , m_pendingSlots(0)
+            , m_lastKey(0)
+            , m_lastSlot(FlatHashIndex::NOT_FOUND)
+            , m_lateTrades(0)
+            , m_unscaledTrades(0)
+        {
+            Configure(historyBars, latenessNs);
+        }
+
+        void BarAggregator::Configure(size_t historyBars, int64_t latenessNs)
+        {
+            Clear();
+            m_historyBars = std::bit_ceil(std::max<size_t>(historyBars, 1));
+            m_latenessNs = std::max<int64_t>(latenessNs, 0);
+            // Windows from WindowStart(watermark - lateness) to the watermark's own can be open at once
+            m_pendingSlots = static_cast<size_t>((m_latenessNs + SECOND_NS - 1) / SECOND_NS) + 2;
+        }
+
+        int64_t BarAggregator::WindowStart(int64_t timestampNs, size_t level)
+        {
+            const int64_t period = BarPeriodNs(static_cast<BarTimeframe>(level));
+            const int64_t remainder = timestampNs % period;
+            return timestampNs - (remainder < 0 ? remainder + period : remainder);
+        }
+
+        bool BarAggregator::AddTrade(const TradeRecord& trade)
+        {
+            const DecimalScale scale(trade.priceScale, trade.quantityScale);
+            return Apply(GetSlot(TradeStreamKey(trade.exchangeId, trade.symbolId), scale), trade.timestampNs,
+                         trade.price, trade.quantity, scale, trade.side == TradeSide::Buy);
+        }
+
+        void BarAggregator::AddTrades(const std::vector<TradeRecord>& trades)
+        {
+            for (const TradeRecord& trade : trades)
+                AddTrade(trade);
+        }
+
+        void BarAggregator::AddTrades(const TradeColumns& batch)
+        {
+            for (size_t i = 0; i < batch.Size(); i++)
+            {
+                const DecimalScale scale(batch.priceScale[i], batch.quantityScale[i]);
+                Apply(GetSlot(TradeStreamKey(batch.exchangeId[i], batch.symbolId[i]), scale), batch.timestampNs[i],
+                      batch.price[i], batch.quantity[i], scale, batch.side[i] == TradeSide::Buy);
+            }
+        }
+
+        uint32_t BarAggregator::GetSlot(uint64_t key, DecimalScale scale)
+        {
+            if (m_lastSlot != FlatHashIndex::NOT_FOUND && m_lastKey == key)
+                return m_lastSlot;
+
+            uint32_t slot = m_index.Find(key);
+            if (slot == FlatHashIndex::NOT_FOUND)
+            {
+                slot = static_cast<uint32_t>(m_symbols.size());
+                SymbolBars& symbol = m_symbols.emplace_back();
+                symbol.key = key;
+                symbol.scale = scale;
+                symbol.sealedBeforeNs = INT64_MIN;
+                symbol.watermarkNs = INT64_MIN;
+                symbol.rings.fill(Ring{0, 0});
+                m_pending.resize(m_symbols.size() * m_pendingSlots);
+                m_history.resize(m_symbols.size() * BAR_TIMEFRAME_COUNT * m_historyBars);
+                m_index.Insert(key, slot);
+            }
+            m_lastKey = key;
+            m_lastSlot = slot;
+            return slot;
+        }
+
+        uint32_t BarAggregator::FindSlot(uint16_t exchangeId, uint32_t symbolId) const
+        {
+            return m_index.Find(TradeStreamKey(exchangeId, symbolId));
+        }
+
+        size_t BarAggregator::PendingIndex(int64_t windowStartNs) const
+        {
+            const int64_t second = windowStartNs / SECOND_NS; // Window starts are whole seconds
+            const int64_t slots = static_cast<int64_t>(m_pendingSlots);
+            const int64_t index = second % slots;
+            return static_cast<size_t>(index < 0 ? index + slots : index);
+        }
+
+        bool BarAggregator::Apply(uint32_t slot, int64_t timestampNs, Decimal price, Decimal quantity,
+                                  DecimalScale scale, bool isBuy)
+        {
+            SymbolBars& symbol = m_symbols[slot];
+            const int64_t windowStart = WindowStart(timestampNs, 0);
+            if (windowStart < symbol.sealedBeforeNs)
+            {
+                m_lateTrades++;
+                return false;
+            }
+            if ((scale.price != symbol.scale.price && !price.Rescale(scale.price, symbol.scale.price, price)) ||
+                (scale.quantity != symbol.scale.quantity && !quantity.Rescale(scale.quantity, symbol.scale.quantity, quantity)))
+            {
+                m_unscaledTrades++;
+                return false;
+            }
+            if (timestampNs > symbol.watermarkNs)
+            {
+                symbol.watermarkNs = timestampNs;
+                Seal(slot, timestampNs); // Never seals this trade's own window
+            }
+
+            OhlcvBar& bar = Pending(slot)[PendingIndex(windowStart)];
+            if (!bar.IsEmpty() && bar.startNs != windowStart)
+            {
+                // The slot still holds an older second; it is final by now, so publish it before reuse
+                const OhlcvBar closed = bar;
+                bar = OhlcvBar();
+                PushClosed(slot, 0, closed);
+            }
+            if (bar.IsEmpty())
+                bar.startNs = windowStart;
+            bar.AddTrade(price, quantity,
+                         price.ToDouble(symbol.scale.price) * quantity.ToDouble(symbol.scale.quantity), isBuy);
+            return true;
+        }
+
+        void BarAggregator::Seal(uint32_t slot, int64_t upToNs)
+        {
+            // A 1s window is final once trades or the clock are `lateness` past its end
+            SymbolBars& symbol = m_symbols[slot];
+            const int64_t sealedBefore = WindowStart(upToNs - m_latenessNs, 0);
+            const int64_t previous = symbol.sealedBeforeNs;
+            if (sealedBefore <= previous || symbol.watermarkNs == INT64_MIN)
+                return;
+            symbol.sealedBeforeNs = sealedBefore;
+
+            // After a gap the watermark can be far past the pending bars, so the whole
+            // ring is scanned rather than the seconds behind the watermark. Oldest first,
+            // so parents receive their children in time order.
+            OhlcvBar* pending = Pending(slot);
+            m_sealOrder.clear();
+            for (uint32_t i = 0; i < m_pendingSlots; i++)
+            {
+                if (!pending[i].IsEmpty() && pending[i].startNs < sealedBefore)
+                    m_sealOrder.push_back(i);
+            }
+            std::sort(m_sealOrder.begin(), m_sealOrder.end(),
+                      [pending](uint32_t a, uint32_t b) { return pending[a].startNs < pending[b].startNs; });
+            for (uint32_t index : m_sealOrder)
+            {
+                const OhlcvBar closed = pending[index];
+                pending[index] = OhlcvBar();
+                PushClosed(slot, 0, closed);
+            }
+
+            // Lower timeframes first, so each closed bar lands in its parent before the parent is checked
+            for (size_t level = 1; level < BAR_TIMEFRAME_COUNT; level++)
+            {
+                const OhlcvBar& bar = m_symbols[slot].open[level];
+                if (!bar.IsEmpty() && bar.startNs + BarPeriodNs(static_cast<BarTimeframe>(level)) <= sealedBefore)
+                    CloseBar(slot, level);
+            }
+        }
+
+        void BarAggregator::CloseBar(uint32_t slot, size_t level)
+        {
+            SymbolBars& symbol = m_symbols[slot];
+            const OhlcvBar closed = symbol.open[level];
+            symbol.open[level] = OhlcvBar();
+            PushClosed(slot, level, closed);
+        }
+
+        void BarAggregator::PushClosed(uint32_t slot, size_t level, const OhlcvBar& closed)
+        {
+            Ring& ring = m_symbols[slot].rings[level];
+            History(slot, level)[ring.head] = closed;
+            ring.head = static_cast<uint32_t>((ring.head + 1) & (m_historyBars - 1));
+            ring.count = static_cast<uint32_t>(std::min<size_t>(ring.count + 1, m_historyBars));
+
+            if (level + 1 < BAR_TIMEFRAME_COUNT)
+                Fold(slot, level + 1, closed);
+        }
+
+        void BarAggregator::Fold(uint32_t slot, size_t level, const OhlcvBar& closed)
+        {
+            const int64_t windowStart = WindowStart(closed.startNs, level);
+            OhlcvBar& parent = m_symbols[slot].open[level];
+            if (!parent.IsEmpty() && parent.startNs != windowStart)
+                CloseBar(slot, level);
+
+            if (parent.IsEmpty())
+                parent.startNs = windowStart;
+            parent.Merge(closed);
+        }
+
+        void BarAggregator::CloseElapsed(int64_t nowNs)
+        {
+            for (uint32_t slot = 0; slot < m_symbols.size(); slot++)
+                Seal(slot, nowNs);
+        }
+
+        bool BarAggregator::GetCurrentBar(uint16_t exchangeId, uint32_t symbolId, BarTimeframe timeframe,
+                                          OhlcvBar& out) const
+        {
+            out = OhlcvBar();
+            const uint32_t slot = FindSlot(exchangeId, symbolId);
+            if (slot == FlatHashIndex::NOT_FOUND)
+                return false;
+
+            const SymbolBars& symbol = m_symbols[slot];
+            const size_t level = static_cast<size_t>(timeframe);
+            const OhlcvBar* pending = Pending(slot);
+
+            // The newest data sits in the pending 1s bars, then in the lowest open timeframe
+            int64_t newest = INT64_MIN;
+            for (size_t i = 0; i < m_pendingSlots; i++)
+            {
+                if (!pending[i].IsEmpty())
+                    newest = std::max(newest, pending[i].startNs);
+            }
+            for (size_t i = 1; i <= level && newest == INT64_MIN; i++)
+            {
+                if (!symbol.open[i].IsEmpty())
+                    newest = symbol.open[i].startNs;
+            }
+            if (newest == INT64_MIN)
+                return false;
+
+            const int64_t target = WindowStart(newest, level);
+            out.startNs = target;
+            for (size_t i = level; i >= 1; i--)
+            {
+                if (!symbol.open[i].IsEmpty() && WindowStart(symbol.open[i].startNs, level) == target)
+                    out.Merge(symbol.open[i]);
+            }
+            const int64_t oldest = newest - static_cast<int64_t>(m_pendingSlots - 1) * SECOND_NS;
+            for (int64_t start = std::max(oldest, symbol.sealedBeforeNs); start <= newest; start += SECOND_NS)
+            {
+                const OhlcvBar& bar = pending[PendingIndex(start)];
+                if (!bar.IsEmpty() && bar.startNs == start && WindowStart(start, level) == target)
+                    out.Merge(bar);
+            }
+            return !out.IsEmpty();
+        }
+
+        size_t BarAggregator::CopyHistory(uint16_t exchangeId, uint32_t symbolId, BarTimeframe timeframe,
+                                          size_t maxBars, std::vector<OhlcvBar>& out) const
+        {
+            out.clear();
+            const uint32_t slot = FindSlot(exchangeId, symbolId);
+            if (slot == FlatHashIndex::NOT_FOUND)
+                return 0;
+
+            const size_t level = static_cast<size_t>(timeframe);
+            const Ring& ring = m_symbols[slot].rings[level];
+            const size_t count = (maxBars == 0) ? ring.count : std::min<size_t>(maxBars, ring.count);
+            const OhlcvBar* bars = History(slot, level);
+            out.reserve(count);
+            for (size_t i = 1; i <= count; i++)
+                out.push_back(bars[(ring.head - i) & (m_historyBars - 1)]);
+            return count;
+        }
+
+        bool BarAggregator::GetScale(uint16_t exchangeId, uint32_t symbolId, DecimalScale& scale) const
+        {
+            const uint32_t slot = FindSlot(exchangeId, symbolId);
+            if (slot == FlatHashIndex::NOT_FOUND)
+                return false;
+            scale = m_symbols[slot].scale;
+            return true;
+        }
+
+        void BarAggregator::Clear()
+        {
+            m_symbols.clear();
+            m_pending.clear();
+            m_history.clear();
+            m_index.Clear();
+            m_lastSlot = FlatHashIndex::NOT_FOUND;
+            m_lateTrades = 0;
+            m_unscaledTrades = 0;
+        }
+    } // editor
+} // gui
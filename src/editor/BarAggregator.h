@@ -0,0 +1,162 @@
+#pragma once
+
+#include "Decimal.h"
+#include "FlatHashIndex.h"
+#include "TradeBatch.h"
+#include "TradeRecord.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gui::editor
+{
+    enum class BarTimeframe : uint8_t
+    {
+        Second1,
+        Minute1,
+        Minute5,
+        Hour1
+    };
+
+    constexpr size_t BAR_TIMEFRAME_COUNT = 4;
+
+    constexpr int64_t BarPeriodNs(BarTimeframe timeframe)
+    {
+        constexpr int64_t SECOND = 1000000000;
+        switch (timeframe)
+        {
+            case BarTimeframe::Second1: return SECOND;
+            case BarTimeframe::Minute1: return 60 * SECOND;
+            case BarTimeframe::Minute5: return 300 * SECOND;
+            case BarTimeframe::Hour1:   return 3600 * SECOND;
+        }
+        return SECOND;
+    }
+
+    const char* BarTimeframeToString(BarTimeframe timeframe);
+
+    // One OHLCV bar. Prices and volumes stay at the symbol's scales; the notional
+    // sum is only used for VWAP, so it is kept as a double.
+    struct OhlcvBar
+    {
+        int64_t startNs;     // Window start, ns since epoch
+        Decimal open;
+        Decimal high;
+        Decimal low;
+        Decimal close;
+        Decimal volume;
+        Decimal buyVolume;   // Aggressor was the buyer
+        double notional;     // Sum of price * quantity
+        uint32_t tradeCount; // 0 = empty bar
+
+        OhlcvBar() : startNs(0), notional(0.0), tradeCount(0) {}
+
+        bool IsEmpty() const { return tradeCount == 0; }
+        double GetVwap(int quantityScale) const;
+
+        void AddTrade(Decimal price, Decimal quantity, double tradeNotional, bool isBuy);
+        void Merge(const OhlcvBar& later); // `later` covers time after this bar's data
+    };
+
+    // Multi-timeframe bar aggregation for many streams (exchange + symbol) at once.
+    // Trades only touch a pending 1s bar. A 1s bar is sealed once trades (or the
+    // clock) have moved `lateness` past its end; it is then pushed to its ring and
+    // folded into the next timeframe's open bar, so 1m bars are built from 1s bars,
+    // 5m from 1m and 1h from 5m, and trades are never rescanned. A trade costs O(1);
+    // the cascade runs at most once per second per stream.
+    //
+    // Bars are sparse: a window without trades produces no bar. Trades for a 1s
+    // window that has already been sealed are counted as late and dropped, since the
+    // bars they belong to have already been published.
+    class BarAggregator
+    {
+    public:
+        // historyBars is the ring size per stream and timeframe (rounded up to a power of two);
+        // latenessNs is how long after a 1s window ends its trades are still accepted
+        explicit BarAggregator(size_t historyBars = 256, int64_t latenessNs = 0);
+
+        void Configure(size_t historyBars, int64_t latenessNs); // Clears every stream
+
+        bool AddTrade(const TradeRecord& trade); // false when the trade was late or did not fit the stream's scale
+        void AddTrades(const std::vector<TradeRecord>& trades);
+        void AddTrades(const TradeColumns& batch);
+
+        // Seals bars whose lateness window ended before nowNs, for streams that stopped
+        // trading. O(streams); meant to be called about once a second.
+        void CloseElapsed(int64_t nowNs);
+
+        // Bar in progress, including the unsealed lower timeframes
+        bool GetCurrentBar(uint16_t exchangeId, uint32_t symbolId, BarTimeframe timeframe, OhlcvBar& out) const;
+
+        // Sealed bars, newest first. maxBars 0 means the whole ring.
+        size_t CopyHistory(uint16_t exchangeId, uint32_t symbolId, BarTimeframe timeframe, size_t maxBars,
+                           std::vector<OhlcvBar>& out) const;
+
+        bool GetScale(uint16_t exchangeId, uint32_t symbolId, DecimalScale& scale) const;
+        size_t GetStreamCount() const { return m_symbols.size(); }
+        size_t GetHistoryCapacity() const { return m_historyBars; }
+        int64_t GetLatenessNs() const { return m_latenessNs; }
+        uint64_t GetLateTradeCount() const { return m_lateTrades; }
+        uint64_t GetUnscaledTradeCount() const { return m_unscaledTrades; }
+
+        void Clear();
+
+    private:
+        struct Ring
+        {
+            uint32_t head;  // Next slot to write
+            uint32_t count;
+        };
+
+        struct SymbolBars
+        {
+            uint64_t key;            // TradeStreamKey(exchangeId, symbolId)
+            DecimalScale scale;      // Taken from the first trade; later trades are rescaled
+            int64_t sealedBeforeNs;  // 1s windows starting before this are sealed; their trades are late
+            int64_t watermarkNs;     // Newest trade time seen
+            std::array<OhlcvBar, BAR_TIMEFRAME_COUNT> open; // 1m and up; 1s bars wait in the pending ring
+            std::array<Ring, BAR_TIMEFRAME_COUNT> rings;
+        };
+
+        static int64_t WindowStart(int64_t timestampNs, size_t level);
+
+        uint32_t GetSlot(uint64_t key, DecimalScale scale);
+        uint32_t FindSlot(uint16_t exchangeId, uint32_t symbolId) const;
+        size_t PendingIndex(int64_t windowStartNs) const; // Slot of a 1s window in its stream's pending ring
+        bool Apply(uint32_t slot, int64_t timestampNs, Decimal price, Decimal quantity,
+                   DecimalScale scale, bool isBuy);
+        void Seal(uint32_t slot, int64_t upToNs); // Seals the 1s windows that are final, then their parents
+        void CloseBar(uint32_t slot, size_t level);
+        void PushClosed(uint32_t slot, size_t level, const OhlcvBar& closed);
+        void Fold(uint32_t slot, size_t level, const OhlcvBar& closed);
+
+        OhlcvBar* Pending(uint32_t slot) { return m_pending.data() + static_cast<size_t>(slot) * m_pendingSlots; }
+        const OhlcvBar* Pending(uint32_t slot) const
+        {
+            return m_pending.data() + static_cast<size_t>(slot) * m_pendingSlots;
+        }
+        OhlcvBar* History(uint32_t slot, size_t level)
+        {
+            return m_history.data() + (static_cast<size_t>(slot) * BAR_TIMEFRAME_COUNT + level) * m_historyBars;
+        }
+        const OhlcvBar* History(uint32_t slot, size_t level) const
+        {
+            return m_history.data() + (static_cast<size_t>(slot) * BAR_TIMEFRAME_COUNT + level) * m_historyBars;
+        }
+
+        size_t m_historyBars;
+        int64_t m_latenessNs;
+        size_t m_pendingSlots;           // Unsealed 1s windows per stream: lateness in seconds + 2
+        std::vector<SymbolBars> m_symbols;
+        std::vector<OhlcvBar> m_pending; // Unsealed 1s bars, m_pendingSlots per stream, by second
+        std::vector<OhlcvBar> m_history; // Rings of all streams, one block per stream
+        FlatHashIndex m_index;           // Stream key -> slot in m_symbols
+        std::vector<uint32_t> m_sealOrder; // Reused by Seal: pending slots to seal, oldest first
+        uint64_t m_lastKey;              // Trades arrive in runs per stream
+        uint32_t m_lastSlot;
+        uint64_t m_lateTrades;
+        uint64_t m_unscaledTrades; // Price or quantity overflowed the stream's scale
+    };
+}
@@ -0,0 +1,102 @@
+#include "BatchArena.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace gui
+{
+    namespace editor
+    {
+        BatchArena::BatchArena(size_t blockSize)
+            : m_currentBlock(0)
+            , m_cursor(nullptr)
+            , m_limit(nullptr)
+            , m_blockSize(blockSize)
+            , m_bytesUsed(0)
+            , m_bytesReserved(0)
+            , m_highWaterMark(0)
+        {
+        }
+
+        BatchArena::~BatchArena()
+        {
+            for (const Block& block : m_blocks)
+                ::operator delete(block.data, std::align_val_t(alignof(std::max_align_t)));
+        }
+
+        void* BatchArena::Allocate(size_t size, size_t alignment)
+        {
+            if (size == 0)
+                size = 1;
+
+            for (;;)
+            {
+                const auto address = reinterpret_cast<uintptr_t>(m_cursor);
+                const uintptr_t aligned = (address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+                char* result = reinterpret_cast<char*>(aligned);
+
+                if (m_cursor && result + size <= m_limit)
+                {
+                    m_bytesUsed += static_cast<size_t>(result + size - m_cursor);
+                    m_cursor = result + size;
+                    return result;
+                }
+
+                // Move to the next retained block if it is large enough, otherwise grow
+                if (m_cursor && m_currentBlock + 1 < m_blocks.size() &&
+                    m_blocks[m_currentBlock + 1].size >= size + alignment)
+                {
+                    ++m_currentBlock;
+                }
+                else
+                {
+                    AddBlock(size + alignment);
+                }
+
+                m_cursor = m_blocks[m_currentBlock].data;
+                m_limit = m_cursor + m_blocks[m_currentBlock].size;
+            }
+        }
+
+        void BatchArena::AddBlock(size_t minimumSize)
+        {
+            const size_t size = std::max(m_blockSize, minimumSize);
+            char* data = static_cast<char*>(::operator new(size, std::align_val_t(alignof(std::max_align_t))));
+
+            // Keep retained blocks in order so Reset() walks them front to back
+            const size_t position = m_cursor ? m_currentBlock + 1 : 0;
+            m_blocks.insert(m_blocks.begin() + static_cast<std::ptrdiff_t>(position), Block{data, size});
+            m_currentBlock = position;
+            m_bytesReserved += size;
+        }
+
+        void BatchArena::Reset()
+        {
+            m_highWaterMark = std::max(m_highWaterMark, m_bytesUsed);
+            m_bytesUsed = 0;
+            m_currentBlock = 0;
+            if (m_blocks.empty())
+            {
+                m_cursor = nullptr;
+                m_limit = nullptr;
+                return;
+            }
+            m_cursor = m_blocks[0].data;
+            m_limit = m_cursor + m_blocks[0].size;
+        }
+
+        std::string_view BatchArena::CopyString(std::string_view text)
+        {
+            char* copy = static_cast<char*>(Allocate(text.size(), 1));
+            std::memcpy(copy, text.data(), text.size());
+            return std::string_view(copy, text.size());
+        }
+
+        BatchArena& GetThreadArena()
+        {
+            thread_local BatchArena arena;
+            return arena;
+        }
+    } // editor
+} // gui
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gui::editor
+{
+    // Bump-pointer arena for temporaries that die within one processing batch.
+    // Allocation is a pointer increment; Reset() releases everything at once and
+    // keeps the blocks, so after warm-up a batch never calls the global allocator.
+    class BatchArena
+    {
+    public:
+        static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+        explicit BatchArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+        ~BatchArena();
+
+        BatchArena(const BatchArena&) = delete;
+        BatchArena& operator=(const BatchArena&) = delete;
+
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+        void Reset();
+
+        std::string_view CopyString(std::string_view text);
+
+        // Statistics
+        size_t GetBytesUsed() const { return m_bytesUsed; }
+        size_t GetBytesReserved() const { return m_bytesReserved; }
+        size_t GetBlockCount() const { return m_blocks.size(); }
+        size_t GetHighWaterMark() const { return m_highWaterMark; }
+
+    private:
+        struct Block
+        {
+            char* data;
+            size_t size;
+        };
+
+        void AddBlock(size_t minimumSize);
+
+        std::vector<Block> m_blocks;
+        size_t m_currentBlock;
+        char* m_cursor;
+        char* m_limit;
+        size_t m_blockSize;
+        size_t m_bytesUsed;
+        size_t m_bytesReserved;
+        size_t m_highWaterMark;
+    };
+
+    // Arena owned by the calling worker thread
+    BatchArena& GetThreadArena();
+
+    // Resets the thread arena when the batch ends
+    class BatchArenaScope
+    {
+    public:
+        BatchArenaScope() : m_arena(GetThreadArena()) {}
+        ~BatchArenaScope() { m_arena.Reset(); }
+
+        BatchArena& GetArena() { return m_arena; }
+
+    private:
+        BatchArena& m_arena;
+    };
+
+    // std::allocator-compatible adapter; deallocate is a no-op
+    template<typename T>
+    class ArenaAllocator
+    {
+    public:
+        using value_type = T;
+
+        ArenaAllocator() noexcept : m_arena(&GetThreadArena()) {}
+        explicit ArenaAllocator(BatchArena& arena) noexcept : m_arena(&arena) {}
+
+        template<typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena(other.GetArena()) {}
+
+        T* allocate(size_t count)
+        {
+            return static_cast<T*>(m_arena->Allocate(count * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T*, size_t) noexcept {}
+
+        BatchArena* GetArena() const noexcept { return m_arena; }
+
+        template<typename U>
+        bool operator==(const ArenaAllocator<U>& other) const noexcept { return m_arena == other.GetArena(); }
+
+    private:
+        BatchArena* m_arena;
+    };
+
+    // Temporaries for extractors, filters and processors. Never keep them past the batch.
+    using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+    template<typename T>
+    using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+}
@@ -0,0 +1,199 @@
+#include "BookAnalytics.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace gui
+{
+    namespace editor
+    {
+        BookAnalytics::BookAnalytics(size_t windowTicks)
+            : m_windowTicks(std::bit_ceil(std::max<size_t>(windowTicks, 64)))
+            , m_baseTick(0)
+            , m_tickUnits(0)
+            , m_rebuildCount(0)
+        {
+            for (Side* side : {&m_bids, &m_asks})
+            {
+                side->quantity.assign(m_windowTicks, 0);
+                side->depth.Reset(m_windowTicks);
+                side->notional.Reset(m_windowTicks);
+            }
+        }
+
+        void BookAnalytics::Rebuild(const PriceLadderBook& book)
+        {
+            m_tickUnits = std::max<int64_t>(book.GetTickUnits(), 1);
+
+            // Centre the window on the touch (or whichever side exists)
+            NormalizedOrderbookLevel bid;
+            NormalizedOrderbookLevel ask;
+            const bool hasBid = book.GetBestBid(bid);
+            const bool hasAsk = book.GetBestAsk(ask);
+            int64_t centre = 0;
+            if (hasBid && hasAsk)
+                centre = (bid.price.units / m_tickUnits + ask.price.units / m_tickUnits) / 2;
+            else if (hasBid || hasAsk)
+                centre = (hasBid ? bid.price.units : ask.price.units) / m_tickUnits;
+            m_baseTick = centre - static_cast<int64_t>(m_windowTicks / 2);
+
+            thread_local std::vector<NormalizedOrderbookLevel> levels;
+            std::vector<int64_t> notional(m_windowTicks);
+            for (bool isBid : {true, false})
+            {
+                Side& side = isBid ? m_bids : m_asks;
+                std::fill(side.quantity.begin(), side.quantity.end(), 0);
+
+                // Levels are best-first; stop at the first one beyond the window
+                book.CopyTop(isBid, 0, levels);
+                for (const NormalizedOrderbookLevel& level : levels)
+                {
+                    const int64_t tick = level.price.units / m_tickUnits;
+                    if (!InWindow(tick))
+                    {
+                        if (isBid ? tick < m_baseTick : tick >= m_baseTick + static_cast<int64_t>(m_windowTicks))
+                            break;
+                        continue;
+                    }
+                    side.quantity[static_cast<size_t>(tick - m_baseTick)] = level.quantity.units;
+                }
+
+                for (size_t i = 0; i < m_windowTicks; i++)
+                    notional[i] = static_cast<int64_t>(i) * side.quantity[i];
+                side.depth.Build(side.quantity);
+                side.notional.Build(notional);
+            }
+            m_rebuildCount++;
+        }
+
+        void BookAnalytics::ApplyLevel(const PriceLadderBook& book, bool isBid, Decimal price, Decimal quantity)
+        {
+            // The book may have adopted a finer tick for this price
+            if (book.GetTickUnits() != m_tickUnits)
+            {
+                Rebuild(book);
+                return;
+            }
+
+            const int64_t tick = price.units / m_tickUnits;
+            if (InWindow(tick))
+            {
+                Side& side = isBid ? m_bids : m_asks;
+                const size_t index = static_cast<size_t>(tick - m_baseTick);
+                const int64_t delta = quantity.units - side.quantity[index];
+                if (delta != 0)
+                {
+                    side.quantity[index] = quantity.units;
+                    side.depth.Add(index, delta);
+                    side.notional.Add(index, static_cast<int64_t>(index) * delta);
+                }
+            }
+
+            if (NeedsRecenter(book))
+                Rebuild(book);
+        }
+
+        bool BookAnalytics::NeedsRecenter(const PriceLadderBook& book) const
+        {
+            NormalizedOrderbookLevel bid;
+            NormalizedOrderbookLevel ask;
+            const int64_t quarter = static_cast<int64_t>(m_windowTicks / 4);
+            const int64_t low = m_baseTick + quarter;
+            const int64_t high = m_baseTick + static_cast<int64_t>(m_windowTicks) - quarter;
+            if (book.GetBestBid(bid))
+            {
+                const int64_t tick = bid.price.units / m_tickUnits;
+                if (tick < low || tick >= high)
+                    return true;
+            }
+            if (book.GetBestAsk(ask))
+            {
+                const int64_t tick = ask.price.units / m_tickUnits;
+                if (tick < low || tick >= high)
+                    return true;
+            }
+            return false;
+        }
+
+        void BookAnalytics::SumRange(const Side& side, int64_t fromTick, int64_t toTick,
+                                     int64_t& depth, int64_t& notional) const
+        {
+            fromTick = std::max(fromTick, m_baseTick);
+            toTick = std::min(toTick, m_baseTick + static_cast<int64_t>(m_windowTicks) - 1);
+            if (toTick < fromTick)
+            {
+                depth = 0;
+                notional = 0;
+                return;
+            }
+            const size_t begin = static_cast<size_t>(fromTick - m_baseTick);
+            const size_t end = static_cast<size_t>(toTick - m_baseTick) + 1;
+            depth = side.depth.Range(begin, end);
+            notional = side.notional.Range(begin, end);
+        }
+
+        bool BookAnalytics::Compute(const PriceLadderBook& book, DecimalScale scale, double bandBps,
+                                    BookAnalyticsSample& sample) const
+        {
+            NormalizedOrderbookLevel bid;
+            NormalizedOrderbookLevel ask;
+            if (m_tickUnits == 0 || !book.GetBestBid(bid) || !book.GetBestAsk(ask))
+                return false;
+
+            const double bidPrice = bid.price.ToDouble(scale.price);
+            const double askPrice = ask.price.ToDouble(scale.price);
+            const double bidQuantity = bid.quantity.ToDouble(scale.quantity);
+            const double askQuantity = ask.quantity.ToDouble(scale.quantity);
+            const double touchQuantity = bidQuantity + askQuantity;
+
+            sample.midPrice = (bidPrice + askPrice) * 0.5;
+            sample.microprice = touchQuantity > 0.0
+                ? (bidPrice * askQuantity + askPrice * bidQuantity) / touchQuantity
+                : sample.midPrice;
+            sample.topImbalance = touchQuantity > 0.0
+                ? static_cast<float>((bidQuantity - askQuantity) / touchQuantity)
+                : 0.0f;
+
+            // Band edges in ticks around the mid
+            const double tickPrice = static_cast<double>(m_tickUnits) / static_cast<double>(DecimalPow10(scale.price));
+            const double midTick = sample.midPrice / tickPrice;
+            // Edges landing exactly on a tick count as inside, despite rounding in the product
+            const double band = bandBps * 1e-4;
+            const int64_t lowTick = static_cast<int64_t>(std::ceil(midTick * (1.0 - band) - 1e-6));
+            const int64_t highTick = static_cast<int64_t>(std::floor(midTick * (1.0 + band) + 1e-6));
+            const int64_t midFloor = static_cast<int64_t>(std::floor(midTick));
+            const int64_t midCeil = static_cast<int64_t>(std::ceil(midTick));
+
+            int64_t bidUnits = 0;
+            int64_t askUnits = 0;
+            int64_t bidNotional = 0;
+            int64_t askNotional = 0;
+            SumRange(m_bids, lowTick, midFloor, bidUnits, bidNotional);
+            SumRange(m_asks, midCeil, highTick, askUnits, askNotional);
+
+            const double quantityUnit = 1.0 / static_cast<double>(DecimalPow10(scale.quantity));
+            sample.bidDepth = static_cast<double>(bidUnits) * quantityUnit;
+            sample.askDepth = static_cast<double>(askUnits) * quantityUnit;
+
+            const double bandDepth = sample.bidDepth + sample.askDepth;
+            sample.depthImbalance = bandDepth > 0.0
+                ? static_cast<float>((sample.bidDepth - sample.askDepth) / bandDepth)
+                : 0.0f;
+
+            if (bidUnits > 0 && askUnits > 0)
+            {
+                // Band VWAPs from the notional sums, which are kept as window index * quantity
+                const double base = static_cast<double>(m_baseTick);
+                const double bidVwap = (base + static_cast<double>(bidNotional) / static_cast<double>(bidUnits)) * tickPrice;
+                const double askVwap = (base + static_cast<double>(askNotional) / static_cast<double>(askUnits)) * tickPrice;
+                sample.queueWeightedMid = (bidVwap * sample.askDepth + askVwap * sample.bidDepth) / bandDepth;
+            }
+            else
+            {
+                sample.queueWeightedMid = sample.microprice;
+            }
+            return true;
+        }
+    } // editor
+} // gui
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Decimal.h"
+#include "PriceLadderBook.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gui::editor
+{
+    // Binary indexed tree: point add and prefix sum in O(log n)
+    template<typename T>
+    class FenwickTree
+    {
+    public:
+        void Reset(size_t size) { m_tree.assign(size + 1, T()); }
+        size_t Size() const { return m_tree.empty() ? 0 : m_tree.size() - 1; }
+
+        // Builds from dense values in O(n)
+        void Build(const std::vector<T>& values)
+        {
+            m_tree.assign(values.size() + 1, T());
+            for (size_t i = 1; i < m_tree.size(); i++)
+            {
+                m_tree[i] += values[i - 1];
+                const size_t parent = i + (i & (0 - i));
+                if (parent < m_tree.size())
+                    m_tree[parent] += m_tree[i];
+            }
+        }
+
+        void Add(size_t index, T delta)
+        {
+            for (size_t i = index + 1; i < m_tree.size(); i += i & (0 - i))
+                m_tree[i] += delta;
+        }
+
+        T Prefix(size_t end) const // Sum of [0, end)
+        {
+            T sum = T();
+            for (size_t i = end; i > 0; i -= i & (0 - i))
+                sum += m_tree[i];
+            return sum;
+        }
+
+        T Range(size_t begin, size_t end) const { return end > begin ? Prefix(end) - Prefix(begin) : T(); }
+
+    private:
+        std::vector<T> m_tree;
+    };
+
+    // Microstructure metrics of one book at one instant
+    struct BookAnalyticsSample
+    {
+        int64_t timestampNs;
+        uint32_t symbolId;       // Interned currency pair (TradeStringTable)
+        float topImbalance;      // (bidQty - askQty) / (bidQty + askQty) at the touch, in [-1, 1]
+        float depthImbalance;    // Same over the levels within the band
+        double midPrice;
+        double microprice;       // Touch prices weighted by the opposite queue
+        double queueWeightedMid; // Band VWAPs weighted by the opposite band depth
+        double bidDepth;         // Quantity within the band below mid
+        double askDepth;         // Quantity within the band above mid
+    };
+
+    static_assert(sizeof(BookAnalyticsSample) <= 64, "BookAnalyticsSample must fit in a cache line");
+
+    // Incremental depth sums for one L2 book. Quantities of the ticks in a window
+    // around the mid are held in integer Fenwick trees (quantity and window index *
+    // quantity per side), so a level change and a depth-within-band query both cost O(log window)
+    // whatever the number of levels. The window follows the mid and is rebuilt from
+    // the book when the mid drifts into its outer quarters, which is rare.
+    //
+    // Feed it the same changes as the PriceLadderBook it describes: ApplyLevel after
+    // each PriceLadderBook::SetLevel, Rebuild after a snapshot.
+    class BookAnalytics
+    {
+    public:
+        explicit BookAnalytics(size_t windowTicks = 8192);
+
+        void Rebuild(const PriceLadderBook& book);
+        void ApplyLevel(const PriceLadderBook& book, bool isBid, Decimal price, Decimal quantity);
+
+        // O(log window). Bands wider than half the window are clipped to it.
+        bool Compute(const PriceLadderBook& book, DecimalScale scale, double bandBps,
+                     BookAnalyticsSample& sample) const;
+
+        size_t GetRebuildCount() const { return m_rebuildCount; }
+
+    private:
+        struct Side
+        {
+            std::vector<int64_t> quantity;   // Quantity units per window tick
+            FenwickTree<int64_t> depth;
+            FenwickTree<int64_t> notional;   // Window index * quantity units, exact like the depth sums
+        };
+
+        bool InWindow(int64_t tick) const
+        {
+            return tick >= m_baseTick && tick < m_baseTick + static_cast<int64_t>(m_windowTicks);
+        }
+        bool NeedsRecenter(const PriceLadderBook& book) const; // Touch drifted into an outer quarter
+
+        // Sums over [fromTick, toTick] clipped to the window
+        void SumRange(const Side& side, int64_t fromTick, int64_t toTick, int64_t& depth, int64_t& notional) const;
+
+        size_t m_windowTicks;
+        int64_t m_baseTick;   // Tick of window index 0
+        int64_t m_tickUnits;  // Tick size the window was built with; a change forces a rebuild
+        Side m_bids;
+        Side m_asks;
+        size_t m_rebuildCount;
+    };
+}
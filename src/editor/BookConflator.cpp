@@ -0,0 +1,180 @@
+#include "BookConflator.h"
+
+#include <algorithm>
+
+namespace gui
+{
+    namespace editor
+    {
+        BookConflator::BookConflator(size_t snapshotThreshold)
+            : m_bidIndex(64)
+            , m_askIndex(64)
+            , m_windowDepth(0)
+            , m_snapshotThreshold(snapshotThreshold)
+            , m_needsSnapshot(true)
+            , m_updatesIn(0)
+            , m_reads(0)
+        {
+        }
+
+        void BookConflator::OnReset()
+        {
+            // The snapshot read will carry every level; pending deltas are redundant
+            Clear();
+            m_needsSnapshot = true;
+            m_updatesIn++;
+        }
+
+        void BookConflator::OnLevel(bool isBid, Decimal price, Decimal quantity, int orderCount)
+        {
+            m_updatesIn++;
+            if (m_needsSnapshot)
+                return;
+
+            FlatHashIndex& index = isBid ? m_bidIndex : m_askIndex;
+            std::vector<NormalizedOrderbookLevel>& dirty = isBid ? m_bidDirty : m_askDirty;
+
+            const auto key = static_cast<uint64_t>(price.units);
+            uint32_t slot = index.Find(key);
+            if (slot == FlatHashIndex::NOT_FOUND)
+            {
+                slot = static_cast<uint32_t>(dirty.size());
+                index.Insert(key, slot);
+                dirty.emplace_back();
+                dirty.back().price = price;
+            }
+            dirty[slot].quantity = quantity;
+            dirty[slot].orderCount = orderCount;
+
+            if (m_snapshotThreshold != 0 && m_bidDirty.size() + m_askDirty.size() > m_snapshotThreshold)
+            {
+                Clear();
+                m_needsSnapshot = true;
+            }
+        }
+
+        bool BookConflator::Read(const PriceLadderBook& book, size_t depth, NormalizedOrderbook& out)
+        {
+            if (depth != m_windowDepth)
+                m_needsSnapshot = true;
+            if (!HasChanges())
+                return false;
+
+            out.scale = m_scale;
+            if (m_needsSnapshot)
+            {
+                book.CopyTop(true, depth, out.bids);
+                book.CopyTop(false, depth, out.asks);
+                out.isSnapshot = true;
+                m_needsSnapshot = false;
+                m_windowDepth = depth;
+
+                m_bidWindow.clear();
+                for (const NormalizedOrderbookLevel& level : out.bids)
+                    m_bidWindow.push_back(level.price);
+                m_askWindow.clear();
+                for (const NormalizedOrderbookLevel& level : out.asks)
+                    m_askWindow.push_back(level.price);
+            }
+            else
+            {
+                book.CopyTop(true, depth, m_top);
+                DiffWindow(true, out.bids);
+                book.CopyTop(false, depth, m_top);
+                DiffWindow(false, out.asks);
+                out.isSnapshot = false;
+            }
+
+            Clear();
+            m_reads++;
+            return true;
+        }
+
+        void BookConflator::DiffWindow(bool isBid, std::vector<NormalizedOrderbookLevel>& out)
+        {
+            // Both windows are sorted best first, so one merge pass pairs them up
+            std::vector<Decimal>& window = isBid ? m_bidWindow : m_askWindow;
+            const FlatHashIndex& dirty = isBid ? m_bidIndex : m_askIndex;
+            const auto better = [isBid](Decimal a, Decimal b) { return isBid ? a > b : a < b; };
+
+            out.clear();
+            size_t previous = 0;
+            size_t current = 0;
+            while (previous < window.size() || current < m_top.size())
+            {
+                if (current == m_top.size() ||
+                    (previous < window.size() && better(window[previous], m_top[current].price)))
+                {
+                    // Pushed out of the window, or removed from the book
+                    NormalizedOrderbookLevel& removed = out.emplace_back();
+                    removed.price = window[previous++];
+                }
+                else if (previous == window.size() || better(m_top[current].price, window[previous]))
+                {
+                    out.push_back(m_top[current++]); // Entered the window
+                }
+                else
+                {
+                    if (dirty.Find(static_cast<uint64_t>(m_top[current].price.units)) != FlatHashIndex::NOT_FOUND)
+                        out.push_back(m_top[current]);
+                    previous++;
+                    current++;
+                }
+            }
+
+            window.clear();
+            for (const NormalizedOrderbookLevel& level : m_top)
+                window.push_back(level.price);
+        }
+
+        void BookConflator::Clear()
+        {
+            // Erase key by key; the dirty set is small compared to the index capacity
+            for (const NormalizedOrderbookLevel& level : m_bidDirty)
+                m_bidIndex.Erase(static_cast<uint64_t>(level.price.units));
+            for (const NormalizedOrderbookLevel& level : m_askDirty)
+                m_askIndex.Erase(static_cast<uint64_t>(level.price.units));
+            m_bidDirty.clear();
+            m_askDirty.clear();
+        }
+
+        void ConflatedBookView::Apply(const NormalizedOrderbook& read)
+        {
+            m_scale = read.scale;
+            if (read.isSnapshot)
+            {
+                m_bids.assign(read.bids.begin(), read.bids.end());
+                m_asks.assign(read.asks.begin(), read.asks.end());
+                return;
+            }
+            ApplySide(true, read.bids, m_bids);
+            ApplySide(false, read.asks, m_asks);
+        }
+
+        void ConflatedBookView::ApplySide(bool isBid, const std::vector<NormalizedOrderbookLevel>& changes,
+                                          std::vector<NormalizedOrderbookLevel>& levels)
+        {
+            const auto better = [isBid](const NormalizedOrderbookLevel& level, Decimal price) {
+                return isBid ? level.price > price : level.price < price;
+            };
+            for (const NormalizedOrderbookLevel& change : changes)
+            {
+                const auto it = std::lower_bound(levels.begin(), levels.end(), change.price, better);
+                const bool found = it != levels.end() && it->price == change.price;
+                if (change.quantity.IsZero())
+                {
+                    if (found)
+                        levels.erase(it);
+                }
+                else if (found)
+                {
+                    *it = change;
+                }
+                else
+                {
+                    levels.insert(it, change);
+                }
+            }
+        }
+    } // editor
+} // gui
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "FlatHashIndex.h"
+#include "MessageProcessors.h"
+#include "PriceLadderBook.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gui::editor
+{
+    // Coalesces book changes between consumer reads. Each (side, price) is held
+    // once in a dirty set with its latest quantity, so a consumer that reads at
+    // frame rate gets one net delta however many updates arrived in between.
+    // After a book reset, a depth change, or when the dirty set outgrows the
+    // threshold, the read returns a top-N snapshot taken from the book instead.
+    //
+    // Deltas are relative to the top-N window of the previous read, not the whole
+    // book: levels that entered the window are sent even if they did not change,
+    // levels that left it are sent with quantity 0, and changes outside both
+    // windows are dropped. A consumer applying each read to the previous result
+    // (see ConflatedBookView) therefore holds exactly the book's top N.
+    class BookConflator
+    {
+    public:
+        explicit BookConflator(size_t snapshotThreshold = 256);
+
+        void OnReset(); // Book was replaced (snapshot / resync)
+        void OnLevel(bool isBid, Decimal price, Decimal quantity, int orderCount);
+        void SetScale(DecimalScale scale) { m_scale = scale; }
+
+        bool HasChanges() const { return m_needsSnapshot || !m_bidDirty.empty() || !m_askDirty.empty(); }
+
+        // Writes the net change since the last read into `out` (levels cleared, capacity kept).
+        // Quantity 0 marks a level removed from the window. Returns false when nothing changed.
+        bool Read(const PriceLadderBook& book, size_t depth, NormalizedOrderbook& out);
+
+        uint64_t GetUpdatesIn() const { return m_updatesIn; }
+        uint64_t GetReads() const { return m_reads; }
+
+    private:
+        void Clear();
+        void DiffWindow(bool isBid, std::vector<NormalizedOrderbookLevel>& out);
+
+        FlatHashIndex m_bidIndex; // price units -> slot in m_bidDirty
+        FlatHashIndex m_askIndex;
+        std::vector<NormalizedOrderbookLevel> m_bidDirty;
+        std::vector<NormalizedOrderbookLevel> m_askDirty;
+        std::vector<Decimal> m_bidWindow; // Prices sent by the previous read, best first
+        std::vector<Decimal> m_askWindow;
+        std::vector<NormalizedOrderbookLevel> m_top; // Scratch for the current window
+        size_t m_windowDepth;
+        size_t m_snapshotThreshold;
+        DecimalScale m_scale;
+        bool m_needsSnapshot;
+        uint64_t m_updatesIn;
+        uint64_t m_reads;
+    };
+
+    // Consumer-side copy of a conflated top-N book: applies each Read() result in
+    // order. Levels stay sorted best first.
+    class ConflatedBookView
+    {
+    public:
+        void Apply(const NormalizedOrderbook& read);
+
+        const std::vector<NormalizedOrderbookLevel>& GetBids() const { return m_bids; }
+        const std::vector<NormalizedOrderbookLevel>& GetAsks() const { return m_asks; }
+        DecimalScale GetScale() const { return m_scale; }
+
+    private:
+        static void ApplySide(bool isBid, const std::vector<NormalizedOrderbookLevel>& changes,
+                              std::vector<NormalizedOrderbookLevel>& levels);
+
+        std::vector<NormalizedOrderbookLevel> m_bids;
+        std::vector<NormalizedOrderbookLevel> m_asks;
+        DecimalScale m_scale;
+    };
+}
@@ -0,0 +1,203 @@
+#include "BookIntegrity.h"
+
+#include <array>
+
+namespace gui
+{
+    namespace editor
+    {
+        namespace
+        {
+            constexpr std::array<uint32_t, 256> MakeCrcTable()
+            {
+                std::array<uint32_t, 256> table{};
+                for (uint32_t i = 0; i < 256; i++)
+                {
+                    uint32_t crc = i;
+                    for (int bit = 0; bit < 8; bit++)
+                        crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+                    table[i] = crc;
+                }
+                return table;
+            }
+
+            constexpr std::array<uint32_t, 256> CRC_TABLE = MakeCrcTable();
+
+            // Running CRC over the pieces of the checksum string, so nothing is concatenated
+            struct CrcStream
+            {
+                uint32_t crc = 0xFFFFFFFFu;
+
+                void Append(const char* data, size_t size)
+                {
+                    for (size_t i = 0; i < size; i++)
+                        crc = CRC_TABLE[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+                }
+                void Append(char c) { Append(&c, 1); }
+                uint32_t Finish() const { return crc ^ 0xFFFFFFFFu; }
+            };
+
+            // Kraken: the value printed at the pair's precision, digits only, without the
+            // decimal point or leading zeros
+            void AppendKrakenField(CrcStream& stream, Decimal value, int scale, int precision)
+            {
+                Decimal printed;
+                if (!value.Rescale(scale, precision, printed))
+                    return;
+                char buffer[32];
+                const size_t length = printed.Format(buffer, sizeof(buffer), precision);
+                bool leading = true;
+                for (size_t i = 0; i < length; i++)
+                {
+                    const char c = buffer[i];
+                    if (c == '.' || (leading && c == '0'))
+                        continue;
+                    leading = false;
+                    stream.Append(c);
+                }
+            }
+
+            // Shortest form without trailing zeros, as OKX strings and JSON numbers are printed
+            void AppendTrimmedField(CrcStream& stream, Decimal value, int scale)
+            {
+                char buffer[32];
+                size_t length = value.Format(buffer, sizeof(buffer), scale);
+                if (scale > 0)
+                {
+                    while (length > 0 && buffer[length - 1] == '0')
+                        length--;
+                    if (length > 0 && buffer[length - 1] == '.')
+                        length--;
+                }
+                stream.Append(buffer, length);
+            }
+
+            // Top levels copied once per checksum; kept per thread to avoid reallocating
+            std::vector<NormalizedOrderbookLevel>& ScratchLevels(bool isBid)
+            {
+                thread_local std::vector<NormalizedOrderbookLevel> bids;
+                thread_local std::vector<NormalizedOrderbookLevel> asks;
+                return isBid ? bids : asks;
+            }
+        }
+
+        namespace BookChecksum
+        {
+            size_t GetDepth(ChecksumScheme scheme)
+            {
+                switch (scheme)
+                {
+                    case ChecksumScheme::Kraken:   return 10;
+                    case ChecksumScheme::Okx:      return 25;
+                    case ChecksumScheme::Bitfinex: return 25;
+                    case ChecksumScheme::None:     break;
+                }
+                return 0;
+            }
+
+            uint32_t Crc32(const void* data, size_t size, uint32_t crc)
+            {
+                CrcStream stream{crc ^ 0xFFFFFFFFu};
+                stream.Append(static_cast<const char*>(data), size);
+                return stream.Finish();
+            }
+
+            uint32_t Compute(ChecksumScheme scheme, const PriceLadderBook& book, DecimalScale scale,
+                             DecimalScale venuePrecision)
+            {
+                const size_t depth = GetDepth(scheme);
+                if (depth == 0)
+                    return 0;
+
+                std::vector<NormalizedOrderbookLevel>& bids = ScratchLevels(true);
+                std::vector<NormalizedOrderbookLevel>& asks = ScratchLevels(false);
+                book.CopyTop(true, depth, bids);
+                book.CopyTop(false, depth, asks);
+
+                CrcStream stream;
+                switch (scheme)
+                {
+                    case ChecksumScheme::Kraken:
+                        for (const NormalizedOrderbookLevel& level : asks)
+                        {
+                            AppendKrakenField(stream, level.price, scale.price, venuePrecision.price);
+                            AppendKrakenField(stream, level.quantity, scale.quantity, venuePrecision.quantity);
+                        }
+                        for (const NormalizedOrderbookLevel& level : bids)
+                        {
+                            AppendKrakenField(stream, level.price, scale.price, venuePrecision.price);
+                            AppendKrakenField(stream, level.quantity, scale.quantity, venuePrecision.quantity);
+                        }
+                        break;
+
+                    case ChecksumScheme::Okx:
+                    case ChecksumScheme::Bitfinex:
+                    {
+                        const bool okx = scheme == ChecksumScheme::Okx;
+                        bool first = true;
+                        auto appendLevel = [&](const NormalizedOrderbookLevel& level, bool negate) {
+                            if (!first)
+                                stream.Append(':');
+                            first = false;
+                            AppendTrimmedField(stream, level.price, scale.price);
+                            stream.Append(':');
+                            AppendTrimmedField(stream, negate ? -level.quantity : level.quantity, scale.quantity);
+                        };
+                        for (size_t i = 0; i < depth; i++)
+                        {
+                            if (i < bids.size())
+                                appendLevel(bids[i], false);
+                            if (i < asks.size())
+                                appendLevel(asks[i], !okx);
+                        }
+                        break;
+                    }
+
+                    case ChecksumScheme::None:
+                        break;
+                }
+                return stream.Finish();
+            }
+        }
+
+        namespace BookIntegrity
+        {
+            bool IsSorted(const std::vector<NormalizedOrderbookLevel>& levels, bool isBids)
+            {
+                const size_t count = levels.size();
+                if (count < 2)
+                    return true;
+
+                // Count violations instead of returning at the first one: no data-dependent branch
+                const NormalizedOrderbookLevel* data = levels.data();
+                size_t violations = 0;
+                if (isBids)
+                {
+                    for (size_t i = 1; i < count; i++)
+                        violations += static_cast<size_t>(data[i].price.units >= data[i - 1].price.units);
+                }
+                else
+                {
+                    for (size_t i = 1; i < count; i++)
+                        violations += static_cast<size_t>(data[i].price.units <= data[i - 1].price.units);
+                }
+                return violations == 0;
+            }
+
+            bool HasNonPositiveQuantity(const std::vector<NormalizedOrderbookLevel>& levels)
+            {
+                const NormalizedOrderbookLevel* data = levels.data();
+                size_t violations = 0;
+                for (size_t i = 0; i < levels.size(); i++)
+                    violations += static_cast<size_t>(data[i].quantity.units <= 0);
+                return violations != 0;
+            }
+
+            bool IsCrossed(const std::vector<NormalizedOrderbookLevel>& bids,
+                           const std::vector<NormalizedOrderbookLevel>& asks)
+            {
+                return !bids.empty() && !asks.empty() && bids.front().price >= asks.front().price;
+            }
+        }
+    } // editor
+} // gui
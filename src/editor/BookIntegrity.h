@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Decimal.h"
+#include "OrderbookLevel.h"
+#include "PriceLadderBook.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gui::editor
+{
+    namespace BookChecksum
+    {
+        size_t GetDepth(ChecksumScheme scheme);
+
+        uint32_t Crc32(const void* data, size_t size, uint32_t crc = 0);
+
+        // Checksum of the book as it stands. Only the top GetDepth() levels are
+        // formatted, so recomputing after every update costs O(depth), not O(book).
+        // `scale` is the book's; `venuePrecision` is how many decimals the venue prints
+        // (the instrument's precisions), which Kraken's digit strings depend on. OKX and
+        // Bitfinex print the shortest form, so only the values matter for them.
+        uint32_t Compute(ChecksumScheme scheme, const PriceLadderBook& book, DecimalScale scale,
+                         DecimalScale venuePrecision);
+    }
+
+    // Whole-side checks written as branch-free reductions so the compiler can
+    // vectorise them; they visit every level without early exits.
+    namespace BookIntegrity
+    {
+        // Bids strictly descending, asks strictly ascending
+        bool IsSorted(const std::vector<NormalizedOrderbookLevel>& levels, bool isBids);
+        bool HasNonPositiveQuantity(const std::vector<NormalizedOrderbookLevel>& levels);
+        bool IsCrossed(const std::vector<NormalizedOrderbookLevel>& bids,
+                       const std::vector<NormalizedOrderbookLevel>& asks); // Expects sorted sides
+    }
+}
@@ -0,0 +1,164 @@
+#include "ConsolidatedBook.h"
+
+#include <bit>
+
+namespace gui
+{
+    namespace editor
+    {
+        ConsolidatedBook::ConsolidatedBook()
+            : m_bidIndex(256)
+            , m_askIndex(256)
+        {
+        }
+
+        int ConsolidatedBook::RegisterVenue(std::string_view venue)
+        {
+            const int existing = FindVenue(venue);
+            if (existing >= 0)
+                return existing;
+            if (m_venueNames.size() >= MAX_VENUES)
+                return -1;
+            m_venueNames.emplace_back(venue);
+            return static_cast<int>(m_venueNames.size() - 1);
+        }
+
+        int ConsolidatedBook::FindVenue(std::string_view venue) const
+        {
+            for (size_t i = 0; i < m_venueNames.size(); i++)
+            {
+                if (m_venueNames[i] == venue)
+                    return static_cast<int>(i);
+            }
+            return -1;
+        }
+
+        void ConsolidatedBook::SetVenueLevel(int venue, bool isBid, Decimal price, Decimal quantity)
+        {
+            if (venue < 0 || venue >= GetVenueCount())
+                return;
+
+            FlatHashIndex& index = PriceIndex(isBid);
+            const auto key = static_cast<uint64_t>(price.units);
+            uint32_t slot = index.Find(key);
+
+            if (slot == FlatHashIndex::NOT_FOUND)
+            {
+                if (quantity.IsZero())
+                    return;
+
+                if (!m_freeLevels.empty())
+                {
+                    slot = m_freeLevels.back();
+                    m_freeLevels.pop_back();
+                }
+                else
+                {
+                    slot = static_cast<uint32_t>(m_levelPool.size());
+                    m_levelPool.emplace_back();
+                }
+                m_levelPool[slot] = Level{price, Decimal(), {}, 0, isBid};
+                index.Insert(key, slot);
+            }
+
+            Level& level = m_levelPool[slot];
+            const uint32_t bit = uint32_t(1) << venue;
+            Decimal& venueQuantity = level.venueQuantity[static_cast<size_t>(venue)];
+
+            level.total += quantity - venueQuantity;
+            venueQuantity = quantity;
+            level.venueMask = quantity.IsZero() ? (level.venueMask & ~bit) : (level.venueMask | bit);
+
+            if (level.venueMask == 0)
+            {
+                m_ladder.SetLevel(isBid, price, Decimal(), 0);
+                index.Erase(key);
+                m_freeLevels.push_back(slot);
+                return;
+            }
+            m_ladder.SetLevel(isBid, price, level.total, std::popcount(level.venueMask));
+        }
+
+        void ConsolidatedBook::ApplyVenueSnapshot(int venue, const std::vector<NormalizedOrderbookLevel>& bids,
+                                                  const std::vector<NormalizedOrderbookLevel>& asks)
+        {
+            ClearVenue(venue);
+            for (const NormalizedOrderbookLevel& level : bids)
+                SetVenueLevel(venue, true, level.price, level.quantity);
+            for (const NormalizedOrderbookLevel& level : asks)
+                SetVenueLevel(venue, false, level.price, level.quantity);
+        }
+
+        void ConsolidatedBook::ClearVenue(int venue)
+        {
+            if (venue < 0 || venue >= GetVenueCount())
+                return;
+            RemoveVenueFromSide(venue, true);
+            RemoveVenueFromSide(venue, false);
+        }
+
+        bool ConsolidatedBook::Rescale(DecimalScale from, DecimalScale to)
+        {
+            if (to.price < from.price || to.quantity < from.quantity)
+                return false; // Coarser scales would merge distinct levels
+
+            ConsolidatedBook rebuilt;
+            rebuilt.m_venueNames = m_venueNames;
+            for (uint32_t slot = 0; slot < m_levelPool.size(); slot++)
+            {
+                const Level& level = m_levelPool[slot];
+                if (PriceIndex(level.isBid).Find(static_cast<uint64_t>(level.price.units)) != slot)
+                    continue; // Free slot holding stale data
+
+                Decimal price;
+                if (!level.price.Rescale(from.price, to.price, price))
+                    return false;
+                for (int venue = 0; venue < GetVenueCount(); venue++)
+                {
+                    if (!(level.venueMask & (uint32_t(1) << venue)))
+                        continue;
+                    Decimal quantity;
+                    if (!level.venueQuantity[static_cast<size_t>(venue)].Rescale(from.quantity, to.quantity, quantity))
+                        return false;
+                    rebuilt.SetVenueLevel(venue, level.isBid, price, quantity);
+                }
+            }
+            *this = std::move(rebuilt);
+            return true;
+        }
+
+        void ConsolidatedBook::RemoveVenueFromSide(int venue, bool isBid)
+        {
+            // Snapshots and disconnects only: walks the venue's levels through the pool
+            const uint32_t bit = uint32_t(1) << venue;
+            const FlatHashIndex& index = PriceIndex(isBid);
+            for (uint32_t slot = 0; slot < m_levelPool.size(); slot++)
+            {
+                const Level& level = m_levelPool[slot];
+                if (level.isBid != isBid || !(level.venueMask & bit))
+                    continue;
+                if (index.Find(static_cast<uint64_t>(level.price.units)) != slot)
+                    continue; // Free slot holding stale data
+                SetVenueLevel(venue, isBid, level.price, Decimal());
+            }
+        }
+
+        ConsolidatedBBO ConsolidatedBook::GetBBO() const
+        {
+            ConsolidatedBBO bbo{};
+            bbo.hasBid = m_ladder.GetBestBid(bbo.bid);
+            bbo.hasAsk = m_ladder.GetBestAsk(bbo.ask);
+            if (bbo.hasBid)
+                bbo.bidVenueMask = FindLevel(true, bbo.bid.price)->venueMask;
+            if (bbo.hasAsk)
+                bbo.askVenueMask = FindLevel(false, bbo.ask.price)->venueMask;
+            return bbo;
+        }
+
+        const ConsolidatedBook::Level* ConsolidatedBook::FindLevel(bool isBid, Decimal price) const
+        {
+            const uint32_t slot = PriceIndex(isBid).Find(static_cast<uint64_t>(price.units));
+            return slot == FlatHashIndex::NOT_FOUND ? nullptr : &m_levelPool[slot];
+        }
+    } // editor
+} // gui
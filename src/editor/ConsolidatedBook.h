@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Decimal.h"
+#include "FlatHashIndex.h"
+#include "OrderbookLevel.h"
+#include "PriceLadderBook.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gui::editor
+{
+    // Best bid/offer across venues with the venues quoting at each side of the touch
+    struct ConsolidatedBBO
+    {
+        NormalizedOrderbookLevel bid; // orderCount = number of venues at the level
+        NormalizedOrderbookLevel ask;
+        uint32_t bidVenueMask;
+        uint32_t askVenueMask;
+        bool hasBid;
+        bool hasAsk;
+    };
+
+    // Aggregated ladder over several venues' L2 books for one pair. Every venue
+    // level update adjusts one aggregated level (total plus per-venue breakdown)
+    // and pushes the new total into a PriceLadderBook, so nothing is rebuilt and
+    // the cross-venue BBO is the ladder's O(1) touch.
+    class ConsolidatedBook
+    {
+    public:
+        static constexpr int MAX_VENUES = 16;
+
+        struct Level
+        {
+            Decimal price;
+            Decimal total;
+            std::array<Decimal, MAX_VENUES> venueQuantity;
+            uint32_t venueMask; // Bit per venue with quantity at this price
+            bool isBid;
+        };
+
+        ConsolidatedBook();
+
+        // Returns the venue's index, registering it on first use; -1 when full
+        int RegisterVenue(std::string_view venue);
+        int FindVenue(std::string_view venue) const;
+        const std::string& GetVenueName(int venue) const { return m_venueNames[static_cast<size_t>(venue)]; }
+        int GetVenueCount() const { return static_cast<int>(m_venueNames.size()); }
+
+        void SetVenueLevel(int venue, bool isBid, Decimal price, Decimal quantity); // Zero quantity removes
+        void ApplyVenueSnapshot(int venue, const std::vector<NormalizedOrderbookLevel>& bids,
+                                const std::vector<NormalizedOrderbookLevel>& asks);
+        void ClearVenue(int venue); // e.g. on disconnect
+
+        // Moves every level to finer scales, which is exact. Returns false and leaves
+        // the book unchanged when a value would overflow.
+        bool Rescale(DecimalScale from, DecimalScale to);
+
+        ConsolidatedBBO GetBBO() const;
+        const Level* FindLevel(bool isBid, Decimal price) const;
+        const PriceLadderBook& GetLadder() const { return m_ladder; }
+
+    private:
+        FlatHashIndex& PriceIndex(bool isBid) { return isBid ? m_bidIndex : m_askIndex; }
+        const FlatHashIndex& PriceIndex(bool isBid) const { return isBid ? m_bidIndex : m_askIndex; }
+        void RemoveVenueFromSide(int venue, bool isBid);
+
+        std::vector<std::string> m_venueNames;
+        std::vector<Level> m_levelPool;
+        std::vector<uint32_t> m_freeLevels;
+        FlatHashIndex m_bidIndex; // price units -> level pool index
+        FlatHashIndex m_askIndex;
+        PriceLadderBook m_ladder; // Totals across venues
+    };
+}
@@ -3,10 +3,1080 @@
 //
 
 #include "DataUpdaters.h"
+#include "InstrumentRegistry.h"
+#include "WalletValuation.h"
+
+#include <algorithm>
 
 namespace gui
 {
     namespace editor
     {
+        void DataUpdaterBase::Update(float deltaTime)
+        {
+            (void)deltaTime;
+            DrainInputs();
+            ProcessQueuedUpdates();
+        }
+
+        void DataUpdaterBase::DrainInputs()
+        {
+            for (const Pin& pin : GetInputPins())
+            {
+                std::shared_ptr<NodeData> data = GetInputData(pin.id);
+                if (!data)
+                    continue;
+
+                auto consumed = std::find_if(m_consumedInputs.begin(), m_consumedInputs.end(),
+                                             [&](const ConsumedInput& entry) { return entry.pin == pin.id; });
+                if (consumed == m_consumedInputs.end())
+                    consumed = m_consumedInputs.insert(m_consumedInputs.end(), ConsumedInput{pin.id, nullptr});
+                else if (consumed->data == data)
+                    continue; // Nothing published since the last pass
+
+                consumed->data = std::move(data);
+                ConsumeInput(pin.id, *consumed->data);
+            }
+        }
+
+        void DataUpdaterBase::OnInputDisconnected(ax::NodeEditor::PinId pinId)
+        {
+            m_consumedInputs.erase(std::remove_if(m_consumedInputs.begin(), m_consumedInputs.end(),
+                                                  [pinId](const ConsumedInput& entry) { return entry.pin == pinId; }),
+                                   m_consumedInputs.end());
+        }
+
+        bool TradesUpdater::CanAcceptInput(ax::NodeEditor::PinId inputPin, const NodeData* outputData) const
+        {
+            (void)inputPin;
+            return IsTradeBatchData(outputData);
+        }
+
+        void TradesUpdater::ProcessTradeBatch(const NodeData& batch)
+        {
+            if (const auto* rows = batch.As<TradeRowBatchData>())
+            {
+                for (const TradeRecord& trade : rows->trades)
+                    EnqueueTrade(trade);
+            }
+            else if (const auto* columns = batch.As<TradeColumnBatchData>())
+            {
+                // Rebuilt as rows so both layouts get the same dedup, sequence and conflict checks
+                TradeRecord trade;
+                for (size_t i = 0; i < columns->columns.Size(); i++)
+                {
+                    columns->columns.GetRow(i, trade);
+                    EnqueueTrade(trade);
+                }
+            }
+        }
+
+        void TradesUpdater::ProcessTradeUpdate(const TradeRecord& trade)
+        {
+            if (m_tradesConfig.enableDuplicateDetection)
+            {
+                if (!m_processedTradeIds.insert(TradeDedupKey(trade)).second)
+                    return;
+                CleanupProcessedTradeIds();
+            }
+            if (!ValidateTradeSequence(trade))
+                return;
+
+            m_lastTradeTime[trade.symbolId] = trade.GetTimestamp();
+            m_processedCount++;
+            UpdateTradeMetrics(trade);
+        }
+
+        void TradesUpdater::CleanupProcessedTradeIds()
+        {
+            // Bounded by starting over; the sequence windows still reject replays of recent numeric ids
+            if (m_maxTradeIdCache > 0 && m_processedTradeIds.size() > static_cast<size_t>(m_maxTradeIdCache))
+                m_processedTradeIds.clear();
+        }
+
+        void TradesUpdater::UpdateTradeMetrics(const TradeRecord& trade)
+        {
+            const double quantity = trade.GetQuantity();
+            m_metrics.totalVolume += quantity;
+            m_metrics.averageTradeSize += (quantity - m_metrics.averageTradeSize) / static_cast<double>(m_processedCount);
+            m_metrics.tradesByPair[trade.symbolId]++;
+            m_metrics.tradesByExchange[trade.exchangeId]++;
+        }
+
+        bool TradesUpdater::ValidateTradeSequence(const TradeRecord& trade)
+        {
+            // Only numeric trade ids are sequence numbers
+            if (!m_tradesConfig.enableSequenceValidation ||
+                (trade.flags & (TradeFlags::InlineTradeId | TradeFlags::HashedTradeId)))
+                return true;
+
+            SequenceWindow& window = m_tradeSequences[TradeStreamKey(trade.exchangeId, trade.symbolId)];
+            const uint64_t highest = window.GetHighest();
+            const SequenceResult result = window.Record(trade.tradeId, SequenceWindow::Clock::now());
+            m_metrics.missingTrades += result.missing;
+
+            switch (result.status)
+            {
+                case SequenceStatus::First:
+                case SequenceStatus::InOrder:
+                case SequenceStatus::Ahead:
+                    return true;
+
+                case SequenceStatus::Reset:
+                    m_metrics.sequenceResets++;
+                    AddConflict("Trade ids for " + GetTradeStringTable().Lookup(trade.symbolId) + " jumped from " +
+                                std::to_string(highest) + " to " + std::to_string(trade.tradeId) +
+                                "; sequence tracking restarted");
+                    return true;
+
+                case SequenceStatus::Late:
+                    m_outOfOrderCount++;
+                    m_metrics.lateTrades++;
+                    m_metrics.maxLateDistance = std::max(m_metrics.maxLateDistance, result.lateDistance);
+                    return m_tradesConfig.allowOutOfOrderTrades &&
+                           result.lateDistance <= static_cast<uint64_t>(m_tradesConfig.maxSequenceGap);
+
+                case SequenceStatus::Duplicate:
+                case SequenceStatus::Expired:
+                    return false;
+            }
+            return false;
+        }
+
+        void TradesUpdater::ExpireTradeSequenceHoles()
+        {
+            const auto now = SequenceWindow::Clock::now();
+            const auto timeout = std::chrono::milliseconds(m_maxWaitTime);
+            for (auto& [stream, window] : m_tradeSequences)
+            {
+                uint64_t first = 0;
+                const uint64_t missing = window.ExpireHoles(now, timeout, first);
+                if (missing == 0)
+                    continue;
+
+                const TradeStringTable& strings = GetTradeStringTable();
+                m_metrics.missingTrades += missing;
+                AddConflict("Missing " + std::to_string(missing) + " trade(s) from id " + std::to_string(first) +
+                            " for " + strings.LookupName(static_cast<uint16_t>(stream >> 32)) + " " +
+                            strings.Lookup(static_cast<uint32_t>(stream)));
+            }
+        }
+
+        void TradesUpdater::ProcessQueuedUpdates()
+        {
+            QueuedTrade queued;
+            while (m_tradeQueue.Pop(queued))
+                ProcessTradeUpdate(queued.trade);
+            m_queuedCount = 0;
+
+            // Checked on every pass, so a hole is declared missing even after the pair goes quiet
+            if (m_tradesConfig.enableSequenceValidation)
+                ExpireTradeSequenceHoles();
+        }
+
+        void TradesUpdater::EnqueueTrade(const TradeRecord& trade)
+        {
+            QueuedTrade queued;
+            queued.trade = trade;
+            queued.queueTime = std::chrono::system_clock::now();
+            const auto priority = m_sourcePriorities.find(GetTradeStringTable().LookupName(trade.sourceId));
+            queued.priority = priority != m_sourcePriorities.end() ? priority->second : 0;
+
+            m_tradeQueue.Push(trade.sourceId, MakeQueueKey(queued), queued);
+            m_queuedCount = static_cast<int>(m_tradeQueue.Size());
+        }
+
+        uint64_t TradesUpdater::MakeQueueKey(const QueuedTrade& queued) const
+        {
+            // The merge queue sorts each source by key and breaks ties by arrival
+            switch (m_updateOrder)
+            {
+                case UpdateOrder::ByTimestamp:
+                    return static_cast<uint64_t>(queued.trade.timestampNs);
+                case UpdateOrder::BySequence:
+                    return queued.trade.tradeId;
+                case UpdateOrder::ByPriority:
+                    // Higher priority first
+                    return static_cast<uint64_t>(INT32_MAX) - static_cast<uint64_t>(std::max(queued.priority, 0));
+                case UpdateOrder::BySource:
+                    return queued.trade.sourceId;
+            }
+            return 0;
+        }
+
+        void OrderbookUpdater::MergeOrderbookUpdates(const NormalizedOrderbook& update)
+        {
+            PriceLadderBook& book = m_currentOrderbooks[update.currencyPair];
+            BookConflator& conflator = m_conflators.try_emplace(
+                update.currencyPair, static_cast<size_t>(m_orderbookConfig.conflationSnapshotThreshold)).first->second;
+
+            conflator.SetScale(update.scale);
+
+            // The venue's tick keys the ladder; inferring it from prices only finds a finer grid
+            const InstrumentRegistry& instruments = GetInstrumentRegistry();
+            uint64_t& tickGeneration = m_tickGenerations[update.currencyPair];
+            if (tickGeneration != instruments.GetGeneration())
+            {
+                tickGeneration = instruments.GetGeneration();
+                const InstrumentData* instrument = instruments.Find(update.exchange, update.currencyPair);
+                const int64_t tickUnits = instrument ? instrument->GetTickUnits(update.scale.price) : 0;
+                if (tickUnits > 0)
+                    book.SetTickUnits(tickUnits);
+            }
+
+            // Change subscribers get the applied levels only, so they never rescan the book
+            const bool recordChanges = !m_bookChangeSubscribers.empty();
+            m_appliedChanges.bids.clear();
+            m_appliedChanges.asks.clear();
+
+            const uint64_t rejectedBefore = book.GetRejectedCount();
+            m_appliedChanges.isSnapshot = update.isSnapshot || !m_orderbookConfig.enableIncrementalUpdates;
+            if (m_appliedChanges.isSnapshot)
+            {
+                book.ApplySnapshot(update.bids, update.asks);
+                conflator.OnReset();
+            }
+            else
+            {
+                for (const NormalizedOrderbookLevel& level : update.bids)
+                {
+                    if (!book.SetLevel(true, level.price, level.quantity, level.orderCount))
+                        continue;
+                    conflator.OnLevel(true, level.price, level.quantity, level.orderCount);
+                    if (recordChanges)
+                        m_appliedChanges.bids.push_back(level);
+                }
+                for (const NormalizedOrderbookLevel& level : update.asks)
+                {
+                    if (!book.SetLevel(false, level.price, level.quantity, level.orderCount))
+                        continue;
+                    conflator.OnLevel(false, level.price, level.quantity, level.orderCount);
+                    if (recordChanges)
+                        m_appliedChanges.asks.push_back(level);
+                }
+            }
+            // Kraken and similar venues send no delete for a level pushed below the subscribed
+            // depth; it would otherwise resurface, stale, when better levels are removed
+            if (m_orderbookConfig.subscribedDepth > 0)
+            {
+                const size_t subscribed = static_cast<size_t>(m_orderbookConfig.subscribedDepth);
+                for (const bool isBid : {true, false})
+                {
+                    book.TrimTo(isBid, subscribed, m_trimmedPrices);
+                    for (Decimal price : m_trimmedPrices)
+                    {
+                        conflator.OnLevel(isBid, price, Decimal(), 0);
+                        if (recordChanges && !m_appliedChanges.isSnapshot)
+                        {
+                            NormalizedOrderbookLevel removed;
+                            removed.price = price;
+                            (isBid ? m_appliedChanges.bids : m_appliedChanges.asks).push_back(removed);
+                        }
+                    }
+                }
+            }
+
+            if (book.GetRejectedCount() != rejectedBefore)
+            {
+                m_metrics.offGridLevelsRejected += static_cast<int>(book.GetRejectedCount() - rejectedBefore);
+                AddConflict("Off-grid price levels rejected for " + update.exchange + " " + update.currencyPair);
+            }
+
+            // Only the published depth is copied out; the ladder stays the source of truth
+            m_mergedOrderbook.currencyPair = update.currencyPair;
+            m_mergedOrderbook.exchange = update.exchange;
+            m_mergedOrderbook.timestamp = update.timestamp;
+            m_mergedOrderbook.receivedTime = update.receivedTime;
+            m_mergedOrderbook.scale = update.scale;
+            m_mergedOrderbook.isSnapshot = true;
+
+            const size_t depth = static_cast<size_t>(std::max(m_orderbookConfig.publishDepth, 1));
+            book.CopyTop(true, depth, m_mergedOrderbook.bids);
+            book.CopyTop(false, depth, m_mergedOrderbook.asks);
+
+            NormalizedOrderbookLevel bestBid;
+            NormalizedOrderbookLevel bestAsk;
+            m_mergedOrderbook.spread = 0.0;
+            m_mergedOrderbook.midPrice = 0.0;
+            if (book.GetBestBid(bestBid) && book.GetBestAsk(bestAsk))
+            {
+                const double bid = bestBid.price.ToDouble(update.scale.price);
+                const double ask = bestAsk.price.ToDouble(update.scale.price);
+                m_mergedOrderbook.spread = ask - bid;
+                m_mergedOrderbook.midPrice = (ask + bid) * 0.5;
+
+                // Wallet valuation subscribes to the pairs it converts through
+                WalletValuation& valuation = GetWalletValuation();
+                const uint32_t symbolId = GetTradeStringTable().Find(update.currencyPair);
+                if (symbolId != 0 && valuation.IsSubscribed(symbolId))
+                    valuation.OnMidPrice(symbolId, m_mergedOrderbook.midPrice);
+            }
+
+            if (recordChanges)
+            {
+                m_appliedChanges.currencyPair = update.currencyPair;
+                m_appliedChanges.exchange = update.exchange;
+                m_appliedChanges.timestamp = update.timestamp;
+                m_appliedChanges.receivedTime = update.receivedTime;
+                m_appliedChanges.scale = update.scale;
+                for (const auto& [subscription, callback] : m_bookChangeSubscribers)
+                    callback(m_appliedChanges, book);
+            }
+        }
+
+        bool OrderbookUpdater::ReadConflatedBook(const std::string& pair, NormalizedOrderbook& out)
+        {
+            const auto book = m_currentOrderbooks.find(pair);
+            const auto conflator = m_conflators.find(pair);
+            if (book == m_currentOrderbooks.end() || conflator == m_conflators.end())
+                return false;
+
+            out.currencyPair = pair;
+            const size_t depth = static_cast<size_t>(std::max(m_orderbookConfig.publishDepth, 1));
+            return conflator->second.Read(book->second, depth, out);
+        }
+
+        void OrderbookUpdater::SubscribeConflatedBook(const std::string& pair, ConflatedBookCallback callback)
+        {
+            m_conflatedSubscribers[pair] = std::move(callback);
+        }
+
+        uint64_t OrderbookUpdater::SubscribeBookChanges(BookChangeCallback callback)
+        {
+            const uint64_t subscription = m_nextBookChangeSubscription++;
+            m_bookChangeSubscribers.emplace_back(subscription, std::move(callback));
+            return subscription;
+        }
+
+        void OrderbookUpdater::UnsubscribeBookChanges(uint64_t subscription)
+        {
+            m_bookChangeSubscribers.erase(
+                std::remove_if(m_bookChangeSubscribers.begin(), m_bookChangeSubscribers.end(),
+                               [subscription](const auto& entry) { return entry.first == subscription; }),
+                m_bookChangeSubscribers.end());
+        }
+
+        void OrderbookUpdater::PublishConflatedBooks()
+        {
+            for (const auto& [pair, callback] : m_conflatedSubscribers)
+            {
+                if (callback && ReadConflatedBook(pair, m_conflatedRead))
+                    callback(m_conflatedRead);
+            }
+        }
+
+        void OrderbookUpdater::ProcessOrderEvent(const std::string& pair, const L3OrderEvent& event)
+        {
+            OrderByOrderBook& book = m_orderByOrderBooks[pair];
+            book.Apply(event);
+            if (!book.NeedsResync())
+                return;
+
+            // Publishing depth that is missing a level would be wrong, so the pair starts over
+            // and is rebuilt from the feed
+            m_metrics.offGridLevelsRejected++;
+            AddConflict("Order book " + pair + " rejected a level off the tick grid; rebuilding it from the feed");
+            book.Clear();
+        }
+
+        void OrderbookUpdater::MarkOwnOrder(const std::string& pair, uint64_t orderId)
+        {
+            m_orderByOrderBooks[pair].MarkOwn(orderId);
+        }
+
+        bool OrderbookUpdater::GetQueuePosition(const std::string& pair, uint64_t orderId,
+                                                L3QueuePosition& position) const
+        {
+            const auto it = m_orderByOrderBooks.find(pair);
+            return it != m_orderByOrderBooks.end() && it->second.GetQueuePosition(orderId, position);
+        }
+
+        void OrderbookUpdater::ProcessOrderbookUpdate(const NormalizedOrderbook& orderbook)
+        {
+            if (orderbook.isSnapshot)
+                m_metrics.snapshotsReceived++;
+            else
+                m_metrics.incrementalUpdatesReceived++;
+
+            // A malformed snapshot would replace a good book; drop it and wait for the next one
+            if (!ValidateOrderbookIntegrity(orderbook))
+            {
+                m_metrics.invalidSnapshotsDropped++;
+                return;
+            }
+
+            const auto [sourceIt, firstUpdate] = m_pairSources.try_emplace(orderbook.currencyPair);
+            PairSource& source = sourceIt->second;
+            const bool rescaled = !firstUpdate && (source.scale.price != orderbook.scale.price ||
+                                                   source.scale.quantity != orderbook.scale.quantity);
+            if (source.exchange != orderbook.exchange)
+                source.exchange = orderbook.exchange;
+            source.scale = orderbook.scale;
+
+            // The instrument's precisions arrived or changed: units at two scales cannot share
+            // a ladder, so the pair starts over from a snapshot at the new scale
+            if (rescaled)
+            {
+                m_currentOrderbooks.erase(orderbook.currencyPair);
+                m_tickGenerations.erase(orderbook.currencyPair);
+                if (!orderbook.isSnapshot)
+                {
+                    m_metrics.rescaledDeltasDropped++;
+                    const auto resync = m_resync.find(orderbook.currencyPair);
+                    if (resync != m_resync.end())
+                    {
+                        resync->second.Invalidate();
+                        resync->second.OnSnapshotRequested(OrderbookResync::Clock::now());
+                    }
+                    if (m_orderbookConfig.enableSnapshotRecovery)
+                        RequestSnapshot(orderbook.currencyPair);
+                    return;
+                }
+            }
+
+            if (!m_orderbookConfig.enableSnapshotRecovery)
+            {
+                MergeOrderbookUpdates(orderbook);
+                UpdateOrderbookMetrics(m_mergedOrderbook);
+                return;
+            }
+
+            // Recovery state is per pair, so a gap on one pair never holds back the others
+            OrderbookResync& resync = m_resync.try_emplace(
+                orderbook.currencyPair, static_cast<size_t>(m_orderbookConfig.maxBufferedDeltas),
+                static_cast<uint64_t>(std::max(m_orderbookConfig.snapshotRequestThreshold, 1))).first->second;
+
+            const ResyncAction action = resync.OnUpdate(orderbook);
+            switch (action)
+            {
+                case ResyncAction::Apply:
+                    MergeOrderbookUpdates(orderbook);
+                    if (VerifyBookChecksum(orderbook))
+                        UpdateOrderbookMetrics(m_mergedOrderbook);
+                    break;
+
+                case ResyncAction::Buffer:
+                    m_metrics.deltasBuffered++;
+                    break;
+
+                case ResyncAction::Drop:
+                    m_metrics.staleDeltasDropped++;
+                    break;
+
+                case ResyncAction::RequestSnapshot:
+                    if (!orderbook.isSnapshot)
+                        m_metrics.deltasBuffered++; // The delta that revealed the gap is kept for replay
+                    HandleSequenceGap(orderbook.currencyPair, resync.GetLastSequence() + 1,
+                                      orderbook.firstSequence != 0 ? orderbook.firstSequence : orderbook.sequence);
+                    resync.OnSnapshotRequested(OrderbookResync::Clock::now());
+                    break;
+
+                case ResyncAction::Resynced:
+                case ResyncAction::GapFilled:
+                {
+                    MergeOrderbookUpdates(orderbook);
+                    const NormalizedOrderbook* lastApplied = &orderbook;
+                    for (const NormalizedOrderbook& delta : resync.GetReplay())
+                    {
+                        MergeOrderbookUpdates(delta);
+                        lastApplied = &delta;
+                    }
+                    m_metrics.deltasReplayed += static_cast<int>(resync.GetReplay().size());
+                    const bool consistent = VerifyBookChecksum(*lastApplied);
+                    resync.ClearReplay();
+                    if (!consistent)
+                        break;
+                    UpdateOrderbookMetrics(m_mergedOrderbook);
+                    if (action == ResyncAction::GapFilled)
+                    {
+                        m_metrics.lateGapsFilled++;
+                        break;
+                    }
+
+                    const double recoveryMs =
+                        std::chrono::duration<double, std::milli>(resync.GetLastRecoveryTime()).count();
+                    m_metrics.resyncCount++;
+                    m_metrics.resyncsByPair[orderbook.currencyPair]++;
+                    m_metrics.recoveryMsByPair[orderbook.currencyPair] = recoveryMs;
+                    m_metrics.lastRecoveryMs = recoveryMs;
+                    m_metrics.averageRecoveryMs +=
+                        (recoveryMs - m_metrics.averageRecoveryMs) / static_cast<double>(m_metrics.resyncCount);
+                    break;
+                }
+            }
+        }
+
+        bool OrderbookUpdater::VerifyBookChecksum(const NormalizedOrderbook& lastApplied)
+        {
+            if (!m_orderbookConfig.verifyChecksums || !lastApplied.hasChecksum)
+                return true;
+
+            const ChecksumScheme scheme = lastApplied.checksumScheme;
+            const auto book = m_currentOrderbooks.find(lastApplied.currencyPair);
+            if (scheme == ChecksumScheme::None || book == m_currentOrderbooks.end())
+                return true;
+
+            // Kraken's string depends on the decimals the venue prints; without the
+            // instrument's precisions the CRC cannot be reproduced, so it is not checked
+            DecimalScale venuePrecision = lastApplied.scale;
+            const InstrumentData* instrument =
+                GetInstrumentRegistry().Find(lastApplied.exchange, lastApplied.currencyPair);
+            if (instrument != nullptr)
+                venuePrecision = DecimalScale(instrument->pricePrecision, instrument->quantityPrecision);
+            else if (scheme == ChecksumScheme::Kraken)
+                return true;
+
+            m_metrics.checksumsVerified++;
+            if (BookChecksum::Compute(scheme, book->second, lastApplied.scale, venuePrecision) == lastApplied.checksum)
+                return true;
+
+            // Desynced: recover now rather than waiting for the spread to look wrong
+            m_metrics.checksumMismatches++;
+            AddConflict("Checksum mismatch on " + lastApplied.exchange + " " + lastApplied.currencyPair);
+            const auto resync = m_resync.find(lastApplied.currencyPair);
+            if (resync != m_resync.end())
+            {
+                resync->second.Invalidate();
+                resync->second.OnSnapshotRequested(OrderbookResync::Clock::now());
+            }
+            RequestSnapshot(lastApplied.currencyPair);
+            return false;
+        }
+
+        bool OrderbookUpdater::ValidateOrderbookIntegrity(const NormalizedOrderbook& orderbook)
+        {
+            if (!m_orderbookConfig.validateOrderbookIntegrity)
+                return true;
+
+            // Deltas carry arbitrary levels in arbitrary order; only snapshots describe a whole book
+            if (!orderbook.isSnapshot)
+                return true;
+
+            const bool valid = ValidateLevelSorting(orderbook.bids, true) &&
+                               ValidateLevelSorting(orderbook.asks, false) &&
+                               !BookIntegrity::IsCrossed(orderbook.bids, orderbook.asks) &&
+                               !BookIntegrity::HasNonPositiveQuantity(orderbook.bids) &&
+                               !BookIntegrity::HasNonPositiveQuantity(orderbook.asks);
+            if (!valid)
+                AddConflict("Integrity check failed for " + orderbook.exchange + " " + orderbook.currencyPair);
+            return valid;
+        }
+
+        bool OrderbookUpdater::ValidateLevelSorting(const std::vector<NormalizedOrderbookLevel>& levels, bool isBids)
+        {
+            return BookIntegrity::IsSorted(levels, isBids);
+        }
+
+        void OrderbookUpdater::HandleSequenceGap(const std::string& pair, uint64_t expected, uint64_t received)
+        {
+            SequenceGap gap;
+            gap.currencyPair = pair;
+            gap.expectedSequence = expected;
+            gap.receivedSequence = received;
+            gap.detectedTime = std::chrono::system_clock::now();
+            gap.recoveryRequested = m_orderbookConfig.enableSnapshotRecovery;
+
+            if (m_detectedGaps.size() >= MAX_CONFLICT_HISTORY)
+                m_detectedGaps.erase(m_detectedGaps.begin());
+            m_detectedGaps.push_back(gap);
+
+            if (gap.recoveryRequested)
+                RequestSnapshot(pair);
+        }
+
+        bool OrderbookUpdater::CanAcceptInput(ax::NodeEditor::PinId inputPin, const NodeData* outputData) const
+        {
+            (void)inputPin;
+            return outputData && outputData->As<OrderbookBatchData>();
+        }
+
+        void OrderbookUpdater::ConsumeInput(ax::NodeEditor::PinId pin, const NodeData& data)
+        {
+            (void)pin;
+            // Not through m_orderbookQueue: deltas must keep their order within a pair
+            if (const auto* batch = data.As<OrderbookBatchData>())
+            {
+                for (const NormalizedOrderbook& orderbook : batch->books)
+                    ProcessOrderbookUpdate(orderbook);
+            }
+        }
+
+        OrderbookUpdater::~OrderbookUpdater()
+        {
+            // Consumers still holding the handle must not reach this updater any more
+            if (m_bookChangeSource)
+                m_bookChangeSource->updater = nullptr;
+        }
+
+        void OrderbookUpdater::ProcessQueuedUpdates()
+        {
+            while (!m_orderbookQueue.empty())
+            {
+                ProcessOrderbookUpdate(m_orderbookQueue.top().orderbook);
+                m_orderbookQueue.pop();
+            }
+
+            // Checked on every pass, so a lost request is retried even after the pair goes quiet
+            if (m_orderbookConfig.enableSnapshotRecovery)
+                CheckSnapshotTimeouts();
+
+            // One net change per subscriber per pass, however many updates were drained
+            PublishConflatedBooks();
+
+            // The same handle every pass, so a consumer attaches once per connection
+            if (Pin* pin = FindOutputPin("Book Changes"))
+            {
+                if (!m_bookChangeSource)
+                {
+                    m_bookChangeSource = std::make_shared<BookChangeSourceData>();
+                    m_bookChangeSource->updater = this;
+                }
+                SetOutputData(pin->id, m_bookChangeSource);
+            }
+
+            // Positions in currencies whose mid moved are repriced once per pass, not per update.
+            // Routes follow the instrument definitions: rebuilt only when they changed.
+            WalletValuation& valuation = GetWalletValuation();
+            valuation.SyncRoutes(GetInstrumentRegistry());
+            if (valuation.GetPendingCount() > 0)
+                valuation.Revalue();
+        }
+
+        void OrderbookUpdater::RequestSnapshot(const std::string& pair)
+        {
+            if (m_snapshotEndpoint[0] == '\0')
+            {
+                AddConflict("No snapshot endpoint configured; cannot resync " + pair);
+                return;
+            }
+
+            std::string endpoint(m_snapshotEndpoint);
+            const size_t placeholder = endpoint.find("{symbol}");
+            if (placeholder != std::string::npos)
+                endpoint.replace(placeholder, 8, pair);
+
+            if (!m_snapshotRequests)
+            {
+                m_snapshotRequests = std::make_shared<RestRequestData>();
+                m_snapshotRequests->onResponse = [this](const RestResponse& response) { ProcessSnapshotResponse(response); };
+            }
+            RestRequest& request = m_snapshotRequests->requests.emplace_back();
+            request.method = "GET";
+            request.endpoint = std::move(endpoint);
+            request.correlationId = pair;
+            m_metrics.snapshotsRequested++;
+
+            if (Pin* pin = FindOutputPin("Snapshot Requests"))
+                SetOutputData(pin->id, m_snapshotRequests);
+        }
+
+        void OrderbookUpdater::ProcessSnapshotResponse(const RestResponse& response)
+        {
+            // Failures are left to CheckSnapshotTimeouts, which asks again
+            const std::string& pair = response.correlationId;
+            if (response.status < 200 || response.status >= 300)
+            {
+                AddConflict("Snapshot request for " + pair + " failed with HTTP " + std::to_string(response.status));
+                return;
+            }
+
+            const auto source = m_pairSources.find(pair);
+            const ExchangeOrderbookPreset* preset =
+                source != m_pairSources.end() ? FindOrderbookPreset(source->second.exchange) : nullptr;
+            if (!preset)
+            {
+                AddConflict("No orderbook decoder for the venue of " + pair + "; snapshot dropped");
+                return;
+            }
+
+            NormalizedOrderbook& snapshot = m_snapshotResponse;
+            snapshot.scale = source->second.scale;
+            const size_t maxLevels = static_cast<size_t>(std::max(m_orderbookConfig.subscribedDepth, 0));
+            if (!preset->decode(response.body, maxLevels, snapshot))
+            {
+                AddConflict("Could not decode the snapshot for " + pair);
+                return;
+            }
+
+            // The request names the pair; REST depth bodies (Binance) carry no symbol
+            snapshot.currencyPair = pair;
+            snapshot.exchange = source->second.exchange;
+            snapshot.isSnapshot = true;
+            snapshot.hasChecksum = false;
+            snapshot.timestamp = std::chrono::system_clock::now();
+            snapshot.receivedTime = snapshot.timestamp;
+            ProcessOrderbookUpdate(snapshot);
+        }
+
+        void OrderbookUpdater::CheckSnapshotTimeouts()
+        {
+            const auto now = OrderbookResync::Clock::now();
+            const auto timeout = std::chrono::milliseconds(m_orderbookConfig.snapshotTimeoutMs);
+            const auto lateWait = std::chrono::milliseconds(m_maxWaitTime);
+            for (auto& [pair, resync] : m_resync)
+            {
+                if (resync.IsSnapshotOverdue(now, timeout) || resync.IsGapWaitOver(now, lateWait))
+                {
+                    RequestSnapshot(pair);
+                    resync.OnSnapshotRequested(now);
+                }
+            }
+        }
+
+        ConsolidatedBookNode::ConsolidatedBookNode(ax::NodeEditor::NodeId nodeId)
+            : DataUpdaterBase(nodeId, "ConsolidatedBook", "Consolidated Book", "Orderbook")
+            , m_configExpanded(true)
+            , m_venuesExpanded(false)
+        {
+            for (int i = 1; i <= VENUE_INPUTS; i++)
+                AddInputPin("Venue " + std::to_string(i), DataType::MessageStream, Colors::MessageStream);
+        }
+
+        bool ConsolidatedBookNode::CanAcceptInput(ax::NodeEditor::PinId inputPin, const NodeData* outputData) const
+        {
+            (void)inputPin;
+            return outputData && outputData->As<OrderbookBatchData>();
+        }
+
+        void ConsolidatedBookNode::ConsumeInput(ax::NodeEditor::PinId pin, const NodeData& data)
+        {
+            const auto* batch = data.As<OrderbookBatchData>();
+            if (!batch)
+                return;
+            for (const NormalizedOrderbook& orderbook : batch->books)
+            {
+                m_venuePins[orderbook.exchange] = pin;
+                ProcessVenueUpdate(orderbook);
+                m_processedCount++;
+            }
+        }
+
+        void ConsolidatedBookNode::OnInputDisconnected(ax::NodeEditor::PinId pinId)
+        {
+            DataUpdaterBase::OnInputDisconnected(pinId);
+            for (auto it = m_venuePins.begin(); it != m_venuePins.end();)
+            {
+                if (it->second != pinId)
+                {
+                    ++it;
+                    continue;
+                }
+                OnVenueDisconnected(it->first);
+                it = m_venuePins.erase(it);
+            }
+        }
+
+        void ConsolidatedBookNode::ProcessQueuedUpdates()
+        {
+            // Venue books are applied as their batches are consumed; nothing waits between passes
+            m_queuedCount = 0;
+        }
+
+        void ConsolidatedBookNode::HandleDataConflict(const std::string& conflictInfo)
+        {
+            AddConflict(conflictInfo);
+        }
+
+        bool ConsolidatedBookNode::ShouldQueueUpdate(const std::string& updateId)
+        {
+            (void)updateId;
+            return false;
+        }
+
+        bool ConsolidatedBookNode::GetBestBidOffer(const std::string& pair, ConsolidatedBBO& bbo) const
+        {
+            const ConsolidatedBook* book = GetBook(pair);
+            if (!book)
+                return false;
+            bbo = book->GetBBO();
+            return bbo.hasBid || bbo.hasAsk;
+        }
+
+        const ConsolidatedBook* ConsolidatedBookNode::GetBook(const std::string& pair) const
+        {
+            const auto it = m_books.find(pair);
+            return it == m_books.end() ? nullptr : &it->second.book;
+        }
+
+        void ConsolidatedBookNode::ProcessVenueUpdate(const NormalizedOrderbook& update)
+        {
+            if (update.exchange.empty())
+            {
+                AddConflict("Book for " + update.currencyPair + " has no venue; ignoring it");
+                return;
+            }
+
+            PairBook& pairBook = m_books[update.currencyPair];
+            const int venue = pairBook.book.RegisterVenue(update.exchange);
+            if (venue < 0)
+            {
+                AddConflict("Too many venues for " + update.currencyPair + ", ignoring " + update.exchange);
+                return;
+            }
+
+            if (!pairBook.hasScale)
+            {
+                pairBook.scale = update.scale;
+                pairBook.hasScale = true;
+            }
+
+            // The pair uses the finest scale seen so far: rounding a finer venue down would
+            // merge distinct levels, so the book is moved up instead, which is exact
+            const DecimalScale common(std::max(pairBook.scale.price, update.scale.price),
+                                      std::max(pairBook.scale.quantity, update.scale.quantity));
+            if (common.price != pairBook.scale.price || common.quantity != pairBook.scale.quantity)
+            {
+                if (!pairBook.book.Rescale(pairBook.scale, common))
+                {
+                    AddConflict(update.exchange + " " + update.currencyPair + " does not fit the consolidated scale");
+                    return;
+                }
+                pairBook.scale = common;
+            }
+
+            const std::vector<NormalizedOrderbookLevel>* bids = &update.bids;
+            const std::vector<NormalizedOrderbookLevel>* asks = &update.asks;
+            if (update.scale.price != pairBook.scale.price || update.scale.quantity != pairBook.scale.quantity)
+            {
+                auto rescale = [&](const std::vector<NormalizedOrderbookLevel>& from,
+                                   std::vector<NormalizedOrderbookLevel>& to) {
+                    to.assign(from.begin(), from.end());
+                    bool ok = true;
+                    for (NormalizedOrderbookLevel& level : to)
+                    {
+                        ok = ok && level.price.Rescale(update.scale.price, pairBook.scale.price, level.price) &&
+                             level.quantity.Rescale(update.scale.quantity, pairBook.scale.quantity, level.quantity);
+                    }
+                    return ok;
+                };
+                if (!rescale(update.bids, m_rescaledBids) || !rescale(update.asks, m_rescaledAsks))
+                {
+                    AddConflict(update.exchange + " " + update.currencyPair + " does not fit the consolidated scale");
+                    return;
+                }
+                bids = &m_rescaledBids;
+                asks = &m_rescaledAsks;
+            }
+
+            if (update.isSnapshot)
+            {
+                pairBook.book.ApplyVenueSnapshot(venue, *bids, *asks);
+                return;
+            }
+            for (const NormalizedOrderbookLevel& level : *bids)
+                pairBook.book.SetVenueLevel(venue, true, level.price, level.quantity);
+            for (const NormalizedOrderbookLevel& level : *asks)
+                pairBook.book.SetVenueLevel(venue, false, level.price, level.quantity);
+        }
+
+        void ConsolidatedBookNode::OnVenueDisconnected(const std::string& venue)
+        {
+            if (!m_consolidatedConfig.excludeStaleVenues)
+                return;
+            for (auto& [pair, pairBook] : m_books)
+                pairBook.book.ClearVenue(pairBook.book.FindVenue(venue));
+        }
+
+        BarAggregatorNode::BarAggregatorNode(ax::NodeEditor::NodeId nodeId)
+            : DataUpdaterBase(nodeId, "BarAggregator", "Bar Aggregator", "Trade")
+            , m_configExpanded(true)
+            , m_barsExpanded(false)
+        {
+            AddInputPin("Trades", DataType::MessageStream, Colors::MessageStream);
+        }
+
+        void BarAggregatorNode::ProcessQueuedUpdates()
+        {
+            // Trades are added as their batches are consumed; each pass only seals bars whose
+            // lateness window ran out, so quiet pairs still close on time
+            CloseElapsedBars();
+        }
+
+        void BarAggregatorNode::HandleDataConflict(const std::string& conflictInfo)
+        {
+            AddConflict(conflictInfo);
+        }
+
+        bool BarAggregatorNode::ShouldQueueUpdate(const std::string& updateId)
+        {
+            (void)updateId;
+            return false;
+        }
+
+        bool BarAggregatorNode::CanAcceptInput(ax::NodeEditor::PinId inputPin, const NodeData* outputData) const
+        {
+            (void)inputPin;
+            return IsTradeBatchData(outputData);
+        }
+
+        void BarAggregatorNode::ProcessTradeBatch(const NodeData& batch)
+        {
+            const uint64_t lateBefore = m_bars.GetLateTradeCount();
+            if (const auto* rows = batch.As<TradeRowBatchData>())
+                m_bars.AddTrades(rows->trades);
+            else if (const auto* columns = batch.As<TradeColumnBatchData>())
+                m_bars.AddTrades(columns->columns);
+            m_outOfOrderCount += static_cast<int>(m_bars.GetLateTradeCount() - lateBefore);
+        }
+
+        void BarAggregatorNode::CloseElapsedBars()
+        {
+            // The aggregator holds each second open for the configured lateness itself
+            const auto now = std::chrono::system_clock::now().time_since_epoch();
+            m_bars.CloseElapsed(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+        }
+
+        void BarAggregatorNode::ApplyBarConfig()
+        {
+            m_bars.Configure(static_cast<size_t>(std::max(m_barConfig.historyBars, 1)),
+                             static_cast<int64_t>(std::max(m_barConfig.latenessMs, 0)) * 1000000);
+        }
+
+        bool BarAggregatorNode::GetCurrentBar(const std::string& exchange, const std::string& pair,
+                                              BarTimeframe timeframe, OhlcvBar& bar) const
+        {
+            const TradeStringTable& strings = GetTradeStringTable();
+            const uint16_t exchangeId = strings.FindName(exchange);
+            const uint32_t symbolId = strings.Find(pair);
+            return (exchangeId != 0 || exchange.empty()) && symbolId != 0 &&
+                   m_bars.GetCurrentBar(exchangeId, symbolId, timeframe, bar);
+        }
+
+        size_t BarAggregatorNode::GetBars(const std::string& exchange, const std::string& pair,
+                                          BarTimeframe timeframe, size_t maxBars, std::vector<OhlcvBar>& bars) const
+        {
+            bars.clear();
+            const TradeStringTable& strings = GetTradeStringTable();
+            const uint16_t exchangeId = strings.FindName(exchange);
+            const uint32_t symbolId = strings.Find(pair);
+            if ((exchangeId == 0 && !exchange.empty()) || symbolId == 0)
+                return 0;
+            return m_bars.CopyHistory(exchangeId, symbolId, timeframe, maxBars, bars);
+        }
+
+        BookAnalyticsNode::BookAnalyticsNode(ax::NodeEditor::NodeId nodeId)
+            : DataUpdaterBase(nodeId, "BookAnalytics", "Book Analytics", "Orderbook")
+            , m_configExpanded(true)
+            , m_metricsExpanded(false)
+        {
+            AddInputPin("Book Changes", DataType::MessageStream, Colors::MessageStream);
+        }
+
+        BookAnalyticsNode::~BookAnalyticsNode()
+        {
+            Detach();
+        }
+
+        bool BookAnalyticsNode::CanAcceptInput(ax::NodeEditor::PinId inputPin, const NodeData* outputData) const
+        {
+            (void)inputPin;
+            return outputData && outputData->As<BookChangeSourceData>();
+        }
+
+        void BookAnalyticsNode::ConsumeInput(ax::NodeEditor::PinId pin, const NodeData& data)
+        {
+            const auto* source = data.As<BookChangeSourceData>();
+            if (!source || source == m_source.get())
+                return;
+
+            Detach();
+            if (!source->updater)
+                return;
+            m_source = std::static_pointer_cast<BookChangeSourceData>(GetInputData(pin));
+            AttachTo(*source->updater);
+        }
+
+        void BookAnalyticsNode::OnInputDisconnected(ax::NodeEditor::PinId pinId)
+        {
+            DataUpdaterBase::OnInputDisconnected(pinId);
+            Detach();
+        }
+
+        void BookAnalyticsNode::AttachTo(OrderbookUpdater& updater)
+        {
+            m_subscription = updater.SubscribeBookChanges([this](const NormalizedOrderbook& changes, const PriceLadderBook& book) {
+                ProcessBookChanges(changes, book);
+            });
+        }
+
+        void BookAnalyticsNode::Detach()
+        {
+            if (m_subscription != 0 && m_source && m_source->updater)
+                m_source->updater->UnsubscribeBookChanges(m_subscription);
+            m_source.reset();
+            m_subscription = 0;
+            m_pairs.clear(); // Another updater's ladders start from their own state
+        }
+
+        void BookAnalyticsNode::ProcessQueuedUpdates()
+        {
+            // Samples are computed inside the updater's pass; what is left is the unread backlog
+            m_queuedCount = static_cast<int>(m_samples.size());
+        }
+
+        void BookAnalyticsNode::HandleDataConflict(const std::string& conflictInfo)
+        {
+            AddConflict(conflictInfo);
+        }
+
+        bool BookAnalyticsNode::ShouldQueueUpdate(const std::string& updateId)
+        {
+            (void)updateId;
+            return false;
+        }
+
+        void BookAnalyticsNode::ProcessBookChanges(const NormalizedOrderbook& changes, const PriceLadderBook& book)
+        {
+            const auto [entry, attached] = m_pairs.try_emplace(
+                changes.currencyPair, static_cast<size_t>(std::max(m_analyticsConfig.windowTicks, 64)));
+            PairAnalytics& pair = entry->second;
+            if (pair.symbolId == 0)
+                pair.symbolId = GetTradeStringTable().Intern(changes.currencyPair);
+
+            // A pair first seen mid-stream starts from the ladder as it is
+            if (changes.isSnapshot || attached)
+            {
+                pair.analytics.Rebuild(book);
+            }
+            else
+            {
+                // One prefix-sum update per applied level, whatever the depth of the book. The
+                // book already holds the whole update, and the last change of a price is its
+                // final quantity, so applying them in order ends in the book's state.
+                for (const NormalizedOrderbookLevel& level : changes.bids)
+                    pair.analytics.ApplyLevel(book, true, level.price, level.quantity);
+                for (const NormalizedOrderbookLevel& level : changes.asks)
+                    pair.analytics.ApplyLevel(book, false, level.price, level.quantity);
+            }
+
+            BookAnalyticsSample sample;
+            if (!pair.analytics.Compute(book, changes.scale, m_analyticsConfig.bandBps, sample))
+                return;
+            sample.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                changes.timestamp.time_since_epoch()).count();
+            sample.symbolId = pair.symbolId;
+            pair.latest = sample;
+            pair.hasSample = true;
+
+            if (m_samples.size() >= static_cast<size_t>(std::max(m_analyticsConfig.maxPendingSamples, 2)))
+                m_samples.erase(m_samples.begin(), m_samples.begin() + static_cast<std::ptrdiff_t>(m_samples.size() / 2));
+            m_samples.push_back(sample);
+        }
+
+        size_t BookAnalyticsNode::ReadSamples(std::vector<BookAnalyticsSample>& out)
+        {
+            out.clear();
+            out.swap(m_samples);
+            return out.size();
+        }
+
+        bool BookAnalyticsNode::GetLatestSample(const std::string& pair, BookAnalyticsSample& sample) const
+        {
+            const auto it = m_pairs.find(pair);
+            if (it == m_pairs.end() || !it->second.hasSample)
+                return false;
+            sample = it->second.latest;
+            return true;
+        }
     } // editor
-} // gui
\ No newline at end of file
+} // gui
@@ -2,6 +2,17 @@
 
 #include "Node.h"
 #include "MessageProcessors.h"
+#include "BarAggregator.h"
+#include "BookAnalytics.h"
+#include "BookConflator.h"
+#include "BookIntegrity.h"
+#include "ConsolidatedBook.h"
+#include "OrderByOrderBook.h"
+#include "OrderbookResync.h"
+#include "PriceLadderBook.h"
+#include "RestRequest.h"
+#include "SequenceWindow.h"
+#include "SourceMergeQueue.h"
 #include <queue>
 #include <unordered_map>
 #include <functional>
@@ -63,6 +74,11 @@ namespace gui::editor
         virtual void HandleDataConflict(const std::string& conflictInfo) = 0;
         virtual bool ShouldQueueUpdate(const std::string& updateId) = 0;
         
+        // Hands each input pin's newly published batch to ConsumeInput once; Update() runs it
+        // before ProcessQueuedUpdates()
+        void DrainInputs();
+        virtual void ConsumeInput(ax::NodeEditor::PinId pin, const NodeData& data) { (void)pin; (void)data; }
+        
         void UpdateStatistics(float latency);
         void AddConflict(const std::string& conflictInfo);
         
@@ -101,6 +117,14 @@ namespace gui::editor
 
     private:
         void CleanupConflicts();
+        
+        // Last batch consumed per input pin. Holding it keeps a new batch from reusing its address.
+        struct ConsumedInput
+        {
+            ax::NodeEditor::PinId pin;
+            std::shared_ptr<NodeData> data;
+        };
+        std::vector<ConsumedInput> m_consumedInputs;
     };
 
     // Trades Updater Node
@@ -110,37 +134,43 @@ namespace gui::editor
         TradesUpdater(ax::NodeEditor::NodeId nodeId);
         virtual ~TradesUpdater() = default;
 
+        // Accepts both TradeRowBatchData and TradeColumnBatchData on the input pin
+        bool CanAcceptInput(ax::NodeEditor::PinId inputPin, const NodeData* outputData) const override;
+
     protected:
         void ProcessQueuedUpdates() override;
         void HandleDataConflict(const std::string& conflictInfo) override;
         bool ShouldQueueUpdate(const std::string& updateId) override;
+        void ConsumeInput(ax::NodeEditor::PinId pin, const NodeData& data) override { (void)pin; ProcessTradeBatch(data); }
 
     private:
         void RenderTradesConfiguration();
-        void ProcessTradeUpdate(const NormalizedTrade& trade);
-        bool ValidateTradeSequence(const NormalizedTrade& trade);
-        void DetectTradeConflicts(const NormalizedTrade& trade);
+        void ProcessTradeUpdate(const TradeRecord& trade);
+        void ProcessTradeBatch(const NodeData& batch); // Dispatches on row/column form; queues every trade
+        bool ValidateTradeSequence(const TradeRecord& trade);
+        void DetectTradeConflicts(const TradeRecord& trade);
         
         // Trade-specific update queue
         struct QueuedTrade
         {
-            NormalizedTrade trade;
+            TradeRecord trade; // Source connection is trade.sourceId
             std::chrono::system_clock::time_point queueTime;
             int priority;
-            std::string sourceConnection;
-            
-            // Comparison operators for priority queue
-            bool operator<(const QueuedTrade& other) const;
         };
         
-        std::priority_queue<QueuedTrade> m_tradeQueue;
+        // Per-source queues (trade.sourceId) merged on a key derived from m_updateOrder
+        SourceMergeQueue<QueuedTrade> m_tradeQueue;
+        void EnqueueTrade(const TradeRecord& trade);
+        uint64_t MakeQueueKey(const QueuedTrade& queued) const; // Any order; ties pop in arrival order
         
         // Trade sequence tracking
-        std::unordered_map<std::string, uint64_t> m_lastTradeSequence; // Per currency pair
-        std::unordered_map<std::string, std::chrono::system_clock::time_point> m_lastTradeTime; // Per currency pair
+        // Per exchange and currency pair (TradeStreamKey); numeric trade ids are the sequence
+        std::unordered_map<uint64_t, SequenceWindow> m_tradeSequences;
+        void ExpireTradeSequenceHoles(); // Holes open longer than m_maxWaitTime are declared missing
+        std::unordered_map<uint32_t, std::chrono::system_clock::time_point> m_lastTradeTime; // Per currency pair (symbolId)
         
         // Duplicate detection
-        std::unordered_set<std::string> m_processedTradeIds;
+        std::unordered_set<TradeDedupId, TradeDedupIdHash> m_processedTradeIds; // TradeDedupKey values
         int m_maxTradeIdCache;
         
         // Trade-specific configuration
@@ -168,13 +198,20 @@ namespace gui::editor
             int tradesPerSecond;
             double averageTradeSize;
             double totalVolume;
-            std::unordered_map<std::string, int> tradesByPair;
-            std::unordered_map<std::string, int> tradesByExchange;
+            std::unordered_map<uint32_t, int> tradesByPair;     // Keyed by symbolId
+            std::unordered_map<uint16_t, int> tradesByExchange; // Keyed by exchangeId
+            
+            // Sequence tracking
+            int lateTrades;          // Filled a hole within the window
+            uint64_t missingTrades;  // Declared missing after the timeout or a window overrun
+            uint64_t maxLateDistance; // Largest distance behind the newest trade
+            int sequenceResets;      // Id jumps treated as a restarted feed
             
-            TradeMetrics() : tradesPerSecond(0), averageTradeSize(0.0), totalVolume(0.0) {}
+            TradeMetrics() : tradesPerSecond(0), averageTradeSize(0.0), totalVolume(0.0)
+                , lateTrades(0), missingTrades(0), maxLateDistance(0), sequenceResets(0) {}
         } m_metrics;
         
-        void UpdateTradeMetrics(const NormalizedTrade& trade);
+        void UpdateTradeMetrics(const TradeRecord& trade);
         void CleanupProcessedTradeIds();
         
         // UI state
@@ -182,17 +219,23 @@ namespace gui::editor
         bool m_metricsExpanded;
     };
 
+    class BookChangeSourceData;
+
     // Orderbook Updater Node
     class OrderbookUpdater : public DataUpdaterBase
     {
     public:
         OrderbookUpdater(ax::NodeEditor::NodeId nodeId);
-        virtual ~OrderbookUpdater() = default;
+        virtual ~OrderbookUpdater();
+
+        // Accepts OrderbookBatchData from the orderbook processors
+        bool CanAcceptInput(ax::NodeEditor::PinId inputPin, const NodeData* outputData) const override;
 
     protected:
         void ProcessQueuedUpdates() override;
         void HandleDataConflict(const std::string& conflictInfo) override;
         bool ShouldQueueUpdate(const std::string& updateId) override;
+        void ConsumeInput(ax::NodeEditor::PinId pin, const NodeData& data) override; // Books are applied in arrival order
 
     private:
         void RenderOrderbookConfiguration();
@@ -216,7 +259,45 @@ namespace gui::editor
         std::priority_queue<QueuedOrderbook> m_orderbookQueue;
         
         // Current orderbook state (for incremental updates)
-        std::unordered_map<std::string, NormalizedOrderbook> m_currentOrderbooks; // Per currency pair
+        std::unordered_map<std::string, PriceLadderBook> m_currentOrderbooks; // Per currency pair
+        std::unordered_map<std::string, uint64_t> m_tickGenerations; // Per currency pair: registry generation its tick was taken at
+        NormalizedOrderbook m_mergedOrderbook; // Top-N view of the last merged book; reused
+        std::vector<Decimal> m_trimmedPrices;  // Scratch for levels beyond subscribedDepth
+        std::unordered_map<std::string, BookConflator> m_conflators; // Per currency pair, drained by consumers
+        
+        // Order-by-order books for venues with per-order (L3) feeds
+        std::unordered_map<std::string, OrderByOrderBook> m_orderByOrderBooks; // Per currency pair
+        
+    public:
+        // Net change (or a top-publishDepth snapshot) since the previous read of this pair.
+        // Consumers such as OrderBookPanel call this at their own pace.
+        bool ReadConflatedBook(const std::string& pair, NormalizedOrderbook& out);
+        
+        // Called with the pair's conflated change at most once per ProcessQueuedUpdates pass
+        using ConflatedBookCallback = std::function<void(const NormalizedOrderbook&)>;
+        void SubscribeConflatedBook(const std::string& pair, ConflatedBookCallback callback);
+        
+        // Called after every merge, for every pair, with the levels actually applied to the
+        // pair's ladder (quantity 0 = removed) and the ladder itself. isSnapshot means the
+        // ladder was replaced: rebuild from it and ignore the level lists.
+        // Returns an id for UnsubscribeBookChanges.
+        using BookChangeCallback = std::function<void(const NormalizedOrderbook& changes, const PriceLadderBook& book)>;
+        uint64_t SubscribeBookChanges(BookChangeCallback callback);
+        void UnsubscribeBookChanges(uint64_t subscription);
+        
+        void ProcessOrderEvent(const std::string& pair, const L3OrderEvent& event);
+        void MarkOwnOrder(const std::string& pair, uint64_t orderId);
+        bool GetQueuePosition(const std::string& pair, uint64_t orderId, L3QueuePosition& position) const;
+        
+    private:
+        std::unordered_map<std::string, ConflatedBookCallback> m_conflatedSubscribers; // Per currency pair
+        NormalizedOrderbook m_conflatedRead; // Reused for subscriber reads
+        void PublishConflatedBooks();
+        
+        std::vector<std::pair<uint64_t, BookChangeCallback>> m_bookChangeSubscribers;
+        uint64_t m_nextBookChangeSubscription = 1;
+        std::shared_ptr<BookChangeSourceData> m_bookChangeSource; // Published on the "Book Changes" pin
+        NormalizedOrderbook m_appliedChanges; // Levels applied by the current merge; reused
         
         // Sequence tracking
         std::unordered_map<std::string, uint64_t> m_lastOrderbookSequence; // Per currency pair
@@ -234,18 +315,27 @@ namespace gui::editor
             int snapshotRequestThreshold;   // Gap size that triggers snapshot request
             double conflictSpreadThreshold; // Spread difference threshold for conflicts (%)
             bool maintainLevelHistory;      // Keep history of level changes
+            int publishDepth;               // Levels per side copied out of the ladder
+            int maxBufferedDeltas;          // Per pair while waiting for a snapshot
+            int snapshotTimeoutMs;          // Re-request a snapshot that has not arrived
+            int conflationSnapshotThreshold; // Dirty levels after which a read returns a snapshot
+            bool verifyChecksums;           // Check exchange CRC32s after every update (needs instrument precisions)
+            int subscribedDepth;            // Venue depth subscribed to; deeper levels are trimmed (0 = keep all)
             
             OrderbookUpdaterConfig()
                 : enableSequenceValidation(true), enableSnapshotRecovery(true)
                 , enableIncrementalUpdates(true), validateOrderbookIntegrity(true)
                 , maxSequenceGap(5), maxTimestampSkew(2000), snapshotRequestThreshold(3)
-                , conflictSpreadThreshold(1.0), maintainLevelHistory(false) {}
+                , conflictSpreadThreshold(1.0), maintainLevelHistory(false), publishDepth(20)
+                , maxBufferedDeltas(4096), snapshotTimeoutMs(5000), conflationSnapshotThreshold(256)
+                , verifyChecksums(false), subscribedDepth(0) {}
         } m_orderbookConfig;
         
         // Orderbook integrity validation
         bool ValidateOrderbookIntegrity(const NormalizedOrderbook& orderbook);
         bool ValidateLevelSorting(const std::vector<NormalizedOrderbookLevel>& levels, bool isBids);
         double CalculateSpread(const NormalizedOrderbook& orderbook);
+        bool VerifyBookChecksum(const NormalizedOrderbook& lastApplied); // false = mismatch, resync started
         
         // Performance tracking
         struct OrderbookMetrics
@@ -257,9 +347,30 @@ namespace gui::editor
             std::unordered_map<std::string, int> updatesByPair;
             std::unordered_map<std::string, double> spreadByPair;
             
+            // Resynchronisation
+            int resyncCount;
+            int deltasBuffered;
+            int deltasReplayed;
+            int staleDeltasDropped;
+            double lastRecoveryMs;
+            double averageRecoveryMs;
+            int checksumsVerified;
+            int checksumMismatches;
+            int snapshotsRequested;
+            int lateGapsFilled;        // Small gaps closed by late deltas without a snapshot
+            int offGridLevelsRejected; // Prices that were not a whole number of ticks
+            int invalidSnapshotsDropped; // Unsorted, crossed or non-positive snapshots
+            int rescaledDeltasDropped;   // Deltas at a new instrument scale, before its snapshot
+            std::unordered_map<std::string, int> resyncsByPair;
+            std::unordered_map<std::string, double> recoveryMsByPair; // Last recovery per pair
+            
             OrderbookMetrics() 
                 : updatesPerSecond(0), snapshotsReceived(0)
-                , incrementalUpdatesReceived(0), averageSpread(0.0) {}
+                , incrementalUpdatesReceived(0), averageSpread(0.0)
+                , resyncCount(0), deltasBuffered(0), deltasReplayed(0), staleDeltasDropped(0)
+                , lastRecoveryMs(0.0), averageRecoveryMs(0.0)
+                , checksumsVerified(0), checksumMismatches(0), snapshotsRequested(0), lateGapsFilled(0)
+                , offGridLevelsRejected(0), invalidSnapshotsDropped(0), rescaledDeltasDropped(0) {}
         } m_metrics;
         
         void UpdateOrderbookMetrics(const NormalizedOrderbook& orderbook);
@@ -276,11 +387,204 @@ namespace gui::editor
         
         std::vector<SequenceGap> m_detectedGaps;
         void HandleSequenceGap(const std::string& pair, uint64_t expected, uint64_t received);
-        void RequestSnapshot(const std::string& pair);
+        void RequestSnapshot(const std::string& pair); // Queues a REST depth fetch on the "Snapshot Requests" pin
+        void ProcessSnapshotResponse(const RestResponse& response); // correlationId is the pair
+        void CheckSnapshotTimeouts(); // Re-requests snapshots that have not arrived; ends waits for late deltas
+        
+        char m_snapshotEndpoint[256]; // e.g. "/api/v3/depth?symbol={symbol}&limit=1000"; {symbol} = pair
+        std::shared_ptr<RestRequestData> m_snapshotRequests; // Drained by the connected RestConnectionNode
+        NormalizedOrderbook m_snapshotResponse; // Decoded REST snapshot; reused
+        
+        // Venue and scale of each pair's stream: REST snapshots are decoded to match it
+        struct PairSource
+        {
+            std::string exchange;
+            DecimalScale scale;
+        };
+        std::unordered_map<std::string, PairSource> m_pairSources;
+        
+        std::unordered_map<std::string, OrderbookResync> m_resync; // Per currency pair
         
         // UI state
         bool m_configExpanded;
         bool m_metricsExpanded;
         bool m_integrityExpanded;
     };
-}
\ No newline at end of file
+
+    // Pin payload on OrderbookUpdater's "Book Changes" output: a handle consumers such as
+    // BookAnalyticsNode subscribe through. updater is cleared when the updater is destroyed.
+    class BookChangeSourceData : public NodeData
+    {
+    public:
+        OrderbookUpdater* updater = nullptr;
+
+        std::unique_ptr<NodeData> Clone() const override { return std::make_unique<BookChangeSourceData>(*this); }
+        std::type_index GetTypeIndex() const override { return std::type_index(typeid(BookChangeSourceData)); }
+    };
+
+    // Consolidated Book Node: merges per-venue L2 books for the same pair
+    class ConsolidatedBookNode : public DataUpdaterBase
+    {
+    public:
+        ConsolidatedBookNode(ax::NodeEditor::NodeId nodeId);
+        virtual ~ConsolidatedBookNode() = default;
+
+        // One input per venue, each taking OrderbookBatchData from an orderbook processor
+        bool CanAcceptInput(ax::NodeEditor::PinId inputPin, const NodeData* outputData) const override;
+        void OnInputDisconnected(ax::NodeEditor::PinId pinId) override;
+
+        // Cross-venue touch for routing; O(1)
+        bool GetBestBidOffer(const std::string& pair, ConsolidatedBBO& bbo) const;
+        const ConsolidatedBook* GetBook(const std::string& pair) const;
+
+    protected:
+        void ProcessQueuedUpdates() override;
+        void HandleDataConflict(const std::string& conflictInfo) override;
+        bool ShouldQueueUpdate(const std::string& updateId) override;
+        void ConsumeInput(ax::NodeEditor::PinId pin, const NodeData& data) override;
+
+    private:
+        static constexpr int VENUE_INPUTS = 4;
+        
+        void RenderConsolidatedConfiguration();
+        void ProcessVenueUpdate(const NormalizedOrderbook& update); // update.exchange names the venue
+        void OnVenueDisconnected(const std::string& venue);
+        
+        struct PairBook
+        {
+            ConsolidatedBook book;
+            DecimalScale scale;  // Finest scale seen; venue updates are rescaled up to it
+            bool hasScale;
+            
+            PairBook() : hasScale(false) {}
+        };
+        
+        std::unordered_map<std::string, PairBook> m_books; // Per currency pair
+        std::vector<NormalizedOrderbookLevel> m_rescaledBids; // Scratch for venues at another scale
+        std::vector<NormalizedOrderbookLevel> m_rescaledAsks;
+        std::unordered_map<std::string, ax::NodeEditor::PinId> m_venuePins; // Input each venue last arrived on
+        
+        // Consolidated-specific configuration
+        struct ConsolidatedConfig
+        {
+            bool excludeStaleVenues;  // Drop a venue's levels when it disconnects
+            int publishDepth;
+            
+            ConsolidatedConfig() : excludeStaleVenues(true), publishDepth(20) {}
+        } m_consolidatedConfig;
+        
+        // UI state
+        bool m_configExpanded;
+        bool m_venuesExpanded;
+    };
+
+    // Bar Aggregator Node: 1s/1m/5m/1h OHLCV and VWAP bars for every pair on its trade input
+    class BarAggregatorNode : public DataUpdaterBase
+    {
+    public:
+        BarAggregatorNode(ax::NodeEditor::NodeId nodeId);
+        virtual ~BarAggregatorNode() = default;
+
+        // Accepts both TradeRowBatchData and TradeColumnBatchData on the input pin
+        bool CanAcceptInput(ax::NodeEditor::PinId inputPin, const NodeData* outputData) const override;
+
+        // Bars are kept per exchange and pair; the exchange is the trades' venue name
+        bool GetCurrentBar(const std::string& exchange, const std::string& pair, BarTimeframe timeframe,
+                           OhlcvBar& bar) const;
+        size_t GetBars(const std::string& exchange, const std::string& pair, BarTimeframe timeframe, size_t maxBars,
+                       std::vector<OhlcvBar>& bars) const; // Sealed bars, newest first
+
+        void ApplyBarConfig(); // Call after editing m_barConfig; drops every bar
+
+    protected:
+        void ProcessQueuedUpdates() override;
+        void HandleDataConflict(const std::string& conflictInfo) override;
+        bool ShouldQueueUpdate(const std::string& updateId) override;
+        void ConsumeInput(ax::NodeEditor::PinId pin, const NodeData& data) override { (void)pin; ProcessTradeBatch(data); }
+
+    private:
+        void RenderBarConfiguration();
+        void ProcessTradeBatch(const NodeData& batch); // Dispatches on row/column form
+        void CloseElapsedBars(); // Seals bars of pairs that stopped trading
+        
+        // Bar-specific configuration
+        struct BarConfig
+        {
+            int historyBars;  // Ring size per pair and timeframe
+            int latenessMs;   // How long after a second ends its trades are still accepted
+            
+            BarConfig() : historyBars(256), latenessMs(1000) {}
+        } m_barConfig;
+
+        // Declared after m_barConfig so it starts with the configured sizes
+        BarAggregator m_bars{static_cast<size_t>(m_barConfig.historyBars),
+                             static_cast<int64_t>(m_barConfig.latenessMs) * 1000000};
+        
+        // UI state
+        bool m_configExpanded;
+        bool m_barsExpanded;
+    };
+
+    // Book Analytics Node: imbalance, microprice, depth within a band and queue-weighted
+    // mid per pair, maintained from the level changes an OrderbookUpdater applies and
+    // emitted as compact samples. It reads the updater's ladders and keeps none of its own.
+    class BookAnalyticsNode : public DataUpdaterBase
+    {
+    public:
+        BookAnalyticsNode(ax::NodeEditor::NodeId nodeId);
+        virtual ~BookAnalyticsNode();
+
+        // Accepts BookChangeSourceData: connecting an updater's "Book Changes" output attaches
+        // to it, disconnecting (or deleting either node) detaches
+        bool CanAcceptInput(ax::NodeEditor::PinId inputPin, const NodeData* outputData) const override;
+        void OnInputDisconnected(ax::NodeEditor::PinId pinId) override;
+
+        void AttachTo(OrderbookUpdater& updater); // Subscribes to the updater's book changes
+
+        // Samples emitted since the previous call (out is swapped with the pending buffer)
+        size_t ReadSamples(std::vector<BookAnalyticsSample>& out);
+        bool GetLatestSample(const std::string& pair, BookAnalyticsSample& sample) const;
+
+    protected:
+        void ProcessQueuedUpdates() override;
+        void HandleDataConflict(const std::string& conflictInfo) override;
+        bool ShouldQueueUpdate(const std::string& updateId) override;
+        void ConsumeInput(ax::NodeEditor::PinId pin, const NodeData& data) override;
+
+    private:
+        void RenderAnalyticsConfiguration();
+        void ProcessBookChanges(const NormalizedOrderbook& changes, const PriceLadderBook& book);
+        void Detach(); // Unsubscribes from the connected updater and drops its pairs
+        
+        std::shared_ptr<BookChangeSourceData> m_source; // Handle of the connected updater
+        uint64_t m_subscription = 0;
+        
+        struct PairAnalytics
+        {
+            BookAnalytics analytics;
+            uint32_t symbolId;
+            BookAnalyticsSample latest;
+            bool hasSample;
+            
+            explicit PairAnalytics(size_t windowTicks)
+                : analytics(windowTicks), symbolId(0), latest(), hasSample(false) {}
+        };
+        
+        std::unordered_map<std::string, PairAnalytics> m_pairs; // Per currency pair
+        std::vector<BookAnalyticsSample> m_samples; // Pending until ReadSamples
+        
+        // Analytics-specific configuration
+        struct AnalyticsConfig
+        {
+            double bandBps;         // Depth is summed within this distance of the mid
+            int windowTicks;        // Ticks around the mid kept in the prefix sums
+            int maxPendingSamples;  // Oldest half dropped when nobody reads
+            
+            AnalyticsConfig() : bandBps(10.0), windowTicks(8192), maxPendingSamples(65536) {}
+        } m_analyticsConfig;
+        
+        // UI state
+        bool m_configExpanded;
+        bool m_metricsExpanded;
+    };
+}
@@ -0,0 +1,295 @@
+#include "Decimal.h"
+
+#include <cmath>
+#include <limits>
+
+namespace gui
+{
+    namespace editor
+    {
+        namespace
+        {
+#if defined(__SIZEOF_INT128__)
+            __extension__ typedef __int128 Int128;
+#endif
+
+            constexpr int64_t POW10[] = {
+                1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL,
+                100000000LL, 1000000000LL, 10000000000LL, 100000000000LL, 1000000000000LL,
+                10000000000000LL, 100000000000000LL, 1000000000000000LL,
+                10000000000000000LL, 100000000000000000LL, 1000000000000000000LL
+            };
+
+            // Divides rounding half away from zero
+            int64_t DivideRounded(int64_t value, int64_t divisor)
+            {
+                const int64_t quotient = value / divisor;
+                const int64_t remainder = value % divisor;
+                if (remainder * 2 >= divisor)
+                    return quotient + 1;
+                if (remainder * 2 <= -divisor)
+                    return quotient - 1;
+                return quotient;
+            }
+        }
+
+        int64_t DecimalPow10(int exponent)
+        {
+            return (exponent >= 0 && exponent <= Decimal::MAX_SCALE) ? POW10[exponent] : 0;
+        }
+
+        double Decimal::ToDouble(int scale) const
+        {
+            return static_cast<double>(units) / static_cast<double>(DecimalPow10(scale));
+        }
+
+        bool Decimal::FromDouble(double value, int scale, Decimal& out)
+        {
+            if (scale < 0 || scale > MAX_SCALE || !std::isfinite(value))
+                return false;
+
+            // 2^63 is exact as a double; anything at or beyond it would wrap in the cast
+            const double scaled = std::round(value * static_cast<double>(POW10[scale]));
+            if (!(scaled >= -9223372036854775808.0 && scaled < 9223372036854775808.0))
+                return false;
+            out = Decimal(static_cast<int64_t>(scaled));
+            return true;
+        }
+
+        bool Decimal::Rescale(int fromScale, int toScale, Decimal& out) const
+        {
+            if (fromScale < 0 || fromScale > MAX_SCALE || toScale < 0 || toScale > MAX_SCALE)
+                return false;
+            if (toScale < fromScale)
+            {
+                out = Decimal(DivideRounded(units, POW10[fromScale - toScale]));
+                return true;
+            }
+
+            const int64_t factor = POW10[toScale - fromScale];
+            if (units > std::numeric_limits<int64_t>::max() / factor || units < std::numeric_limits<int64_t>::min() / factor)
+                return false;
+            out = Decimal(units * factor);
+            return true;
+        }
+
+        bool Decimal::Multiply(Decimal a, int aScale, Decimal b, int bScale, int resultScale, Decimal& out)
+        {
+            if (aScale < 0 || aScale > MAX_SCALE || bScale < 0 || bScale > MAX_SCALE ||
+                resultScale < 0 || resultScale > MAX_SCALE)
+                return false;
+
+            const int shift = aScale + bScale - resultScale;
+#if defined(__SIZEOF_INT128__)
+            // |a * b| < 2^126 and 10^36 < 2^120, so neither the product nor the divisor overflows
+            Int128 product = static_cast<Int128>(a.units) * b.units;
+            if (shift > 0)
+            {
+                const Int128 divisor = shift > MAX_SCALE
+                    ? static_cast<Int128>(POW10[MAX_SCALE]) * POW10[shift - MAX_SCALE]
+                    : static_cast<Int128>(POW10[shift]);
+                const Int128 quotient = product / divisor;
+                const Int128 remainder = product % divisor;
+                product = quotient + (remainder * 2 >= divisor ? 1 : 0) - (remainder * 2 <= -divisor ? 1 : 0);
+            }
+            else if (shift < 0)
+            {
+                // Checked before multiplying: the result has to fit 64 bits anyway
+                const int64_t factor = POW10[-shift];
+                if (product > std::numeric_limits<int64_t>::max() / factor || product < std::numeric_limits<int64_t>::min() / factor)
+                    return false;
+                product *= factor;
+            }
+            if (product > std::numeric_limits<int64_t>::max() || product < std::numeric_limits<int64_t>::min())
+                return false;
+            out = Decimal(static_cast<int64_t>(product));
+            return true;
+#else
+            const double product = a.ToDouble(aScale) * b.ToDouble(bScale) * static_cast<double>(POW10[resultScale]);
+            (void)shift;
+            if (!(std::fabs(product) < 9.2e18))
+                return false;
+            out = Decimal(static_cast<int64_t>(std::llround(product)));
+            return true;
+#endif
+        }
+
+        bool Decimal::Parse(std::string_view text, int scale, Decimal& out)
+        {
+            const char* p = text.data();
+            const char* end = p + text.size();
+
+            if (p == end || scale < 0 || scale > MAX_SCALE)
+                return false;
+
+            bool negative = false;
+            if (*p == '-' || *p == '+')
+            {
+                negative = (*p == '-');
+                ++p;
+            }
+
+            // Accumulate significant digits as an integer mantissa plus decimal exponent
+            uint64_t mantissa = 0;
+            int digits = 0;        // significant digits accumulated into the mantissa
+            int exponent = 0;      // value = mantissa * 10^exponent
+            bool sawDigit = false;
+            bool roundUp = false;  // first dropped digit >= 5
+            bool dropped = false;
+
+            for (; p != end && *p >= '0' && *p <= '9'; ++p)
+            {
+                sawDigit = true;
+                if (digits < 19)
+                {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                    if (mantissa != 0)
+                        ++digits;
+                }
+                else
+                {
+                    if (!dropped)
+                        roundUp = (*p >= '5');
+                    dropped = true;
+                    ++exponent;
+                }
+            }
+
+            if (p != end && *p == '.')
+            {
+                ++p;
+                for (; p != end && *p >= '0' && *p <= '9'; ++p)
+                {
+                    sawDigit = true;
+                    if (digits < 19)
+                    {
+                        mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                        if (mantissa != 0)
+                            ++digits;
+                        --exponent;
+                    }
+                    else if (!dropped)
+                    {
+                        roundUp = (*p >= '5');
+                        dropped = true;
+                    }
+                }
+            }
+
+            if (!sawDigit)
+                return false;
+
+            if (p != end && (*p == 'e' || *p == 'E'))
+            {
+                ++p;
+                bool negativeExponent = false;
+                if (p != end && (*p == '-' || *p == '+'))
+                {
+                    negativeExponent = (*p == '-');
+                    ++p;
+                }
+                if (p == end)
+                    return false;
+
+                int value = 0;
+                for (; p != end && *p >= '0' && *p <= '9'; ++p)
+                {
+                    if (value < 1000)
+                        value = value * 10 + (*p - '0');
+                }
+                exponent += negativeExponent ? -value : value;
+            }
+
+            if (p != end)
+                return false;
+
+            if (dropped && roundUp)
+                ++mantissa;
+
+            // Bring the mantissa to the requested scale
+            const int shift = exponent + scale;
+            uint64_t result = mantissa;
+            if (shift > 0)
+            {
+                if (shift > MAX_SCALE)
+                {
+                    if (mantissa != 0)
+                        return false;
+                }
+                else
+                {
+                    const uint64_t factor = static_cast<uint64_t>(POW10[shift]);
+                    if (mantissa > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) / factor)
+                        return false;
+                    result = mantissa * factor;
+                }
+            }
+            else if (shift < 0)
+            {
+                if (-shift > MAX_SCALE + 1)
+                {
+                    result = 0;
+                }
+                else if (-shift == MAX_SCALE + 1)
+                {
+                    // 10^19 does not fit int64; only the rounding digit matters here
+                    result = mantissa >= 5000000000000000000ull ? 1 : 0;
+                }
+                else
+                {
+                    const uint64_t divisor = static_cast<uint64_t>(POW10[-shift]);
+                    result = mantissa / divisor;
+                    if ((mantissa % divisor) * 2 >= divisor)
+                        ++result;
+                }
+            }
+
+            if (result > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+                return false;
+
+            out.units = negative ? -static_cast<int64_t>(result) : static_cast<int64_t>(result);
+            return true;
+        }
+
+        size_t Decimal::Format(char* buffer, size_t size, int scale) const
+        {
+            // At most 20 digits for the magnitude, or MAX_SCALE + 1 with the padding below
+            if (scale < 0 || scale > MAX_SCALE)
+                return 0;
+            char digits[24];
+            int count = 0;
+
+            uint64_t magnitude = units < 0 ? 0 - static_cast<uint64_t>(units) : static_cast<uint64_t>(units);
+            do
+            {
+                digits[count++] = static_cast<char>('0' + magnitude % 10);
+                magnitude /= 10;
+            } while (magnitude != 0);
+
+            // Pad so that there is at least one integer digit
+            while (count <= scale)
+                digits[count++] = '0';
+
+            const size_t length = static_cast<size_t>(count) + (scale > 0 ? 1 : 0) + (units < 0 ? 1 : 0);
+            if (length > size)
+                return 0;
+
+            size_t pos = 0;
+            if (units < 0)
+                buffer[pos++] = '-';
+            for (int i = count - 1; i >= 0; i--)
+            {
+                buffer[pos++] = digits[i];
+                if (i == scale && scale > 0)
+                    buffer[pos++] = '.';
+            }
+            return pos;
+        }
+
+        std::string Decimal::ToString(int scale) const
+        {
+            char buffer[48];
+            return std::string(buffer, Format(buffer, sizeof(buffer), scale));
+        }
+    } // editor
+} // gui
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace gui::editor
+{
+    // 64-bit fixed-point decimal. The scale (number of fractional digits) is not stored
+    // in the value; it is fixed per instrument (InstrumentData::pricePrecision and
+    // quantityPrecision) and travels with the container (book, trade, order, balance).
+    // Values at the same scale compare and add exactly, so they can be used as keys.
+    struct Decimal
+    {
+        int64_t units; // value * 10^scale
+
+        static constexpr int MAX_SCALE = 18;
+
+        constexpr Decimal() : units(0) {}
+        constexpr explicit Decimal(int64_t scaledUnits) : units(scaledUnits) {}
+
+        // Exact arithmetic, both operands at the same scale
+        constexpr Decimal operator+(Decimal other) const { return Decimal(units + other.units); }
+        constexpr Decimal operator-(Decimal other) const { return Decimal(units - other.units); }
+        constexpr Decimal operator-() const { return Decimal(-units); }
+        constexpr Decimal& operator+=(Decimal other) { units += other.units; return *this; }
+        constexpr Decimal& operator-=(Decimal other) { units -= other.units; return *this; }
+        constexpr auto operator<=>(const Decimal&) const = default;
+
+        constexpr bool IsZero() const { return units == 0; }
+        constexpr bool IsPositive() const { return units > 0; }
+
+        // Conversions
+        double ToDouble(int scale) const;
+        // Rounds half away from zero. Returns false for NaN, infinity, an out-of-range
+        // scale or a value that does not fit; out is left untouched in that case.
+        static bool FromDouble(double value, int scale, Decimal& out);
+        // Rounds half away from zero. Returns false when a scale is out of range or the
+        // value does not fit at toScale; out is left untouched in that case.
+        bool Rescale(int fromScale, int toScale, Decimal& out) const;
+
+        // Product of two decimals, rounded to resultScale (e.g. price * qty = notional).
+        // Returns false on an out-of-range scale or overflow; out is left untouched.
+        static bool Multiply(Decimal a, int aScale, Decimal b, int bScale, int resultScale, Decimal& out);
+
+        // Exact string -> decimal. Accepts an optional sign, digits, '.', and an exponent.
+        // Digits beyond the scale are rounded half away from zero. Returns false on
+        // malformed input or overflow; out is left untouched in that case.
+        static bool Parse(std::string_view text, int scale, Decimal& out);
+
+        // Writes the value with exactly `scale` fractional digits. Returns the number of
+        // characters written (not null-terminated), or 0 if the buffer is too small or
+        // the scale is outside 0..MAX_SCALE.
+        size_t Format(char* buffer, size_t size, int scale) const;
+        std::string ToString(int scale) const;
+    };
+
+    static_assert(sizeof(Decimal) == 8, "Decimal must stay a plain 64-bit value");
+
+    // Per-instrument scales, derived from InstrumentData precisions
+    struct DecimalScale
+    {
+        uint8_t price;
+        uint8_t quantity;
+
+        constexpr DecimalScale() : price(8), quantity(8) {}
+        constexpr DecimalScale(int priceScale, int quantityScale)
+            : price(static_cast<uint8_t>(ClampScale(priceScale)))
+            , quantity(static_cast<uint8_t>(ClampScale(quantityScale))) {}
+
+        static constexpr int ClampScale(int scale)
+        {
+            return scale < 0 ? 0 : (scale > Decimal::MAX_SCALE ? Decimal::MAX_SCALE : scale);
+        }
+    };
+
+    // Powers of ten up to 10^18
+    int64_t DecimalPow10(int exponent);
+}
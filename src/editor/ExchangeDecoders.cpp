@@ -0,0 +1,628 @@
+#include "ExchangeDecoders.h"
+#include "MessageProcessors.h"
+#include "OrderbookLevelParser.h"
+
+#include <array>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+namespace gui
+{
+    namespace editor
+    {
+        namespace
+        {
+            // Trade schemas ------------------------------------------------------------
+
+            // {"e":"trade","E":..,"s":"BNBBTC","t":12345,"p":"0.001","q":"100","T":123456785,"m":true}
+            struct BinanceTradeSchema
+            {
+                static constexpr std::string_view Exchange = "Binance";
+                static constexpr std::string_view DataArray = "";
+                static constexpr std::string_view TradeId = "t";
+                static constexpr std::string_view Price = "p";
+                static constexpr std::string_view Quantity = "q";
+                static constexpr std::string_view Side = "";
+                static constexpr std::string_view Timestamp = "T";
+                static constexpr std::string_view Symbol = "s";
+                static constexpr std::string_view IsMaker = "m"; // Buyer is maker -> aggressor sold
+                static constexpr bool IsoTimestamp = false;
+                static constexpr bool SideIsMakerSide = false;
+            };
+
+            // {"type":"match","trade_id":10,"product_id":"BTC-USD","size":"5.2","price":"400.23","side":"sell","time":"..."}
+            struct CoinbaseTradeSchema
+            {
+                static constexpr std::string_view Exchange = "Coinbase";
+                static constexpr std::string_view DataArray = "";
+                static constexpr std::string_view TradeId = "trade_id";
+                static constexpr std::string_view Price = "price";
+                static constexpr std::string_view Quantity = "size";
+                static constexpr std::string_view Side = "side";
+                static constexpr std::string_view Timestamp = "time";
+                static constexpr std::string_view Symbol = "product_id";
+                static constexpr std::string_view IsMaker = "";
+                static constexpr bool IsoTimestamp = true;
+                static constexpr bool SideIsMakerSide = true; // "side" is the maker order's side
+            };
+
+            // {"channel":"trade","data":[{"symbol":"BTC/USD","side":"buy","price":0.51,"qty":64.2,"trade_id":4665846,"timestamp":"..."}]}
+            struct KrakenTradeSchema
+            {
+                static constexpr std::string_view Exchange = "Kraken";
+                static constexpr std::string_view DataArray = "data";
+                static constexpr std::string_view TradeId = "trade_id";
+                static constexpr std::string_view Price = "price";
+                static constexpr std::string_view Quantity = "qty";
+                static constexpr std::string_view Side = "side";
+                static constexpr std::string_view Timestamp = "timestamp";
+                static constexpr std::string_view Symbol = "symbol";
+                static constexpr std::string_view IsMaker = "";
+                static constexpr bool IsoTimestamp = true;
+                static constexpr bool SideIsMakerSide = false;
+            };
+
+            // Orderbook schemas --------------------------------------------------------
+
+            // REST depth: {"lastUpdateId":160,"bids":[["0.0024","10"]],"asks":[["0.0026","100"]]}
+            // Diff depth: {"e":"depthUpdate","E":..,"s":"BNBBTC","U":157,"u":160,"b":[["0.0024","10"]],"a":[..]}
+            struct BinanceOrderbookSchema
+            {
+                static constexpr std::string_view Exchange = "Binance";
+                static constexpr std::string_view DataArray = "";
+                static constexpr std::string_view TypeField = "";
+                static constexpr std::string_view SnapshotType = "";
+                static constexpr std::string_view SnapshotIdField = "lastUpdateId";
+                static constexpr std::string_view Sequence = "u";      // Diff depth stream
+                static constexpr std::string_view FirstSequence = "U";
+                static constexpr std::string_view PreviousSequence = "";
+                static constexpr std::string_view Checksum = "";
+                static constexpr ChecksumScheme Checksums = ChecksumScheme::None;
+                static constexpr std::string_view SymbolParent = "";
+                static constexpr std::string_view Symbol = "s";
+                static constexpr std::string_view Bids = "bids";
+                static constexpr std::string_view Asks = "asks";
+                static constexpr std::string_view DeltaBids = "b"; // Diff depth stream
+                static constexpr std::string_view DeltaAsks = "a";
+                static constexpr std::string_view Price = "0";
+                static constexpr std::string_view Quantity = "1";
+            };
+
+            // {"channel":"book","type":"snapshot","data":[{"symbol":"BTC/USD","bids":[{"price":..,"qty":..}],"asks":[..]}]}
+            struct KrakenOrderbookSchema
+            {
+                static constexpr std::string_view Exchange = "Kraken";
+                static constexpr std::string_view DataArray = "data";
+                static constexpr std::string_view TypeField = "type";
+                static constexpr std::string_view SnapshotType = "snapshot";
+                static constexpr std::string_view SnapshotIdField = "";
+                static constexpr std::string_view Sequence = "";       // Book integrity comes from checksums
+                static constexpr std::string_view FirstSequence = "";
+                static constexpr std::string_view PreviousSequence = "";
+                static constexpr std::string_view Checksum = "checksum"; // CRC32 over the top 10 levels
+                static constexpr ChecksumScheme Checksums = ChecksumScheme::Kraken;
+                static constexpr std::string_view SymbolParent = "";
+                static constexpr std::string_view Symbol = "symbol";
+                static constexpr std::string_view Bids = "bids";
+                static constexpr std::string_view Asks = "asks";
+                static constexpr std::string_view DeltaBids = ""; // Updates use the same names
+                static constexpr std::string_view DeltaAsks = "";
+                static constexpr std::string_view Price = "price";
+                static constexpr std::string_view Quantity = "qty";
+            };
+
+            // {"arg":{"channel":"books","instId":"BTC-USDT"},"action":"snapshot",
+            //  "data":[{"asks":[["8476.98","415","0","13"]],"bids":[..],"checksum":-855196043,"prevSeqId":-1,"seqId":123}]}
+            struct OkxOrderbookSchema
+            {
+                static constexpr std::string_view Exchange = "OKX";
+                static constexpr std::string_view DataArray = "data";
+                static constexpr std::string_view TypeField = "action";
+                static constexpr std::string_view SnapshotType = "snapshot";
+                static constexpr std::string_view SnapshotIdField = "";
+                static constexpr std::string_view Sequence = "seqId";
+                static constexpr std::string_view FirstSequence = "";
+                static constexpr std::string_view PreviousSequence = "prevSeqId"; // seqId of the previous message
+                static constexpr std::string_view Checksum = "checksum"; // Signed CRC32 over the top 25 levels
+                static constexpr ChecksumScheme Checksums = ChecksumScheme::Okx;
+                static constexpr std::string_view SymbolParent = "arg"; // Symbol is outside the data array
+                static constexpr std::string_view Symbol = "instId";
+                static constexpr std::string_view Bids = "bids";
+                static constexpr std::string_view Asks = "asks";
+                static constexpr std::string_view DeltaBids = "";
+                static constexpr std::string_view DeltaAsks = "";
+                static constexpr std::string_view Price = "0";
+                static constexpr std::string_view Quantity = "1";
+            };
+
+            // Symbols repeat message after message; skip the interning lookup when unchanged
+            uint32_t InternSymbol(TradeStringTable& strings, std::string_view symbol)
+            {
+                thread_local const TradeStringTable* cachedTable = nullptr;
+                thread_local char cachedSymbol[32];
+                thread_local size_t cachedLength = 0;
+                thread_local uint32_t cachedId = 0;
+
+                if (cachedTable == &strings && symbol.size() == cachedLength &&
+                    std::memcmp(symbol.data(), cachedSymbol, cachedLength) == 0)
+                    return cachedId;
+
+                cachedId = strings.Intern(symbol);
+                if (symbol.size() <= sizeof(cachedSymbol))
+                {
+                    cachedTable = &strings;
+                    cachedLength = symbol.size();
+                    std::memcpy(cachedSymbol, symbol.data(), cachedLength);
+                }
+                return cachedId;
+            }
+
+            template<typename Schema>
+            bool DecodeTradeObject(std::string_view object, DecimalScale scale, TradeStringTable& strings,
+                                   uint16_t exchangeId, TradeRecord& out)
+            {
+                out = TradeRecord{};
+                out.exchangeId = exchangeId;
+                out.priceScale = scale.price;
+                out.quantityScale = scale.quantity;
+
+                JsonScan::ObjectReader reader(object);
+                std::string_view key;
+                std::string_view value;
+                bool hasPrice = false;
+                bool hasQuantity = false;
+
+                // Each test below is a length check plus a short compare against a constant
+                while (reader.Next(key, value))
+                {
+                    const std::string_view text = JsonScan::Unquote(value);
+
+                    if (key == Schema::Price)
+                        hasPrice = Decimal::Parse(text, scale.price, out.price);
+                    else if (key == Schema::Quantity)
+                        hasQuantity = Decimal::Parse(text, scale.quantity, out.quantity);
+                    else if (key == Schema::TradeId)
+                        EncodeTradeId(text, out);
+                    else if (key == Schema::Symbol)
+                        out.symbolId = InternSymbol(strings, JsonScan::Unescape(value, GetThreadArena()));
+                    else if (key == Schema::Timestamp)
+                    {
+                        if constexpr (Schema::IsoTimestamp)
+                            JsonTime::ParseIso8601(text, out.timestampNs);
+                        else
+                            JsonTime::ParseEpoch(text, out.timestampNs);
+                    }
+                    else if constexpr (!Schema::Side.empty())
+                    {
+                        if (key == Schema::Side)
+                        {
+                            const TradeSide side = ParseTradeSide(text);
+                            out.side = !Schema::SideIsMakerSide ? side
+                                : side == TradeSide::Buy ? TradeSide::Sell
+                                : side == TradeSide::Sell ? TradeSide::Buy : TradeSide::Unknown;
+                        }
+                    }
+                    else if constexpr (!Schema::IsMaker.empty())
+                    {
+                        if (key == Schema::IsMaker)
+                            out.side = (text == "true") ? TradeSide::Sell : TradeSide::Buy;
+                    }
+                }
+
+                return hasPrice && hasQuantity;
+            }
+
+            template<typename Schema>
+            size_t DecodeTrades(std::string_view json, DecimalScale scale, TradeStringTable& strings,
+                                std::vector<TradeRecord>& out)
+            {
+                // One slot per schema so the exchange name never evicts the symbol cache
+                thread_local const TradeStringTable* exchangeTable = nullptr;
+                thread_local uint16_t exchangeId = 0;
+                if (exchangeTable != &strings)
+                {
+                    if (!strings.InternName(Schema::Exchange, exchangeId))
+                        return 0;
+                    exchangeTable = &strings;
+                }
+                TradeRecord trade;
+
+                if constexpr (Schema::DataArray.empty())
+                {
+                    if (!DecodeTradeObject<Schema>(json, scale, strings, exchangeId, trade))
+                        return 0;
+                    out.push_back(trade);
+                    return 1;
+                }
+                else
+                {
+                    JsonScan::ArrayReader entries(JsonScan::FindField(json, Schema::DataArray));
+                    std::string_view entry;
+                    size_t decoded = 0;
+                    while (entries.Next(entry))
+                    {
+                        if (DecodeTradeObject<Schema>(entry, scale, strings, exchangeId, trade))
+                        {
+                            out.push_back(trade);
+                            decoded++;
+                        }
+                    }
+                    return decoded;
+                }
+            }
+
+            uint64_t ParseUnsigned(std::string_view text)
+            {
+                uint64_t value = 0;
+                for (char c : text)
+                {
+                    if (c < '0' || c > '9')
+                        break;
+                    value = value * 10 + static_cast<uint64_t>(c - '0');
+                }
+                return value;
+            }
+
+            // Exchanges publish CRC32s as signed (OKX, Bitfinex) or unsigned (Kraken) decimals
+            bool ParseChecksum(std::string_view text, uint32_t& checksum)
+            {
+                const bool negative = !text.empty() && text.front() == '-';
+                if (negative)
+                    text.remove_prefix(1);
+                if (text.empty() || text.size() > 10 || text.front() < '0' || text.front() > '9')
+                    return false;
+                const uint64_t magnitude = ParseUnsigned(text);
+                if (magnitude > (negative ? uint64_t(0x80000000u) : uint64_t(0xFFFFFFFFu)))
+                    return false;
+                checksum = static_cast<uint32_t>(negative ? uint64_t(0) - magnitude : magnitude);
+                return true;
+            }
+
+            template<typename Schema>
+            const JsonLevelLayout& GetLevelLayout()
+            {
+                static const JsonLevelLayout layout = [] {
+                    JsonLevelLayout result;
+                    result.price = JsonLevelField::FromMapping(Schema::Price.data());
+                    result.quantity = JsonLevelField::FromMapping(Schema::Quantity.data());
+                    return result;
+                }();
+                return layout;
+            }
+
+            template<typename Schema>
+            bool DecodeBookObject(std::string_view object, size_t maxLevels, NormalizedOrderbook& out)
+            {
+                JsonLevelLayout layout = GetLevelLayout<Schema>();
+                layout.maxLevels = maxLevels;
+
+                JsonScan::ObjectReader reader(object);
+                std::string_view key;
+                std::string_view value;
+                bool hasSide = false;
+
+                while (reader.Next(key, value))
+                {
+                    if (key == Schema::Bids || (!Schema::DeltaBids.empty() && key == Schema::DeltaBids))
+                        hasSide |= OrderbookLevelParser::Parse(value, layout, out.scale, out.bids);
+                    else if (key == Schema::Asks || (!Schema::DeltaAsks.empty() && key == Schema::DeltaAsks))
+                        hasSide |= OrderbookLevelParser::Parse(value, layout, out.scale, out.asks);
+                    else if (key == Schema::Symbol)
+                        out.currencyPair.assign(JsonScan::Unescape(value, GetThreadArena()));
+                    else if (!Schema::SnapshotIdField.empty() && key == Schema::SnapshotIdField)
+                    {
+                        out.orderbookId.assign(JsonScan::Unquote(value));
+                        out.sequence = ParseUnsigned(JsonScan::Unquote(value));
+                        out.isSnapshot = true;
+                    }
+                    else if (!Schema::Sequence.empty() && key == Schema::Sequence)
+                        out.sequence = ParseUnsigned(value);
+                    else if (!Schema::FirstSequence.empty() && key == Schema::FirstSequence)
+                        out.firstSequence = ParseUnsigned(value);
+                    else if (!Schema::PreviousSequence.empty() && key == Schema::PreviousSequence)
+                    {
+                        // -1 on snapshots; otherwise the delta starts right after it
+                        const std::string_view previous = JsonScan::Unquote(value);
+                        if (!previous.empty() && previous.front() != '-')
+                            out.firstSequence = ParseUnsigned(previous) + 1;
+                    }
+                    else if (!Schema::Checksum.empty() && key == Schema::Checksum)
+                    {
+                        out.hasChecksum = ParseChecksum(JsonScan::Unquote(value), out.checksum);
+                        out.checksumScheme = Schema::Checksums;
+                    }
+                }
+                return hasSide;
+            }
+
+            template<typename Schema>
+            bool DecodeOrderbook(std::string_view json, size_t maxLevels, NormalizedOrderbook& out)
+            {
+                // `out` is reused across messages: a body without a symbol (a REST depth
+                // snapshot) must not inherit the previous message's pair
+                out.currencyPair.clear();
+                out.orderbookId.clear();
+                out.bids.clear();
+                out.asks.clear();
+                out.isSnapshot = false;
+                out.sequence = 0;
+                out.firstSequence = 0;
+                out.hasChecksum = false;
+                out.checksumScheme = ChecksumScheme::None;
+
+                if constexpr (Schema::DataArray.empty())
+                {
+                    return DecodeBookObject<Schema>(json, maxLevels, out);
+                }
+                else
+                {
+                    JsonScan::ObjectReader reader(json);
+                    std::string_view key;
+                    std::string_view value;
+                    bool decoded = false;
+
+                    while (reader.Next(key, value))
+                    {
+                        if (key == Schema::TypeField)
+                            out.isSnapshot = (JsonScan::Unquote(value) == Schema::SnapshotType);
+                        else if (!Schema::SymbolParent.empty() && key == Schema::SymbolParent)
+                            out.currencyPair.assign(JsonScan::Unescape(JsonScan::FindField(value, Schema::Symbol),
+                                                                       GetThreadArena()));
+                        else if (key == Schema::DataArray)
+                        {
+                            JsonScan::ArrayReader books(value);
+                            std::string_view book;
+                            if (books.Next(book))
+                                decoded = DecodeBookObject<Schema>(book, maxLevels, out);
+                        }
+                    }
+                    return decoded;
+                }
+            }
+
+            // One [price, count, amount] entry; a negative amount is an ask, count 0 deletes
+            bool DecodeBitfinexLevel(std::string_view level, size_t maxLevels, NormalizedOrderbook& out)
+            {
+                JsonScan::ArrayReader fields(level);
+                std::string_view price;
+                std::string_view count;
+                std::string_view amount;
+                if (!fields.Next(price) || !fields.Next(count) || !fields.Next(amount) || amount.empty())
+                    return false;
+
+                const bool isBid = amount.front() != '-';
+                if (!isBid)
+                    amount.remove_prefix(1);
+                std::vector<NormalizedOrderbookLevel>& side = isBid ? out.bids : out.asks;
+                if (maxLevels != 0 && side.size() >= maxLevels)
+                    return true;
+
+                NormalizedOrderbookLevel parsed;
+                const uint64_t orders = ParseUnsigned(count);
+                if (!Decimal::Parse(price, out.scale.price, parsed.price) ||
+                    (orders != 0 && !Decimal::Parse(amount, out.scale.quantity, parsed.quantity)))
+                    return false;
+                parsed.orderCount = static_cast<int>(orders);
+                side.push_back(parsed);
+                return true;
+            }
+
+            // Bitfinex books are positional arrays on a numbered channel:
+            //   {"event":"subscribed","channel":"book","chanId":17082,"symbol":"tBTCUSD",..}
+            //   [17082,[[7254.7,3,3.3],[7254.6,2,-1]]]   snapshot
+            //   [17082,[7254.5,0,1]]                      update
+            //   [17082,"cs",-1234]                        signed CRC32 of the book so far
+            // Events and heartbeats carry no book and return false, so filter them upstream.
+            bool DecodeBitfinexOrderbook(std::string_view json, size_t maxLevels, NormalizedOrderbook& out)
+            {
+                thread_local std::unordered_map<uint64_t, std::string> channelSymbols;
+
+                out.currencyPair.clear();
+                out.orderbookId.clear();
+                out.bids.clear();
+                out.asks.clear();
+                out.isSnapshot = false;
+                out.sequence = 0;
+                out.firstSequence = 0;
+                out.hasChecksum = false;
+                out.checksumScheme = ChecksumScheme::None;
+
+                if (!json.empty() && json.front() == '{')
+                {
+                    if (JsonScan::Unquote(JsonScan::FindField(json, "event")) == "subscribed" &&
+                        JsonScan::Unquote(JsonScan::FindField(json, "channel")) == "book")
+                        channelSymbols[ParseUnsigned(JsonScan::FindField(json, "chanId"))].assign(
+                            JsonScan::Unescape(JsonScan::FindField(json, "symbol"), GetThreadArena()));
+                    return false;
+                }
+
+                JsonScan::ArrayReader message(json);
+                std::string_view channel;
+                std::string_view body;
+                if (!message.Next(channel) || !message.Next(body) || body.empty())
+                    return false;
+                const auto symbol = channelSymbols.find(ParseUnsigned(channel));
+                if (symbol == channelSymbols.end())
+                    return false;
+                out.currencyPair.assign(symbol->second);
+
+                if (body.front() == '"')
+                {
+                    std::string_view checksum;
+                    if (JsonScan::Unquote(body) != "cs" || !message.Next(checksum))
+                        return false; // Heartbeat
+                    out.hasChecksum = ParseChecksum(checksum, out.checksum);
+                    out.checksumScheme = ChecksumScheme::Bitfinex;
+                    return out.hasChecksum;
+                }
+
+                JsonScan::ArrayReader levels(body);
+                std::string_view level;
+                if (!levels.Next(level) || level.empty())
+                    return false;
+                if (level.front() != '[')
+                    return DecodeBitfinexLevel(body, 0, out);
+
+                out.isSnapshot = true;
+                do
+                {
+                    if (!DecodeBitfinexLevel(level, maxLevels, out))
+                        return false;
+                } while (levels.Next(level));
+                return true;
+            }
+
+            template<typename Schema>
+            constexpr ExchangeTradePreset MakeTradePreset()
+            {
+                return ExchangeTradePreset{Schema::Exchange, Schema::TradeId, Schema::Price, Schema::Quantity,
+                                           Schema::Side, Schema::Timestamp, Schema::Symbol, Schema::IsMaker,
+                                           &DecodeTrades<Schema>};
+            }
+
+            template<typename Schema>
+            constexpr ExchangeOrderbookPreset MakeOrderbookPreset()
+            {
+                return ExchangeOrderbookPreset{Schema::Exchange, Schema::Bids, Schema::Asks, Schema::Price,
+                                               Schema::Quantity, &DecodeOrderbook<Schema>};
+            }
+
+            constexpr std::array<ExchangeTradePreset, 3> TRADE_PRESETS = {
+                MakeTradePreset<BinanceTradeSchema>(),
+                MakeTradePreset<CoinbaseTradeSchema>(),
+                MakeTradePreset<KrakenTradeSchema>()
+            };
+
+            constexpr std::array<ExchangeOrderbookPreset, 4> ORDERBOOK_PRESETS = {
+                MakeOrderbookPreset<BinanceOrderbookSchema>(),
+                MakeOrderbookPreset<KrakenOrderbookSchema>(),
+                MakeOrderbookPreset<OkxOrderbookSchema>(),
+                ExchangeOrderbookPreset{"Bitfinex", "", "", "0", "2", &DecodeBitfinexOrderbook}
+            };
+
+            bool ParseDigits(const char*& p, const char* end, int count, int& out)
+            {
+                int value = 0;
+                for (int i = 0; i < count; i++, ++p)
+                {
+                    if (p == end || *p < '0' || *p > '9')
+                        return false;
+                    value = value * 10 + (*p - '0');
+                }
+                out = value;
+                return true;
+            }
+
+            // Days since 1970-01-01 for a proleptic Gregorian date
+            int64_t DaysFromCivil(int year, int month, int day)
+            {
+                year -= month <= 2 ? 1 : 0;
+                const int era = (year >= 0 ? year : year - 399) / 400;
+                const int yearOfEra = year - era * 400;
+                const int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+                const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+                return static_cast<int64_t>(era) * 146097 + dayOfEra - 719468;
+            }
+        }
+
+        const ExchangeTradePreset* FindTradePreset(std::string_view exchange)
+        {
+            for (const ExchangeTradePreset& preset : TRADE_PRESETS)
+            {
+                if (preset.exchange == exchange)
+                    return &preset;
+            }
+            return nullptr;
+        }
+
+        const ExchangeOrderbookPreset* FindOrderbookPreset(std::string_view exchange)
+        {
+            for (const ExchangeOrderbookPreset& preset : ORDERBOOK_PRESETS)
+            {
+                if (preset.exchange == exchange)
+                    return &preset;
+            }
+            return nullptr;
+        }
+
+        namespace JsonTime
+        {
+            bool ParseIso8601(std::string_view text, int64_t& ns)
+            {
+                const char* p = text.data();
+                const char* end = p + text.size();
+                int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+
+                if (!ParseDigits(p, end, 4, year) || p == end || *p++ != '-' ||
+                    !ParseDigits(p, end, 2, month) || p == end || *p++ != '-' ||
+                    !ParseDigits(p, end, 2, day) || p == end || (*p != 'T' && *p != ' '))
+                    return false;
+                ++p;
+                if (!ParseDigits(p, end, 2, hour) || p == end || *p++ != ':' ||
+                    !ParseDigits(p, end, 2, minute) || p == end || *p++ != ':' ||
+                    !ParseDigits(p, end, 2, second))
+                    return false;
+
+                int64_t fraction = 0;
+                int fractionDigits = 0;
+                if (p != end && *p == '.')
+                {
+                    for (++p; p != end && *p >= '0' && *p <= '9'; ++p)
+                    {
+                        if (fractionDigits < 9)
+                        {
+                            fraction = fraction * 10 + (*p - '0');
+                            fractionDigits++;
+                        }
+                    }
+                }
+                for (; fractionDigits < 9; fractionDigits++)
+                    fraction *= 10;
+
+                int64_t offsetSeconds = 0;
+                if (p != end && (*p == '+' || *p == '-'))
+                {
+                    const int sign = (*p++ == '-') ? -1 : 1;
+                    int offsetHours = 0, offsetMinutes = 0;
+                    if (!ParseDigits(p, end, 2, offsetHours))
+                        return false;
+                    if (p != end && *p == ':')
+                        ++p;
+                    ParseDigits(p, end, 2, offsetMinutes);
+                    offsetSeconds = sign * (offsetHours * 3600 + offsetMinutes * 60);
+                }
+
+                const int64_t seconds = DaysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second
+                                      - offsetSeconds;
+                ns = seconds * 1000000000LL + fraction;
+                return true;
+            }
+
+            bool ParseEpoch(std::string_view text, int64_t& ns)
+            {
+                if (text.empty())
+                    return false;
+
+                int64_t value = 0;
+                for (char c : text)
+                {
+                    if (c < '0' || c > '9')
+                        return false;
+                    value = value * 10 + (c - '0');
+                }
+
+                // Seconds until ~2286 are < 1e10; the other units follow by magnitude
+                if (value < 10000000000LL)
+                    ns = value * 1000000000LL;
+                else if (value < 10000000000000LL)
+                    ns = value * 1000000LL;
+                else if (value < 10000000000000000LL)
+                    ns = value * 1000LL;
+                else
+                    ns = value;
+                return true;
+            }
+        }
+    } // editor
+} // gui
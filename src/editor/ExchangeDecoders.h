@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Decimal.h"
+#include "TradeRecord.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace gui::editor
+{
+    struct NormalizedOrderbook;
+
+    // Decoders specialised at compile time for known exchange schemas. Field names are
+    // constexpr, so each decoder is one pass over the message with the key tests
+    // inlined. A preset is only used when the processor is configured for its exchange;
+    // field names alone never select a venue, since generic feeds share them.
+    // Appends every trade in the message to `out` (capacity is reused); returns the count
+    using TradeDecodeFn = size_t (*)(std::string_view json, DecimalScale scale, TradeStringTable& strings,
+                                     std::vector<TradeRecord>& out);
+    using OrderbookDecodeFn = bool (*)(std::string_view json, size_t maxLevels, NormalizedOrderbook& out);
+
+    struct ExchangeTradePreset
+    {
+        std::string_view exchange;
+        std::string_view tradeIdField;
+        std::string_view priceField;
+        std::string_view quantityField;
+        std::string_view sideField;      // Empty when the side is derived from isMakerField
+        std::string_view timestampField;
+        std::string_view currencyPairField;
+        std::string_view isMakerField;
+        TradeDecodeFn decode;
+    };
+
+    struct ExchangeOrderbookPreset
+    {
+        std::string_view exchange;
+        std::string_view bidsField;
+        std::string_view asksField;
+        std::string_view priceField;     // Array index or member name within a level
+        std::string_view quantityField;
+        OrderbookDecodeFn decode;
+    };
+
+    // Presets matching the exchanges in WebSocketConnectionNode::GetExchangeEndpoints();
+    // nullptr when the exchange has no preset for that message type
+    const ExchangeTradePreset* FindTradePreset(std::string_view exchange);
+    const ExchangeOrderbookPreset* FindOrderbookPreset(std::string_view exchange);
+
+    namespace JsonTime
+    {
+        // "2023-09-25T07:48:36.925533Z" -> ns since epoch
+        bool ParseIso8601(std::string_view text, int64_t& ns);
+
+        // Integer epoch in seconds, milliseconds, microseconds or nanoseconds (guessed from magnitude)
+        bool ParseEpoch(std::string_view text, int64_t& ns);
+    }
+}
@@ -0,0 +1,167 @@
+#include "FixExecutionReport.h"
+
+#include <cstring>
+#include <utility>
+
+namespace gui
+{
+    namespace editor
+    {
+        namespace
+        {
+            constexpr int MSG_TYPE_TAG = 35;
+
+            char FirstChar(std::string_view value)
+            {
+                return value.empty() ? '\0' : value[0];
+            }
+        }
+
+        FixExecutionReportDecoder::FixExecutionReportDecoder(const FixOrderTags& tags)
+            : m_table{}
+            , m_multiplier(1)
+            , m_shift(32)
+        {
+            Configure(tags);
+        }
+
+        void FixExecutionReportDecoder::Configure(const FixOrderTags& tags)
+        {
+            const std::pair<int, FixOrderField> mapping[] = {
+                {MSG_TYPE_TAG, FixOrderField::MsgType},
+                {tags.orderIdTag, FixOrderField::OrderId},
+                {tags.clientOrderIdTag, FixOrderField::ClientOrderId},
+                {tags.origClientOrderIdTag, FixOrderField::OrigClientOrderId},
+                {tags.orderStatusTag, FixOrderField::OrderStatus},
+                {tags.sideTag, FixOrderField::Side},
+                {tags.orderTypeTag, FixOrderField::OrderType},
+                {tags.orderQtyTag, FixOrderField::OrderQty},
+                {tags.priceTag, FixOrderField::Price},
+                {tags.lastQtyTag, FixOrderField::LastQty},
+                {tags.lastPxTag, FixOrderField::LastPx},
+                {tags.avgPxTag, FixOrderField::AvgPx},
+                {tags.cumQtyTag, FixOrderField::CumQty},
+                {tags.leavesQtyTag, FixOrderField::LeavesQty},
+                {tags.execTypeTag, FixOrderField::ExecType},
+                {tags.execIdTag, FixOrderField::ExecId},
+                {tags.symbolTag, FixOrderField::Symbol},
+                {tags.textTag, FixOrderField::Text},
+            };
+
+            // Disabled (<= 0) and repeated tags are dropped; the first mapping of a tag wins
+            std::array<Entry, static_cast<size_t>(FixOrderField::Count)> entries{};
+            size_t count = 0;
+            for (const auto& [tag, field] : mapping)
+            {
+                bool duplicate = tag <= 0;
+                for (size_t i = 0; i < count && !duplicate; i++)
+                    duplicate = entries[i].tag == tag;
+                if (!duplicate)
+                    entries[count++] = Entry{tag, field};
+            }
+
+            // Smallest table first; odd multipliers from a fixed sequence so the result is reproducible
+            for (unsigned bits = 5; bits <= MAX_TABLE_BITS; bits++)
+            {
+                uint32_t multiplier = 0x9E3779B1u;
+                for (int attempt = 0; attempt < 4096; attempt++)
+                {
+                    if (TryBuild(entries, count, multiplier | 1u, bits))
+                        return;
+                    multiplier = multiplier * 1664525u + 1013904223u;
+                }
+            }
+
+            // Eighteen distinct tags always fit long before this; better to decode nothing than misclassify
+            m_table.fill(Entry{-1, FixOrderField::None});
+            m_multiplier = 0;
+            m_shift = 31;
+        }
+
+        bool FixExecutionReportDecoder::TryBuild(const std::array<Entry, static_cast<size_t>(FixOrderField::Count)>& entries,
+                                                 size_t count, uint32_t multiplier, unsigned bits)
+        {
+            const unsigned shift = 32 - bits;
+            m_table.fill(Entry{-1, FixOrderField::None});
+            for (size_t i = 0; i < count; i++)
+            {
+                Entry& slot = m_table[static_cast<uint32_t>(entries[i].tag) * multiplier >> shift];
+                if (slot.tag != -1)
+                    return false;
+                slot = entries[i];
+            }
+            m_multiplier = multiplier;
+            m_shift = shift;
+            return true;
+        }
+
+        bool FixExecutionReportDecoder::Decode(std::string_view message, DecimalScale scale,
+                                               FixExecutionReport& out) const
+        {
+            out.Reset();
+
+            const char* p = message.data();
+            const char* end = p + message.size();
+
+            // Logged messages often use '|' instead of SOH; the first field tells which
+            char delimiter = '\x01';
+            for (const char* c = p; c != end; ++c)
+            {
+                if (*c == '\x01' || *c == '|')
+                {
+                    delimiter = *c;
+                    break;
+                }
+            }
+
+            bool ok = true;
+            while (p < end)
+            {
+                int tag = 0;
+                const char* tagStart = p;
+                while (p < end && static_cast<unsigned>(*p - '0') < 10)
+                    tag = tag * 10 + (*p++ - '0');
+                if (p == end || *p != '=' || p == tagStart)
+                    return false;
+
+                const char* value = ++p;
+                const char* stop = static_cast<const char*>(std::memchr(p, delimiter, static_cast<size_t>(end - p)));
+                if (!stop)
+                    stop = end;
+                const std::string_view field(value, static_cast<size_t>(stop - value));
+                p = stop + 1;
+
+                const FixOrderField kind = Classify(tag);
+                if (kind == FixOrderField::None)
+                    continue;
+                out.presentMask |= 1u << static_cast<unsigned>(kind);
+
+                switch (kind)
+                {
+                    case FixOrderField::MsgType:       out.msgType = FirstChar(field); break;
+                    case FixOrderField::OrderId:       out.orderId = field; break;
+                    case FixOrderField::ClientOrderId: out.clientOrderId = field; break;
+                    case FixOrderField::OrigClientOrderId: out.origClientOrderId = field; break;
+                    case FixOrderField::OrderStatus:   out.orderStatus = FirstChar(field); break;
+                    case FixOrderField::Side:          out.side = FirstChar(field); break;
+                    case FixOrderField::OrderType:     out.orderType = FirstChar(field); break;
+                    case FixOrderField::ExecType:      out.execType = FirstChar(field); break;
+                    case FixOrderField::ExecId:        out.execId = field; break;
+                    case FixOrderField::Symbol:        out.symbol = field; break;
+                    case FixOrderField::Text:          out.text = field; break;
+                    case FixOrderField::OrderQty:      ok &= Decimal::Parse(field, scale.quantity, out.orderQty); break;
+                    case FixOrderField::Price:         ok &= Decimal::Parse(field, scale.price, out.price); break;
+                    case FixOrderField::LastQty:       ok &= Decimal::Parse(field, scale.quantity, out.lastQty); break;
+                    case FixOrderField::LastPx:        ok &= Decimal::Parse(field, scale.price, out.lastPx); break;
+                    case FixOrderField::AvgPx:         ok &= Decimal::Parse(field, scale.price, out.avgPx); break;
+                    case FixOrderField::CumQty:        ok &= Decimal::Parse(field, scale.quantity, out.cumQty); break;
+                    case FixOrderField::LeavesQty:     ok &= Decimal::Parse(field, scale.quantity, out.leavesQty); break;
+                    case FixOrderField::None:
+                    case FixOrderField::Count:
+                        break;
+                }
+            }
+            return ok;
+        }
+    } // editor
+} // gui
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "Decimal.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace gui::editor
+{
+    // Tags read from ExecutionReport (8) and OrderCancelReject (9) messages
+    struct FixOrderTags
+    {
+        int orderIdTag;         // 37
+        int clientOrderIdTag;   // 11
+        int origClientOrderIdTag; // 41, the ClOrdID a cancel/replace refers to
+        int orderStatusTag;     // 39
+        int sideTag;            // 54
+        int orderTypeTag;       // 40
+        int orderQtyTag;        // 38
+        int priceTag;           // 44
+        int lastQtyTag;         // 32
+        int lastPxTag;          // 31
+        int avgPxTag;           // 6
+        int cumQtyTag;          // 14
+        int leavesQtyTag;       // 151
+        int execTypeTag;        // 150
+        int execIdTag;          // 17
+        int symbolTag;          // 55
+        int textTag;            // 58
+
+        FixOrderTags() : orderIdTag(37), clientOrderIdTag(11), origClientOrderIdTag(41), orderStatusTag(39),
+                       sideTag(54), orderTypeTag(40), orderQtyTag(38), priceTag(44),
+                       lastQtyTag(32), lastPxTag(31), avgPxTag(6), cumQtyTag(14), leavesQtyTag(151),
+                       execTypeTag(150), execIdTag(17), symbolTag(55), textTag(58) {}
+    };
+
+    enum class FixOrderField : uint8_t
+    {
+        None,
+        MsgType,
+        OrderId,
+        ClientOrderId,
+        OrigClientOrderId,
+        OrderStatus,
+        Side,
+        OrderType,
+        OrderQty,
+        Price,
+        LastQty,
+        LastPx,
+        AvgPx,
+        CumQty,
+        LeavesQty,
+        ExecType,
+        ExecId,
+        Symbol,
+        Text,
+        Count
+    };
+
+    // One decoded report. Text fields are views into the message; numbers are parsed
+    // at the scale given to the decoder. Absent fields are left at zero/empty.
+    struct FixExecutionReport
+    {
+        std::string_view orderId;
+        std::string_view clientOrderId;
+        std::string_view origClientOrderId;
+        std::string_view execId;
+        std::string_view symbol;
+        std::string_view text;
+        Decimal orderQty;
+        Decimal price;
+        Decimal lastQty;
+        Decimal lastPx;
+        Decimal avgPx;
+        Decimal cumQty;
+        Decimal leavesQty;
+        uint32_t presentMask; // Bit per FixOrderField
+        char msgType;         // '8' ExecutionReport, '9' OrderCancelReject
+        char orderStatus;     // OrdStatus (39)
+        char execType;        // ExecType (150)
+        char side;            // Side (54)
+        char orderType;       // OrdType (40)
+
+        FixExecutionReport() : presentMask(0), msgType(0), orderStatus(0), execType(0), side(0), orderType(0) {}
+
+        void Reset() { *this = FixExecutionReport(); }
+        bool Has(FixOrderField field) const { return (presentMask >> static_cast<unsigned>(field)) & 1u; }
+    };
+
+    // Single-pass decoder. The configured tags are placed in a small perfect-hash
+    // table (tag * multiplier >> shift, multiplier searched once at configuration),
+    // so each field of the message costs one multiply and one compare to classify;
+    // fields are decoded as they are met, left to right, without tokenising first.
+    class FixExecutionReportDecoder
+    {
+    public:
+        explicit FixExecutionReportDecoder(const FixOrderTags& tags = FixOrderTags());
+
+        void Configure(const FixOrderTags& tags);
+
+        // False on a malformed message or an unparsable number; out holds what was decoded
+        bool Decode(std::string_view message, DecimalScale scale, FixExecutionReport& out) const;
+
+        FixOrderField Classify(int tag) const
+        {
+            const Entry& entry = m_table[static_cast<uint32_t>(tag) * m_multiplier >> m_shift];
+            return entry.tag == tag ? entry.field : FixOrderField::None;
+        }
+
+    private:
+        static constexpr size_t MAX_TABLE_BITS = 10;
+
+        struct Entry
+        {
+            int tag;
+            FixOrderField field;
+        };
+
+        bool TryBuild(const std::array<Entry, static_cast<size_t>(FixOrderField::Count)>& entries,
+                      size_t count, uint32_t multiplier, unsigned bits);
+
+        std::array<Entry, size_t(1) << MAX_TABLE_BITS> m_table;
+        uint32_t m_multiplier;
+        unsigned m_shift;
+    };
+}
@@ -0,0 +1,317 @@
+#include "FixMessageView.h"
+#include "MessageProcessors.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace gui
+{
+    namespace editor
+    {
+        namespace
+        {
+            bool ParseInt(std::string_view text, int& out)
+            {
+                if (text.empty())
+                    return false;
+
+                int value = 0;
+                for (char c : text)
+                {
+                    if (c < '0' || c > '9')
+                        return false;
+                    value = value * 10 + (c - '0');
+                }
+                out = value;
+                return true;
+            }
+
+            template<typename Compare>
+            void UpsertLevel(std::vector<NormalizedOrderbookLevel>& levels, Decimal price, Decimal size,
+                             bool remove, Compare compare)
+            {
+                auto it = std::lower_bound(levels.begin(), levels.end(), price,
+                                           [&](const NormalizedOrderbookLevel& level, Decimal value) {
+                                               return compare(level.price, value);
+                                           });
+                const bool found = (it != levels.end() && it->price == price);
+
+                if (remove || size.IsZero())
+                {
+                    if (found)
+                        levels.erase(it);
+                    return;
+                }
+
+                if (found)
+                {
+                    it->quantity = size;
+                    return;
+                }
+
+                NormalizedOrderbookLevel level;
+                level.price = price;
+                level.quantity = size;
+                levels.insert(it, level);
+            }
+        }
+
+        bool FixMessageView::Tokenize(std::string_view message, char delimiter)
+        {
+            m_fields.clear();
+
+            // Logged messages often use '|' instead of SOH
+            if (delimiter == '\x01' && message.find('\x01') == std::string_view::npos)
+                delimiter = '|';
+
+            size_t pos = 0;
+            while (pos < message.size())
+            {
+                const size_t equals = message.find('=', pos);
+                if (equals == std::string_view::npos)
+                    break;
+
+                size_t next = message.find(delimiter, equals + 1);
+                if (next == std::string_view::npos)
+                    next = message.size();
+
+                int tag = 0;
+                if (!ParseInt(message.substr(pos, equals - pos), tag))
+                    return false;
+
+                m_fields.push_back({tag, message.substr(equals + 1, next - equals - 1)});
+                pos = next + 1;
+            }
+
+            return !m_fields.empty();
+        }
+
+        std::string_view FixMessageView::GetField(int tag) const
+        {
+            const int index = FindFieldIndex(tag);
+            return index >= 0 ? m_fields[static_cast<size_t>(index)].value : std::string_view();
+        }
+
+        int FixMessageView::FindFieldIndex(int tag, size_t startIndex) const
+        {
+            for (size_t i = startIndex; i < m_fields.size(); i++)
+            {
+                if (m_fields[i].tag == tag)
+                    return static_cast<int>(i);
+            }
+            return -1;
+        }
+
+        FixGroupDefinition::FixGroupDefinition(int count, int delimiter, std::initializer_list<int> members)
+            : countTag(count), delimiterTag(delimiter), memberTags{}, memberCount(0)
+        {
+            for (int tag : members)
+            {
+                if (memberCount < MAX_MEMBER_TAGS)
+                    memberTags[static_cast<size_t>(memberCount++)] = tag;
+            }
+        }
+
+        bool FixGroupDefinition::IsMember(int tag) const
+        {
+            if (tag == delimiterTag)
+                return true;
+            for (int i = 0; i < memberCount; i++)
+            {
+                if (memberTags[static_cast<size_t>(i)] == tag)
+                    return true;
+            }
+            // Without a member list every tag up to the trailer belongs to the group
+            return memberCount == 0 && tag != 10;
+        }
+
+        std::string_view FixGroupEntry::GetField(int tag) const
+        {
+            for (const FixField* field = m_begin; field != m_end; ++field)
+            {
+                if (field->tag == tag)
+                    return field->value;
+            }
+            return {};
+        }
+
+        FixGroupIterator::FixGroupIterator(const FixField* begin, const FixField* end, const FixGroupDefinition& group)
+            : m_group(group), m_cursor(end), m_end(end), m_declaredCount(0), m_visited(0)
+        {
+            for (const FixField* field = begin; field != end; ++field)
+            {
+                if (field->tag == group.countTag)
+                {
+                    ParseInt(field->value, m_declaredCount);
+                    m_cursor = field + 1;
+                    break;
+                }
+            }
+        }
+
+        FixGroupIterator::FixGroupIterator(const FixMessageView& message, const FixGroupDefinition& group)
+            : FixGroupIterator(message.GetFields().data(), message.GetFields().data() + message.GetFieldCount(), group)
+        {
+        }
+
+        FixGroupIterator::FixGroupIterator(const FixGroupEntry& parent, const FixGroupDefinition& group)
+            : FixGroupIterator(parent.begin(), parent.end(), group)
+        {
+        }
+
+        bool FixGroupIterator::Next(FixGroupEntry& entry)
+        {
+            if (m_visited >= m_declaredCount || m_cursor == m_end || m_cursor->tag != m_group.delimiterTag)
+                return false;
+
+            const FixField* begin = m_cursor;
+            const FixField* field = m_cursor + 1;
+
+            // An entry runs until the next delimiter tag, so tags missing from the member list
+            // (venue extensions, nested groups) stay in their entry. Nothing delimits the last
+            // entry, which ends at the first tag outside the group or at the trailer. Nested
+            // entries can be walked with a FixGroupIterator over the parent entry.
+            const bool last = (m_visited + 1 >= m_declaredCount);
+            for (; field != m_end; ++field)
+            {
+                if (field->tag == m_group.delimiterTag || field->tag == 10)
+                    break;
+                if (last && !m_group.IsMember(field->tag))
+                    break;
+            }
+
+            entry = FixGroupEntry(begin, field);
+            m_cursor = field;
+            m_visited++;
+            return true;
+        }
+
+        FixGroupDefinition FixMarketDataTags::MakeGroupDefinition() const
+        {
+            return FixGroupDefinition(noMdEntriesTag, mdUpdateActionTag, {
+                mdUpdateActionTag, mdEntryTypeTag, mdEntryPxTag, mdEntrySizeTag, mdEntryPositionNoTag, symbolTag,
+                48, 22,          // SecurityID, SecurityIDSource
+                272, 273,        // MDEntryDate, MDEntryTime
+                346, 1023,       // NumberOfOrders, MDPriceLevel
+                278, 280, 336,   // MDEntryID, MDEntryRefID, TradingSessionID
+                15, 83           // Currency, RptSeq
+            });
+        }
+
+        bool FixMarketDataApplier::DecodeEntry(const FixGroupEntry& entry, const FixMarketDataTags& tags,
+                                               DecimalScale scale, FixMarketDataEntry& out)
+        {
+            out.entryType = 0;
+            out.updateAction = '0';
+            out.positionNo = 0;
+            out.symbol = {};
+            out.price = Decimal();
+            out.size = Decimal();
+
+            // Single pass over the entry's fields
+            for (const FixField& field : entry)
+            {
+                if (field.tag == tags.mdEntryTypeTag)
+                    out.entryType = field.value.empty() ? 0 : field.value[0];
+                else if (field.tag == tags.mdUpdateActionTag)
+                    out.updateAction = field.value.empty() ? '0' : field.value[0];
+                else if (field.tag == tags.mdEntryPxTag)
+                {
+                    if (!Decimal::Parse(field.value, scale.price, out.price))
+                        return false;
+                }
+                else if (field.tag == tags.mdEntrySizeTag)
+                {
+                    if (!Decimal::Parse(field.value, scale.quantity, out.size))
+                        return false;
+                }
+                else if (field.tag == tags.mdEntryPositionNoTag)
+                    ParseInt(field.value, out.positionNo);
+                else if (field.tag == tags.symbolTag)
+                    out.symbol = field.value;
+            }
+
+            return out.entryType != 0;
+        }
+
+        void FixMarketDataApplier::ApplyEntry(const FixMarketDataEntry& entry, NormalizedOrderbook& orderbook)
+        {
+            const bool remove = (entry.updateAction == '2');
+            if (entry.entryType == '0')
+                UpsertLevel(orderbook.bids, entry.price, entry.size, remove, std::greater<Decimal>());
+            else if (entry.entryType == '1')
+                UpsertLevel(orderbook.asks, entry.price, entry.size, remove, std::less<Decimal>());
+        }
+
+        int FixMarketDataApplier::Apply(const FixMessageView& message, const FixMarketDataTags& tags,
+                                        const FixGroupDefinition& group, NormalizedOrderbook& orderbook)
+        {
+            const std::string_view msgType = message.GetMsgType();
+            const bool isSnapshot = (msgType == "W");
+            if (!isSnapshot && msgType != "X")
+                return 0;
+
+            // Snapshot entries start with MDEntryType and incremental ones with MDUpdateAction,
+            // though some venues lead incremental entries with MDEntryType too
+            FixGroupDefinition entryGroup = group;
+            entryGroup.delimiterTag = isSnapshot ? tags.mdEntryTypeTag : tags.mdUpdateActionTag;
+            const int countIndex = message.FindFieldIndex(tags.noMdEntriesTag);
+            if (!isSnapshot && countIndex >= 0 && static_cast<size_t>(countIndex) + 1 < message.GetFieldCount() &&
+                message.GetFields()[static_cast<size_t>(countIndex) + 1].tag == tags.mdEntryTypeTag)
+                entryGroup.delimiterTag = tags.mdEntryTypeTag;
+
+            if (isSnapshot)
+            {
+                orderbook.bids.clear(); // Capacity is kept
+                orderbook.asks.clear();
+            }
+            orderbook.isSnapshot = isSnapshot;
+
+            const std::string_view bookSymbol = orderbook.currencyPair;
+            FixGroupIterator entries(message, entryGroup);
+            FixGroupEntry entry(nullptr, nullptr);
+            FixMarketDataEntry decoded{};
+            int applied = 0;
+
+            while (entries.Next(entry))
+            {
+                if (!DecodeEntry(entry, tags, orderbook.scale, decoded))
+                    continue;
+                if (!decoded.symbol.empty() && !bookSymbol.empty() && decoded.symbol != bookSymbol)
+                    continue;
+                // Trades, index values, opening prices etc. share the group but not the book
+                if (decoded.entryType != '0' && decoded.entryType != '1')
+                    continue;
+
+                if (isSnapshot)
+                {
+                    NormalizedOrderbookLevel level;
+                    level.price = decoded.price;
+                    level.quantity = decoded.size;
+                    if (decoded.entryType == '0')
+                        orderbook.bids.push_back(level);
+                    else
+                        orderbook.asks.push_back(level);
+                }
+                else
+                {
+                    ApplyEntry(decoded, orderbook);
+                }
+                applied++;
+            }
+
+            if (isSnapshot)
+            {
+                auto bidOrder = [](const NormalizedOrderbookLevel& a, const NormalizedOrderbookLevel& b) { return a.price > b.price; };
+                auto askOrder = [](const NormalizedOrderbookLevel& a, const NormalizedOrderbookLevel& b) { return a.price < b.price; };
+                if (!std::is_sorted(orderbook.bids.begin(), orderbook.bids.end(), bidOrder))
+                    std::sort(orderbook.bids.begin(), orderbook.bids.end(), bidOrder);
+                if (!std::is_sorted(orderbook.asks.begin(), orderbook.asks.end(), askOrder))
+                    std::sort(orderbook.asks.begin(), orderbook.asks.end(), askOrder);
+            }
+
+            orderbook.totalLevels = static_cast<int>(orderbook.bids.size() + orderbook.asks.size());
+            return applied;
+        }
+    } // editor
+} // gui
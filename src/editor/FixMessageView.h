@@ -0,0 +1,139 @@
+#pragma once
+
+#include "Decimal.h"
+#include "OrderbookLevel.h"
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <string_view>
+#include <vector>
+
+namespace gui::editor
+{
+    struct NormalizedOrderbook;
+
+    struct FixField
+    {
+        int tag;
+        std::string_view value;
+    };
+
+    // Tokenised view over a raw FIX message. Fields point into the original buffer,
+    // and the field vector is reused between messages so tokenising does not allocate
+    // once it has grown to the largest message seen.
+    class FixMessageView
+    {
+    public:
+        FixMessageView() = default;
+
+        bool Tokenize(std::string_view message, char delimiter = '\x01');
+
+        const std::vector<FixField>& GetFields() const { return m_fields; }
+        size_t GetFieldCount() const { return m_fields.size(); }
+
+        // First occurrence of a tag in the header/body (before any repeating group scan)
+        std::string_view GetField(int tag) const;
+        int FindFieldIndex(int tag, size_t startIndex = 0) const; // -1 when missing
+        std::string_view GetMsgType() const { return GetField(35); }
+
+    private:
+        std::vector<FixField> m_fields;
+    };
+
+    // Repeating group layout: NoXXX count tag, the delimiter (first) tag of every entry,
+    // and the tags that may appear inside an entry, including nested group tags. Entries
+    // end at the next delimiter; the member list only bounds the last entry.
+    struct FixGroupDefinition
+    {
+        static constexpr int MAX_MEMBER_TAGS = 24;
+
+        int countTag;
+        int delimiterTag;
+        std::array<int, MAX_MEMBER_TAGS> memberTags;
+        int memberCount;
+
+        FixGroupDefinition() : countTag(0), delimiterTag(0), memberTags{}, memberCount(0) {}
+        FixGroupDefinition(int count, int delimiter, std::initializer_list<int> members);
+
+        bool IsMember(int tag) const;
+    };
+
+    // One entry of a repeating group: a contiguous span of fields
+    class FixGroupEntry
+    {
+    public:
+        FixGroupEntry(const FixField* begin, const FixField* end) : m_begin(begin), m_end(end) {}
+
+        std::string_view GetField(int tag) const;
+        const FixField* begin() const { return m_begin; }
+        const FixField* end() const { return m_end; }
+
+    private:
+        const FixField* m_begin;
+        const FixField* m_end;
+    };
+
+    // Forward iterator over the entries of one repeating group. Works on a whole
+    // message or, for nested groups, on the span of a parent entry. Never allocates.
+    class FixGroupIterator
+    {
+    public:
+        FixGroupIterator(const FixField* begin, const FixField* end, const FixGroupDefinition& group);
+        FixGroupIterator(const FixMessageView& message, const FixGroupDefinition& group);
+        FixGroupIterator(const FixGroupEntry& parent, const FixGroupDefinition& group);
+
+        bool Next(FixGroupEntry& entry);
+        int GetDeclaredCount() const { return m_declaredCount; }
+        int GetVisitedCount() const { return m_visited; }
+
+    private:
+        const FixGroupDefinition& m_group;
+        const FixField* m_cursor;
+        const FixField* m_end;
+        int m_declaredCount;
+        int m_visited;
+    };
+
+    // Market data entries (NoMDEntries 268) for W full refresh and X incremental refresh
+    struct FixMarketDataTags
+    {
+        int noMdEntriesTag;       // 268
+        int mdUpdateActionTag;    // 279 (X only: 0=New, 1=Change, 2=Delete)
+        int mdEntryTypeTag;       // 269 (0=Bid, 1=Offer)
+        int mdEntryPxTag;         // 270
+        int mdEntrySizeTag;       // 271
+        int mdEntryPositionNoTag; // 290
+        int symbolTag;            // 55 (per entry in X)
+
+        FixMarketDataTags()
+            : noMdEntriesTag(268), mdUpdateActionTag(279), mdEntryTypeTag(269), mdEntryPxTag(270)
+            , mdEntrySizeTag(271), mdEntryPositionNoTag(290), symbolTag(55) {}
+
+        FixGroupDefinition MakeGroupDefinition() const;
+    };
+
+    struct FixMarketDataEntry
+    {
+        char entryType;     // '0' bid, '1' offer, others ignored for books
+        char updateAction;  // '0' new, '1' change, '2' delete
+        Decimal price;
+        Decimal size;
+        int positionNo;     // 0 when absent
+        std::string_view symbol;
+    };
+
+    class FixMarketDataApplier
+    {
+    public:
+        // Applies a W (full refresh) or X (incremental) message to the book in place.
+        // Entries for other symbols are skipped. Returns the number of entries applied.
+        static int Apply(const FixMessageView& message, const FixMarketDataTags& tags,
+                         const FixGroupDefinition& group, NormalizedOrderbook& orderbook);
+
+        static bool DecodeEntry(const FixGroupEntry& entry, const FixMarketDataTags& tags,
+                                DecimalScale scale, FixMarketDataEntry& out);
+
+        static void ApplyEntry(const FixMarketDataEntry& entry, NormalizedOrderbook& orderbook);
+    };
+}
@@ -0,0 +1,132 @@
+#include "FlatHashIndex.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace gui
+{
+    namespace editor
+    {
+        FlatHashIndex::FlatHashIndex(size_t initialCapacity)
+            : m_mask(0)
+            , m_size(0)
+        {
+            m_slots.assign(std::bit_ceil(std::max<size_t>(initialCapacity, 8)), Slot{0, NOT_FOUND});
+            m_mask = m_slots.size() - 1;
+        }
+
+        uint32_t FlatHashIndex::Find(uint64_t key) const
+        {
+            for (size_t i = Home(key);; i = (i + 1) & m_mask)
+            {
+                const Slot& slot = m_slots[i];
+                if (slot.value == NOT_FOUND)
+                    return NOT_FOUND;
+                if (slot.key == key)
+                    return slot.value;
+            }
+        }
+
+        bool FlatHashIndex::Insert(uint64_t key, uint32_t value)
+        {
+            // Keep the load factor under 1/2 so probe runs stay short
+            if ((m_size + 1) * 2 > m_slots.size())
+                Grow(m_slots.size() * 2);
+
+            for (size_t i = Home(key);; i = (i + 1) & m_mask)
+            {
+                Slot& slot = m_slots[i];
+                if (slot.value == NOT_FOUND)
+                {
+                    slot = Slot{key, value};
+                    m_size++;
+                    return true;
+                }
+                if (slot.key == key)
+                    return false;
+            }
+        }
+
+        void FlatHashIndex::Assign(uint64_t key, uint32_t value)
+        {
+            if ((m_size + 1) * 2 > m_slots.size())
+                Grow(m_slots.size() * 2);
+
+            for (size_t i = Home(key);; i = (i + 1) & m_mask)
+            {
+                Slot& slot = m_slots[i];
+                if (slot.value == NOT_FOUND)
+                {
+                    slot = Slot{key, value};
+                    m_size++;
+                    return;
+                }
+                if (slot.key == key)
+                {
+                    slot.value = value;
+                    return;
+                }
+            }
+        }
+
+        bool FlatHashIndex::Erase(uint64_t key)
+        {
+            size_t hole = Home(key);
+            for (;; hole = (hole + 1) & m_mask)
+            {
+                if (m_slots[hole].value == NOT_FOUND)
+                    return false;
+                if (m_slots[hole].key == key)
+                    break;
+            }
+
+            // Pull later members of the probe run back into the hole
+            for (size_t next = (hole + 1) & m_mask; m_slots[next].value != NOT_FOUND; next = (next + 1) & m_mask)
+            {
+                const size_t home = Home(m_slots[next].key);
+                const bool movable = (next > hole) ? (home <= hole || home > next)
+                                                   : (home <= hole && home > next);
+                if (movable)
+                {
+                    m_slots[hole] = m_slots[next];
+                    hole = next;
+                }
+            }
+
+            m_slots[hole].value = NOT_FOUND;
+            m_size--;
+            return true;
+        }
+
+        void FlatHashIndex::Clear()
+        {
+            std::fill(m_slots.begin(), m_slots.end(), Slot{0, NOT_FOUND});
+            m_size = 0;
+        }
+
+        void FlatHashIndex::Reserve(size_t count)
+        {
+            if (count * 2 > m_slots.size())
+                Grow(std::bit_ceil(count * 2));
+        }
+
+        void FlatHashIndex::Grow(size_t capacity)
+        {
+            std::vector<Slot> old(capacity, Slot{0, NOT_FOUND});
+            old.swap(m_slots);
+            m_mask = m_slots.size() - 1;
+            m_size = 0;
+
+            for (const Slot& slot : old)
+            {
+                if (slot.value == NOT_FOUND)
+                    continue;
+                size_t i = Home(slot.key);
+                while (m_slots[i].value != NOT_FOUND)
+                    i = (i + 1) & m_mask;
+                m_slots[i] = slot;
+                m_size++;
+            }
+        }
+    } // editor
+} // gui
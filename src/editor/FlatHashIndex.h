@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gui::editor
+{
+    // Open-addressing uint64 -> uint32 index with linear probing and backward-shift
+    // deletion (no tombstones). Values are typically slots in a pool vector.
+    class FlatHashIndex
+    {
+    public:
+        static constexpr uint32_t NOT_FOUND = 0xFFFFFFFFu;
+
+        explicit FlatHashIndex(size_t initialCapacity = 64);
+
+        uint32_t Find(uint64_t key) const;
+        bool Insert(uint64_t key, uint32_t value); // false if the key already exists
+        void Assign(uint64_t key, uint32_t value); // Insert or overwrite
+        bool Erase(uint64_t key);
+        void Clear();
+
+        size_t Size() const { return m_size; }
+        size_t Capacity() const { return m_slots.size(); }
+        void Reserve(size_t count);
+
+        static uint64_t Hash(uint64_t key)
+        {
+            // splitmix64 finaliser; sequential IDs spread across the table
+            key ^= key >> 30;
+            key *= 0xBF58476D1CE4E5B9ull;
+            key ^= key >> 27;
+            key *= 0x94D049BB133111EBull;
+            return key ^ (key >> 31);
+        }
+
+    private:
+        struct Slot
+        {
+            uint64_t key;
+            uint32_t value; // NOT_FOUND marks an empty slot
+        };
+
+        size_t Home(uint64_t key) const { return static_cast<size_t>(Hash(key)) & m_mask; }
+        void Grow(size_t capacity);
+
+        std::vector<Slot> m_slots;
+        size_t m_mask;
+        size_t m_size;
+    };
+}
@@ -0,0 +1,331 @@
+#include "InstrumentCache.h"
+#include "InstrumentRegistry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace gui
+{
+    namespace editor
+    {
+        namespace
+        {
+            constexpr char CACHE_MAGIC[8] = {'I', 'N', 'S', 'T', 'C', 'A', 'C', 'H'};
+
+            struct InstrumentCacheHeader
+            {
+                char magic[8];
+                uint32_t version;
+                uint32_t recordSize;   // Catches layout changes that forgot to bump the version
+                uint64_t exchangeHash;
+                uint64_t count;
+                uint64_t stringBytes;
+                int64_t savedTimeNs;
+                uint64_t checksum;     // Of records and strings
+            };
+
+            uint64_t HashBytes(const void* data, size_t size, uint64_t hash = 0xCBF29CE484222325ull)
+            {
+                // Eight bytes per step; guards against torn or truncated files, not tampering
+                const auto* p = static_cast<const uint8_t*>(data);
+                while (size >= 8)
+                {
+                    uint64_t chunk;
+                    std::memcpy(&chunk, p, 8);
+                    hash = (hash ^ chunk) * 0x100000001B3ull;
+                    hash ^= hash >> 32;
+                    p += 8;
+                    size -= 8;
+                }
+                while (size-- > 0)
+                    hash = (hash ^ *p++) * 0x100000001B3ull;
+                return hash;
+            }
+
+            int64_t ToNanoseconds(std::chrono::system_clock::time_point time)
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+            }
+        }
+
+        struct InstrumentCache::Record
+        {
+            uint32_t symbolOffset;
+            uint32_t symbolLength;
+            uint32_t baseOffset;
+            uint32_t baseLength;
+            uint32_t quoteOffset;
+            uint32_t quoteLength;
+            uint32_t statusOffset;
+            uint32_t statusLength;
+            double minOrderSize;
+            double maxOrderSize;
+            double tickSize;
+            double lotSize;
+            int64_t updateTimeNs;
+            int32_t pricePrecision;
+            int32_t quantityPrecision;
+            uint8_t tradingEnabled;
+            uint8_t reserved[7];
+        };
+
+        static_assert(std::is_trivially_copyable_v<InstrumentCacheHeader>);
+        static_assert(sizeof(InstrumentCacheHeader) % alignof(double) == 0, "Records must start aligned in the mapping");
+
+        InstrumentCache::InstrumentCache(std::string directory)
+            : m_directory(std::move(directory))
+            , m_count(0)
+            , m_savedTimeNs(0)
+            , m_strings(nullptr)
+            , m_stringBytes(0)
+            , m_hasPending(false)
+            , m_writing(false)
+            , m_stop(false)
+            , m_lastSaveFailed(false)
+        {
+        }
+
+        InstrumentCache::~InstrumentCache()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            if (m_writer.joinable())
+                m_writer.join();
+            Close();
+        }
+
+        std::string InstrumentCache::GetPath(std::string_view exchange) const
+        {
+            std::string name = "instruments-";
+            for (char c : exchange)
+            {
+                const bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                                  c == '-' || c == '_';
+                name.push_back(safe ? c : '_');
+            }
+            name += ".bin";
+            return (std::filesystem::path(m_directory) / name).string();
+        }
+
+        bool InstrumentCache::Open(std::string_view exchange)
+        {
+            Close();
+            if (!m_file.Open(GetPath(exchange)))
+                return false;
+
+            const uint8_t* data = m_file.GetData();
+            const size_t size = m_file.GetSize();
+            InstrumentCacheHeader header;
+            if (size < sizeof(header))
+            {
+                Close();
+                return false;
+            }
+            std::memcpy(&header, data, sizeof(header));
+
+            const size_t body = size - sizeof(header);
+            const bool valid = std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 &&
+                               header.version == FORMAT_VERSION &&
+                               header.recordSize == sizeof(Record) &&
+                               header.exchangeHash == HashBytes(exchange.data(), exchange.size()) &&
+                               header.count <= body / sizeof(Record) &&
+                               header.stringBytes == body - header.count * sizeof(Record) &&
+                               header.stringBytes <= UINT32_MAX &&
+                               header.checksum == HashBytes(data + sizeof(header), body);
+            if (!valid)
+            {
+                Close();
+                return false;
+            }
+
+            m_exchange.assign(exchange);
+            m_count = static_cast<size_t>(header.count);
+            m_savedTimeNs = header.savedTimeNs;
+            m_strings = reinterpret_cast<const char*>(data + sizeof(header) + m_count * sizeof(Record));
+            m_stringBytes = static_cast<uint32_t>(header.stringBytes);
+            return true;
+        }
+
+        void InstrumentCache::Close()
+        {
+            m_file.Close();
+            m_exchange.clear();
+            m_count = 0;
+            m_savedTimeNs = 0;
+            m_strings = nullptr;
+            m_stringBytes = 0;
+        }
+
+        bool InstrumentCache::Find(std::string_view symbol, InstrumentData& out) const
+        {
+            const Record* begin = GetRecords();
+            const Record* end = begin + m_count;
+            const Record* found = std::lower_bound(begin, end, symbol, [this](const Record& record, std::string_view key) {
+                return GetString(record.symbolOffset, record.symbolLength) < key;
+            });
+            if (found == end || GetString(found->symbolOffset, found->symbolLength) != symbol)
+                return false;
+            ToInstrument(*found, m_exchange, out);
+            return true;
+        }
+
+        size_t InstrumentCache::CopyTo(std::unordered_map<std::string, InstrumentData>& out) const
+        {
+            const Record* records = GetRecords();
+            out.reserve(out.size() + m_count);
+            for (size_t i = 0; i < m_count; i++)
+            {
+                InstrumentData instrument;
+                ToInstrument(records[i], m_exchange, instrument);
+                std::string symbol = instrument.symbol;
+                out.insert_or_assign(std::move(symbol), std::move(instrument));
+            }
+            return m_count;
+        }
+
+        void InstrumentCache::SaveAsync(std::string_view exchange,
+                                        const std::unordered_map<std::string, InstrumentData>& instruments)
+        {
+            std::vector<const std::pair<const std::string, InstrumentData>*> sorted;
+            sorted.reserve(instruments.size());
+            for (const auto& entry : instruments)
+                sorted.push_back(&entry);
+            std::sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+
+            std::vector<Record> records(sorted.size());
+            std::string strings;
+            auto addString = [&strings](const std::string& text, uint32_t& offset, uint32_t& length) {
+                offset = static_cast<uint32_t>(strings.size());
+                length = static_cast<uint32_t>(text.size());
+                strings += text;
+            };
+            for (size_t i = 0; i < sorted.size(); i++)
+            {
+                const InstrumentData& instrument = sorted[i]->second;
+                Record& record = records[i];
+                std::memset(&record, 0, sizeof(record));
+                addString(sorted[i]->first, record.symbolOffset, record.symbolLength);
+                addString(instrument.baseAsset, record.baseOffset, record.baseLength);
+                addString(instrument.quoteAsset, record.quoteOffset, record.quoteLength);
+                addString(instrument.tradingStatus, record.statusOffset, record.statusLength);
+                record.minOrderSize = instrument.minOrderSize;
+                record.maxOrderSize = instrument.maxOrderSize;
+                record.tickSize = instrument.tickSize;
+                record.lotSize = instrument.lotSize;
+                record.updateTimeNs = ToNanoseconds(instrument.updateTime);
+                record.pricePrecision = instrument.pricePrecision;
+                record.quantityPrecision = instrument.quantityPrecision;
+                record.tradingEnabled = instrument.tradingEnabled ? 1 : 0;
+            }
+
+            InstrumentCacheHeader header;
+            std::memset(&header, 0, sizeof(header));
+            std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+            header.version = FORMAT_VERSION;
+            header.recordSize = sizeof(Record);
+            header.exchangeHash = HashBytes(exchange.data(), exchange.size());
+            header.count = records.size();
+            header.stringBytes = strings.size();
+            header.savedTimeNs = ToNanoseconds(std::chrono::system_clock::now());
+
+            std::string image(sizeof(header) + records.size() * sizeof(Record) + strings.size(), '\0');
+            char* body = image.data() + sizeof(header);
+            if (!records.empty())
+                std::memcpy(body, records.data(), records.size() * sizeof(Record));
+            std::memcpy(body + records.size() * sizeof(Record), strings.data(), strings.size());
+            header.checksum = HashBytes(body, image.size() - sizeof(header));
+            std::memcpy(image.data(), &header, sizeof(header));
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_pendingPath = GetPath(exchange);
+                m_pendingImage.swap(image);
+                m_hasPending = true;
+                if (!m_writer.joinable())
+                    m_writer = std::thread(&InstrumentCache::WriterLoop, this);
+            }
+            m_wake.notify_one();
+        }
+
+        void InstrumentCache::WaitForSave()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_idle.wait(lock, [this] { return !m_hasPending && !m_writing; });
+        }
+
+        bool InstrumentCache::GetLastSaveFailed() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_lastSaveFailed;
+        }
+
+        const InstrumentCache::Record* InstrumentCache::GetRecords() const
+        {
+            return m_file.IsOpen()
+                ? reinterpret_cast<const Record*>(m_file.GetData() + sizeof(InstrumentCacheHeader))
+                : nullptr;
+        }
+
+        std::string_view InstrumentCache::GetString(uint32_t offset, uint32_t length) const
+        {
+            // Checked on every access: a bad offset gives an empty string, never a read past the mapping
+            if (offset > m_stringBytes || length > m_stringBytes - offset)
+                return {};
+            return std::string_view(m_strings + offset, length);
+        }
+
+        void InstrumentCache::ToInstrument(const Record& record, std::string_view exchange, InstrumentData& out) const
+        {
+            out.symbol.assign(GetString(record.symbolOffset, record.symbolLength));
+            out.exchange.assign(exchange);
+            out.baseAsset.assign(GetString(record.baseOffset, record.baseLength));
+            out.quoteAsset.assign(GetString(record.quoteOffset, record.quoteLength));
+            out.tradingStatus.assign(GetString(record.statusOffset, record.statusLength));
+            out.minOrderSize = record.minOrderSize;
+            out.maxOrderSize = record.maxOrderSize;
+            out.tickSize = record.tickSize;
+            out.lotSize = record.lotSize;
+            out.pricePrecision = record.pricePrecision;
+            out.quantityPrecision = record.quantityPrecision;
+            out.tradingEnabled = record.tradingEnabled != 0;
+            out.updateTime = std::chrono::system_clock::time_point(
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(record.updateTimeNs)));
+        }
+
+        void InstrumentCache::WriterLoop()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (true)
+            {
+                m_wake.wait(lock, [this] { return m_stop || m_hasPending; });
+                if (!m_hasPending)
+                    break; // Stopping with nothing left to write
+
+                std::string path;
+                std::string image;
+                path.swap(m_pendingPath);
+                image.swap(m_pendingImage);
+                m_hasPending = false;
+                m_writing = true;
+                lock.unlock();
+
+                std::error_code error;
+                std::filesystem::create_directories(m_directory, error);
+                const bool ok = ReplaceFileContents(path, image.data(), image.size());
+
+                lock.lock();
+                m_writing = false;
+                m_lastSaveFailed = !ok;
+                m_idle.notify_all();
+            }
+        }
+    } // editor
+} // gui
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "MappedFile.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+namespace gui::editor
+{
+    struct InstrumentData;
+
+    // Instrument definitions of one exchange persisted between runs, so trading can
+    // start from the previous run's metadata while the live fetch is still in flight.
+    //
+    // File (one per exchange, <directory>/instruments-<exchange>.bin), little endian:
+    //   InstrumentCacheHeader
+    //   InstrumentCacheRecord[count]   sorted by symbol
+    //   char strings[stringBytes]      symbol, assets and status of every record
+    // The header carries a format version, the record size and a checksum of
+    // everything after it; a file that fails any check is ignored, never half-read.
+    // Open() maps the file and Find() binary-searches the mapped records, so nothing
+    // is parsed on startup.
+    //
+    // SaveAsync() serialises on the calling thread and hands the image to a writer
+    // thread, which replaces the file atomically. Saves queued while one is being
+    // written collapse into the latest.
+    class InstrumentCache
+    {
+    public:
+        static constexpr uint32_t FORMAT_VERSION = 1;
+
+        explicit InstrumentCache(std::string directory = "cache");
+        ~InstrumentCache(); // Finishes a pending save
+
+        InstrumentCache(const InstrumentCache&) = delete;
+        InstrumentCache& operator=(const InstrumentCache&) = delete;
+
+        std::string GetPath(std::string_view exchange) const;
+
+        bool Open(std::string_view exchange); // False when missing, stale format or corrupt
+        void Close();
+        bool IsOpen() const { return m_file.IsOpen(); }
+
+        size_t GetCount() const { return m_count; }
+        int64_t GetSavedTimeNs() const { return m_savedTimeNs; }
+        bool Find(std::string_view symbol, InstrumentData& out) const;
+        size_t CopyTo(std::unordered_map<std::string, InstrumentData>& out) const; // Keyed by symbol
+
+        void SaveAsync(std::string_view exchange, const std::unordered_map<std::string, InstrumentData>& instruments);
+        void WaitForSave();
+        bool GetLastSaveFailed() const;
+
+    private:
+        struct Record;
+
+        const Record* GetRecords() const;
+        std::string_view GetString(uint32_t offset, uint32_t length) const;
+        void ToInstrument(const Record& record, std::string_view exchange, InstrumentData& out) const;
+        void WriterLoop();
+
+        std::string m_directory;
+
+        MappedFile m_file;
+        std::string m_exchange;
+        size_t m_count;
+        int64_t m_savedTimeNs;
+        const char* m_strings;
+        uint32_t m_stringBytes;
+
+        // Writer thread, started by the first SaveAsync
+        std::thread m_writer;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_idle;
+        std::string m_pendingPath;
+        std::string m_pendingImage;
+        bool m_hasPending;
+        bool m_writing;
+        bool m_stop;
+        bool m_lastSaveFailed;
+    };
+}
@@ -0,0 +1,94 @@
+#include "InstrumentRegistry.h"
+
+#include <cmath>
+
+namespace gui
+{
+    namespace editor
+    {
+        namespace
+        {
+            // Fields consumers derive state from; timestamps alone are not a change
+            bool SameDefinition(const InstrumentData& a, const InstrumentData& b)
+            {
+                return a.baseAsset == b.baseAsset && a.quoteAsset == b.quoteAsset && a.tickSize == b.tickSize &&
+                       a.lotSize == b.lotSize && a.minOrderSize == b.minOrderSize && a.maxOrderSize == b.maxOrderSize &&
+                       a.pricePrecision == b.pricePrecision && a.quantityPrecision == b.quantityPrecision &&
+                       a.tradingEnabled == b.tradingEnabled && a.tradingStatus == b.tradingStatus;
+            }
+        }
+
+        int64_t InstrumentData::GetTickUnits(int priceScale) const
+        {
+            if (!(tickSize > 0.0) || priceScale < 0 || priceScale > Decimal::MAX_SCALE)
+                return 0;
+            const double units = tickSize * static_cast<double>(DecimalPow10(priceScale));
+            const double rounded = std::round(units);
+            // A tick finer than the scale, or one the scale cannot express, is no grid at all
+            if (rounded < 1.0 || rounded > 9.0e15 || std::fabs(units - rounded) > 1e-6 * rounded)
+                return 0;
+            return static_cast<int64_t>(rounded);
+        }
+
+        bool InstrumentRegistry::Publish(const InstrumentData& instrument)
+        {
+            if (instrument.symbol.empty())
+                return false;
+            InstrumentData& stored = m_instruments[instrument.exchange][instrument.symbol];
+            if (!stored.symbol.empty() && SameDefinition(stored, instrument))
+            {
+                stored.updateTime = instrument.updateTime;
+                return false;
+            }
+            stored = instrument;
+            m_generation++;
+            return true;
+        }
+
+        void InstrumentRegistry::Remove(std::string_view exchange, std::string_view symbol)
+        {
+            const auto venue = m_instruments.find(std::string(exchange));
+            if (venue != m_instruments.end() && venue->second.erase(std::string(symbol)) != 0)
+                m_generation++;
+        }
+
+        const InstrumentData* InstrumentRegistry::Find(std::string_view exchange, std::string_view symbol) const
+        {
+            const std::string key(symbol);
+            const auto venue = m_instruments.find(std::string(exchange));
+            if (venue != m_instruments.end())
+            {
+                const auto it = venue->second.find(key);
+                if (it != venue->second.end())
+                    return &it->second;
+            }
+            for (const auto& [name, symbols] : m_instruments)
+            {
+                const auto it = symbols.find(key);
+                if (it != symbols.end())
+                    return &it->second;
+            }
+            return nullptr;
+        }
+
+        size_t InstrumentRegistry::GetCount() const
+        {
+            size_t count = 0;
+            for (const auto& [exchange, symbols] : m_instruments)
+                count += symbols.size();
+            return count;
+        }
+
+        void InstrumentRegistry::Clear()
+        {
+            m_instruments.clear();
+            m_generation++;
+        }
+
+        InstrumentRegistry& GetInstrumentRegistry()
+        {
+            static InstrumentRegistry registry;
+            return registry;
+        }
+    } // editor
+} // gui
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Decimal.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace gui::editor
+{
+    struct InstrumentData
+    {
+        std::string symbol;
+        std::string exchange;
+        std::string baseAsset;
+        std::string quoteAsset;
+        double minOrderSize;
+        double maxOrderSize;
+        double tickSize;
+        double lotSize;
+        int pricePrecision;
+        int quantityPrecision;
+        bool tradingEnabled;
+        std::string tradingStatus; // "TRADING", "HALT", "BREAK", etc.
+        std::chrono::system_clock::time_point updateTime;
+        
+        InstrumentData() : minOrderSize(0.0), maxOrderSize(0.0), tickSize(0.0), lotSize(0.0),
+                          pricePrecision(0), quantityPrecision(0), tradingEnabled(false) {}
+        
+        DecimalScale GetDecimalScale() const { return DecimalScale(pricePrecision, quantityPrecision); }
+
+        // Tick size in price units at priceScale; 0 when unknown or not a whole number of units
+        int64_t GetTickUnits(int priceScale) const;
+    };
+
+    // Latest definition of every instrument the instrument updaters have published,
+    // by exchange and symbol. Books, processors and wallet valuation read tick sizes,
+    // scales and base/quote assets from here and watch GetGeneration() for changes,
+    // so nothing ties their lifetime to the updaters'.
+    class InstrumentRegistry
+    {
+    public:
+        InstrumentRegistry() : m_generation(0) {}
+
+        bool Publish(const InstrumentData& instrument); // false when nothing changed
+        void Remove(std::string_view exchange, std::string_view symbol);
+
+        // Exact venue first; an empty or unknown exchange matches the symbol on any venue
+        const InstrumentData* Find(std::string_view exchange, std::string_view symbol) const;
+
+        uint64_t GetGeneration() const { return m_generation; } // Bumped by every change
+        size_t GetCount() const;
+
+        template<typename Fn>
+        void ForEach(Fn&& fn) const; // fn(const InstrumentData&)
+
+        void Clear();
+
+    private:
+        std::unordered_map<std::string, std::unordered_map<std::string, InstrumentData>> m_instruments; // Exchange -> symbol
+        uint64_t m_generation;
+    };
+
+    template<typename Fn>
+    void InstrumentRegistry::ForEach(Fn&& fn) const
+    {
+        for (const auto& [exchange, symbols] : m_instruments)
+        {
+            for (const auto& [symbol, instrument] : symbols)
+                fn(instrument);
+        }
+    }
+
+    // Process-wide registry; the instrument updaters publish into it
+    InstrumentRegistry& GetInstrumentRegistry();
+}
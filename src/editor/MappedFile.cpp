@@ -0,0 +1,153 @@
+#include "MappedFile.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace gui
+{
+    namespace editor
+    {
+        MappedFile::MappedFile()
+            : m_data(nullptr)
+            , m_size(0)
+#ifdef _WIN32
+            , m_file(INVALID_HANDLE_VALUE)
+            , m_mapping(nullptr)
+#else
+            , m_descriptor(-1)
+#endif
+        {
+        }
+
+        MappedFile::~MappedFile()
+        {
+            Close();
+        }
+
+#ifdef _WIN32
+        bool MappedFile::Open(const std::string& path)
+        {
+            Close();
+            m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                                 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (m_file == INVALID_HANDLE_VALUE)
+                return false;
+
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+            {
+                Close();
+                return false;
+            }
+            m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            const void* view = m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+            if (!view)
+            {
+                Close();
+                return false;
+            }
+            m_data = static_cast<const uint8_t*>(view);
+            m_size = static_cast<size_t>(size.QuadPart);
+            return true;
+        }
+
+        void MappedFile::Close()
+        {
+            if (m_data)
+                UnmapViewOfFile(m_data);
+            if (m_mapping)
+                CloseHandle(m_mapping);
+            if (m_file != INVALID_HANDLE_VALUE)
+                CloseHandle(m_file);
+            m_data = nullptr;
+            m_size = 0;
+            m_mapping = nullptr;
+            m_file = INVALID_HANDLE_VALUE;
+        }
+#else
+        bool MappedFile::Open(const std::string& path)
+        {
+            Close();
+            m_descriptor = ::open(path.c_str(), O_RDONLY);
+            if (m_descriptor < 0)
+                return false;
+
+            struct stat info;
+            if (::fstat(m_descriptor, &info) != 0 || info.st_size <= 0)
+            {
+                Close();
+                return false;
+            }
+            void* view = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, m_descriptor, 0);
+            if (view == MAP_FAILED)
+            {
+                Close();
+                return false;
+            }
+            m_data = static_cast<const uint8_t*>(view);
+            m_size = static_cast<size_t>(info.st_size);
+            return true;
+        }
+
+        void MappedFile::Close()
+        {
+            if (m_data)
+                ::munmap(const_cast<uint8_t*>(m_data), m_size);
+            if (m_descriptor >= 0)
+                ::close(m_descriptor);
+            m_data = nullptr;
+            m_size = 0;
+            m_descriptor = -1;
+        }
+#endif
+
+        bool SyncFile(std::FILE* file)
+        {
+            if (std::fflush(file) != 0)
+                return false;
+#ifdef _WIN32
+            return _commit(_fileno(file)) == 0;
+#else
+            return ::fsync(::fileno(file)) == 0;
+#endif
+        }
+
+        bool ReplaceFileContents(const std::string& path, const void* data, size_t size)
+        {
+            const std::string temporary = path + ".tmp";
+            std::FILE* file = std::fopen(temporary.c_str(), "wb");
+            if (!file)
+                return false;
+
+            bool ok = std::fwrite(data, 1, size, file) == size && SyncFile(file);
+            ok = std::fclose(file) == 0 && ok;
+
+            std::error_code error;
+            if (ok)
+                std::filesystem::rename(temporary, path, error);
+            if (!ok || error)
+            {
+                std::filesystem::remove(temporary, error);
+                return false;
+            }
+            return true;
+        }
+    } // editor
+} // gui
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace gui::editor
+{
+    // Read-only mapping of a whole file (mmap / MapViewOfFile). The view stays valid
+    // until Close(), Open() of another file or destruction. Empty files do not map.
+    class MappedFile
+    {
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool Open(const std::string& path);
+        void Close();
+
+        bool IsOpen() const { return m_data != nullptr; }
+        const uint8_t* GetData() const { return m_data; }
+        size_t GetSize() const { return m_size; }
+
+    private:
+        const uint8_t* m_data;
+        size_t m_size;
+#ifdef _WIN32
+        void* m_file;
+        void* m_mapping;
+#else
+        int m_descriptor;
+#endif
+    };
+
+    // Flushes stdio buffers and asks the OS to put the file on disk (fsync / _commit)
+    bool SyncFile(std::FILE* file);
+
+    // Writes `size` bytes to path.tmp, flushes it and renames it over path, so readers
+    // see either the old file or the complete new one
+    bool ReplaceFileContents(const std::string& path, const void* data, size_t size);
+}
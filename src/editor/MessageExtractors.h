@@ -2,6 +2,7 @@
 
 #include "Node.h"
 #include <chrono>
+#include <string_view>
 #include <unordered_map>
 
 namespace gui::editor
@@ -80,8 +81,8 @@ namespace gui::editor
 
     private:
         void RenderFixConfiguration();
-        std::string ExtractFixField(const std::string& message, int tag);
-        std::chrono::system_clock::time_point ParseFixTimestamp(const std::string& timestamp);
+        std::string_view ExtractFixField(std::string_view message, int tag); // View into message
+        std::chrono::system_clock::time_point ParseFixTimestamp(std::string_view timestamp);
         
         // FIX-specific configuration
         std::string m_timestampTag; // Usually "52" for SendingTime
@@ -104,8 +105,8 @@ namespace gui::editor
 
     private:
         void RenderJsonConfiguration();
-        std::string ExtractJsonField(const std::string& message, const std::string& fieldPath);
-        std::chrono::system_clock::time_point ParseJsonTimestamp(const std::string& timestamp);
+        std::string_view ExtractJsonField(std::string_view message, std::string_view fieldPath); // View into message
+        std::chrono::system_clock::time_point ParseJsonTimestamp(std::string_view timestamp);
         
         // JSON-specific configuration
         char m_timestampFieldPath[128]; // e.g., "data.timestamp" or "timestamp"
@@ -129,8 +130,8 @@ namespace gui::editor
 
     private:
         void RenderFixConfiguration();
-        std::string ExtractFixField(const std::string& message, int tag);
-        std::chrono::system_clock::time_point ParseFixTimestamp(const std::string& timestamp);
+        std::string_view ExtractFixField(std::string_view message, int tag); // View into message
+        std::chrono::system_clock::time_point ParseFixTimestamp(std::string_view timestamp);
         
         // FIX-specific configuration for orderbook
         std::string m_timestampTag; // Usually "52" for SendingTime
@@ -154,8 +155,8 @@ namespace gui::editor
 
     private:
         void RenderJsonConfiguration();
-        std::string ExtractJsonField(const std::string& message, const std::string& fieldPath);
-        std::chrono::system_clock::time_point ParseJsonTimestamp(const std::string& timestamp);
+        std::string_view ExtractJsonField(std::string_view message, std::string_view fieldPath); // View into message
+        std::chrono::system_clock::time_point ParseJsonTimestamp(std::string_view timestamp);
         
         // JSON-specific configuration for orderbook
         char m_timestampFieldPath[128]; // e.g., "data.timestamp" or "timestamp"
@@ -3,10 +3,593 @@
 //
 
 #include "MessageProcessors.h"
+#include "InstrumentRegistry.h"
+
+#include <algorithm>
+#include <chrono>
 
 namespace gui
 {
     namespace editor
     {
+        namespace
+        {
+            uint64_t ParseSequence(std::string_view text)
+            {
+                uint64_t value = 0;
+                for (char c : JsonScan::Unquote(text))
+                {
+                    if (c < '0' || c > '9')
+                        break;
+                    value = value * 10 + static_cast<uint64_t>(c - '0');
+                }
+                return value;
+            }
+
+            std::chrono::system_clock::time_point FromNanoseconds(int64_t ns)
+            {
+                return std::chrono::system_clock::time_point(
+                    std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(ns)));
+            }
+
+            // FNV-1a, folded over each configuration field; a changed hash means the compiled form is stale
+            uint64_t HashConfig(std::string_view bytes, uint64_t hash = 14695981039346656037ull)
+            {
+                for (char c : bytes)
+                {
+                    hash ^= static_cast<uint8_t>(c);
+                    hash *= 1099511628211ull;
+                }
+                return hash;
+            }
+
+            // Connection and receive delay; a trade without an exchange timestamp takes the receive time
+            bool StampReceivedTrade(const FilteredMessage& message, TradeStringTable& strings, TradeRecord& trade)
+            {
+                if (!strings.InternName(message.sourceConnection, trade.sourceId))
+                    return false;
+
+                const int64_t receivedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    message.receivedTime.time_since_epoch()).count();
+                if (trade.timestampNs == 0)
+                    trade.timestampNs = receivedNs;
+                trade.receiveDelayUs = static_cast<int32_t>(
+                    std::clamp<int64_t>((receivedNs - trade.timestampNs) / 1000, INT32_MIN, INT32_MAX));
+                return true;
+            }
+
+            // FIX UTCTimestamp "20230925-07:48:36.925" -> ns since epoch
+            bool ParseFixUtcTimestamp(std::string_view text, int64_t& ns)
+            {
+                if (text.size() < 17 || text[8] != '-')
+                    return false;
+
+                // Same layout as ISO 8601 once the date is punctuated
+                char iso[40];
+                const size_t timeLength = std::min(text.size() - 9, sizeof(iso) - 13);
+                std::copy_n(text.data(), 4, iso);
+                iso[4] = '-';
+                std::copy_n(text.data() + 4, 2, iso + 5);
+                iso[7] = '-';
+                std::copy_n(text.data() + 6, 2, iso + 8);
+                iso[10] = 'T';
+                std::copy_n(text.data() + 9, timeLength, iso + 11);
+                iso[11 + timeLength] = 'Z';
+                return JsonTime::ParseIso8601(std::string_view(iso, 12 + timeLength), ns);
+            }
+        }
+
+        DecimalScale MessageProcessorBase::GetInstrumentScale(uint32_t symbolId) const
+        {
+            const auto it = m_instrumentScales.find(symbolId);
+            return it != m_instrumentScales.end() ? it->second : m_defaultScale;
+        }
+
+        void MessageProcessorBase::SyncInstrumentScales()
+        {
+            const InstrumentRegistry& registry = GetInstrumentRegistry();
+            if (registry.GetGeneration() == m_scaleGeneration)
+                return;
+            m_scaleGeneration = registry.GetGeneration();
+
+            const std::string_view venue = GetVenue();
+            TradeStringTable& strings = GetTradeStringTable();
+            m_instrumentScales.clear();
+            registry.ForEach([&](const InstrumentData& instrument) {
+                // A definition without precisions would truncate every price to integers
+                if (instrument.pricePrecision <= 0 && instrument.quantityPrecision <= 0)
+                    return;
+                const uint32_t symbolId = strings.Intern(instrument.symbol);
+                if (symbolId == 0)
+                    return;
+                const auto [it, inserted] = m_instrumentScales.try_emplace(symbolId, instrument.GetDecimalScale());
+                if (!inserted && !venue.empty() && instrument.exchange == venue)
+                    it->second = instrument.GetDecimalScale();
+            });
+        }
+
+        void MessageProcessorBase::ProcessMessageBatch(const std::vector<FilteredMessage>& batch)
+        {
+            BatchArenaScope scope;
+            SyncDecoderConfig();
+            SyncInstrumentScales();
+            for (const FilteredMessage& message : batch)
+                ProcessMessage(message);
+            FlushOutputs();
+        }
+
+        void MessageProcessorBase::QueueOrderbook(const NormalizedOrderbook& orderbook)
+        {
+            if (!m_pendingBooks)
+                m_pendingBooks = std::make_shared<OrderbookBatchData>();
+            m_pendingBooks->books.push_back(orderbook);
+        }
+
+        void MessageProcessorBase::FlushOutputs()
+        {
+            FlushTradeBatch();
+            if (!m_pendingBooks)
+                return;
+            if (Pin* pin = FindOutputPin("Orderbooks"))
+                SetOutputData(pin->id, m_pendingBooks);
+            m_pendingBooks.reset();
+        }
+
+        void MessageProcessorBase::EmitTrade(const TradeRecord& trade)
+        {
+            if (m_outputLayout == TradeBatchLayout::Columns)
+            {
+                if (!m_pendingColumns)
+                    m_pendingColumns = std::make_shared<TradeColumnBatchData>();
+                m_pendingColumns->columns.Append(trade);
+            }
+            else
+            {
+                if (!m_pendingRows)
+                    m_pendingRows = std::make_shared<TradeRowBatchData>();
+                m_pendingRows->trades.push_back(trade);
+            }
+        }
+
+        void MessageProcessorBase::FlushTradeBatch()
+        {
+            // Consumers keep the published batch, so the next one starts fresh
+            Pin* pin = FindOutputPin("Trades");
+            if (m_pendingRows && !m_pendingRows->trades.empty() && pin)
+                SetOutputData(pin->id, m_pendingRows);
+            if (m_pendingColumns && !m_pendingColumns->columns.Empty() && pin)
+                SetOutputData(pin->id, m_pendingColumns);
+            m_pendingRows.reset();
+            m_pendingColumns.reset();
+        }
+
+        void JSONTradeProcessor::SyncDecoderConfig()
+        {
+            // The UI and Deserialize edit m_presetExchange in place
+            const uint64_t hash = HashConfig(m_presetExchange);
+            if (hash == m_decoderConfigHash && m_decoderConfigHash != 0)
+                return;
+            m_decoderConfigHash = hash;
+            SelectPresetDecoder();
+            m_scaleGeneration = UINT64_MAX; // The venue whose scales win changed with it
+        }
+
+        void JSONTradeProcessor::SelectPresetDecoder()
+        {
+            m_tradePreset = FindTradePreset(m_presetExchange);
+        }
+
+        void JSONTradeProcessor::ProcessMessage(const FilteredMessage& message)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const std::string& json = message.messageInfo.originalMessage;
+            TradeStringTable& strings = GetTradeStringTable();
+
+            if (m_tradePreset)
+            {
+                // The symbol is read in the same pass as the prices, so decode at the previous
+                // message's scale and again only if this message's instrument differs
+                DecimalScale scale = m_defaultScale;
+                if (!m_decodedTrades.empty())
+                    scale = DecimalScale{m_decodedTrades.back().priceScale, m_decodedTrades.back().quantityScale};
+                m_decodedTrades.clear();
+                m_tradePreset->decode(json, scale, strings, m_decodedTrades);
+                if (!m_decodedTrades.empty())
+                {
+                    const DecimalScale actual = GetInstrumentScale(m_decodedTrades.front().symbolId);
+                    if (actual.price != scale.price || actual.quantity != scale.quantity)
+                    {
+                        m_decodedTrades.clear();
+                        m_tradePreset->decode(json, actual, strings, m_decodedTrades);
+                    }
+                }
+            }
+            else
+            {
+                m_decodedTrades.clear();
+                const TradeRecord trade = ParseJsonTrade(json);
+                if (trade.symbolId != 0)
+                    m_decodedTrades.push_back(trade);
+            }
+
+            bool parsed = !m_decodedTrades.empty();
+            for (TradeRecord& trade : m_decodedTrades)
+            {
+                if ((trade.exchangeId == 0 && !strings.InternName(message.sourceConnection, trade.exchangeId)) ||
+                    !StampReceivedTrade(message, strings, trade))
+                {
+                    parsed = false;
+                    break;
+                }
+                EmitTrade(trade);
+            }
+            if (!parsed)
+                AddError("Unparsable trade", message.messageInfo.messageId);
+            UpdateStatistics(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count(),
+                             parsed);
+        }
+
+        TradeRecord JSONTradeProcessor::ParseJsonTrade(const std::string& jsonMessage)
+        {
+            const std::string_view json(jsonMessage);
+            TradeStringTable& strings = GetTradeStringTable();
+            BatchArena& arena = GetThreadArena();
+            auto field = [&](const char* path) { return JsonScan::Unquote(JsonScan::FindField(json, path)); };
+
+            TradeRecord trade{};
+            const std::string_view symbol = JsonScan::Unescape(JsonScan::FindField(json, m_jsonMapping.currencyPairField), arena);
+            const DecimalScale scale = GetInstrumentScale(strings.Find(symbol));
+            trade.priceScale = scale.price;
+            trade.quantityScale = scale.quantity;
+            if (symbol.empty() ||
+                !Decimal::Parse(field(m_jsonMapping.priceField), scale.price, trade.price) ||
+                !Decimal::Parse(field(m_jsonMapping.quantityField), scale.quantity, trade.quantity))
+                return trade;
+
+            // The generic mapping has no venue of its own: the configured exchange, else (in
+            // ProcessMessage) the connection
+            if (m_presetExchange[0] != '\0' && !strings.InternName(m_presetExchange, trade.exchangeId))
+                return trade;
+
+            EncodeTradeId(field(m_jsonMapping.tradeIdField), trade);
+            trade.side = ParseTradeSide(field(m_jsonMapping.sideField));
+            trade.orderRefsId = strings.InternOrderRefs(field(m_jsonMapping.orderIdField), {}, {});
+            if (field(m_jsonMapping.isMakerField) == "true")
+                trade.flags |= TradeFlags::IsMaker;
+
+            const std::string_view timestamp = field(m_jsonMapping.timestampField);
+            if (!JsonTime::ParseEpoch(timestamp, trade.timestampNs))
+                JsonTime::ParseIso8601(timestamp, trade.timestampNs);
+
+            constexpr int FEE_SCALE = 8;
+            Decimal fee;
+            if (Decimal::Parse(field(m_jsonMapping.feeField), FEE_SCALE, fee))
+            {
+                trade.fee = fee.ToDouble(FEE_SCALE);
+                trade.flags |= TradeFlags::HasFee;
+            }
+            const std::string_view feeCurrency = field(m_jsonMapping.feeCurrencyField);
+            if (!feeCurrency.empty() && strings.InternName(feeCurrency, trade.feeCurrencyId))
+                trade.flags |= TradeFlags::HasFee;
+
+            trade.symbolId = strings.Intern(symbol);
+            return trade;
+        }
+
+        void JSONOrderbookProcessor::ProcessMessage(const FilteredMessage& message)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const bool parsed = ParseJsonOrderbook(message.messageInfo.originalMessage, m_workingOrderbook);
+            if (parsed)
+            {
+                m_workingOrderbook.originalMessageId = message.messageInfo.messageId;
+                m_workingOrderbook.source = message.sourceConnection;
+                // The decoder schema only says how to parse; the venue comes from configuration
+                if (m_venueName[0] != '\0')
+                    m_workingOrderbook.exchange.assign(m_venueName);
+                else
+                    m_workingOrderbook.exchange.assign(message.sourceConnection);
+                m_workingOrderbook.receivedTime = message.receivedTime;
+                QueueOrderbook(m_workingOrderbook);
+            }
+            else
+            {
+                AddError("Unparsable orderbook", message.messageInfo.messageId);
+            }
+            UpdateStatistics(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count(),
+                             parsed);
+        }
+
+        void JSONOrderbookProcessor::SyncDecoderConfig()
+        {
+            // The UI and Deserialize edit these in place
+            uint64_t hash = HashConfig(m_presetExchange);
+            for (const char* field : {m_jsonMapping.orderbookIdField, m_jsonMapping.currencyPairField,
+                                      m_jsonMapping.timestampField, m_jsonMapping.bidsField, m_jsonMapping.asksField,
+                                      m_jsonMapping.priceField, m_jsonMapping.quantityField, m_jsonMapping.countField,
+                                      m_jsonMapping.sequenceField, m_jsonMapping.firstSequenceField})
+                hash = HashConfig(field, hash ^ 0xFF); // Separator, so moved characters still change it
+            hash = HashConfig(std::string_view(reinterpret_cast<const char*>(&m_maxLevelsPerSide), sizeof(m_maxLevelsPerSide)), hash);
+            hash = HashConfig(m_venueName, hash ^ 0xFF);
+            if (hash == m_layoutConfigHash && m_layoutConfigHash != 0)
+                return;
+            m_layoutConfigHash = hash;
+            RebuildLevelLayout();
+            m_scaleGeneration = UINT64_MAX; // The venue whose scales win may have changed
+        }
+
+        void JSONOrderbookProcessor::RebuildLevelLayout()
+        {
+            m_levelLayout.price = JsonLevelField::FromMapping(m_jsonMapping.priceField);
+            m_levelLayout.quantity = JsonLevelField::FromMapping(m_jsonMapping.quantityField);
+            m_levelLayout.count = JsonLevelField::FromMapping(m_jsonMapping.countField);
+            m_levelLayout.maxLevels = m_maxLevelsPerSide > 0 ? static_cast<size_t>(m_maxLevelsPerSide) : 0;
+
+            // With a depth limit the working buffers never need to grow after this
+            if (m_levelLayout.maxLevels != 0)
+            {
+                m_workingOrderbook.bids.reserve(m_levelLayout.maxLevels);
+                m_workingOrderbook.asks.reserve(m_levelLayout.maxLevels);
+            }
+
+            // Only an explicitly chosen exchange selects a preset; the generic mapping never infers one
+            m_orderbookPreset = FindOrderbookPreset(m_presetExchange);
+        }
+
+        bool JSONOrderbookProcessor::ParseOrderbookLevels(std::string_view levelsJson, DecimalScale scale,
+                                                          std::vector<NormalizedOrderbookLevel>& levels)
+        {
+            if (!OrderbookLevelParser::Parse(levelsJson, m_levelLayout, scale, levels))
+                return false;
+
+            Decimal minimum;
+            if (m_minLevelQuantity > 0.0 && Decimal::FromDouble(m_minLevelQuantity, scale.quantity, minimum))
+            {
+                levels.erase(std::remove_if(levels.begin(), levels.end(),
+                                            [minimum](const NormalizedOrderbookLevel& level) {
+                                                return level.quantity < minimum && !level.quantity.IsZero();
+                                            }),
+                             levels.end());
+            }
+            return true;
+        }
+
+        bool JSONOrderbookProcessor::ParseJsonOrderbook(const std::string& jsonMessage, NormalizedOrderbook& orderbook)
+        {
+            const std::string_view json(jsonMessage);
+            const TradeStringTable& strings = GetTradeStringTable();
+
+            if (m_orderbookPreset)
+            {
+                // Levels are parsed in the same pass as the symbol, so assume the previous
+                // message's instrument and parse again only if the symbol's scale differs
+                orderbook.scale = GetInstrumentScale(strings.Find(orderbook.currencyPair));
+                if (!m_orderbookPreset->decode(json, m_levelLayout.maxLevels, orderbook))
+                    return false;
+                const DecimalScale scale = GetInstrumentScale(strings.Find(orderbook.currencyPair));
+                if (scale.price != orderbook.scale.price || scale.quantity != orderbook.scale.quantity)
+                {
+                    orderbook.scale = scale;
+                    if (!m_orderbookPreset->decode(json, m_levelLayout.maxLevels, orderbook))
+                        return false;
+                }
+            }
+            else
+            {
+                BatchArena& arena = GetThreadArena();
+                orderbook.currencyPair.assign(JsonScan::Unescape(JsonScan::FindField(json, m_jsonMapping.currencyPairField), arena));
+                orderbook.orderbookId.assign(JsonScan::Unescape(JsonScan::FindField(json, m_jsonMapping.orderbookIdField), arena));
+                orderbook.scale = GetInstrumentScale(strings.Find(orderbook.currencyPair));
+                orderbook.hasChecksum = false;
+
+                orderbook.sequence = 0;
+                orderbook.firstSequence = 0;
+                if (m_jsonMapping.sequenceField[0] != '\0')
+                    orderbook.sequence = ParseSequence(JsonScan::FindField(json, m_jsonMapping.sequenceField));
+                if (m_jsonMapping.firstSequenceField[0] != '\0')
+                    orderbook.firstSequence = ParseSequence(JsonScan::FindField(json, m_jsonMapping.firstSequenceField));
+                // Without a first-update-id field the generic layout carries whole books
+                orderbook.isSnapshot = m_jsonMapping.firstSequenceField[0] == '\0';
+
+                const std::string_view bids = JsonScan::FindField(json, m_jsonMapping.bidsField);
+                const std::string_view asks = JsonScan::FindField(json, m_jsonMapping.asksField);
+                orderbook.bids.clear();
+                orderbook.asks.clear();
+                if ((bids.empty() && asks.empty()) ||
+                    (!bids.empty() && !ParseOrderbookLevels(bids, orderbook.scale, orderbook.bids)) ||
+                    (!asks.empty() && !ParseOrderbookLevels(asks, orderbook.scale, orderbook.asks)))
+                    return false;
+            }
+
+            const std::string_view timestamp = JsonScan::Unquote(JsonScan::FindField(json, m_jsonMapping.timestampField));
+            int64_t timestampNs = 0;
+            if (JsonTime::ParseEpoch(timestamp, timestampNs) || JsonTime::ParseIso8601(timestamp, timestampNs))
+                orderbook.timestamp = FromNanoseconds(timestampNs);
+
+            orderbook.totalLevels = static_cast<int>(orderbook.bids.size() + orderbook.asks.size());
+            orderbook.spread = 0.0;
+            orderbook.midPrice = 0.0;
+            if (!orderbook.bids.empty() && !orderbook.asks.empty())
+            {
+                const double bid = orderbook.bids.front().price.ToDouble(orderbook.scale.price);
+                const double ask = orderbook.asks.front().price.ToDouble(orderbook.scale.price);
+                if (m_calculateSpread)
+                    orderbook.spread = ask - bid;
+                if (m_calculateMidPrice)
+                    orderbook.midPrice = (bid + ask) / 2.0;
+            }
+            return true;
+        }
+
+        void FIXTradeProcessor::ProcessMessage(const FilteredMessage& message)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            TradeRecord trade = ParseFixTrade(message.messageInfo.originalMessage);
+            TradeStringTable& strings = GetTradeStringTable();
+            // A FIX session is one venue, so the connection names the exchange too
+            const bool parsed = trade.symbolId != 0 &&
+                                strings.InternName(message.sourceConnection, trade.exchangeId) &&
+                                StampReceivedTrade(message, strings, trade);
+            if (parsed)
+            {
+                EmitTrade(trade);
+            }
+            else
+            {
+                AddError("Unparsable trade", message.messageInfo.messageId);
+            }
+            UpdateStatistics(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count(),
+                             parsed);
+        }
+
+        TradeSide FIXTradeProcessor::MapFixSide(const std::string& fixSide)
+        {
+            if (fixSide == "1")
+                return TradeSide::Buy;
+            if (fixSide == "2")
+                return TradeSide::Sell;
+            return TradeSide::Unknown;
+        }
+
+        TradeRecord FIXTradeProcessor::ParseFixTrade(const std::string& fixMessage)
+        {
+            TradeRecord trade{};
+            if (!m_messageView.Tokenize(fixMessage))
+                return trade;
+            if (m_strictMsgTypeValidation && m_messageView.GetMsgType() != m_expectedMsgType)
+                return trade;
+
+            TradeStringTable& strings = GetTradeStringTable();
+            const std::string_view symbol = m_messageView.GetField(m_fixMapping.symbolTag);
+            const DecimalScale scale = GetInstrumentScale(strings.Find(symbol));
+            trade.priceScale = scale.price;
+            trade.quantityScale = scale.quantity;
+            if (symbol.empty() ||
+                !Decimal::Parse(m_messageView.GetField(m_fixMapping.priceTag), scale.price, trade.price) ||
+                !Decimal::Parse(m_messageView.GetField(m_fixMapping.quantityTag), scale.quantity, trade.quantity))
+                return trade;
+
+            // Trade capture reports carry 571; execution reports only have the ExecID
+            std::string_view tradeId = m_messageView.GetField(m_fixMapping.tradeIdTag);
+            if (tradeId.empty())
+                tradeId = m_messageView.GetField(m_fixMapping.execIdTag);
+            EncodeTradeId(tradeId, trade);
+
+            trade.side = MapFixSide(std::string(m_messageView.GetField(m_fixMapping.sideTag)));
+            trade.orderRefsId = strings.InternOrderRefs(m_messageView.GetField(m_fixMapping.orderIdTag), {}, {});
+            ParseFixUtcTimestamp(m_messageView.GetField(m_fixMapping.timestampTag), trade.timestampNs);
+
+            const std::string_view commission = m_messageView.GetField(m_fixMapping.commissionTag);
+            if (!commission.empty())
+            {
+                constexpr int FEE_SCALE = 8;
+                Decimal fee;
+                if (Decimal::Parse(commission, FEE_SCALE, fee))
+                {
+                    trade.fee = fee.ToDouble(FEE_SCALE);
+                    trade.flags |= TradeFlags::HasFee;
+                }
+            }
+
+            trade.symbolId = strings.Intern(symbol);
+            return trade;
+        }
+
+        void FIXOrderbookProcessor::ProcessMessage(const FilteredMessage& message)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const bool parsed = ParseFixOrderbook(message.messageInfo.originalMessage, m_workingOrderbook);
+            if (parsed)
+            {
+                m_workingOrderbook.originalMessageId = message.messageInfo.messageId;
+                m_workingOrderbook.source = message.sourceConnection;
+                m_workingOrderbook.exchange.assign(message.sourceConnection);
+                m_workingOrderbook.receivedTime = message.receivedTime;
+                QueueOrderbook(m_workingOrderbook);
+            }
+            else
+            {
+                AddError("Unparsable market data", message.messageInfo.messageId);
+            }
+            UpdateStatistics(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count(),
+                             parsed);
+        }
+
+        void FIXOrderbookProcessor::SyncDecoderConfig()
+        {
+            const uint64_t hash = HashConfig(std::string_view(reinterpret_cast<const char*>(&m_fixMapping), sizeof(m_fixMapping)));
+            if (hash == m_groupConfigHash && m_groupConfigHash != 0)
+                return;
+            m_groupConfigHash = hash;
+            RebuildGroupDefinition();
+        }
+
+        void FIXOrderbookProcessor::RebuildGroupDefinition()
+        {
+            m_mdTags.noMdEntriesTag = m_fixMapping.noMdEntriesTag;
+            m_mdTags.mdUpdateActionTag = m_fixMapping.mdUpdateActionTag;
+            m_mdTags.mdEntryTypeTag = m_fixMapping.mdEntryTypeTag;
+            m_mdTags.mdEntryPxTag = m_fixMapping.mdEntryPxTag;
+            m_mdTags.mdEntrySizeTag = m_fixMapping.mdEntrySizeTag;
+            m_mdTags.mdEntryPositionNoTag = m_fixMapping.mdEntryPositionNoTag;
+            m_mdTags.symbolTag = m_fixMapping.symbolTag;
+            m_mdEntryGroup = m_mdTags.MakeGroupDefinition();
+        }
+
+        bool FIXOrderbookProcessor::ParseFixOrderbook(const std::string& fixMessage, NormalizedOrderbook& orderbook)
+        {
+            if (!m_messageView.Tokenize(fixMessage))
+                return false;
+
+            const std::string_view msgType = m_messageView.GetMsgType();
+            if (msgType != "W" && msgType != "X")
+                return false;
+            if (msgType == "X" && !m_processIncrementalUpdates)
+                return false;
+
+            // W carries the symbol in the body and X in its first entry; either way it is
+            // the first occurrence. Deltas for another symbol must not land on this book.
+            const std::string_view symbol = m_messageView.GetField(m_fixMapping.symbolTag);
+            if (symbol != orderbook.currencyPair)
+            {
+                orderbook.bids.clear();
+                orderbook.asks.clear();
+                orderbook.currencyPair.assign(symbol);
+            }
+            orderbook.orderbookId.assign(m_messageView.GetField(m_fixMapping.mdReqIdTag));
+            orderbook.scale = GetInstrumentScale(GetTradeStringTable().Find(orderbook.currencyPair));
+            orderbook.hasChecksum = false;
+            orderbook.sequence = 0;
+            orderbook.firstSequence = 0;
+
+            int64_t timestampNs = 0;
+            if (ParseFixUtcTimestamp(m_messageView.GetField(m_fixMapping.timestampTag), timestampNs) ||
+                ParseFixUtcTimestamp(m_messageView.GetField(52), timestampNs)) // SendingTime
+                orderbook.timestamp = FromNanoseconds(timestampNs);
+
+            ParseFixMarketDataEntries(m_messageView, orderbook);
+
+            orderbook.spread = 0.0;
+            orderbook.midPrice = 0.0;
+            if (!orderbook.bids.empty() && !orderbook.asks.empty())
+            {
+                const double bid = orderbook.bids.front().price.ToDouble(orderbook.scale.price);
+                const double ask = orderbook.asks.front().price.ToDouble(orderbook.scale.price);
+                orderbook.spread = ask - bid;
+                orderbook.midPrice = (bid + ask) / 2.0;
+            }
+            return true;
+        }
+
+        void FIXOrderbookProcessor::ParseFixMarketDataEntries(const FixMessageView& message, NormalizedOrderbook& orderbook)
+        {
+            const int applied = FixMarketDataApplier::Apply(message, m_mdTags, m_mdEntryGroup, orderbook);
+
+            // Fewer book entries than declared is normal when trades share the group;
+            // none at all on a non-empty snapshot means the tags do not match the venue
+            const std::string_view declared = message.GetField(m_mdTags.noMdEntriesTag);
+            if (applied == 0 && orderbook.isSnapshot && !declared.empty() && declared != "0")
+                AddError("Snapshot has no bid/offer entries");
+        }
     } // editor
-} // gui
\ No newline at end of file
+} // gui
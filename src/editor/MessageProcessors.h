@@ -2,44 +2,19 @@
 
 #include "Node.h"
 #include "MessageFilters.h"
+#include "ExchangeDecoders.h"
+#include "FixMessageView.h"
+#include "OrderbookLevel.h"
+#include "OrderbookLevelParser.h"
+#include "TradeBatch.h"
+#include "TradeRecord.h"
+#include <array>
+#include <unordered_map>
 #include <vector>
 
 namespace gui::editor
 {
     // Normalized data structures
-    struct NormalizedTrade
-    {
-        std::string tradeId;
-        std::string currencyPair;
-        std::string exchange;
-        double price;
-        double quantity;
-        std::string side; // "buy" or "sell"
-        std::chrono::system_clock::time_point timestamp;
-        std::chrono::system_clock::time_point receivedTime;
-        std::string originalMessageId;
-        std::string source; // Connection source identifier
-        
-        // Optional fields
-        std::string orderId;
-        std::string buyOrderId;
-        std::string sellOrderId;
-        double fee;
-        std::string feeCurrency;
-        bool isMaker;
-        
-        NormalizedTrade() : price(0.0), quantity(0.0), fee(0.0), isMaker(false) {}
-    };
-
-    struct NormalizedOrderbookLevel
-    {
-        double price;
-        double quantity;
-        int orderCount; // Number of orders at this level (if available)
-        
-        NormalizedOrderbookLevel() : price(0.0), quantity(0.0), orderCount(0) {}
-    };
-
     struct NormalizedOrderbook
     {
         std::string orderbookId;
@@ -51,14 +26,30 @@ namespace gui::editor
         std::chrono::system_clock::time_point receivedTime;
         std::string originalMessageId;
         std::string source;
+        DecimalScale scale; // Instrument price/quantity precision
         bool isSnapshot; // true for full snapshot, false for incremental update
+        uint64_t sequence;      // Last update id covered by this message (0 = unsequenced)
+        uint64_t firstSequence; // First update id in a delta (0 = same as sequence)
+        uint32_t checksum;      // Exchange-published CRC32 of the resulting top of book
+        bool hasChecksum;
+        ChecksumScheme checksumScheme; // Set by the decoder that read the checksum
         
         // Market info
         double spread;
         double midPrice;
         int totalLevels;
         
-        NormalizedOrderbook() : isSnapshot(false), spread(0.0), midPrice(0.0), totalLevels(0) {}
+        NormalizedOrderbook() : isSnapshot(false), sequence(0), firstSequence(0), checksum(0), hasChecksum(false), checksumScheme(ChecksumScheme::None), spread(0.0), midPrice(0.0), totalLevels(0) {}
+    };
+
+    // Pin payload: the books parsed from one message batch, in arrival order
+    class OrderbookBatchData : public NodeData
+    {
+    public:
+        std::vector<NormalizedOrderbook> books;
+
+        std::unique_ptr<NodeData> Clone() const override { return std::make_unique<OrderbookBatchData>(*this); }
+        std::type_index GetTypeIndex() const override { return std::type_index(typeid(OrderbookBatchData)); }
     };
 
     // Base class for message processors
@@ -90,13 +81,38 @@ namespace gui::editor
         void RenderStatistics();
         void RenderErrorLog();
         void ProcessIncomingMessages();
+        // Parses one batch; temporaries go to the thread arena, which is reset at the end
+        void ProcessMessageBatch(const std::vector<FilteredMessage>& batch);
         
         virtual void ProcessMessage(const FilteredMessage& message) = 0;
         virtual void ValidateNormalizedData() = 0;
+        // Publishes what the batch produced; called once after its last ProcessMessage
+        void FlushOutputs();
+        
+        // Books parsed this batch, published on the "Orderbooks" pin by FlushOutputs
+        void QueueOrderbook(const NormalizedOrderbook& orderbook);
+        std::shared_ptr<OrderbookBatchData> m_pendingBooks; // A fresh batch per flush; consumers keep the last
+        
+        // Trades parsed this batch, published on the "Trades" MessageStream pin by FlushOutputs
+        void EmitTrade(const TradeRecord& trade);
+        void FlushTradeBatch();
+        TradeBatchLayout m_outputLayout = TradeBatchLayout::Rows;
+        std::shared_ptr<TradeRowBatchData> m_pendingRows;       // Whichever layout is active;
+        std::shared_ptr<TradeColumnBatchData> m_pendingColumns; // a fresh batch per flush
         
-        void AddError(const std::string& error, const std::string& messageId = "");
+        void AddError(std::string_view error, std::string_view messageId = {});
         void UpdateStatistics(float processingTime, bool success);
         
+        // Decimal scales per instrument (from InstrumentData precisions)
+        void SetInstrumentScale(uint32_t symbolId, DecimalScale scale) { m_instrumentScales[symbolId] = scale; }
+        DecimalScale GetInstrumentScale(uint32_t symbolId) const;
+        // Refills the scales from the instrument registry when it has changed; once per batch
+        void SyncInstrumentScales();
+        // Recompiles decoders when their configuration was edited since the last batch
+        virtual void SyncDecoderConfig() {}
+        // Venue whose definitions win for a symbol listed on several; empty = first found
+        virtual std::string_view GetVenue() const { return {}; }
+        
         std::string m_messageType; // "Trade" or "Orderbook"
         std::string m_format;      // "JSON" or "FIX"
         
@@ -105,6 +121,9 @@ namespace gui::editor
         bool m_enableErrorLogging;
         bool m_strictMode; // Reject messages with any validation errors
         int m_maxErrorsBeforeDisable;
+        std::unordered_map<uint32_t, DecimalScale> m_instrumentScales; // Keyed by symbolId
+        DecimalScale m_defaultScale; // Used until the instrument is known
+        uint64_t m_scaleGeneration = 0; // Registry generation m_instrumentScales was filled from
         
         // Statistics
         int m_processedCount;
@@ -112,17 +131,19 @@ namespace gui::editor
         int m_errorCount;
         float m_averageProcessingTime;
         
-        // Error handling
+        // Error handling - fixed-size entries in a ring so logging never allocates
         struct ProcessingError
         {
-            std::string timestamp;
-            std::string messageId;
-            std::string error;
-            std::string messageSnippet;
+            char timestamp[32];
+            char messageId[64];
+            char error[160];
+            char messageSnippet[96];
         };
         
-        std::vector<ProcessingError> m_errors;
         static constexpr int MAX_ERROR_LOG_SIZE = 100;
+        std::array<ProcessingError, MAX_ERROR_LOG_SIZE> m_errors;
+        int m_errorLogHead;  // Next slot to write
+        int m_errorLogCount; // Valid entries (<= MAX_ERROR_LOG_SIZE)
         
     private:
         void CleanupErrorLog();
@@ -138,14 +159,16 @@ namespace gui::editor
     protected:
         void ProcessMessage(const FilteredMessage& message) override;
         void ValidateNormalizedData() override;
+        std::string_view GetVenue() const override { return m_presetExchange; }
+        void SyncDecoderConfig() override;
 
     private:
         void RenderJsonTradeConfiguration();
-        NormalizedTrade ParseJsonTrade(const std::string& jsonMessage);
-        std::string ExtractJsonField(const std::string& json, const std::string& fieldPath);
-        double ParsePrice(const std::string& priceStr);
-        double ParseQuantity(const std::string& quantityStr);
-        std::chrono::system_clock::time_point ParseTimestamp(const std::string& timestampStr);
+        TradeRecord ParseJsonTrade(const std::string& jsonMessage); // Generic mapping; symbolId 0 when unusable
+        std::string_view ExtractJsonField(std::string_view json, std::string_view fieldPath); // View into json
+        Decimal ParsePrice(std::string_view priceStr, int scale);       // Exact, no strtod
+        Decimal ParseQuantity(std::string_view quantityStr, int scale); // Exact, no strtod
+        std::chrono::system_clock::time_point ParseTimestamp(std::string_view timestampStr);
         
         // JSON field mapping configuration
         struct JsonTradeMapping
@@ -183,6 +206,13 @@ namespace gui::editor
         bool m_requireOrderId;
         bool m_requireFeeInfo;
         
+        // Compile-time decoder for the configured exchange's schema
+        char m_presetExchange[32]; // e.g. "Binance"; empty = generic mapping path
+        const ExchangeTradePreset* m_tradePreset; // nullptr -> generic mapping path
+        std::vector<TradeRecord> m_decodedTrades; // Reused across messages
+        void SelectPresetDecoder(); // Call after editing m_presetExchange; SyncDecoderConfig does
+        uint64_t m_decoderConfigHash = 0; // m_presetExchange the decoder was selected for
+        
         // UI state
         bool m_mappingExpanded;
         bool m_validationExpanded;
@@ -198,11 +228,17 @@ namespace gui::editor
     protected:
         void ProcessMessage(const FilteredMessage& message) override;
         void ValidateNormalizedData() override;
+        std::string_view GetVenue() const override { return m_venueName[0] != '\0' ? m_venueName : m_presetExchange; }
+        void SyncDecoderConfig() override;
 
     private:
         void RenderJsonOrderbookConfiguration();
-        NormalizedOrderbook ParseJsonOrderbook(const std::string& jsonMessage);
-        std::vector<NormalizedOrderbookLevel> ParseOrderbookLevels(const std::string& levelsJson);
+        // Parses into m_workingOrderbook; bids/asks keep their capacity between messages
+        bool ParseJsonOrderbook(const std::string& jsonMessage, NormalizedOrderbook& orderbook);
+        bool ParseOrderbookLevels(std::string_view levelsJson, DecimalScale scale,
+                                  std::vector<NormalizedOrderbookLevel>& levels);
+        void RebuildLevelLayout(); // Call after editing m_jsonMapping, m_maxLevelsPerSide or m_presetExchange; SyncDecoderConfig does
+        uint64_t m_layoutConfigHash = 0; // Configuration m_levelLayout was compiled from
         
         // JSON field mapping configuration
         struct JsonOrderbookMapping
@@ -215,6 +251,8 @@ namespace gui::editor
             char priceField[64];    // Within each level
             char quantityField[64]; // Within each level
             char countField[64];    // Order count within each level
+            char sequenceField[64];      // Final update id; empty = unsequenced
+            char firstSequenceField[64]; // First update id of a delta; empty = same as sequence
             
             JsonOrderbookMapping() {
                 strcpy(orderbookIdField, "id");
@@ -225,9 +263,17 @@ namespace gui::editor
                 strcpy(priceField, "0");      // Array index or field name
                 strcpy(quantityField, "1");   // Array index or field name
                 strcpy(countField, "count");
+                sequenceField[0] = '\0';
+                firstSequenceField[0] = '\0';
             }
         } m_jsonMapping;
         
+        JsonLevelLayout m_levelLayout;       // Compiled from m_jsonMapping
+        NormalizedOrderbook m_workingOrderbook; // Reused for every message
+        char m_presetExchange[32]; // Exchange whose compile-time decoder to use; empty = generic mapping
+        const ExchangeOrderbookPreset* m_orderbookPreset; // nullptr -> generic mapping path
+        char m_venueName[32]; // Venue stamped on every book, e.g. for consolidation; empty = source connection
+        
         // Processing configuration
         bool m_calculateSpread;
         bool m_calculateMidPrice;
@@ -253,9 +299,9 @@ namespace gui::editor
 
     private:
         void RenderFixTradeConfiguration();
-        NormalizedTrade ParseFixTrade(const std::string& fixMessage);
-        std::string GetFixField(const std::string& message, int tag);
-        std::string GetFixField(const std::string& message, const std::string& tagStr);
+        TradeRecord ParseFixTrade(const std::string& fixMessage); // symbolId 0 when it is not a usable trade
+        std::string_view GetFixField(std::string_view message, int tag); // View into message
+        std::string_view GetFixField(std::string_view message, std::string_view tagStr);
         
         // FIX tag mapping configuration
         struct FixTradeMapping
@@ -281,7 +327,9 @@ namespace gui::editor
         bool m_strictMsgTypeValidation;
         
         // Side mapping (FIX uses numbers)
-        std::string MapFixSide(const std::string& fixSide);
+        TradeSide MapFixSide(const std::string& fixSide);
+        
+        FixMessageView m_messageView; // Reused between messages
         
         // UI state
         bool m_mappingExpanded;
@@ -298,11 +346,15 @@ namespace gui::editor
     protected:
         void ProcessMessage(const FilteredMessage& message) override;
         void ValidateNormalizedData() override;
+        void SyncDecoderConfig() override;
 
     private:
         void RenderFixOrderbookConfiguration();
-        NormalizedOrderbook ParseFixOrderbook(const std::string& fixMessage);
-        void ParseFixMarketDataEntries(const std::string& message, NormalizedOrderbook& orderbook);
+        // Both W and X are applied in place to m_workingOrderbook without allocating
+        bool ParseFixOrderbook(const std::string& fixMessage, NormalizedOrderbook& orderbook);
+        void ParseFixMarketDataEntries(const FixMessageView& message, NormalizedOrderbook& orderbook);
+        void RebuildGroupDefinition(); // Call after editing m_fixMapping; SyncDecoderConfig does
+        uint64_t m_groupConfigHash = 0; // m_fixMapping the group definition was compiled from
         
         // FIX tag mapping configuration
         struct FixOrderbookMapping
@@ -315,13 +367,22 @@ namespace gui::editor
             int mdEntryPxTag;    // Usually 270 (MDEntryPx)
             int mdEntrySizeTag;  // Usually 271 (MDEntrySize)
             int mdEntryPositionNoTag; // Usually 290 (MDEntryPositionNo)
+            int mdUpdateActionTag; // Usually 279 (MDUpdateAction: 0=New, 1=Change, 2=Delete)
             
             FixOrderbookMapping()
                 : mdReqIdTag(262), symbolTag(55), timestampTag(60), noMdEntriesTag(268)
                 , mdEntryTypeTag(269), mdEntryPxTag(270), mdEntrySizeTag(271)
-                , mdEntryPositionNoTag(290) {}
+                , mdEntryPositionNoTag(290), mdUpdateActionTag(279) {}
         } m_fixMapping;
         
+        // Compiled from m_fixMapping
+        FixMarketDataTags m_mdTags;
+        FixGroupDefinition m_mdEntryGroup = FixMarketDataTags().MakeGroupDefinition();
+        
+        // Reused between messages
+        FixMessageView m_messageView;
+        NormalizedOrderbook m_workingOrderbook;
+        
         // FIX message type validation
         std::string m_expectedMsgType; // Usually "W" for MarketDataSnapshotFullRefresh
         bool m_processIncrementalUpdates; // Handle "X" MarketDataIncrementalRefresh
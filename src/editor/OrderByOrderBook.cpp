@@ -0,0 +1,256 @@
+#include "OrderByOrderBook.h"
+
+namespace gui
+{
+    namespace editor
+    {
+        OrderByOrderBook::OrderByOrderBook()
+            : m_orderIndex(1024)
+            , m_bidPriceIndex(256)
+            , m_askPriceIndex(256)
+            , m_pendingOwn(16)
+            , m_rejectedLevels(0)
+            , m_needsResync(false)
+        {
+        }
+
+        void OrderByOrderBook::Clear()
+        {
+            m_orderPool.clear();
+            m_freeOrders.clear();
+            m_levelPool.clear();
+            m_freeLevels.clear();
+            m_orderIndex.Clear();
+            m_bidPriceIndex.Clear();
+            m_askPriceIndex.Clear();
+            m_pendingOwn.Clear();
+            m_levels.Clear();
+            m_needsResync = false;
+        }
+
+        bool OrderByOrderBook::Apply(const L3OrderEvent& event)
+        {
+            switch (event.type)
+            {
+                case L3EventType::Add:
+                    return Add(event.orderId, event.isBid, event.price, event.quantity, event.timestampNs);
+                case L3EventType::Modify:
+                    return Modify(event.orderId, event.price, event.quantity, event.timestampNs);
+                case L3EventType::Cancel:
+                    return Cancel(event.orderId);
+                case L3EventType::Execute:
+                    return Execute(event.orderId, event.quantity);
+            }
+            return false;
+        }
+
+        bool OrderByOrderBook::Add(uint64_t orderId, bool isBid, Decimal price, Decimal quantity, int64_t timestampNs)
+        {
+            if (!quantity.IsPositive() || m_orderIndex.Find(orderId) != NONE)
+                return false;
+
+            const uint32_t index = AllocateOrder();
+            L3Order& order = m_orderPool[index];
+            order.orderId = orderId;
+            order.price = price;
+            order.quantity = quantity;
+            order.timestampNs = timestampNs;
+            order.isBid = isBid;
+            order.isOwn = m_pendingOwn.Erase(orderId);
+
+            m_orderIndex.Insert(orderId, index);
+            LinkOrder(index, AcquireLevel(isBid, price));
+            return true;
+        }
+
+        bool OrderByOrderBook::Modify(uint64_t orderId, Decimal price, Decimal quantity, int64_t timestampNs)
+        {
+            const uint32_t index = m_orderIndex.Find(orderId);
+            if (index == NONE)
+                return false;
+            if (!quantity.IsPositive())
+                return Cancel(orderId);
+
+            L3Order& order = m_orderPool[index];
+            Level& level = m_levelPool[order.level];
+
+            // A smaller size keeps time priority; a new price or a larger size goes to the back
+            if (price == order.price && quantity <= order.quantity)
+            {
+                level.totalQuantity -= order.quantity - quantity;
+                order.quantity = quantity;
+                PublishLevel(level);
+                return true;
+            }
+
+            UnlinkOrder(index);
+            order.price = price;
+            order.quantity = quantity;
+            order.timestampNs = timestampNs;
+            LinkOrder(index, AcquireLevel(order.isBid, price));
+            return true;
+        }
+
+        bool OrderByOrderBook::Cancel(uint64_t orderId)
+        {
+            const uint32_t index = m_orderIndex.Find(orderId);
+            if (index == NONE)
+                return false;
+            RemoveOrder(index);
+            return true;
+        }
+
+        bool OrderByOrderBook::Execute(uint64_t orderId, Decimal quantity)
+        {
+            const uint32_t index = m_orderIndex.Find(orderId);
+            if (!quantity.IsPositive() || index == NONE)
+                return false;
+
+            L3Order& order = m_orderPool[index];
+            if (quantity >= order.quantity)
+            {
+                RemoveOrder(index);
+                return true;
+            }
+
+            Level& level = m_levelPool[order.level];
+            order.quantity -= quantity;
+            level.totalQuantity -= quantity;
+            PublishLevel(level);
+            return true;
+        }
+
+        void OrderByOrderBook::MarkOwn(uint64_t orderId)
+        {
+            const uint32_t index = m_orderIndex.Find(orderId);
+            if (index != NONE)
+                m_orderPool[index].isOwn = true;
+            else
+                m_pendingOwn.Assign(orderId, 0);
+        }
+
+        bool OrderByOrderBook::GetQueuePosition(uint64_t orderId, L3QueuePosition& position) const
+        {
+            const uint32_t index = m_orderIndex.Find(orderId);
+            if (index == NONE)
+                return false;
+
+            const L3Order& order = m_orderPool[index];
+            const Level& level = m_levelPool[order.level];
+
+            position.ordersAhead = 0;
+            position.quantityAhead = Decimal();
+            position.levelQuantity = level.totalQuantity;
+            for (uint32_t i = level.head; i != index; i = m_orderPool[i].next)
+            {
+                position.ordersAhead++;
+                position.quantityAhead += m_orderPool[i].quantity;
+            }
+            return true;
+        }
+
+        const L3Order* OrderByOrderBook::FindOrder(uint64_t orderId) const
+        {
+            const uint32_t index = m_orderIndex.Find(orderId);
+            return index == NONE ? nullptr : &m_orderPool[index];
+        }
+
+        uint32_t OrderByOrderBook::AllocateOrder()
+        {
+            if (!m_freeOrders.empty())
+            {
+                const uint32_t index = m_freeOrders.back();
+                m_freeOrders.pop_back();
+                return index;
+            }
+            m_orderPool.emplace_back();
+            return static_cast<uint32_t>(m_orderPool.size() - 1);
+        }
+
+        uint32_t OrderByOrderBook::AcquireLevel(bool isBid, Decimal price)
+        {
+            FlatHashIndex& prices = PriceIndex(isBid);
+            const auto key = static_cast<uint64_t>(price.units);
+            uint32_t index = prices.Find(key);
+            if (index != NONE)
+                return index;
+
+            if (!m_freeLevels.empty())
+            {
+                index = m_freeLevels.back();
+                m_freeLevels.pop_back();
+            }
+            else
+            {
+                m_levelPool.emplace_back();
+                index = static_cast<uint32_t>(m_levelPool.size() - 1);
+            }
+
+            m_levelPool[index] = Level{price, Decimal(), 0, NONE, NONE, isBid};
+            prices.Insert(key, index);
+            return index;
+        }
+
+        void OrderByOrderBook::LinkOrder(uint32_t orderIndex, uint32_t levelIndex)
+        {
+            L3Order& order = m_orderPool[orderIndex];
+            Level& level = m_levelPool[levelIndex];
+
+            order.level = levelIndex;
+            order.prev = level.tail;
+            order.next = NONE;
+            if (level.tail != NONE)
+                m_orderPool[level.tail].next = orderIndex;
+            else
+                level.head = orderIndex;
+            level.tail = orderIndex;
+
+            level.totalQuantity += order.quantity;
+            level.orderCount++;
+            PublishLevel(level);
+        }
+
+        void OrderByOrderBook::UnlinkOrder(uint32_t orderIndex)
+        {
+            L3Order& order = m_orderPool[orderIndex];
+            Level& level = m_levelPool[order.level];
+
+            if (order.prev != NONE)
+                m_orderPool[order.prev].next = order.next;
+            else
+                level.head = order.next;
+            if (order.next != NONE)
+                m_orderPool[order.next].prev = order.prev;
+            else
+                level.tail = order.prev;
+
+            level.totalQuantity -= order.quantity;
+            level.orderCount--;
+            PublishLevel(level);
+
+            if (level.orderCount == 0)
+            {
+                PriceIndex(level.isBid).Erase(static_cast<uint64_t>(level.price.units));
+                m_freeLevels.push_back(order.level);
+            }
+            order.level = NONE;
+        }
+
+        void OrderByOrderBook::RemoveOrder(uint32_t orderIndex)
+        {
+            UnlinkOrder(orderIndex);
+            m_orderIndex.Erase(m_orderPool[orderIndex].orderId);
+            m_freeOrders.push_back(orderIndex);
+        }
+
+        void OrderByOrderBook::PublishLevel(const Level& level)
+        {
+            if (!m_levels.SetLevel(level.isBid, level.price,
+                                   level.orderCount > 0 ? level.totalQuantity : Decimal(), level.orderCount))
+            {
+                m_rejectedLevels++;
+                m_needsResync = true;
+            }
+        }
+    } // editor
+} // gui
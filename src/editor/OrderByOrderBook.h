@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Decimal.h"
+#include "FlatHashIndex.h"
+#include "PriceLadderBook.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace gui::editor
+{
+    enum class L3EventType : uint8_t
+    {
+        Add,
+        Modify,  // New price and/or quantity for a resting order
+        Cancel,
+        Execute  // quantity = executed amount
+    };
+
+    // One message from a per-order (L3) feed
+    struct L3OrderEvent
+    {
+        L3EventType type;
+        uint64_t orderId;
+        Decimal price;
+        Decimal quantity;
+        int64_t timestampNs;
+        bool isBid;
+    };
+
+    struct L3Order
+    {
+        uint64_t orderId;
+        Decimal price;
+        Decimal quantity;    // Remaining
+        int64_t timestampNs; // Time priority
+        uint32_t prev;       // Intrusive FIFO links within the level (pool indices)
+        uint32_t next;
+        uint32_t level;      // Owning level (pool index)
+        bool isBid;
+        bool isOwn;          // One of our orders; queue position is tracked for these
+    };
+
+    struct L3QueuePosition
+    {
+        int ordersAhead;
+        Decimal quantityAhead;
+        Decimal levelQuantity;
+    };
+
+    // Order-by-order book. Orders and levels live in pools addressed by index; the
+    // orderId and price indexes are open-addressing tables, and each level keeps its
+    // orders in an intrusive FIFO, so add/modify/cancel/execute are O(1). The L2
+    // view (a PriceLadderBook) is updated with each level change rather than rebuilt.
+    class OrderByOrderBook
+    {
+    public:
+        static constexpr uint32_t NONE = FlatHashIndex::NOT_FOUND;
+
+        OrderByOrderBook();
+
+        void Clear();
+
+        bool Apply(const L3OrderEvent& event);
+        bool Add(uint64_t orderId, bool isBid, Decimal price, Decimal quantity, int64_t timestampNs);
+        bool Modify(uint64_t orderId, Decimal price, Decimal quantity, int64_t timestampNs);
+        bool Cancel(uint64_t orderId);
+        bool Execute(uint64_t orderId, Decimal quantity);
+
+        // Own orders; MarkOwn may be called before or after the order appears on the feed
+        void MarkOwn(uint64_t orderId);
+        bool GetQueuePosition(uint64_t orderId, L3QueuePosition& position) const; // O(orders ahead)
+
+        const L3Order* FindOrder(uint64_t orderId) const;
+        size_t GetOrderCount() const { return m_orderIndex.Size(); }
+        const PriceLadderBook& GetLevels() const { return m_levels; }
+
+        // A level the L2 view rejected (off its tick grid) leaves the view out of step with
+        // the orders; the owner should Clear() and rebuild. Clear() resets the flag.
+        bool NeedsResync() const { return m_needsResync; }
+        uint64_t GetRejectedLevelCount() const { return m_rejectedLevels; }
+
+    private:
+        struct Level
+        {
+            Decimal price;
+            Decimal totalQuantity;
+            int orderCount;
+            uint32_t head;
+            uint32_t tail;
+            bool isBid;
+        };
+
+        uint32_t AllocateOrder();
+        uint32_t AcquireLevel(bool isBid, Decimal price);
+        void LinkOrder(uint32_t orderIndex, uint32_t levelIndex);   // Appends to the FIFO tail
+        void UnlinkOrder(uint32_t orderIndex);                      // Releases the level when it empties
+        void RemoveOrder(uint32_t orderIndex);
+        void PublishLevel(const Level& level);                      // Pushes one level into the L2 view
+
+        FlatHashIndex& PriceIndex(bool isBid) { return isBid ? m_bidPriceIndex : m_askPriceIndex; }
+
+        std::vector<L3Order> m_orderPool;
+        std::vector<uint32_t> m_freeOrders;
+        std::vector<Level> m_levelPool;
+        std::vector<uint32_t> m_freeLevels;
+
+        FlatHashIndex m_orderIndex;    // orderId -> order pool index
+        FlatHashIndex m_bidPriceIndex; // price units -> level pool index
+        FlatHashIndex m_askPriceIndex;
+        FlatHashIndex m_pendingOwn;    // Own orderIds not yet seen on the feed
+
+        PriceLadderBook m_levels;      // Derived L2 view
+        uint64_t m_rejectedLevels;
+        bool m_needsResync;
+    };
+}
@@ -0,0 +1,100 @@
+#include "OrderLifecycle.h"
+
+#include <algorithm>
+
+namespace gui
+{
+    namespace editor
+    {
+        static_assert(LookupTransition(OrderStatus::Filled, OrderEvent::Acknowledged).action == TransitionAction::Ignore,
+                      "A late acknowledgement must not reopen a filled order");
+        static_assert(LookupTransition(OrderStatus::Cancelled, OrderEvent::Fill).action == TransitionAction::Reject,
+                      "Conflicting terminal reports must be flagged");
+
+        OrderTransition DecideTransition(const OrderRecord& order, OrderEvent event, const Decimal* cumQty)
+        {
+            // A report that completes the order is a fill, whatever status came with it. Venues
+            // whose terminal status does not say how the order ended (Coinbase "done") map to
+            // Cancelled, so that is corrected here too.
+            if ((event == OrderEvent::PartialFill || event == OrderEvent::Cancelled) && cumQty &&
+                order.originalQuantity.IsPositive() && *cumQty >= order.originalQuantity)
+                event = OrderEvent::Fill;
+
+            OrderTransition transition = LookupTransition(order.status, event);
+            if (transition.action != TransitionAction::Apply)
+                return transition;
+
+            if (cumQty)
+            {
+                if (order.originalQuantity.IsPositive() && *cumQty > order.originalQuantity &&
+                    event != OrderEvent::Replaced)
+                    return OrderTransition{order.status, TransitionAction::Reject};
+
+                // Older than what we already know; terminal reports still end the order
+                if (*cumQty < order.filledQuantity && !IsTerminal(transition.next))
+                    return OrderTransition{order.status, TransitionAction::Ignore};
+            }
+
+            const Decimal filled = cumQty ? std::max(*cumQty, order.filledQuantity) : order.filledQuantity;
+            if (transition.next == OrderStatus::Open && filled.IsPositive())
+                transition.next = OrderStatus::PartiallyFilled;
+            return transition;
+        }
+
+        OrderEvent EventFromStatus(OrderStatus status)
+        {
+            switch (status)
+            {
+                case OrderStatus::Pending:         return OrderEvent::Restated; // Nothing new for an order we sent
+                case OrderStatus::Open:            return OrderEvent::Acknowledged;
+                case OrderStatus::PartiallyFilled: return OrderEvent::PartialFill;
+                case OrderStatus::Filled:          return OrderEvent::Fill;
+                case OrderStatus::Cancelled:       return OrderEvent::Cancelled;
+                case OrderStatus::Rejected:        return OrderEvent::Rejected;
+                case OrderStatus::Expired:         return OrderEvent::Expired;
+                case OrderStatus::PendingCancel:   return OrderEvent::PendingCancel;
+                case OrderStatus::PendingReplace:  return OrderEvent::PendingReplace;
+            }
+            return OrderEvent::Restated;
+        }
+
+        bool EventFromFix(char execType, char orderStatus, OrderEvent& out)
+        {
+            switch (execType)
+            {
+                case '0': out = OrderEvent::Acknowledged; return true;
+                case '4': out = OrderEvent::Cancelled; return true;
+                case '5': out = OrderEvent::Replaced; return true;
+                case '6': out = OrderEvent::PendingCancel; return true;
+                case '8': out = OrderEvent::Rejected; return true;
+                case 'C': out = OrderEvent::Expired; return true;
+                case 'D': out = OrderEvent::Restated; return true;
+                case 'E': out = OrderEvent::PendingReplace; return true;
+                default:  break; // Trade (F), status (I) and FIX 4.2 fill types: OrdStatus says where it stands
+            }
+            OrderStatus status;
+            if (!ParseOrderStatus(std::string_view(&orderStatus, orderStatus != '\0' ? 1 : 0), status))
+                return false;
+            out = EventFromStatus(status);
+            return true;
+        }
+
+        const char* OrderEventToString(OrderEvent event)
+        {
+            switch (event)
+            {
+                case OrderEvent::Acknowledged:   return "acknowledged";
+                case OrderEvent::PartialFill:    return "partial_fill";
+                case OrderEvent::Fill:           return "fill";
+                case OrderEvent::PendingCancel:  return "pending_cancel";
+                case OrderEvent::Cancelled:      return "cancelled";
+                case OrderEvent::PendingReplace: return "pending_replace";
+                case OrderEvent::Replaced:       return "replaced";
+                case OrderEvent::Rejected:       return "rejected";
+                case OrderEvent::Expired:        return "expired";
+                case OrderEvent::Restated:       return "restated";
+            }
+            return "";
+        }
+    } // editor
+} // gui
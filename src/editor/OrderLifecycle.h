@@ -0,0 +1,114 @@
+#pragma once
+
+#include "OrderStore.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace gui::editor
+{
+    // What a report says happened to an order, whatever protocol carried it
+    enum class OrderEvent : uint8_t
+    {
+        Acknowledged,   // FIX ExecType 0 / "open", "new"
+        PartialFill,
+        Fill,
+        PendingCancel,
+        Cancelled,
+        PendingReplace,
+        Replaced,       // FIX ExecType 5
+        Rejected,
+        Expired,
+        Restated        // FIX ExecType D, or a status report that changes nothing
+    };
+
+    constexpr size_t ORDER_EVENT_COUNT = 10;
+
+    enum class TransitionAction : uint8_t
+    {
+        Apply,  // Move to OrderTransition::next
+        Ignore, // Duplicate or stale (e.g. a late "open" after "filled"); drop silently
+        Defer,  // Needs an event that has not arrived yet; queue and retry
+        Reject  // Impossible for this order (e.g. "filled" after "cancelled"); report it
+    };
+
+    struct OrderTransition
+    {
+        OrderStatus next;
+        TransitionAction action;
+    };
+
+    using OrderTransitionTable = std::array<std::array<OrderTransition, ORDER_EVENT_COUNT>, ORDER_STATUS_COUNT>;
+
+    constexpr OrderTransitionTable MakeOrderTransitionTable()
+    {
+        using S = OrderStatus;
+        using E = OrderEvent;
+        using A = TransitionAction;
+
+        OrderTransitionTable table{};
+        auto set = [&table](S from, E event, S next, A action) {
+            table[static_cast<size_t>(from)][static_cast<size_t>(event)] = OrderTransition{next, action};
+        };
+
+        // Live states: fills and cancel/replace flow forward; a repeated or late ack is stale.
+        // While a cancel/replace is pending, an ack or restatement says the request went
+        // nowhere (rejected, or the venue restated the order as working): back to working.
+        for (S from : {S::Pending, S::Open, S::PartiallyFilled, S::PendingCancel, S::PendingReplace})
+        {
+            const bool pendingRequest = from == S::PendingCancel || from == S::PendingReplace;
+            set(from, E::Acknowledged, S::Open, from == S::Pending || pendingRequest ? A::Apply : A::Ignore);
+            set(from, E::PartialFill, pendingRequest ? from : S::PartiallyFilled, A::Apply);
+            set(from, E::Fill, S::Filled, A::Apply);
+            set(from, E::PendingCancel, S::PendingCancel, from == S::PendingCancel ? A::Ignore : A::Apply);
+            set(from, E::Cancelled, S::Cancelled, A::Apply);
+            set(from, E::PendingReplace, S::PendingReplace, from == S::PendingReplace ? A::Ignore : A::Apply);
+            set(from, E::Replaced, S::Open, from == S::Pending ? A::Defer : A::Apply); // Replace confirmed before the ack
+            set(from, E::Rejected, S::Rejected, from == S::Pending ? A::Apply : A::Reject);
+            set(from, E::Expired, S::Expired, A::Apply);
+            set(from, E::Restated, pendingRequest ? S::Open : from, A::Apply);
+        }
+
+        // Terminal states: anything non-terminal is late, the same end is a duplicate,
+        // a different end contradicts what the venue already told us
+        for (S from : {S::Filled, S::Cancelled, S::Rejected, S::Expired})
+        {
+            for (size_t event = 0; event < ORDER_EVENT_COUNT; event++)
+                table[static_cast<size_t>(from)][event] = OrderTransition{from, A::Ignore};
+
+            const std::pair<E, S> ends[] = {{E::Fill, S::Filled}, {E::Cancelled, S::Cancelled},
+                                            {E::Rejected, S::Rejected}, {E::Expired, S::Expired}};
+            for (const auto& [event, end] : ends)
+            {
+                if (end != from)
+                    set(from, event, from, A::Reject);
+            }
+            if (from == S::Rejected)
+                set(from, E::PartialFill, from, A::Reject); // A rejected order never traded
+        }
+        return table;
+    }
+
+    inline constexpr OrderTransitionTable ORDER_TRANSITIONS = MakeOrderTransitionTable();
+
+    constexpr OrderTransition LookupTransition(OrderStatus from, OrderEvent event)
+    {
+        return ORDER_TRANSITIONS[static_cast<size_t>(from)][static_cast<size_t>(event)];
+    }
+
+    // Table lookup plus the quantity rules: a cumulative quantity below what the order
+    // already filled marks the report as stale, one above the order quantity is
+    // impossible, a working order with fills is PartiallyFilled rather than Open, and a
+    // partial fill or cancel whose cumulative quantity covers the order is a fill.
+    // cumQty may be null when the report does not carry it.
+    OrderTransition DecideTransition(const OrderRecord& order, OrderEvent event, const Decimal* cumQty);
+
+    // Protocol mappings
+    OrderEvent EventFromStatus(OrderStatus status);           // WebSocket/REST status fields
+    // FIX ExecType (150) and OrdStatus (39); false when neither says what happened
+    bool EventFromFix(char execType, char orderStatus, OrderEvent& out);
+
+    const char* OrderEventToString(OrderEvent event);
+}
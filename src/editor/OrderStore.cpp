@@ -0,0 +1,584 @@
+#include "OrderStore.h"
+#include "OrderLifecycle.h"
+#include "StateUpdaters.h"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+
+namespace gui
+{
+    namespace editor
+    {
+        namespace
+        {
+            uint64_t HashText(std::string_view text)
+            {
+                uint64_t hash = 14695981039346656037ull; // FNV-1a
+                for (char c : text)
+                {
+                    hash ^= static_cast<uint8_t>(c);
+                    hash *= 1099511628211ull;
+                }
+                return hash;
+            }
+
+            bool EqualsIgnoreCase(std::string_view text, std::string_view lower)
+            {
+                if (text.size() != lower.size())
+                    return false;
+                for (size_t i = 0; i < text.size(); i++)
+                {
+                    if (std::tolower(static_cast<unsigned char>(text[i])) != lower[i])
+                        return false;
+                }
+                return true;
+            }
+
+            int64_t ToNanoseconds(std::chrono::system_clock::time_point time)
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+            }
+
+            std::chrono::system_clock::time_point FromNanoseconds(int64_t nanoseconds)
+            {
+                return std::chrono::system_clock::time_point(
+                    std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(nanoseconds)));
+            }
+        }
+
+        OrderType ParseOrderType(std::string_view type)
+        {
+            if (type.size() == 1)
+            {
+                switch (type[0])
+                {
+                    case '1': return OrderType::Market;
+                    case '2': return OrderType::Limit;
+                    case '3': return OrderType::Stop;
+                    case '4': return OrderType::StopLimit;
+                    default: return OrderType::Unknown;
+                }
+            }
+            if (EqualsIgnoreCase(type, "market"))
+                return OrderType::Market;
+            if (EqualsIgnoreCase(type, "limit"))
+                return OrderType::Limit;
+            if (EqualsIgnoreCase(type, "stop") || EqualsIgnoreCase(type, "stop_loss"))
+                return OrderType::Stop;
+            if (EqualsIgnoreCase(type, "stop_limit") || EqualsIgnoreCase(type, "stop_loss_limit"))
+                return OrderType::StopLimit;
+            return OrderType::Unknown;
+        }
+
+        const char* OrderTypeToString(OrderType type)
+        {
+            switch (type)
+            {
+                case OrderType::Market:    return "market";
+                case OrderType::Limit:     return "limit";
+                case OrderType::Stop:      return "stop";
+                case OrderType::StopLimit: return "stop_limit";
+                case OrderType::Unknown:   break;
+            }
+            return "";
+        }
+
+        bool ParseOrderStatus(std::string_view status, OrderStatus& out)
+        {
+            if (status.size() == 1)
+            {
+                switch (status[0])
+                {
+                    case 'A': out = OrderStatus::Pending; return true; // PendingNew
+                    case '0': out = OrderStatus::Open; return true;
+                    case '1': out = OrderStatus::PartiallyFilled; return true;
+                    case '2': out = OrderStatus::Filled; return true;
+                    case '4': out = OrderStatus::Cancelled; return true;
+                    case '8': out = OrderStatus::Rejected; return true;
+                    case 'C': out = OrderStatus::Expired; return true;
+                    case '6': out = OrderStatus::PendingCancel; return true;
+                    case 'E': out = OrderStatus::PendingReplace; return true;
+                    case '3':             // Done for day
+                    case '5':             // Replaced (FIX 4.2)
+                    case '7':             // Stopped
+                    case '9':             // Suspended
+                    case 'B':             // Calculated
+                    case 'D':             // Accepted for bidding
+                        out = OrderStatus::Open; // Still live at the venue
+                        return true;
+                    default:
+                        return false;
+                }
+            }
+
+            // Venue vocabularies; terminal words that do not say how the order ended map to
+            // Cancelled, and DecideTransition turns them into a fill when CumQty covers the order
+            struct StatusName
+            {
+                std::string_view text;
+                OrderStatus status;
+            };
+            static constexpr StatusName NAMES[] = {
+                {"pending", OrderStatus::Pending},
+                {"pending_new", OrderStatus::Pending},
+                {"received", OrderStatus::Pending},         // Coinbase Exchange
+                {"queued", OrderStatus::Pending},           // Coinbase Advanced Trade
+                {"open", OrderStatus::Open},
+                {"new", OrderStatus::Open},
+                {"active", OrderStatus::Open},
+                {"live", OrderStatus::Open},                // OKX
+                {"partially_filled", OrderStatus::PartiallyFilled},
+                {"partiallyfilled", OrderStatus::PartiallyFilled},
+                {"partially filled", OrderStatus::PartiallyFilled}, // Bitfinex
+                {"filled", OrderStatus::Filled},
+                {"closed", OrderStatus::Filled},            // Kraken: fully executed
+                {"executed", OrderStatus::Filled},          // Bitfinex
+                {"done", OrderStatus::Cancelled},           // Coinbase Exchange: filled or cancelled
+                {"cancelled", OrderStatus::Cancelled},
+                {"canceled", OrderStatus::Cancelled},
+                {"mmp_canceled", OrderStatus::Cancelled},   // OKX market maker protection
+                {"rejected", OrderStatus::Rejected},
+                {"failed", OrderStatus::Rejected},          // Coinbase Advanced Trade
+                {"expired", OrderStatus::Expired},
+                {"expired_in_match", OrderStatus::Expired}, // Binance self-trade prevention
+                {"pending_cancel", OrderStatus::PendingCancel},
+                {"cancel_queued", OrderStatus::PendingCancel}, // Coinbase Advanced Trade
+                {"pending_replace", OrderStatus::PendingReplace},
+            };
+            for (const StatusName& name : NAMES)
+            {
+                if (EqualsIgnoreCase(status, name.text))
+                {
+                    out = name.status;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        const char* OrderStatusToString(OrderStatus status)
+        {
+            switch (status)
+            {
+                case OrderStatus::Pending:         return "pending";
+                case OrderStatus::Open:            return "open";
+                case OrderStatus::PartiallyFilled: return "partially_filled";
+                case OrderStatus::Filled:          return "filled";
+                case OrderStatus::Cancelled:       return "cancelled";
+                case OrderStatus::Rejected:        return "rejected";
+                case OrderStatus::Expired:         return "expired";
+                case OrderStatus::PendingCancel:   return "pending_cancel";
+                case OrderStatus::PendingReplace:  return "pending_replace";
+            }
+            return "";
+        }
+
+        OrderStore::OrderStore(size_t initialCapacity, size_t changeCapacity)
+            : m_orderIndex(initialCapacity * 2)
+            , m_clientOrderIndex(initialCapacity * 2)
+            , m_fillIndex(initialCapacity * 4)
+            , m_size(0)
+            , m_changeSequence(0)
+        {
+            m_records.reserve(initialCapacity);
+            m_details.reserve(initialCapacity);
+            m_changes.resize(std::bit_ceil(std::max<size_t>(changeCapacity, 16)));
+        }
+
+        uint64_t OrderStore::MakeKey(uint16_t exchangeId, std::string_view id)
+        {
+            if (id.empty())
+                return 0;
+            const uint64_t key = HashText(id) ^ (static_cast<uint64_t>(exchangeId) * 0x9E3779B97F4A7C15ull);
+            return key != 0 ? key : 1; // 0 means "no id"
+        }
+
+        uint64_t OrderStore::MakeFillKey(uint16_t exchangeId, uint32_t symbolId, std::string_view fillId)
+        {
+            // Venues number executions per symbol at most, so the id is unique within one stream
+            if (fillId.empty())
+                return 0;
+            const uint64_t key = HashText(fillId) ^ (TradeStreamKey(exchangeId, symbolId) * 0x9E3779B97F4A7C15ull);
+            return key != 0 ? key : 1;
+        }
+
+        uint32_t OrderStore::FindByOrderId(uint16_t exchangeId, std::string_view orderId) const
+        {
+            const uint64_t key = MakeKey(exchangeId, orderId);
+            const uint32_t slot = key != 0 ? m_orderIndex.Find(key) : INVALID_SLOT;
+            // The index is keyed by a hash; the stored id decides
+            if (slot == INVALID_SLOT || m_records[slot].exchangeId != exchangeId || m_details[slot].orderId != orderId)
+                return INVALID_SLOT;
+            return slot;
+        }
+
+        uint32_t OrderStore::FindByClientOrderId(uint16_t exchangeId, std::string_view clientOrderId) const
+        {
+            const uint64_t key = MakeKey(exchangeId, clientOrderId);
+            const uint32_t slot = key != 0 ? m_clientOrderIndex.Find(key) : INVALID_SLOT;
+            if (slot == INVALID_SLOT || m_records[slot].exchangeId != exchangeId ||
+                m_details[slot].clientOrderId != clientOrderId)
+                return INVALID_SLOT;
+            return slot;
+        }
+
+        uint32_t OrderStore::AllocateSlot()
+        {
+            if (!m_freeSlots.empty())
+            {
+                const uint32_t slot = m_freeSlots.back();
+                m_freeSlots.pop_back();
+                return slot;
+            }
+            m_records.emplace_back();
+            m_details.emplace_back();
+            m_generations.push_back(0);
+            return static_cast<uint32_t>(m_records.size() - 1);
+        }
+
+        uint32_t OrderStore::Add(const OrderState& order)
+        {
+            TradeStringTable& strings = GetTradeStringTable();
+            uint16_t exchangeId = 0;
+            uint16_t accountId = 0;
+            if (!strings.InternName(order.exchange, exchangeId))
+                return INVALID_SLOT; // Name pool full: the order could not be keyed by venue
+            strings.InternName(order.account, accountId); // 0 (no account) when the pool is full
+            const uint64_t orderKey = MakeKey(exchangeId, order.orderId);
+            const uint64_t clientOrderKey = MakeKey(exchangeId, order.clientOrderId);
+            if (orderKey == 0 && clientOrderKey == 0)
+                return INVALID_SLOT;
+            if ((orderKey != 0 && m_orderIndex.Find(orderKey) != FlatHashIndex::NOT_FOUND) ||
+                (clientOrderKey != 0 && m_clientOrderIndex.Find(clientOrderKey) != FlatHashIndex::NOT_FOUND))
+                return INVALID_SLOT;
+            // A listed order without a status is working; one we cannot read is not guessed at
+            OrderStatus status = OrderStatus::Open;
+            if (!order.status.empty() && !ParseOrderStatus(order.status, status))
+                return INVALID_SLOT;
+
+            const uint32_t slot = AllocateSlot();
+            OrderRecord& record = m_records[slot];
+            record = OrderRecord{};
+            record.orderKey = orderKey;
+            record.clientOrderKey = clientOrderKey;
+            record.price = order.price;
+            record.originalQuantity = order.originalQuantity;
+            record.filledQuantity = order.filledQuantity;
+            record.updateTimeNs = ToNanoseconds(order.updateTime);
+            record.lastFill = NO_FILL;
+            record.symbolId = strings.Intern(order.currencyPair);
+            record.exchangeId = exchangeId;
+            record.accountId = accountId;
+            record.status = status;
+            record.side = ParseTradeSide(order.side);
+            record.type = ParseOrderType(order.type);
+            record.inUse = 1;
+
+            OrderDetails& details = m_details[slot];
+            details = OrderDetails();
+            details.orderId = order.orderId;
+            details.clientOrderId = order.clientOrderId;
+            details.rejectReason = order.rejectReason;
+            details.scale = order.scale;
+            details.createTimeNs = ToNanoseconds(order.createTime);
+            details.lastFillTimeNs = ToNanoseconds(order.lastFillTime);
+            details.fillNotional = order.averageFillPrice * order.filledQuantity.ToDouble(order.scale.quantity);
+
+            if (orderKey != 0)
+                m_orderIndex.Insert(orderKey, slot);
+            if (clientOrderKey != 0)
+                m_clientOrderIndex.Insert(clientOrderKey, slot);
+            m_size++;
+            Notify(slot, OrderChangeType::Added);
+            return slot;
+        }
+
+        bool OrderStore::AssignOrderId(uint32_t slot, std::string_view orderId)
+        {
+            OrderRecord& record = m_records[slot];
+            OrderDetails& details = m_details[slot];
+            if (details.orderId == orderId)
+                return true;
+
+            const uint64_t key = MakeKey(record.exchangeId, orderId);
+            if (key == 0)
+                return false;
+            const uint32_t existing = m_orderIndex.Find(key);
+            if (existing != FlatHashIndex::NOT_FOUND && existing != slot)
+                return false; // Another order (or a hash collision) already owns the id
+
+            if (record.orderKey != 0)
+                m_orderIndex.Erase(record.orderKey);
+            record.orderKey = key;
+            details.orderId = orderId;
+            m_orderIndex.Assign(key, slot);
+            Notify(slot, OrderChangeType::Updated);
+            return true;
+        }
+
+        bool OrderStore::AssignClientOrderId(uint32_t slot, std::string_view clientOrderId)
+        {
+            OrderRecord& record = m_records[slot];
+            OrderDetails& details = m_details[slot];
+            if (details.clientOrderId == clientOrderId)
+                return true;
+
+            const uint64_t key = MakeKey(record.exchangeId, clientOrderId);
+            if (key == 0)
+                return false;
+            const uint32_t existing = m_clientOrderIndex.Find(key);
+            if (existing != FlatHashIndex::NOT_FOUND && existing != slot)
+                return false;
+
+            if (record.clientOrderKey != 0)
+                m_clientOrderIndex.Erase(record.clientOrderKey);
+            record.clientOrderKey = key;
+            details.clientOrderId = clientOrderId;
+            m_clientOrderIndex.Assign(key, slot);
+            Notify(slot, OrderChangeType::Updated);
+            return true;
+        }
+
+        void OrderStore::AdvanceFillStatus(OrderRecord& record)
+        {
+            const OrderEvent event = record.filledQuantity >= record.originalQuantity
+                ? OrderEvent::Fill
+                : OrderEvent::PartialFill;
+            const OrderTransition transition = LookupTransition(record.status, event);
+            if (transition.action == TransitionAction::Apply)
+                record.status = transition.next;
+        }
+
+        bool OrderStore::ApplyFill(uint32_t slot, std::string_view fillId, Decimal price, Decimal quantity,
+                                   int64_t timeNs)
+        {
+            if (fillId.empty() || !AppendFill(slot, fillId, price, quantity, timeNs))
+                return false;
+
+            OrderRecord& record = m_records[slot];
+            record.filledQuantity += quantity;
+            record.updateTimeNs = timeNs;
+            AdvanceFillStatus(record);
+
+            OrderDetails& details = m_details[slot];
+            details.fillNotional += price.ToDouble(details.scale.price) * quantity.ToDouble(details.scale.quantity);
+            details.lastFillTimeNs = timeNs;
+            Notify(slot, OrderChangeType::Filled);
+            return true;
+        }
+
+        bool OrderStore::ReconcileFilled(uint32_t slot, Decimal cumulativeQuantity, Decimal averagePrice,
+                                         int64_t timeNs)
+        {
+            OrderRecord& record = m_records[slot];
+            if (cumulativeQuantity <= record.filledQuantity)
+                return false;
+
+            OrderDetails& details = m_details[slot];
+            const Decimal missed = cumulativeQuantity - record.filledQuantity;
+            if (averagePrice.IsPositive())
+                details.fillNotional = averagePrice.ToDouble(details.scale.price) *
+                                       cumulativeQuantity.ToDouble(details.scale.quantity);
+            else
+                details.fillNotional += GetAverageFillPrice(slot) * missed.ToDouble(details.scale.quantity);
+            record.filledQuantity = cumulativeQuantity;
+            record.updateTimeNs = timeNs;
+            AdvanceFillStatus(record);
+            Notify(slot, OrderChangeType::Filled);
+            return true;
+        }
+
+        bool OrderStore::AppendFill(uint32_t slot, std::string_view fillId, Decimal price, Decimal quantity,
+                                    int64_t timeNs)
+        {
+            OrderRecord& record = m_records[slot];
+            const uint64_t fillKey = MakeFillKey(record.exchangeId, record.symbolId, fillId);
+            const uint32_t index = static_cast<uint32_t>(m_fills.size());
+            if (fillKey != 0)
+            {
+                const uint32_t existing = m_fillIndex.Find(fillKey);
+                if (existing != FlatHashIndex::NOT_FOUND && m_fillIds[existing] == fillId &&
+                    m_fills[existing].exchangeId == record.exchangeId && m_fills[existing].symbolId == record.symbolId)
+                    return false;
+                // A different id with the same hash keeps the first one indexed; the new fill is
+                // still recorded, it just cannot be told apart from a replay of itself
+                if (existing == FlatHashIndex::NOT_FOUND)
+                    m_fillIndex.Insert(fillKey, index);
+            }
+
+            m_fills.push_back(OrderFill{record.orderKey, fillKey, price, quantity, timeNs, record.lastFill,
+                                        record.symbolId, record.exchangeId});
+            m_fillIds.emplace_back(fillId);
+            record.lastFill = index;
+            return true;
+        }
+
+        void OrderStore::SetStatus(uint32_t slot, OrderStatus status, int64_t timeNs, std::string_view rejectReason)
+        {
+            OrderRecord& record = m_records[slot];
+            if (record.status == status && rejectReason.empty())
+                return;
+            record.status = status;
+            record.updateTimeNs = timeNs;
+            if (!rejectReason.empty())
+                m_details[slot].rejectReason = rejectReason;
+            Notify(slot, OrderChangeType::Updated);
+        }
+
+        void OrderStore::Amend(uint32_t slot, Decimal price, Decimal quantity, int64_t timeNs)
+        {
+            OrderRecord& record = m_records[slot];
+            record.price = price;
+            record.originalQuantity = quantity;
+            record.updateTimeNs = timeNs;
+            Notify(slot, OrderChangeType::Updated);
+        }
+
+        bool OrderStore::Remove(uint32_t slot)
+        {
+            if (slot >= m_records.size() || !m_records[slot].inUse)
+                return false;
+
+            OrderRecord& record = m_records[slot];
+            if (record.orderKey != 0)
+                m_orderIndex.Erase(record.orderKey);
+            if (record.clientOrderKey != 0)
+                m_clientOrderIndex.Erase(record.clientOrderKey);
+            Notify(slot, OrderChangeType::Removed);
+            m_generations[slot]++; // Changes published from now on belong to the slot's next order
+
+            // Fills stay in the append-only array; they keep the order key for history
+            record.inUse = 0;
+            m_details[slot] = OrderDetails();
+            m_freeSlots.push_back(slot);
+            m_size--;
+            return true;
+        }
+
+        uint32_t OrderStore::Restore(const OrderState& order)
+        {
+            TradeStringTable& strings = GetTradeStringTable();
+            uint16_t exchangeId = 0;
+            uint16_t accountId = 0;
+            if (!strings.InternName(order.exchange, exchangeId))
+                return INVALID_SLOT;
+            strings.InternName(order.account, accountId);
+            uint32_t slot = FindByOrderId(exchangeId, order.orderId);
+            if (slot == INVALID_SLOT)
+                slot = FindByClientOrderId(exchangeId, order.clientOrderId);
+            if (slot == INVALID_SLOT)
+                return Add(order);
+
+            if (!order.orderId.empty())
+                AssignOrderId(slot, order.orderId);
+
+            OrderRecord& record = m_records[slot];
+            record.price = order.price;
+            record.originalQuantity = order.originalQuantity;
+            record.filledQuantity = order.filledQuantity;
+            record.updateTimeNs = ToNanoseconds(order.updateTime);
+            record.symbolId = strings.Intern(order.currencyPair);
+            record.accountId = accountId;
+            ParseOrderStatus(order.status, record.status); // Unreadable: keeps the live status
+            record.side = ParseTradeSide(order.side);
+            record.type = ParseOrderType(order.type);
+
+            OrderDetails& details = m_details[slot];
+            details.rejectReason = order.rejectReason;
+            details.scale = order.scale;
+            details.createTimeNs = ToNanoseconds(order.createTime);
+            details.lastFillTimeNs = ToNanoseconds(order.lastFillTime);
+            details.fillNotional = order.averageFillPrice * order.filledQuantity.ToDouble(order.scale.quantity);
+            Notify(slot, OrderChangeType::Updated);
+            return slot;
+        }
+
+        bool OrderStore::RestoreFill(uint32_t slot, std::string_view fillId, Decimal price, Decimal quantity,
+                                     int64_t timeNs)
+        {
+            // Quantities, notional and status already come with the restored order
+            return AppendFill(slot, fillId, price, quantity, timeNs);
+        }
+
+        double OrderStore::GetAverageFillPrice(uint32_t slot) const
+        {
+            const double filled = m_records[slot].filledQuantity.ToDouble(m_details[slot].scale.quantity);
+            return filled > 0.0 ? m_details[slot].fillNotional / filled : 0.0;
+        }
+
+        OrderState OrderStore::ToOrderState(uint32_t slot) const
+        {
+            const OrderRecord& record = m_records[slot];
+            const OrderDetails& details = m_details[slot];
+            const TradeStringTable& strings = GetTradeStringTable();
+
+            OrderState order;
+            order.orderId = details.orderId;
+            order.clientOrderId = details.clientOrderId;
+            order.account = strings.LookupName(record.accountId);
+            order.exchange = strings.LookupName(record.exchangeId);
+            order.currencyPair = strings.Lookup(record.symbolId);
+            order.side = TradeSideToString(record.side);
+            order.type = OrderTypeToString(record.type);
+            order.status = OrderStatusToString(record.status);
+            order.scale = details.scale;
+            order.originalQuantity = record.originalQuantity;
+            order.filledQuantity = record.filledQuantity;
+            order.remainingQuantity = record.GetRemainingQuantity();
+            order.price = record.price;
+            order.averageFillPrice = GetAverageFillPrice(slot);
+            order.createTime = FromNanoseconds(details.createTimeNs);
+            order.updateTime = FromNanoseconds(record.updateTimeNs);
+            order.lastFillTime = FromNanoseconds(details.lastFillTimeNs);
+            order.rejectReason = details.rejectReason;
+
+            for (uint32_t fill = record.lastFill; fill != NO_FILL; fill = m_fills[fill].previous)
+                order.fills.push_back(m_fillIds[fill]);
+            std::reverse(order.fills.begin(), order.fills.end());
+            return order;
+        }
+
+        void OrderStore::Notify(uint32_t slot, OrderChangeType type)
+        {
+            const uint64_t sequence = ++m_changeSequence;
+            m_changes[sequence & (m_changes.size() - 1)] = OrderChange{sequence, slot, m_generations[slot], type, m_records[slot].status};
+        }
+
+        bool OrderStore::ReadChanges(uint64_t& cursor, std::vector<OrderChange>& out) const
+        {
+            const uint64_t capacity = m_changes.size();
+            const uint64_t oldest = m_changeSequence > capacity ? m_changeSequence - capacity + 1 : 1;
+            // A cursor past the newest change was taken before a Clear
+            const bool complete = cursor + 1 >= oldest && cursor <= m_changeSequence;
+            if (!complete)
+                cursor = oldest - 1;
+
+            for (uint64_t sequence = cursor + 1; sequence <= m_changeSequence; sequence++)
+                out.push_back(m_changes[sequence & (capacity - 1)]);
+            cursor = std::max(cursor, m_changeSequence);
+            return complete;
+        }
+
+        void OrderStore::Clear()
+        {
+            m_records.clear();
+            m_details.clear();
+            m_generations.clear();
+            m_freeSlots.clear();
+            m_fills.clear();
+            m_fillIds.clear();
+            m_orderIndex.Clear();
+            m_clientOrderIndex.Clear();
+            m_fillIndex.Clear();
+            m_size = 0;
+            m_changeSequence = 0;
+        }
+
+        OrderStore& GetOrderStore()
+        {
+            static OrderStore store;
+            return store;
+        }
+    } // editor
+} // gui
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "Decimal.h"
+#include "FlatHashIndex.h"
+#include "TradeRecord.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gui::editor
+{
+    struct OrderState;
+
+    enum class OrderType : uint8_t
+    {
+        Unknown,
+        Market,
+        Limit,
+        Stop,
+        StopLimit
+    };
+
+    enum class OrderStatus : uint8_t
+    {
+        Pending,         // Sent, not acknowledged yet
+        Open,
+        PartiallyFilled,
+        Filled,
+        Cancelled,
+        Rejected,
+        Expired,
+        PendingCancel,   // Cancel requested, order still working
+        PendingReplace   // Amend requested, order still working
+    };
+
+    constexpr size_t ORDER_STATUS_COUNT = 9;
+
+    OrderType ParseOrderType(std::string_view type);   // Text or FIX OrdType
+    const char* OrderTypeToString(OrderType type);
+    bool ParseOrderStatus(std::string_view status, OrderStatus& out); // Text or FIX OrdStatus; false (out unchanged) when unrecognised
+    const char* OrderStatusToString(OrderStatus status);
+
+    inline bool IsTerminal(OrderStatus status)
+    {
+        return status == OrderStatus::Filled || status == OrderStatus::Cancelled ||
+               status == OrderStatus::Rejected || status == OrderStatus::Expired;
+    }
+
+    // Hot part of an order: everything an execution report touches, in one cache line.
+    // Strings and rarely read fields live in OrderDetails at the same slot.
+    struct alignas(64) OrderRecord
+    {
+        uint64_t orderKey;       // Index key of the exchange order id (0 = not assigned yet)
+        uint64_t clientOrderKey; // Index key of the client order id (0 = none)
+        Decimal price;           // At the order's scale.price
+        Decimal originalQuantity;
+        Decimal filledQuantity;  // Cumulative
+        int64_t updateTimeNs;
+        uint32_t lastFill;       // Newest fill in the store's fill array (NO_FILL = none)
+        uint32_t symbolId;       // Interned in TradeStringTable
+        uint16_t exchangeId;
+        uint16_t accountId;
+        OrderStatus status;
+        TradeSide side;
+        OrderType type;
+        uint8_t inUse;
+
+        Decimal GetRemainingQuantity() const { return originalQuantity - filledQuantity; }
+    };
+
+    static_assert(sizeof(OrderRecord) == 64, "OrderRecord must stay one cache line");
+
+    struct OrderDetails
+    {
+        std::string orderId;
+        std::string clientOrderId;
+        std::string rejectReason;
+        DecimalScale scale;
+        int64_t createTimeNs;
+        int64_t lastFillTimeNs;
+        double fillNotional; // Sum of fill price * quantity, for the average fill price
+
+        OrderDetails() : createTimeNs(0), lastFillTimeNs(0), fillNotional(0.0) {}
+    };
+
+    // Fills are appended and never modified; each links to the previous fill of its order
+    struct OrderFill
+    {
+        uint64_t orderKey;   // Owning order (slots are reused, keys are not)
+        uint64_t fillKey;    // MakeFillKey of the exchange fill id, for duplicate detection
+        Decimal price;
+        Decimal quantity;
+        int64_t timeNs;
+        uint32_t previous;   // Previous fill of the same order (NO_FILL = first)
+        uint32_t symbolId;   // Stream the fill id is unique in
+        uint16_t exchangeId;
+    };
+
+    enum class OrderChangeType : uint8_t
+    {
+        Added,
+        Updated,  // Status, price or quantity changed
+        Filled,
+        Removed
+    };
+
+    struct OrderChange
+    {
+        uint64_t sequence;
+        uint32_t slot;
+        uint32_t generation; // Slot generation at the change; a reused slot has a newer one
+        OrderChangeType type;
+        OrderStatus status; // Status after the change
+    };
+
+    // Orders shared by the REST, WebSocket and FIX order state updaters. Records sit
+    // in a pool with a free list, so slots are stable while an order lives and are
+    // reused afterwards. Exchange and client order ids each have an open-addressing
+    // index (FlatHashIndex) keyed by a 64-bit hash of venue and id, so resolving an
+    // execution report is one index probe and one record line; the stored id is then
+    // compared, so a colliding hash never resolves to the wrong order. An insert whose
+    // key is already taken (duplicate id or hash collision) is refused. Fill ids have
+    // their own index, so duplicate fills are found in O(1) however many fills an
+    // order has.
+    //
+    // Every change is published to a bounded change stream. Readers keep their own
+    // cursor; a reader that falls more than the stream capacity behind is told so
+    // and should rescan the store. Not thread-safe: use from the node update thread.
+    class OrderStore
+    {
+    public:
+        static constexpr uint32_t INVALID_SLOT = FlatHashIndex::NOT_FOUND;
+        static constexpr uint32_t NO_FILL = 0xFFFFFFFFu;
+
+        explicit OrderStore(size_t initialCapacity = 1024, size_t changeCapacity = 65536);
+
+        static uint64_t MakeKey(uint16_t exchangeId, std::string_view id);
+        static uint64_t MakeFillKey(uint16_t exchangeId, uint32_t symbolId, std::string_view fillId);
+
+        uint32_t FindByOrderId(uint16_t exchangeId, std::string_view orderId) const;
+        uint32_t FindByClientOrderId(uint16_t exchangeId, std::string_view clientOrderId) const;
+
+        // Returns the new slot, or INVALID_SLOT if either id is already present (or collides)
+        // or the status is not recognised
+        uint32_t Add(const OrderState& order);
+        bool AssignOrderId(uint32_t slot, std::string_view orderId); // Exchange acknowledged a client order
+        bool AssignClientOrderId(uint32_t slot, std::string_view clientOrderId); // Replace confirmed under a new ClOrdID
+
+        // Fill quantities add to filledQuantity; a fill id seen before on the venue and symbol is
+        // ignored, and a fill without an id is refused since a replay of it could not be detected
+        bool ApplyFill(uint32_t slot, std::string_view fillId, Decimal price, Decimal quantity, int64_t timeNs);
+        // Raises filledQuantity to the venue's cumulative quantity when executions were missed.
+        // averagePrice (order scale, zero = unknown) replaces the fill notional when given.
+        bool ReconcileFilled(uint32_t slot, Decimal cumulativeQuantity, Decimal averagePrice, int64_t timeNs);
+        void SetStatus(uint32_t slot, OrderStatus status, int64_t timeNs, std::string_view rejectReason = {});
+        void Amend(uint32_t slot, Decimal price, Decimal quantity, int64_t timeNs);
+        bool Remove(uint32_t slot);
+
+        // Recovery (StateJournal): set an order exactly as recorded, bypassing the
+        // lifecycle, and re-link its fills without adding their quantities again
+        uint32_t Restore(const OrderState& order);
+        bool RestoreFill(uint32_t slot, std::string_view fillId, Decimal price, Decimal quantity, int64_t timeNs);
+
+        const OrderRecord& Get(uint32_t slot) const { return m_records[slot]; }
+        const OrderDetails& GetDetails(uint32_t slot) const { return m_details[slot]; }
+        uint32_t GetGeneration(uint32_t slot) const { return m_generations[slot]; } // Bumped by Remove
+        double GetAverageFillPrice(uint32_t slot) const;
+        OrderState ToOrderState(uint32_t slot) const; // Display form
+        const OrderFill& GetFill(uint32_t fill) const { return m_fills[fill]; }
+        const std::string& GetFillId(uint32_t fill) const { return m_fillIds[fill]; }
+
+        // Calls fn(const OrderFill&) newest first
+        template<typename Fn>
+        void ForEachFill(uint32_t slot, Fn&& fn) const;
+
+        // Calls fn(slot, const OrderRecord&) for every live order
+        template<typename Fn>
+        void ForEachOrder(Fn&& fn) const;
+
+        // Changes after `cursor` (a sequence number; start at 0). Returns false when the
+        // reader fell behind and changes were lost; the cursor is moved to the oldest kept.
+        bool ReadChanges(uint64_t& cursor, std::vector<OrderChange>& out) const;
+        uint64_t GetChangeSequence() const { return m_changeSequence; }
+
+        size_t Size() const { return m_size; }
+        size_t GetFillCount() const { return m_fills.size(); }
+        void Clear();
+
+    private:
+        uint32_t AllocateSlot();
+        void Notify(uint32_t slot, OrderChangeType type);
+        bool AppendFill(uint32_t slot, std::string_view fillId, Decimal price, Decimal quantity, int64_t timeNs);
+        void AdvanceFillStatus(OrderRecord& record); // Lifecycle step after filledQuantity grew
+
+        std::vector<OrderRecord> m_records;
+        std::vector<OrderDetails> m_details; // Parallel to m_records
+        std::vector<uint32_t> m_generations; // Parallel to m_records
+        std::vector<uint32_t> m_freeSlots;
+        std::vector<OrderFill> m_fills;
+        std::vector<std::string> m_fillIds;  // Parallel to m_fills; only read for display
+        FlatHashIndex m_orderIndex;          // orderKey -> slot
+        FlatHashIndex m_clientOrderIndex;    // clientOrderKey -> slot
+        FlatHashIndex m_fillIndex;           // fillKey -> index in m_fills
+        size_t m_size;
+
+        std::vector<OrderChange> m_changes;  // Ring of the newest changes
+        uint64_t m_changeSequence;           // Sequence of the last published change
+    };
+
+    // Process-wide store used by the order state updaters
+    OrderStore& GetOrderStore();
+
+    template<typename Fn>
+    void OrderStore::ForEachFill(uint32_t slot, Fn&& fn) const
+    {
+        for (uint32_t fill = m_records[slot].lastFill; fill != NO_FILL; fill = m_fills[fill].previous)
+            fn(m_fills[fill]);
+    }
+
+    template<typename Fn>
+    void OrderStore::ForEachOrder(Fn&& fn) const
+    {
+        for (uint32_t slot = 0; slot < m_records.size(); slot++)
+        {
+            if (m_records[slot].inUse)
+                fn(slot, m_records[slot]);
+        }
+    }
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Decimal.h"
+
+#include <cstdint>
+
+namespace gui::editor
+{
+    // Exchange-published top-of-book checksums (all CRC32/IEEE)
+    enum class ChecksumScheme : uint8_t
+    {
+        None,
+        Kraken,   // Top 10 asks then bids; "." and leading zeros stripped from each field
+        Okx,      // Top 25, "bidPx:bidSz:askPx:askSz:..." interleaved; signed 32-bit
+        Bitfinex  // Top 25, "price:amount" interleaved bid/ask, ask amounts negative; signed 32-bit
+    };
+
+    struct NormalizedOrderbookLevel
+    {
+        Decimal price;    // At the book's scale.price; exact, usable as a level key
+        Decimal quantity; // At the book's scale.quantity
+        int orderCount; // Number of orders at this level (if available)
+        
+        NormalizedOrderbookLevel() : orderCount(0) {}
+    };
+}
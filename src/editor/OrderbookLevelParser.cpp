@@ -0,0 +1,446 @@
+#include "OrderbookLevelParser.h"
+
+namespace gui
+{
+    namespace editor
+    {
+        namespace
+        {
+            struct Cursor
+            {
+                const char* p;
+                const char* end;
+
+                void SkipWhitespace()
+                {
+                    while (p != end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+                        ++p;
+                }
+
+                bool Consume(char c)
+                {
+                    SkipWhitespace();
+                    if (p != end && *p == c)
+                    {
+                        ++p;
+                        return true;
+                    }
+                    return false;
+                }
+
+                bool Peek(char c)
+                {
+                    SkipWhitespace();
+                    return p != end && *p == c;
+                }
+            };
+
+            // Skips one JSON value and returns its raw text
+            std::string_view SkipValue(Cursor& cursor)
+            {
+                cursor.SkipWhitespace();
+                const char* start = cursor.p;
+                if (cursor.p == cursor.end)
+                    return {};
+
+                if (*cursor.p == '"')
+                {
+                    ++cursor.p;
+                    while (cursor.p != cursor.end && *cursor.p != '"')
+                    {
+                        if (*cursor.p == '\\' && cursor.p + 1 != cursor.end)
+                            ++cursor.p;
+                        ++cursor.p;
+                    }
+                    if (cursor.p != cursor.end)
+                        ++cursor.p;
+                }
+                else if (*cursor.p == '[' || *cursor.p == '{')
+                {
+                    int depth = 0;
+                    bool inString = false;
+                    for (; cursor.p != cursor.end; ++cursor.p)
+                    {
+                        const char c = *cursor.p;
+                        if (inString)
+                        {
+                            if (c == '\\' && cursor.p + 1 != cursor.end)
+                                ++cursor.p;
+                            else if (c == '"')
+                                inString = false;
+                        }
+                        else if (c == '"')
+                            inString = true;
+                        else if (c == '[' || c == '{')
+                            ++depth;
+                        else if ((c == ']' || c == '}') && --depth == 0)
+                        {
+                            ++cursor.p;
+                            break;
+                        }
+                    }
+                }
+                else
+                {
+                    while (cursor.p != cursor.end && *cursor.p != ',' && *cursor.p != ']' && *cursor.p != '}' &&
+                           *cursor.p != ' ' && *cursor.p != '\n' && *cursor.p != '\r' && *cursor.p != '\t')
+                        ++cursor.p;
+                }
+
+                return std::string_view(start, static_cast<size_t>(cursor.p - start));
+            }
+
+            bool ParseCount(std::string_view text, int& out)
+            {
+                text = JsonScan::Unquote(text);
+                if (text.empty())
+                    return false;
+
+                // Some venues send "3.0"; a count with a real fraction is malformed
+                const size_t dot = text.find('.');
+                if (dot != std::string_view::npos)
+                {
+                    if (text.find_first_not_of('0', dot + 1) != std::string_view::npos)
+                        return false;
+                    text = text.substr(0, dot);
+                }
+                if (text.empty() || text.size() > 9)
+                    return false;
+
+                int value = 0;
+                for (char c : text)
+                {
+                    if (c < '0' || c > '9')
+                        return false;
+                    value = value * 10 + (c - '0');
+                }
+                out = value;
+                return true;
+            }
+
+            bool StoreLevel(std::string_view priceText, std::string_view quantityText, std::string_view countText,
+                            DecimalScale scale, NormalizedOrderbookLevel& level)
+            {
+                if (!Decimal::Parse(JsonScan::Unquote(priceText), scale.price, level.price) ||
+                    !Decimal::Parse(JsonScan::Unquote(quantityText), scale.quantity, level.quantity))
+                    return false;
+
+                level.orderCount = 0;
+                if (!countText.empty())
+                    ParseCount(countText, level.orderCount);
+                return true;
+            }
+
+            bool ParseHex4(std::string_view text, size_t position, uint32_t& code)
+            {
+                if (position + 4 > text.size())
+                    return false;
+                code = 0;
+                for (size_t i = position; i < position + 4; i++)
+                {
+                    const char c = text[i];
+                    code <<= 4;
+                    if (c >= '0' && c <= '9')
+                        code |= static_cast<uint32_t>(c - '0');
+                    else if (c >= 'a' && c <= 'f')
+                        code |= static_cast<uint32_t>(c - 'a' + 10);
+                    else if (c >= 'A' && c <= 'F')
+                        code |= static_cast<uint32_t>(c - 'A' + 10);
+                    else
+                        return false;
+                }
+                return true;
+            }
+
+            // Writes at most as many bytes as the escape it replaces (6, or 12 for a pair)
+            size_t EncodeUtf8(uint32_t code, char* out)
+            {
+                if (code < 0x80)
+                {
+                    out[0] = static_cast<char>(code);
+                    return 1;
+                }
+                if (code < 0x800)
+                {
+                    out[0] = static_cast<char>(0xC0 | (code >> 6));
+                    out[1] = static_cast<char>(0x80 | (code & 0x3F));
+                    return 2;
+                }
+                if (code < 0x10000)
+                {
+                    out[0] = static_cast<char>(0xE0 | (code >> 12));
+                    out[1] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                    out[2] = static_cast<char>(0x80 | (code & 0x3F));
+                    return 3;
+                }
+                out[0] = static_cast<char>(0xF0 | (code >> 18));
+                out[1] = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                out[2] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out[3] = static_cast<char>(0x80 | (code & 0x3F));
+                return 4;
+            }
+        }
+
+        JsonLevelField JsonLevelField::FromMapping(const char* field)
+        {
+            JsonLevelField result;
+            std::string_view text(field);
+
+            bool numeric = !text.empty();
+            int index = 0;
+            for (char c : text)
+            {
+                if (c < '0' || c > '9')
+                {
+                    numeric = false;
+                    break;
+                }
+                index = index * 10 + (c - '0');
+            }
+
+            if (numeric)
+                result.index = index;
+            else
+                result.key = text;
+            return result;
+        }
+
+        namespace JsonScan
+        {
+            std::string_view FindField(std::string_view json, std::string_view path)
+            {
+                std::string_view current = json;
+                while (!path.empty())
+                {
+                    const size_t dot = path.find('.');
+                    const std::string_view segment = path.substr(0, dot);
+                    path = (dot == std::string_view::npos) ? std::string_view() : path.substr(dot + 1);
+
+                    Cursor cursor{current.data(), current.data() + current.size()};
+                    if (!cursor.Consume('{'))
+                        return {};
+
+                    std::string_view found;
+                    while (!cursor.Peek('}') && cursor.p != cursor.end)
+                    {
+                        const std::string_view key = Unquote(SkipValue(cursor));
+                        if (!cursor.Consume(':'))
+                            return {};
+
+                        const std::string_view value = SkipValue(cursor);
+                        if (key == segment)
+                        {
+                            found = value;
+                            break;
+                        }
+                        if (!cursor.Consume(','))
+                            break;
+                    }
+
+                    if (found.empty())
+                        return {};
+                    current = found;
+                }
+                return current;
+            }
+
+            std::string_view Unquote(std::string_view raw)
+            {
+                if (raw.size() >= 2 && raw.front() == '"' && raw.back() == '"')
+                    return raw.substr(1, raw.size() - 2);
+                return raw;
+            }
+
+            std::string_view Unescape(std::string_view raw, BatchArena& arena)
+            {
+                const std::string_view text = Unquote(raw);
+                if (text.find('\\') == std::string_view::npos)
+                    return text;
+
+                // Decoding never makes the text longer
+                char* out = static_cast<char*>(arena.Allocate(text.size(), 1));
+                size_t length = 0;
+                for (size_t i = 0; i < text.size(); i++)
+                {
+                    if (text[i] != '\\' || i + 1 == text.size())
+                    {
+                        out[length++] = text[i];
+                        continue;
+                    }
+                    const char escaped = text[++i];
+                    switch (escaped)
+                    {
+                        case 'b': out[length++] = '\b'; break;
+                        case 'f': out[length++] = '\f'; break;
+                        case 'n': out[length++] = '\n'; break;
+                        case 'r': out[length++] = '\r'; break;
+                        case 't': out[length++] = '\t'; break;
+                        case 'u':
+                        {
+                            uint32_t code = 0;
+                            if (!ParseHex4(text, i + 1, code))
+                            {
+                                out[length++] = escaped;
+                                break;
+                            }
+                            i += 4;
+                            // A high surrogate followed by \uDC00-\uDFFF is one code point
+                            uint32_t low = 0;
+                            if (code >= 0xD800 && code < 0xDC00 && i + 2 < text.size() && text[i + 1] == '\\' &&
+                                text[i + 2] == 'u' && ParseHex4(text, i + 3, low) && low >= 0xDC00 && low < 0xE000)
+                            {
+                                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                                i += 6;
+                            }
+                            length += EncodeUtf8(code, out + length);
+                            break;
+                        }
+                        default: out[length++] = escaped; break; // \" \\ \/
+                    }
+                }
+                return std::string_view(out, length);
+            }
+
+            ObjectReader::ObjectReader(std::string_view object)
+                : m_cursor(object.data()), m_end(object.data() + object.size()), m_valid(false)
+            {
+                Cursor cursor{m_cursor, m_end};
+                m_valid = cursor.Consume('{');
+                m_cursor = cursor.p;
+            }
+
+            bool ObjectReader::Next(std::string_view& key, std::string_view& rawValue)
+            {
+                if (!m_valid)
+                    return false;
+
+                Cursor cursor{m_cursor, m_end};
+                if (cursor.Peek('}') || cursor.p == cursor.end)
+                    return false;
+
+                key = Unquote(SkipValue(cursor));
+                if (key.empty() || !cursor.Consume(':'))
+                {
+                    m_valid = false;
+                    return false;
+                }
+
+                rawValue = SkipValue(cursor);
+                cursor.Consume(',');
+                m_cursor = cursor.p;
+                return true;
+            }
+
+            ArrayReader::ArrayReader(std::string_view array)
+                : m_cursor(array.data()), m_end(array.data() + array.size()), m_valid(false)
+            {
+                Cursor cursor{m_cursor, m_end};
+                m_valid = cursor.Consume('[');
+                m_cursor = cursor.p;
+            }
+
+            bool ArrayReader::Next(std::string_view& rawValue)
+            {
+                if (!m_valid)
+                    return false;
+
+                Cursor cursor{m_cursor, m_end};
+                if (cursor.Peek(']') || cursor.p == cursor.end)
+                    return false;
+
+                rawValue = SkipValue(cursor);
+                cursor.Consume(',');
+                m_cursor = cursor.p;
+                return !rawValue.empty();
+            }
+        }
+
+        bool OrderbookLevelParser::Parse(std::string_view levelsJson, const JsonLevelLayout& layout,
+                                         DecimalScale scale, std::vector<NormalizedOrderbookLevel>& levels)
+        {
+            levels.clear();
+
+            Cursor cursor{levelsJson.data(), levelsJson.data() + levelsJson.size()};
+            if (!cursor.Consume('['))
+                return false;
+
+            const size_t limit = layout.maxLevels;
+
+            while (!cursor.Peek(']'))
+            {
+                if (limit != 0 && levels.size() >= limit)
+                    return true; // Deeper levels are not needed; stop early
+
+                std::string_view priceText;
+                std::string_view quantityText;
+                std::string_view countText;
+
+                if (cursor.Consume('['))
+                {
+                    // [price, qty, count?, ...]
+                    for (int index = 0; !cursor.Peek(']'); index++)
+                    {
+                        const std::string_view value = SkipValue(cursor);
+                        if (value.empty())
+                            return false;
+
+                        if (index == layout.price.index)
+                            priceText = value;
+                        else if (index == layout.quantity.index)
+                            quantityText = value;
+                        else if (index == layout.count.index)
+                            countText = value;
+
+                        if (!cursor.Consume(','))
+                            break;
+                    }
+                    if (!cursor.Consume(']'))
+                        return false;
+                }
+                else if (cursor.Consume('{'))
+                {
+                    // {"price": .., "qty": .., ...}
+                    while (!cursor.Peek('}'))
+                    {
+                        const std::string_view key = JsonScan::Unquote(SkipValue(cursor));
+                        if (key.empty() || !cursor.Consume(':'))
+                            return false;
+
+                        const std::string_view value = SkipValue(cursor);
+                        if (key == layout.price.key)
+                            priceText = value;
+                        else if (key == layout.quantity.key)
+                            quantityText = value;
+                        else if (key == layout.count.key)
+                            countText = value;
+
+                        if (!cursor.Consume(','))
+                            break;
+                    }
+                    if (!cursor.Consume('}'))
+                        return false;
+                }
+                else
+                {
+                    return false;
+                }
+
+                if (priceText.empty() || quantityText.empty())
+                    return false;
+
+                // Write in place; reuses the slot when the buffer already has capacity
+                levels.emplace_back();
+                if (!StoreLevel(priceText, quantityText, countText, scale, levels.back()))
+                {
+                    levels.pop_back(); // Never leave a half-written level behind
+                    return false;
+                }
+
+                if (!cursor.Consume(','))
+                    break;
+            }
+
+            return cursor.Consume(']') || (limit != 0 && levels.size() >= limit);
+        }
+    } // editor
+} // gui
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "BatchArena.h"
+#include "Decimal.h"
+#include "OrderbookLevel.h"
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace gui::editor
+{
+    // Where price/quantity/count live inside one level: an array position for
+    // [["price","qty"],...] layouts or a member name for [{"price":..},...] layouts.
+    struct JsonLevelField
+    {
+        int index;            // >= 0 for array layouts, -1 otherwise
+        std::string_view key; // Member name for object layouts
+
+        JsonLevelField() : index(-1) {}
+
+        static JsonLevelField FromMapping(const char* field);
+    };
+
+    struct JsonLevelLayout
+    {
+        JsonLevelField price;
+        JsonLevelField quantity;
+        JsonLevelField count;
+        size_t maxLevels; // 0 = unlimited
+
+        JsonLevelLayout() : maxLevels(0) {}
+    };
+
+    // Streaming JSON helpers that work on views into the original message and never allocate
+    namespace JsonScan
+    {
+        // Returns the raw value text (including quotes/brackets) of a dotted path such
+        // as "data.bids", or an empty view when the path does not exist.
+        std::string_view FindField(std::string_view json, std::string_view path);
+
+        // Strips surrounding quotes from a raw string value
+        std::string_view Unquote(std::string_view raw);
+
+        // Unquote plus JSON escape decoding ("BTC\/USD"). Values without a backslash
+        // come back as a view into raw; decoded text lives in the arena until its reset.
+        std::string_view Unescape(std::string_view raw, BatchArena& arena);
+
+        // Walks the members of one object: while (reader.Next(key, value)) ...
+        class ObjectReader
+        {
+        public:
+            explicit ObjectReader(std::string_view object);
+            bool Next(std::string_view& key, std::string_view& rawValue);
+            bool IsValid() const { return m_valid; }
+
+        private:
+            const char* m_cursor;
+            const char* m_end;
+            bool m_valid;
+        };
+
+        // Walks the elements of one array
+        class ArrayReader
+        {
+        public:
+            explicit ArrayReader(std::string_view array);
+            bool Next(std::string_view& rawValue);
+            bool IsValid() const { return m_valid; }
+
+        private:
+            const char* m_cursor;
+            const char* m_end;
+            bool m_valid;
+        };
+    }
+
+    class OrderbookLevelParser
+    {
+    public:
+        // Parses a levels array straight into `levels`. The vector is cleared but keeps
+        // its capacity, so a buffer reserved to layout.maxLevels never reallocates.
+        // Parsing stops as soon as maxLevels levels have been written.
+        static bool Parse(std::string_view levelsJson, const JsonLevelLayout& layout,
+                          DecimalScale scale, std::vector<NormalizedOrderbookLevel>& levels);
+    };
+}
@@ -0,0 +1,178 @@
+#include "OrderbookResync.h"
+
+#include <algorithm>
+
+namespace gui
+{
+    namespace editor
+    {
+        OrderbookResync::OrderbookResync(size_t maxBufferedDeltas, uint64_t requestThreshold)
+            : m_state(State::Live)
+            , m_lastSequence(0)
+            , m_bufferCount(0)
+            , m_replayBegin(0)
+            , m_maxBufferedDeltas(std::max<size_t>(maxBufferedDeltas, 1))
+            , m_requestThreshold(std::max<uint64_t>(requestThreshold, 1))
+            , m_snapshotRequested(true)
+            , m_lastRecoveryTime(Clock::duration::zero())
+        {
+        }
+
+        ResyncAction OrderbookResync::OnUpdate(const NormalizedOrderbook& update)
+        {
+            if (update.isSnapshot)
+                return OnSnapshot(update);
+
+            // Unsequenced feeds cannot be checked or ordered against a snapshot;
+            // pass them through while live and discard them while recovering
+            if (update.sequence == 0)
+                return m_state == State::Live ? ResyncAction::Apply : ResyncAction::Drop;
+
+            if (m_state == State::AwaitingSnapshot)
+            {
+                if (!m_snapshotRequested && update.sequence <= m_lastSequence)
+                    return ResyncAction::Drop;
+                if (!m_snapshotRequested && FirstSequence(update) <= m_lastSequence + 1)
+                    return OnLateDelta(update);
+                BufferDelta(update);
+                return ResyncAction::Buffer;
+            }
+
+            if (m_lastSequence != 0 && update.sequence <= m_lastSequence)
+                return ResyncAction::Drop;
+
+            // A sequenced delta with no baseline is treated like a gap
+            if (m_lastSequence == 0 || FirstSequence(update) > m_lastSequence + 1)
+            {
+                m_state = State::AwaitingSnapshot;
+                m_gapTime = Clock::now();
+                m_requestTime = m_gapTime;
+                m_bufferCount = 0;
+                m_replayBegin = 0;
+                BufferDelta(update);
+
+                // A few missing updates may only be late; wait for them before asking
+                const uint64_t missing = m_lastSequence == 0 ? UINT64_MAX : FirstSequence(update) - m_lastSequence - 1;
+                m_snapshotRequested = missing >= m_requestThreshold;
+                return m_snapshotRequested ? ResyncAction::RequestSnapshot : ResyncAction::Buffer;
+            }
+
+            m_lastSequence = update.sequence;
+            return ResyncAction::Apply;
+        }
+
+        void OrderbookResync::Invalidate()
+        {
+            if (m_state == State::AwaitingSnapshot)
+                return;
+            m_state = State::AwaitingSnapshot;
+            m_snapshotRequested = true;
+            m_gapTime = Clock::now();
+            m_requestTime = m_gapTime;
+            m_bufferCount = 0;
+            m_replayBegin = 0;
+        }
+
+        ResyncAction OrderbookResync::OnLateDelta(const NormalizedOrderbook& delta)
+        {
+            // Part of the gap arrived: it follows the book, so apply it and keep waiting
+            if (m_bufferCount > 0 && delta.sequence + 1 < FirstSequence(m_buffer[0]))
+            {
+                m_lastSequence = delta.sequence;
+                return ResyncAction::Apply;
+            }
+
+            m_state = State::Live;
+            m_snapshotRequested = true;
+            m_replayBegin = 0;
+            while (m_replayBegin < m_bufferCount && m_buffer[m_replayBegin].sequence <= delta.sequence)
+                m_replayBegin++;
+            m_lastSequence = delta.sequence;
+            for (size_t i = m_replayBegin; i < m_bufferCount; i++)
+                m_lastSequence = std::max(m_lastSequence, m_buffer[i].sequence);
+            m_lastRecoveryTime = Clock::now() - m_gapTime;
+            return ResyncAction::GapFilled;
+        }
+
+        ResyncAction OrderbookResync::OnSnapshot(const NormalizedOrderbook& snapshot)
+        {
+            if (m_state == State::Live)
+            {
+                if (snapshot.sequence != 0)
+                    m_lastSequence = snapshot.sequence;
+                return ResyncAction::Apply;
+            }
+
+            // Skip deltas the snapshot already contains
+            size_t first = 0;
+            while (first < m_bufferCount && m_buffer[first].sequence != 0 &&
+                   m_buffer[first].sequence <= snapshot.sequence)
+                first++;
+
+            // Older than the buffered stream: the missing updates are in neither
+            if (first < m_bufferCount && snapshot.sequence != 0 &&
+                FirstSequence(m_buffer[first]) > snapshot.sequence + 1)
+                return ResyncAction::RequestSnapshot;
+
+            m_state = State::Live;
+            m_snapshotRequested = true;
+            m_replayBegin = first;
+            m_lastSequence = snapshot.sequence;
+            for (size_t i = first; i < m_bufferCount; i++)
+                m_lastSequence = std::max(m_lastSequence, m_buffer[i].sequence);
+            m_lastRecoveryTime = Clock::now() - m_gapTime;
+            return ResyncAction::Resynced;
+        }
+
+        void OrderbookResync::BufferDelta(const NormalizedOrderbook& delta)
+        {
+            // Buffered deltas must be contiguous; after a hole only newer ones can help
+            if (m_bufferCount > 0 && delta.sequence != 0)
+            {
+                const uint64_t previous = m_buffer[m_bufferCount - 1].sequence;
+                if (previous != 0 && FirstSequence(delta) > previous + 1)
+                    m_bufferCount = 0;
+            }
+
+            if (m_bufferCount == m_maxBufferedDeltas)
+            {
+                // Keep the newest half; the snapshot will have to cover the rest
+                const size_t keep = m_maxBufferedDeltas / 2;
+                std::move(m_buffer.begin() + static_cast<std::ptrdiff_t>(m_bufferCount - keep),
+                          m_buffer.begin() + static_cast<std::ptrdiff_t>(m_bufferCount), m_buffer.begin());
+                m_bufferCount = keep;
+            }
+
+            if (m_bufferCount < m_buffer.size())
+                m_buffer[m_bufferCount] = delta; // Reuses the slot's level capacity
+            else
+                m_buffer.push_back(delta);
+            m_bufferCount++;
+        }
+
+        std::span<const NormalizedOrderbook> OrderbookResync::GetReplay() const
+        {
+            if (m_state != State::Live)
+                return {};
+            return std::span<const NormalizedOrderbook>(m_buffer.data() + m_replayBegin, m_bufferCount - m_replayBegin);
+        }
+
+        void OrderbookResync::ClearReplay()
+        {
+            if (m_state != State::Live)
+                return;
+            m_bufferCount = 0;
+            m_replayBegin = 0;
+        }
+
+        bool OrderbookResync::IsSnapshotOverdue(Clock::time_point now, Clock::duration timeout) const
+        {
+            return m_state == State::AwaitingSnapshot && m_snapshotRequested && now - m_requestTime >= timeout;
+        }
+
+        bool OrderbookResync::IsGapWaitOver(Clock::time_point now, Clock::duration wait) const
+        {
+            return m_state == State::AwaitingSnapshot && !m_snapshotRequested && now - m_gapTime >= wait;
+        }
+    } // editor
+} // gui
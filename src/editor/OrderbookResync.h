@@ -0,0 +1,87 @@
+#pragma once
+
+#include "MessageProcessors.h"
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace gui::editor
+{
+    enum class ResyncAction : uint8_t
+    {
+        Apply,           // Contiguous delta (or snapshot while live); merge it
+        Buffer,          // Held until the snapshot arrives
+        Drop,            // Already covered by the book
+        RequestSnapshot, // Gap detected or snapshot too old; ask for a (new) snapshot
+        Resynced,        // Snapshot accepted; merge it, then GetReplay(), then ClearReplay()
+        GapFilled        // A late delta closed a small gap; merge it, then replay as for Resynced
+    };
+
+    // Per-pair snapshot + delta recovery. On a gap the pair switches to buffering;
+    // when the snapshot arrives, buffered deltas newer than it are handed back for
+    // replay and the pair resumes. Nothing blocks, so other pairs on the same
+    // connection keep flowing while one pair recovers.
+    //
+    // Gaps smaller than requestThreshold are first given a chance to close: the
+    // deltas after the gap are buffered, and if the missing ones arrive late the
+    // pair resumes without a snapshot. IsGapWaitOver() tells the owner when to
+    // stop waiting and request one.
+    class OrderbookResync
+    {
+    public:
+        enum class State : uint8_t
+        {
+            Live,
+            AwaitingSnapshot
+        };
+
+        using Clock = std::chrono::steady_clock;
+
+        explicit OrderbookResync(size_t maxBufferedDeltas = 4096, uint64_t requestThreshold = 1);
+
+        ResyncAction OnUpdate(const NormalizedOrderbook& update);
+        void Invalidate(); // Book known to be wrong (e.g. checksum mismatch); wait for a snapshot
+
+        std::span<const NormalizedOrderbook> GetReplay() const;
+        void ClearReplay(); // Buffered messages keep their capacity for the next recovery
+
+        // True when a requested snapshot has not arrived within `timeout`
+        bool IsSnapshotOverdue(Clock::time_point now, Clock::duration timeout) const;
+        // True when a small gap has stayed open for `wait` without a snapshot being requested
+        bool IsGapWaitOver(Clock::time_point now, Clock::duration wait) const;
+        void OnSnapshotRequested(Clock::time_point now)
+        {
+            m_requestTime = now;
+            m_snapshotRequested = true;
+        }
+
+        State GetState() const { return m_state; }
+        uint64_t GetLastSequence() const { return m_lastSequence; }
+        size_t GetBufferedCount() const { return m_bufferCount; }
+        Clock::duration GetLastRecoveryTime() const { return m_lastRecoveryTime; }
+
+    private:
+        static uint64_t FirstSequence(const NormalizedOrderbook& update)
+        {
+            return update.firstSequence != 0 ? update.firstSequence : update.sequence;
+        }
+
+        ResyncAction OnSnapshot(const NormalizedOrderbook& snapshot);
+        ResyncAction OnLateDelta(const NormalizedOrderbook& delta);
+        void BufferDelta(const NormalizedOrderbook& delta);
+
+        State m_state;
+        uint64_t m_lastSequence; // 0 until the first sequenced message
+        std::vector<NormalizedOrderbook> m_buffer; // Slots are reused; m_bufferCount are live
+        size_t m_bufferCount;
+        size_t m_replayBegin;
+        size_t m_maxBufferedDeltas;
+        uint64_t m_requestThreshold; // Missing updates at which a snapshot is requested at once
+        bool m_snapshotRequested;    // false while a small gap waits for late deltas
+        Clock::time_point m_gapTime;
+        Clock::time_point m_requestTime;
+        Clock::duration m_lastRecoveryTime;
+    };
+}
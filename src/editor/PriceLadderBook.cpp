@@ -0,0 +1,329 @@
+#include "PriceLadderBook.h"
+
+#include <algorithm>
+#include <bit>
+#include <numeric>
+
+namespace gui
+{
+    namespace editor
+    {
+        PriceLadderSide::PriceLadderSide(size_t ladderSize)
+            : m_size(std::bit_ceil(std::max<size_t>(ladderSize, 64)))
+            , m_mask(m_size - 1)
+            , m_base(0)
+            , m_bestKey(0)
+            , m_ladderCount(0)
+        {
+            m_levels.resize(m_size);
+            m_occupied.resize(m_size / 64);
+        }
+
+        void PriceLadderSide::Clear()
+        {
+            std::fill(m_occupied.begin(), m_occupied.end(), 0);
+            m_overflow.clear();
+            m_ladderCount = 0;
+        }
+
+        void PriceLadderSide::Set(int64_t key, Decimal quantity, int orderCount)
+        {
+            const int64_t margin = static_cast<int64_t>(m_size / 4); // Room for the touch to improve
+
+            if (quantity.IsZero())
+            {
+                if (!InWindow(key))
+                {
+                    m_overflow.erase(key);
+                    return;
+                }
+
+                const size_t slot = Slot(key);
+                if (!IsOccupied(slot))
+                    return;
+
+                Vacate(slot);
+                m_ladderCount--;
+                if (key != m_bestKey)
+                    return;
+
+                // The touch moved away: find the next level, keeping the ladder centred on it
+                if (m_ladderCount > 0)
+                {
+                    m_bestKey = FindNextKey(key + 1);
+                    if (m_bestKey - m_base > static_cast<int64_t>(m_size) - margin)
+                        Recenter(m_bestKey - margin);
+                }
+                else if (!m_overflow.empty())
+                {
+                    Recenter(m_overflow.begin()->first - margin);
+                }
+                return;
+            }
+
+            if (Empty())
+                m_base = key - margin;
+            else if (key < m_base)
+                Recenter(key - margin);
+
+            if (!InWindow(key))
+            {
+                m_overflow[key] = Level{quantity, orderCount};
+                return;
+            }
+
+            const size_t slot = Slot(key);
+            if (!IsOccupied(slot))
+            {
+                Occupy(slot);
+                if (m_ladderCount++ == 0 || key < m_bestKey)
+                    m_bestKey = key;
+            }
+            m_levels[slot] = Level{quantity, orderCount};
+        }
+
+        bool PriceLadderSide::GetBest(int64_t& key, Level& level) const
+        {
+            if (m_ladderCount > 0)
+            {
+                key = m_bestKey;
+                level = m_levels[Slot(m_bestKey)];
+                return true;
+            }
+            if (!m_overflow.empty())
+            {
+                key = m_overflow.begin()->first;
+                level = m_overflow.begin()->second;
+                return true;
+            }
+            return false;
+        }
+
+        int64_t PriceLadderSide::FindNextKey(int64_t fromKey) const
+        {
+            // Slots of one bitmap word hold consecutive keys, so scan a word at a time
+            const int64_t end = m_base + static_cast<int64_t>(m_size);
+            int64_t key = fromKey;
+            while (key < end)
+            {
+                const size_t slot = Slot(key);
+                const uint64_t word = m_occupied[slot >> 6] >> (slot & 63);
+                if (word != 0)
+                    return std::min(end, key + std::countr_zero(word));
+                key += static_cast<int64_t>(64 - (slot & 63));
+            }
+            return end;
+        }
+
+        void PriceLadderSide::Recenter(int64_t newBase)
+        {
+            if (m_ladderCount > 0)
+                newBase = std::min(newBase, m_bestKey); // Never drop the touch out of the ladder
+
+            const int64_t size = static_cast<int64_t>(m_size);
+            const int64_t oldEnd = m_base + size;
+            const int64_t newEnd = newBase + size;
+
+            // Levels pushed past the far end of the window move to the overflow tree
+            for (int64_t key = std::max(newEnd, m_base); key < oldEnd && m_ladderCount > 0; key++)
+            {
+                const size_t slot = Slot(key);
+                if (IsOccupied(slot))
+                {
+                    m_overflow.emplace(key, m_levels[slot]);
+                    Vacate(slot);
+                    m_ladderCount--;
+                }
+            }
+
+            m_base = newBase;
+            RefillFromOverflow();
+            m_bestKey = m_ladderCount > 0 ? FindNextKey(m_base) : 0;
+        }
+
+        void PriceLadderSide::RefillFromOverflow()
+        {
+            const int64_t end = m_base + static_cast<int64_t>(m_size);
+            while (!m_overflow.empty() && m_overflow.begin()->first < end)
+            {
+                const auto it = m_overflow.begin();
+                const size_t slot = Slot(it->first);
+                Occupy(slot);
+                m_levels[slot] = it->second;
+                m_ladderCount++;
+                m_overflow.erase(it);
+            }
+        }
+
+        PriceLadderBook::PriceLadderBook(size_t ladderSize)
+            : m_bids(ladderSize)
+            , m_asks(ladderSize)
+            , m_tickUnits(0)
+            , m_tickFixed(false)
+            , m_rejectedLevels(0)
+        {
+        }
+
+        void PriceLadderBook::Clear()
+        {
+            m_bids.Clear();
+            m_asks.Clear();
+        }
+
+        void PriceLadderBook::SetTickUnits(int64_t tickUnits)
+        {
+            m_tickFixed = tickUnits > 0;
+            if (tickUnits > 0 && tickUnits != m_tickUnits)
+                Rebuild(tickUnits);
+        }
+
+        size_t PriceLadderBook::ApplySnapshot(const std::vector<NormalizedOrderbookLevel>& bids,
+                                              const std::vector<NormalizedOrderbookLevel>& asks)
+        {
+            Clear();
+
+            // Settle the tick first so the levels below are placed once
+            for (const NormalizedOrderbookLevel& level : bids)
+                AdoptTick(level.price);
+            for (const NormalizedOrderbookLevel& level : asks)
+                AdoptTick(level.price);
+
+            size_t rejected = 0;
+            for (const NormalizedOrderbookLevel& level : bids)
+            {
+                if (OnGrid(level.price))
+                    m_bids.Set(ToKey(true, level.price), level.quantity, level.orderCount);
+                else
+                    rejected++;
+            }
+            for (const NormalizedOrderbookLevel& level : asks)
+            {
+                if (OnGrid(level.price))
+                    m_asks.Set(ToKey(false, level.price), level.quantity, level.orderCount);
+                else
+                    rejected++;
+            }
+            m_rejectedLevels += rejected;
+            return rejected;
+        }
+
+        bool PriceLadderBook::SetLevel(bool isBid, Decimal price, Decimal quantity, int orderCount)
+        {
+            // A delete never refines the tick: an off-grid price cannot be a level we hold
+            if (quantity.IsZero() ? !OnGrid(price) : !AdoptTick(price) || !OnGrid(price))
+            {
+                if (!quantity.IsZero())
+                    m_rejectedLevels++;
+                return false;
+            }
+
+            PriceLadderSide& side = isBid ? m_bids : m_asks;
+            side.Set(ToKey(isBid, price), quantity, orderCount);
+            return true;
+        }
+
+        bool PriceLadderBook::GetBestBid(NormalizedOrderbookLevel& level) const
+        {
+            int64_t key = 0;
+            PriceLadderSide::Level best;
+            if (!m_bids.GetBest(key, best))
+                return false;
+            level.price = FromKey(true, key);
+            level.quantity = best.quantity;
+            level.orderCount = best.orderCount;
+            return true;
+        }
+
+        bool PriceLadderBook::GetBestAsk(NormalizedOrderbookLevel& level) const
+        {
+            int64_t key = 0;
+            PriceLadderSide::Level best;
+            if (!m_asks.GetBest(key, best))
+                return false;
+            level.price = FromKey(false, key);
+            level.quantity = best.quantity;
+            level.orderCount = best.orderCount;
+            return true;
+        }
+
+        size_t PriceLadderBook::CopyTop(bool isBid, size_t maxLevels,
+                                        std::vector<NormalizedOrderbookLevel>& levels) const
+        {
+            levels.clear();
+            const PriceLadderSide& side = isBid ? m_bids : m_asks;
+            side.ForEach(maxLevels, [&](int64_t key, const PriceLadderSide::Level& level) {
+                levels.emplace_back();
+                levels.back().price = FromKey(isBid, key);
+                levels.back().quantity = level.quantity;
+                levels.back().orderCount = level.orderCount;
+            });
+            return levels.size();
+        }
+
+        size_t PriceLadderBook::TrimTo(bool isBid, size_t depth, std::vector<Decimal>& removed)
+        {
+            removed.clear();
+            PriceLadderSide& side = isBid ? m_bids : m_asks;
+            if (side.GetLevelCount() <= depth)
+                return 0;
+
+            // Such books hold at most a few levels beyond the depth, so a full walk is cheap
+            size_t rank = 0;
+            side.ForEach(0, [&](int64_t key, const PriceLadderSide::Level&) {
+                if (rank++ >= depth)
+                    removed.push_back(FromKey(isBid, key));
+            });
+            for (Decimal price : removed)
+                side.Set(ToKey(isBid, price), Decimal(), 0);
+            return removed.size();
+        }
+
+        int64_t PriceLadderBook::ToKey(bool isBid, Decimal price) const
+        {
+            const int64_t tick = price.units / m_tickUnits;
+            return isBid ? -tick : tick;
+        }
+
+        Decimal PriceLadderBook::FromKey(bool isBid, int64_t key) const
+        {
+            return Decimal((isBid ? -key : key) * m_tickUnits);
+        }
+
+        bool PriceLadderBook::AdoptTick(Decimal price)
+        {
+            const int64_t units = price.units < 0 ? -price.units : price.units;
+            if (m_tickUnits == 0)
+            {
+                m_tickUnits = units > 0 ? units : 1;
+                return true;
+            }
+            if (units % m_tickUnits == 0)
+                return true;
+            if (m_tickFixed)
+                return false;
+
+            // Inferred tick was too coarse; each refinement at least halves it, so a book
+            // rebuilds at most log2(tick) times however its prices arrive
+            Rebuild(std::gcd(m_tickUnits, units));
+            return true;
+        }
+
+        void PriceLadderBook::Rebuild(int64_t newTickUnits)
+        {
+            std::vector<NormalizedOrderbookLevel> bids;
+            std::vector<NormalizedOrderbookLevel> asks;
+            if (m_tickUnits != 0)
+            {
+                CopyTop(true, 0, bids);
+                CopyTop(false, 0, asks);
+            }
+
+            Clear();
+            m_tickUnits = newTickUnits;
+            for (const NormalizedOrderbookLevel& level : bids)
+                m_bids.Set(ToKey(true, level.price), level.quantity, level.orderCount);
+            for (const NormalizedOrderbookLevel& level : asks)
+                m_asks.Set(ToKey(false, level.price), level.quantity, level.orderCount);
+        }
+    } // editor
+} // gui
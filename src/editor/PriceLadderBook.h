@@ -0,0 +1,134 @@
+#pragma once
+
+#include "Decimal.h"
+#include "OrderbookLevel.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace gui::editor
+{
+    // One side of an L2 book. Prices are tick indices; internally a side stores
+    // "keys" where smaller is always better (bids are negated) so both sides share
+    // the same code. Keys in [base, base + size) live in a ring addressed by
+    // key & mask with an occupancy bitmap; worse keys live in an ordered overflow
+    // tree. Moving the window only touches the slots that enter or leave it.
+    class PriceLadderSide
+    {
+    public:
+        struct Level
+        {
+            Decimal quantity;
+            int orderCount;
+        };
+
+        explicit PriceLadderSide(size_t ladderSize);
+
+        void Clear();
+        void Set(int64_t key, Decimal quantity, int orderCount); // Zero quantity removes the level
+
+        bool Empty() const { return m_ladderCount == 0 && m_overflow.empty(); }
+        size_t GetLevelCount() const { return m_ladderCount + m_overflow.size(); }
+        bool GetBest(int64_t& key, Level& level) const;
+
+        // Calls fn(key, level) best-first for up to maxLevels levels (0 = all)
+        template<typename Fn>
+        void ForEach(size_t maxLevels, Fn&& fn) const;
+
+    private:
+        size_t Slot(int64_t key) const { return static_cast<size_t>(key) & m_mask; }
+        bool InWindow(int64_t key) const { return key >= m_base && key < m_base + static_cast<int64_t>(m_size); }
+        bool IsOccupied(size_t slot) const { return (m_occupied[slot >> 6] >> (slot & 63)) & 1; }
+        void Occupy(size_t slot) { m_occupied[slot >> 6] |= uint64_t(1) << (slot & 63); }
+        void Vacate(size_t slot) { m_occupied[slot >> 6] &= ~(uint64_t(1) << (slot & 63)); }
+
+        int64_t FindNextKey(int64_t fromKey) const; // First occupied key >= fromKey inside the window
+        void Recenter(int64_t newBase);
+        void RefillFromOverflow();
+
+        std::vector<Level> m_levels;
+        std::vector<uint64_t> m_occupied;   // One bit per slot
+        std::map<int64_t, Level> m_overflow; // Keys >= base + size
+        size_t m_size;
+        size_t m_mask;
+        int64_t m_base;
+        int64_t m_bestKey;                  // Valid while m_ladderCount > 0
+        size_t m_ladderCount;
+    };
+
+    // L2 book keyed by price tick. Best bid/ask and level updates are O(1) while
+    // prices stay within the ladder around the touch; top-N walks the bitmap.
+    // A price that is not a whole number of ticks cannot be keyed and is rejected.
+    class PriceLadderBook
+    {
+    public:
+        static constexpr size_t DEFAULT_LADDER_SIZE = 4096; // Ticks per side kept in the ladder
+
+        explicit PriceLadderBook(size_t ladderSize = DEFAULT_LADDER_SIZE);
+
+        void Clear();
+
+        // Tick size in price units at the book's scale, normally the instrument's tickSize.
+        // 0 = infer from the prices seen: the tick becomes the gcd of every price, which
+        // is always a valid grid but may be finer than the venue's (more levels overflow).
+        void SetTickUnits(int64_t tickUnits);
+        int64_t GetTickUnits() const { return m_tickUnits; }
+
+        // Replaces the whole book; returns the number of levels rejected as off-grid
+        size_t ApplySnapshot(const std::vector<NormalizedOrderbookLevel>& bids,
+                             const std::vector<NormalizedOrderbookLevel>& asks);
+
+        // Upserts one level; zero quantity deletes it. false when the price is off-grid
+        // (only rejected upserts count towards GetRejectedCount()).
+        bool SetLevel(bool isBid, Decimal price, Decimal quantity, int orderCount);
+
+        bool GetBestBid(NormalizedOrderbookLevel& level) const;
+        bool GetBestAsk(NormalizedOrderbookLevel& level) const;
+        size_t GetLevelCount(bool isBid) const { return isBid ? m_bids.GetLevelCount() : m_asks.GetLevelCount(); }
+        uint64_t GetRejectedCount() const { return m_rejectedLevels; }
+
+        // Writes up to maxLevels levels best-first into `levels` (cleared, capacity kept)
+        size_t CopyTop(bool isBid, size_t maxLevels, std::vector<NormalizedOrderbookLevel>& levels) const;
+
+        // Deletes every level below the best `depth`, writing their prices to `removed`.
+        // For venues that stop updating levels once they fall out of the subscribed depth.
+        size_t TrimTo(bool isBid, size_t depth, std::vector<Decimal>& removed);
+
+    private:
+        int64_t ToKey(bool isBid, Decimal price) const;
+        Decimal FromKey(bool isBid, int64_t key) const;
+        bool OnGrid(Decimal price) const { return m_tickUnits != 0 && price.units % m_tickUnits == 0; }
+        bool AdoptTick(Decimal price); // Shrinks an inferred m_tickUnits so `price` is a whole tick
+        void Rebuild(int64_t newTickUnits);
+
+        PriceLadderSide m_bids;
+        PriceLadderSide m_asks;
+        int64_t m_tickUnits;
+        bool m_tickFixed; // Set explicitly rather than inferred
+        uint64_t m_rejectedLevels;
+    };
+
+    template<typename Fn>
+    void PriceLadderSide::ForEach(size_t maxLevels, Fn&& fn) const
+    {
+        size_t visited = 0;
+        if (m_ladderCount > 0)
+        {
+            const int64_t end = m_base + static_cast<int64_t>(m_size);
+            for (int64_t key = m_bestKey; key < end; key = FindNextKey(key + 1))
+            {
+                fn(key, m_levels[Slot(key)]);
+                if (++visited == maxLevels)
+                    return;
+            }
+        }
+        for (const auto& [key, level] : m_overflow)
+        {
+            fn(key, level);
+            if (++visited == maxLevels)
+                return;
+        }
+    }
+}
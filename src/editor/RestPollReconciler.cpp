@@ -0,0 +1,188 @@
+#include "RestPollReconciler.h"
+#include "OrderbookLevelParser.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace gui
+{
+    namespace editor
+    {
+        RestPollReconciler::RestPollReconciler(std::string_view arrayPath, std::string_view keyField)
+            : m_arrayPath(arrayPath)
+            , m_keyField(keyField)
+            , m_index(256)
+            , m_generation(0)
+            , m_bodyHash(0)
+            , m_interval(1.0f)
+            , m_minInterval(1.0f)
+            , m_maxInterval(60.0f)
+            , m_polls(0)
+            , m_unchangedPolls(0)
+            , m_skippedEntities(0)
+            , m_malformed(0)
+        {
+        }
+
+        void RestPollReconciler::Configure(std::string_view arrayPath, std::string_view keyField)
+        {
+            m_arrayPath.assign(arrayPath);
+            m_keyField.assign(keyField);
+            Reset();
+        }
+
+        void RestPollReconciler::SetIntervalBounds(float minSeconds, float maxSeconds)
+        {
+            m_minInterval = std::max(minSeconds, 0.01f);
+            m_maxInterval = std::max(maxSeconds, m_minInterval);
+            m_interval = std::clamp(m_interval, m_minInterval, m_maxInterval);
+        }
+
+        void RestPollReconciler::AddConditionalHeaders(std::unordered_map<std::string, std::string>& headers) const
+        {
+            if (!m_etag.empty())
+                headers["If-None-Match"] = m_etag;
+            if (!m_lastModified.empty())
+                headers["If-Modified-Since"] = m_lastModified;
+        }
+
+        bool RestPollReconciler::Reconcile(int httpStatus, std::string_view etag, std::string_view lastModified,
+                                           std::string_view body, std::vector<RestEntityDelta>& out)
+        {
+            out.clear();
+            m_removedKeys.clear();
+            m_polls++;
+
+            if (httpStatus == 304)
+            {
+                m_unchangedPolls++;
+                Adapt(false);
+                return false;
+            }
+            if (httpStatus < 200 || httpStatus >= 300)
+                return false; // Errors say nothing about the entities; keep the interval
+
+            // Validators only from a full answer, so a 304 always refers to state we hold
+            m_etag.assign(etag);
+            m_lastModified.assign(lastModified);
+
+            const uint64_t bodyHash = Hash(body);
+            if (bodyHash == m_bodyHash && m_generation != 0)
+            {
+                m_unchangedPolls++;
+                Adapt(false);
+                return false;
+            }
+
+            JsonScan::ArrayReader entities(JsonScan::FindField(body, m_arrayPath));
+            if (!entities.IsValid())
+            {
+                m_malformed++;
+                return false;
+            }
+            m_bodyHash = bodyHash;
+            const uint32_t generation = ++m_generation;
+
+            std::string_view entity;
+            while (entities.Next(entity))
+            {
+                // Without a key field the content is the identity: an edit shows as Removed + Added
+                const std::string_view key = m_keyField.empty()
+                    ? entity
+                    : JsonScan::Unquote(JsonScan::FindField(entity, m_keyField));
+                if (key.empty())
+                {
+                    m_malformed++;
+                    continue;
+                }
+
+                const uint64_t keyHash = Hash(key);
+                const uint64_t hash = Hash(entity);
+                const uint32_t index = m_index.Find(keyHash);
+                if (index == FlatHashIndex::NOT_FOUND)
+                {
+                    m_index.Insert(keyHash, static_cast<uint32_t>(m_entries.size()));
+                    m_entries.push_back(Entry{std::string(key), hash, generation});
+                    out.push_back(RestEntityDelta{RestEntityChange::Added, key, entity});
+                    continue;
+                }
+
+                Entry& entry = m_entries[index];
+                if (entry.generation == generation)
+                    continue; // Listed twice in one response; the first occurrence wins
+                entry.generation = generation;
+                if (entry.hash == hash && entry.key == key)
+                {
+                    m_skippedEntities++;
+                    continue;
+                }
+                // A different key on the same 64-bit hash is reported as a change of that key
+                entry.key.assign(key);
+                entry.hash = hash;
+                out.push_back(RestEntityDelta{RestEntityChange::Changed, key, entity});
+            }
+
+            // Whatever was not listed is gone; swap-remove keeps the index dense
+            for (size_t i = 0; i < m_entries.size();)
+            {
+                if (m_entries[i].generation == generation)
+                {
+                    i++;
+                    continue;
+                }
+                m_index.Erase(Hash(m_entries[i].key));
+                m_removedKeys.push_back(std::move(m_entries[i].key));
+                if (i + 1 != m_entries.size())
+                {
+                    m_entries[i] = std::move(m_entries.back());
+                    m_index.Assign(Hash(m_entries[i].key), static_cast<uint32_t>(i));
+                }
+                m_entries.pop_back();
+            }
+            for (const std::string& key : m_removedKeys)
+                out.push_back(RestEntityDelta{RestEntityChange::Removed, key, {}});
+
+            Adapt(!out.empty());
+            return !out.empty();
+        }
+
+        void RestPollReconciler::Reset()
+        {
+            m_entries.clear();
+            m_index.Clear();
+            m_removedKeys.clear();
+            m_generation = 0;
+            m_bodyHash = 0;
+            m_etag.clear();
+            m_lastModified.clear();
+            m_interval = m_minInterval;
+        }
+
+        uint64_t RestPollReconciler::Hash(std::string_view text)
+        {
+            // Eight bytes per step; only used to detect change, not against adversarial input
+            uint64_t hash = 0x9E3779B97F4A7C15ull ^ text.size();
+            const char* p = text.data();
+            size_t remaining = text.size();
+            while (remaining >= 8)
+            {
+                uint64_t chunk;
+                std::memcpy(&chunk, p, 8);
+                hash = (hash ^ chunk) * 0xBF58476D1CE4E5B9ull;
+                hash ^= hash >> 29;
+                p += 8;
+                remaining -= 8;
+            }
+            uint64_t tail = 0;
+            std::memcpy(&tail, p, remaining);
+            hash = (hash ^ tail) * 0x94D049BB133111EBull;
+            return FlatHashIndex::Hash(hash);
+        }
+
+        void RestPollReconciler::Adapt(bool changed)
+        {
+            m_interval = changed ? std::max(m_minInterval, m_interval * 0.5f)
+                                 : std::min(m_maxInterval, m_interval * 1.25f);
+        }
+    } // editor
+} // gui
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "FlatHashIndex.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace gui::editor
+{
+    enum class RestEntityChange : uint8_t
+    {
+        Added,
+        Changed,
+        Removed
+    };
+
+    // Views stay valid until the next Reconcile(): key and body point into the
+    // response, or for Removed into the reconciler's own copy of the key.
+    struct RestEntityDelta
+    {
+        RestEntityChange change;
+        std::string_view key;
+        std::string_view body; // Raw JSON object, empty for Removed
+    };
+
+    // Turns successive full responses of a polled REST endpoint into per-entity
+    // deltas. The entities are the objects of one array (arrayPath, a JsonScan path;
+    // empty when the response is the array itself) identified by keyField, e.g.
+    // "symbols"/"symbol" for exchangeInfo or "balances"/"asset" for an account.
+    // With no keyField the whole object is its own key.
+    //
+    // Each entity's raw text is hashed and compared with the previous poll, so an
+    // unchanged entity costs a hash and one index probe and is never parsed. A body
+    // identical to the previous one, or a 304 answer to the ETag/Last-Modified
+    // validators from AddConditionalHeaders, is skipped without being split at all.
+    //
+    // The poll interval adapts between the configured bounds: it halves when a poll
+    // brings changes and grows by a quarter after each quiet one.
+    class RestPollReconciler
+    {
+    public:
+        RestPollReconciler(std::string_view arrayPath = {}, std::string_view keyField = {});
+
+        void Configure(std::string_view arrayPath, std::string_view keyField); // Forgets known entities
+        void SetIntervalBounds(float minSeconds, float maxSeconds);
+
+        // If-None-Match / If-Modified-Since from the last full response, when the venue sent them
+        void AddConditionalHeaders(std::unordered_map<std::string, std::string>& headers) const;
+
+        // Returns true when `out` holds at least one delta. etag and lastModified are
+        // the response headers (empty when absent).
+        bool Reconcile(int httpStatus, std::string_view etag, std::string_view lastModified,
+                       std::string_view body, std::vector<RestEntityDelta>& out);
+        bool Reconcile(std::string_view body, std::vector<RestEntityDelta>& out)
+        {
+            return Reconcile(200, {}, {}, body, out);
+        }
+
+        float GetPollInterval() const { return m_interval; }
+        bool IsPollDue(float secondsSinceLastPoll) const { return secondsSinceLastPoll >= m_interval; }
+
+        size_t GetEntityCount() const { return m_entries.size(); }
+        uint64_t GetPollCount() const { return m_polls; }
+        uint64_t GetUnchangedPollCount() const { return m_unchangedPolls; } // 304 or identical body
+        uint64_t GetSkippedEntityCount() const { return m_skippedEntities; }
+        uint64_t GetMalformedCount() const { return m_malformed; }
+
+        void Reset();
+
+    private:
+        struct Entry
+        {
+            std::string key;
+            uint64_t hash;
+            uint32_t generation; // Last poll that listed it
+        };
+
+        static uint64_t Hash(std::string_view text);
+        void Adapt(bool changed);
+
+        std::string m_arrayPath;
+        std::string m_keyField;
+
+        std::vector<Entry> m_entries;
+        FlatHashIndex m_index; // Hash(key) -> m_entries
+        std::vector<std::string> m_removedKeys;
+        uint32_t m_generation;
+        uint64_t m_bodyHash;
+
+        std::string m_etag;
+        std::string m_lastModified;
+
+        float m_interval;
+        float m_minInterval;
+        float m_maxInterval;
+
+        uint64_t m_polls;
+        uint64_t m_unchangedPolls;
+        uint64_t m_skippedEntities;
+        uint64_t m_malformed;
+    };
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "NodeData.h"
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gui::editor
+{
+    // One call for a connected RestConnectionNode to send
+    struct RestRequest
+    {
+        std::string method;   // "GET", "POST", ...
+        std::string endpoint; // Path and query, relative to the connection's base URL
+        std::unordered_map<std::string, std::string> headers; // Extra headers, e.g. If-None-Match
+        std::string correlationId; // Echoed with the response, e.g. the pair of a depth snapshot
+    };
+
+    // A connection's answer to a queued request, handed back to the node that queued it
+    struct RestResponse
+    {
+        int status;                // HTTP status; 304 when the conditional headers matched
+        std::string etag;          // ETag header, empty when absent
+        std::string lastModified;  // Last-Modified header, empty when absent
+        std::string body;
+        std::string correlationId; // From the request
+
+        RestResponse() : status(0) {}
+    };
+
+    using RestResponseHandler = std::function<void(const RestResponse&)>;
+
+    // Pin payload: requests queued by a node since the connection last drained them.
+    // The connection clears `requests` as it sends them and calls onResponse with each
+    // answer, on the node update thread.
+    class RestRequestData : public NodeData
+    {
+    public:
+        std::vector<RestRequest> requests;
+        RestResponseHandler onResponse;
+
+        std::unique_ptr<NodeData> Clone() const override { return std::make_unique<RestRequestData>(*this); }
+        std::type_index GetTypeIndex() const override { return std::type_index(typeid(RestRequestData)); }
+    };
+}
@@ -0,0 +1,218 @@
+#include "SequenceWindow.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace gui
+{
+    namespace editor
+    {
+        SequenceWindow::SequenceWindow(size_t windowSize)
+            : m_size(std::bit_ceil(std::max<size_t>(windowSize, 64)))
+            , m_mask(m_size - 1)
+            , m_base(0)
+            , m_highest(0)
+            , m_started(false)
+            , m_lateCount(0)
+            , m_missingCount(0)
+            , m_duplicateCount(0)
+            , m_maxLateDistance(0)
+            , m_resetCount(0)
+        {
+            m_bits.resize(m_size / 64);
+        }
+
+        SequenceResult SequenceWindow::Record(uint64_t sequence, Clock::time_point now)
+        {
+            SequenceResult result{SequenceStatus::InOrder, 0, 0};
+
+            if (!m_started)
+            {
+                m_started = true;
+                m_base = sequence + 1;
+                m_highest = sequence;
+                result.status = SequenceStatus::First;
+                return result;
+            }
+
+            if (sequence < m_base)
+            {
+                if (m_base - sequence > m_size || WasDeclaredMissing(sequence))
+                {
+                    result.status = SequenceStatus::Expired;
+                    return result;
+                }
+                m_duplicateCount++;
+                result.status = SequenceStatus::Duplicate;
+                return result;
+            }
+
+            // A whole window past everything received: a restarted feed, not a gap to report
+            if (sequence > m_highest && sequence - m_highest >= m_size)
+            {
+                std::fill(m_bits.begin(), m_bits.end(), 0);
+                m_missingRanges.clear();
+                m_base = sequence + 1;
+                m_highest = sequence;
+                m_resetCount++;
+                result.status = SequenceStatus::Reset;
+                return result;
+            }
+
+            // Too far ahead for the window: the oldest part of it can no longer arrive in time
+            if (sequence - m_base >= m_size)
+            {
+                const uint64_t before = m_missingCount;
+                SkipTo(sequence - m_size + 1);
+                result.missing = m_missingCount - before;
+            }
+
+            if (IsSet(sequence))
+            {
+                m_duplicateCount++;
+                result.status = SequenceStatus::Duplicate;
+                return result;
+            }
+
+            const bool hadHoles = HasHoles();
+            Set(sequence);
+
+            if (sequence > m_highest)
+            {
+                result.status = (sequence == m_base) ? SequenceStatus::InOrder : SequenceStatus::Ahead;
+                if (!hadHoles && result.status == SequenceStatus::Ahead)
+                    m_holeSince = now;
+                m_highest = sequence;
+            }
+            else
+            {
+                result.status = SequenceStatus::Late;
+                result.lateDistance = m_highest - sequence;
+                m_lateCount++;
+                m_maxLateDistance = std::max(m_maxLateDistance, result.lateDistance);
+            }
+
+            if (sequence == m_base)
+            {
+                AdvanceBase();
+
+                // A late fill that closed the oldest hole leaves a later one oldest; as in
+                // ExpireHoles it gets its own full timeout
+                if (result.status == SequenceStatus::Late && m_base > sequence + 1 && HasHoles())
+                    m_holeSince = now;
+            }
+            return result;
+        }
+
+        uint64_t SequenceWindow::ExpireHoles(Clock::time_point now, Clock::duration timeout, uint64_t& first)
+        {
+            if (!HasHoles() || now - m_holeSince < timeout)
+                return 0;
+
+            // The hole runs from base up to the next received sequence (highest at the latest)
+            uint64_t end = m_base;
+            while (end < m_highest)
+            {
+                const size_t slot = Slot(end);
+                const uint64_t word = m_bits[slot >> 6] >> (slot & 63);
+                if (word != 0)
+                {
+                    end += static_cast<uint64_t>(std::countr_zero(word));
+                    break;
+                }
+                end += 64 - (slot & 63);
+            }
+            end = std::min(end, m_highest);
+
+            first = m_base;
+            const uint64_t count = end - m_base;
+            m_missingCount += count;
+            AddMissing(first, end);
+            m_base = end;
+            AdvanceBase();
+
+            // Later holes opened after this one; give them their own full timeout
+            if (HasHoles())
+                m_holeSince = now;
+            return count;
+        }
+
+        void SequenceWindow::AdvanceBase()
+        {
+            while (m_base <= m_highest)
+            {
+                const size_t slot = Slot(m_base);
+                const size_t bit = slot & 63;
+                const uint64_t word = m_bits[slot >> 6] >> bit;
+
+                uint64_t run = static_cast<uint64_t>(std::countr_one(word));
+                run = std::min<uint64_t>(run, 64 - bit);
+                run = std::min<uint64_t>(run, m_highest - m_base + 1);
+                if (run == 0)
+                    return;
+
+                // Clear the consumed bits so the ring slots can be reused
+                const uint64_t mask = (run == 64) ? ~uint64_t(0) : (((uint64_t(1) << run) - 1) << bit);
+                m_bits[slot >> 6] &= ~mask;
+                m_base += run;
+            }
+        }
+
+        void SequenceWindow::SkipTo(uint64_t newBase)
+        {
+            const uint64_t scanEnd = std::min(newBase, m_highest + 1);
+            uint64_t runStart = m_base;
+            for (uint64_t sequence = m_base; sequence < scanEnd; sequence++)
+            {
+                if (IsSet(sequence))
+                {
+                    Reset(sequence);
+                    AddMissing(runStart, sequence);
+                    runStart = sequence + 1;
+                }
+                else
+                {
+                    m_missingCount++;
+                }
+            }
+            if (newBase > scanEnd)
+                m_missingCount += newBase - std::max(m_base, scanEnd);
+            AddMissing(runStart, newBase);
+
+            m_base = newBase;
+            m_highest = std::max(m_highest, newBase - 1);
+            AdvanceBase();
+        }
+
+        void SequenceWindow::AddMissing(uint64_t first, uint64_t end)
+        {
+            if (first >= end)
+                return;
+            if (!m_missingRanges.empty() && m_missingRanges.back().second == first)
+            {
+                m_missingRanges.back().second = end;
+                return;
+            }
+
+            // Ranges a full window behind are reported as expired without a lookup
+            const uint64_t oldest = end > m_size ? end - m_size : 0;
+            size_t keep = 0;
+            while (keep < m_missingRanges.size() && m_missingRanges[keep].second <= oldest)
+                keep++;
+            if (m_missingRanges.size() - keep >= MAX_MISSING_RANGES)
+                keep++;
+            m_missingRanges.erase(m_missingRanges.begin(), m_missingRanges.begin() + static_cast<std::ptrdiff_t>(keep));
+            m_missingRanges.emplace_back(first, end);
+        }
+
+        bool SequenceWindow::WasDeclaredMissing(uint64_t sequence) const
+        {
+            for (const auto& [first, end] : m_missingRanges)
+            {
+                if (sequence >= first && sequence < end)
+                    return true;
+            }
+            return false;
+        }
+    } // editor
+} // gui
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace gui::editor
+{
+    enum class SequenceStatus : uint8_t
+    {
+        InOrder,   // The next expected sequence
+        Ahead,     // Newer than expected; leaves a hole behind it
+        Late,      // Fills an open hole
+        Duplicate, // Already received, including ones the window has moved past
+        Expired,   // Older than the window, or already declared missing
+        First,     // First sequence seen on this stream
+        Reset      // Jumped a whole window past the highest; tracking restarted here
+    };
+
+    struct SequenceResult
+    {
+        SequenceStatus status;
+        uint64_t lateDistance; // Late: how far behind the highest sequence it arrived
+        uint64_t missing;      // Sequences declared missing by this call (window overrun, < 2 windows)
+    };
+
+    // Sliding bitmap over one stream's sequence numbers. Bit i records whether
+    // base + i has arrived; base is the oldest sequence not yet accounted for, so
+    // holes between base and the highest sequence are "late" until the timeout
+    // passes and they are declared missing. Updates are O(1); advancing the base
+    // skips whole 64-bit words at a time.
+    //
+    // Below the base, a sequence is a duplicate unless it falls in one of the recent
+    // missing ranges, up to one window back. A jump of a whole window past the
+    // highest sequence is treated as a stream reset rather than as a gap, so a
+    // restarted or re-numbered feed does not report billions of missing ids.
+    class SequenceWindow
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr size_t DEFAULT_WINDOW = 4096;
+
+        explicit SequenceWindow(size_t windowSize = DEFAULT_WINDOW);
+
+        SequenceResult Record(uint64_t sequence, Clock::time_point now);
+
+        // Declares the oldest hole missing once it has been open longer than `timeout`.
+        // Returns the number of sequences declared missing (0 if none); [first, first + n).
+        uint64_t ExpireHoles(Clock::time_point now, Clock::duration timeout, uint64_t& first);
+
+        bool HasHoles() const { return m_started && m_highest >= m_base; }
+        uint64_t GetNextExpected() const { return m_base; }
+        uint64_t GetHighest() const { return m_highest; }
+
+        // Totals for metrics
+        uint64_t GetLateCount() const { return m_lateCount; }
+        uint64_t GetMissingCount() const { return m_missingCount; }
+        uint64_t GetDuplicateCount() const { return m_duplicateCount; }
+        uint64_t GetMaxLateDistance() const { return m_maxLateDistance; }
+        uint64_t GetResetCount() const { return m_resetCount; }
+
+    private:
+        size_t Slot(uint64_t sequence) const { return static_cast<size_t>(sequence) & m_mask; }
+        bool IsSet(uint64_t sequence) const { return (m_bits[Slot(sequence) >> 6] >> (Slot(sequence) & 63)) & 1; }
+        void Set(uint64_t sequence) { m_bits[Slot(sequence) >> 6] |= uint64_t(1) << (Slot(sequence) & 63); }
+        void Reset(uint64_t sequence) { m_bits[Slot(sequence) >> 6] &= ~(uint64_t(1) << (Slot(sequence) & 63)); }
+
+        void AdvanceBase();                // Consumes the received prefix
+        void SkipTo(uint64_t newBase);     // Declares [base, newBase) missing where not received
+        void AddMissing(uint64_t first, uint64_t end);
+        bool WasDeclaredMissing(uint64_t sequence) const;
+
+        static constexpr size_t MAX_MISSING_RANGES = 64;
+
+        std::vector<uint64_t> m_bits;
+        size_t m_size;
+        size_t m_mask;
+        uint64_t m_base;                   // Oldest sequence not yet received or declared missing
+        uint64_t m_highest;                // Highest sequence received
+        Clock::time_point m_holeSince;     // When the current oldest hole opened
+        std::vector<std::pair<uint64_t, uint64_t>> m_missingRanges; // [first, end), oldest first
+        bool m_started;
+
+        uint64_t m_lateCount;
+        uint64_t m_missingCount;
+        uint64_t m_duplicateCount;
+        uint64_t m_maxLateDistance;
+        uint64_t m_resetCount;
+    };
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace gui::editor
+{
+    // Per-source queues merged by a min-heap of source indices. Each source queue is
+    // kept sorted by (key, arrival), so only the k fronts are compared: pop is
+    // O(log k) integer swaps and items never move inside a heap. Sources usually
+    // deliver in key order, where push is O(1); an out-of-order item is moved back
+    // past the later keys of its own source only. Equal keys pop in arrival order,
+    // across sources too.
+    template<typename T>
+    class SourceMergeQueue
+    {
+    public:
+        void Push(uint16_t source, uint64_t key, const T& item)
+        {
+            if (source >= m_sources.size())
+                m_sources.resize(static_cast<size_t>(source) + 1);
+
+            SourceQueue& queue = m_sources[source];
+            if (queue.count == queue.entries.size())
+                Grow(queue);
+
+            // Insertion step; strictly-later keys only, so equal keys stay first-in first-out
+            size_t position = queue.count;
+            while (position > 0 && key < queue.At(position - 1).key)
+            {
+                queue.At(position) = std::move(queue.At(position - 1));
+                position--;
+            }
+            queue.At(position) = Entry{key, m_arrival++, item};
+
+            if (queue.count++ == 0)
+            {
+                queue.heapIndex = m_heap.size();
+                m_heap.push_back(source);
+                SiftUp(queue.heapIndex);
+            }
+            else if (position == 0)
+            {
+                SiftUp(queue.heapIndex); // New front has a smaller key
+            }
+            m_size++;
+        }
+
+        // Removes the item with the smallest (key, arrival) among the source fronts
+        bool Pop(T& item)
+        {
+            if (m_heap.empty())
+                return false;
+
+            SourceQueue& queue = m_sources[m_heap.front()];
+            item = std::move(queue.At(0).item);
+            queue.head = (queue.head + 1) & (queue.entries.size() - 1);
+            queue.count--;
+            m_size--;
+
+            if (queue.count == 0)
+            {
+                m_heap.front() = m_heap.back();
+                m_sources[m_heap.front()].heapIndex = 0;
+                m_heap.pop_back();
+            }
+            if (!m_heap.empty())
+                SiftDown(0);
+            return true;
+        }
+
+        const T* Peek() const
+        {
+            if (m_heap.empty())
+                return nullptr;
+            const SourceQueue& queue = m_sources[m_heap.front()];
+            return &queue.entries[queue.head].item;
+        }
+
+        void Clear()
+        {
+            for (SourceQueue& queue : m_sources)
+            {
+                queue.head = 0;
+                queue.count = 0;
+            }
+            m_heap.clear();
+            m_size = 0;
+        }
+
+        bool Empty() const { return m_size == 0; }
+        size_t Size() const { return m_size; }
+        size_t GetSourceCount() const { return m_heap.size(); } // Sources with queued items
+
+    private:
+        struct Entry
+        {
+            uint64_t key;
+            uint64_t arrival; // Push order across all sources; breaks key ties
+            T item;
+        };
+
+        struct SourceQueue
+        {
+            std::vector<Entry> entries; // Ring, power-of-two capacity
+            size_t head = 0;
+            size_t count = 0;
+            size_t heapIndex = 0; // Position in m_heap while count > 0
+
+            Entry& At(size_t i) { return entries[(head + i) & (entries.size() - 1)]; }
+        };
+
+        bool FrontLess(uint16_t a, uint16_t b) const
+        {
+            const Entry& left = m_sources[a].entries[m_sources[a].head];
+            const Entry& right = m_sources[b].entries[m_sources[b].head];
+            return left.key < right.key || (left.key == right.key && left.arrival < right.arrival);
+        }
+
+        void Swap(size_t a, size_t b)
+        {
+            std::swap(m_heap[a], m_heap[b]);
+            m_sources[m_heap[a]].heapIndex = a;
+            m_sources[m_heap[b]].heapIndex = b;
+        }
+
+        static void Grow(SourceQueue& queue)
+        {
+            const size_t capacity = queue.entries.empty() ? 16 : queue.entries.size() * 2;
+            std::vector<Entry> entries(capacity);
+            for (size_t i = 0; i < queue.count; i++)
+                entries[i] = std::move(queue.At(i));
+            queue.entries.swap(entries);
+            queue.head = 0;
+        }
+
+        void SiftUp(size_t index)
+        {
+            while (index > 0)
+            {
+                const size_t parent = (index - 1) / 2;
+                if (!FrontLess(m_heap[index], m_heap[parent]))
+                    break;
+                Swap(parent, index);
+                index = parent;
+            }
+        }
+
+        void SiftDown(size_t index)
+        {
+            for (;;)
+            {
+                const size_t left = index * 2 + 1;
+                if (left >= m_heap.size())
+                    break;
+                const size_t right = left + 1;
+                size_t smallest = left;
+                if (right < m_heap.size() && FrontLess(m_heap[right], m_heap[left]))
+                    smallest = right;
+                if (!FrontLess(m_heap[smallest], m_heap[index]))
+                    break;
+                Swap(index, smallest);
+                index = smallest;
+            }
+        }
+
+        std::vector<SourceQueue> m_sources; // Indexed by source id
+        std::vector<uint16_t> m_heap;       // Sources with queued items, min-heap on front (key, arrival)
+        size_t m_size = 0;
+        uint64_t m_arrival = 0;
+    };
+}
@@ -0,0 +1,812 @@
+#include "StateJournal.h"
+#include "MappedFile.h"
+#include "StateUpdaters.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+namespace gui
+{
+    namespace editor
+    {
+        namespace
+        {
+            constexpr char SNAPSHOT_MAGIC[8] = {'S', 'T', 'J', 'S', 'N', 'A', 'P', '1'};
+
+            struct JournalRecordHeader
+            {
+                uint32_t size;     // Payload bytes
+                uint32_t checksum; // Of sequence, type and payload
+                uint64_t sequence;
+                uint16_t type;     // JournalRecordType
+                uint16_t reserved;
+                uint32_t reserved2;
+            };
+
+            struct SnapshotHeader
+            {
+                char magic[8];
+                uint32_t version;
+                uint32_t reserved;
+                uint64_t sequence;  // Last journal sequence the snapshot covers
+                uint64_t bodyBytes;
+                uint64_t checksum;
+            };
+
+            static_assert(sizeof(JournalRecordHeader) == 24, "Record header is part of the file format");
+            static_assert(sizeof(SnapshotHeader) == 40, "Snapshot header is part of the file format");
+
+            constexpr uint32_t MAX_RECORD_BYTES = 1u << 20; // Anything larger is corruption
+
+            uint64_t HashBytes(const void* data, size_t size, uint64_t hash)
+            {
+                const auto* p = static_cast<const uint8_t*>(data);
+                while (size >= 8)
+                {
+                    uint64_t chunk;
+                    std::memcpy(&chunk, p, 8);
+                    hash = (hash ^ chunk) * 0x100000001B3ull;
+                    hash ^= hash >> 32;
+                    p += 8;
+                    size -= 8;
+                }
+                while (size-- > 0)
+                    hash = (hash ^ *p++) * 0x100000001B3ull;
+                return hash;
+            }
+
+            uint32_t RecordChecksum(uint64_t sequence, uint16_t type, const void* payload, size_t size)
+            {
+                const uint64_t hash = HashBytes(payload, size, 0xCBF29CE484222325ull ^ (sequence * 0x9E3779B97F4A7C15ull) ^ type);
+                return static_cast<uint32_t>(hash ^ (hash >> 32));
+            }
+
+            int64_t ToNanoseconds(std::chrono::system_clock::time_point time)
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+            }
+
+            std::chrono::system_clock::time_point FromNanoseconds(int64_t nanoseconds)
+            {
+                return std::chrono::system_clock::time_point(
+                    std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(nanoseconds)));
+            }
+
+            // Little-endian host layout; the files are local state, not an exchange format
+            template<typename T>
+            void Put(std::string& out, T value)
+            {
+                out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+            }
+
+            void PutString(std::string& out, std::string_view text)
+            {
+                Put<uint32_t>(out, static_cast<uint32_t>(text.size()));
+                out.append(text.data(), text.size());
+            }
+
+            void PutDecimal(std::string& out, Decimal value)
+            {
+                Put<int64_t>(out, value.units);
+            }
+
+            size_t BeginRecord(std::string& out)
+            {
+                const size_t start = out.size();
+                out.append(sizeof(JournalRecordHeader), '\0');
+                return start;
+            }
+
+            void EndRecord(std::string& out, size_t start, JournalRecordType type, uint64_t sequence)
+            {
+                JournalRecordHeader header{};
+                header.size = static_cast<uint32_t>(out.size() - start - sizeof(header));
+                header.sequence = sequence;
+                header.type = static_cast<uint16_t>(type);
+                header.checksum = RecordChecksum(sequence, header.type, out.data() + start + sizeof(header), header.size);
+                std::memcpy(out.data() + start, &header, sizeof(header));
+            }
+
+            struct PayloadReader
+            {
+                const uint8_t* p;
+                const uint8_t* end;
+                bool ok;
+
+                template<typename T>
+                T Get()
+                {
+                    T value{};
+                    if (static_cast<size_t>(end - p) < sizeof(T))
+                    {
+                        ok = false;
+                        return value;
+                    }
+                    std::memcpy(&value, p, sizeof(T));
+                    p += sizeof(T);
+                    return value;
+                }
+
+                std::string_view GetString()
+                {
+                    const uint32_t size = Get<uint32_t>();
+                    if (!ok || static_cast<size_t>(end - p) < size)
+                    {
+                        ok = false;
+                        return {};
+                    }
+                    const std::string_view text(reinterpret_cast<const char*>(p), size);
+                    p += size;
+                    return text;
+                }
+
+                Decimal GetDecimal() { return Decimal(Get<int64_t>()); }
+            };
+
+            uint32_t FindOrder(OrderStore& orders, std::string_view exchange, std::string_view orderId,
+                               std::string_view clientOrderId)
+            {
+                const uint16_t exchangeId = GetTradeStringTable().FindName(exchange);
+                if (exchangeId == 0 && !exchange.empty())
+                    return OrderStore::INVALID_SLOT; // Venue never seen, so no order of it is stored
+                const uint32_t slot = orders.FindByOrderId(exchangeId, orderId);
+                return slot != OrderStore::INVALID_SLOT ? slot : orders.FindByClientOrderId(exchangeId, clientOrderId);
+            }
+
+            bool ReadSnapshot(const MappedFile& file, uint64_t& sequence, const uint8_t*& body, size_t& bodyBytes)
+            {
+                SnapshotHeader header;
+                if (!file.IsOpen() || file.GetSize() < sizeof(header))
+                    return false;
+                std::memcpy(&header, file.GetData(), sizeof(header));
+                if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 ||
+                    header.version != StateJournal::FORMAT_VERSION ||
+                    header.bodyBytes != file.GetSize() - sizeof(header))
+                    return false;
+
+                body = file.GetData() + sizeof(header);
+                bodyBytes = static_cast<size_t>(header.bodyBytes);
+                if (HashBytes(body, bodyBytes, 0xCBF29CE484222325ull) != header.checksum)
+                    return false;
+                sequence = header.sequence;
+                return true;
+            }
+        }
+
+        StateJournal::StateJournal(Options options)
+            : m_options(std::move(options))
+            , m_running(false)
+            , m_sequence(0)
+            , m_recordsSinceSnapshot(0)
+            , m_changeCursor(0)
+            , m_pendingSequence(0)
+            , m_snapshotSplit(0)
+            , m_hasSnapshot(false)
+            , m_durableSequence(0)
+            , m_stop(false)
+            , m_writeFailed(false)
+            , m_file(nullptr)
+        {
+        }
+
+        StateJournal::~StateJournal()
+        {
+            Stop();
+        }
+
+        bool StateJournal::Recover(OrderStore& orders, std::vector<WalletState>& wallets, JournalRecoveryStats* stats)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            JournalRecoveryStats result;
+            uint64_t lastSequence = 0;
+
+            MappedFile snapshot;
+            const uint8_t* body = nullptr;
+            size_t bodyBytes = 0;
+            if (snapshot.Open(GetSnapshotPath()) && ReadSnapshot(snapshot, result.snapshotSequence, body, bodyBytes))
+            {
+                uint64_t skipped = 0;
+                size_t valid = 0;
+                Replay(body, bodyBytes, 0, &orders, result.snapshotRecords, skipped, valid, lastSequence);
+            }
+            snapshot.Close();
+
+            MappedFile journal;
+            if (journal.Open(GetJournalPath()))
+            {
+                size_t valid = 0;
+                Replay(journal.GetData(), journal.GetSize(), result.snapshotSequence, &orders,
+                       result.journalRecords, result.skippedRecords, valid, lastSequence);
+                result.validJournalBytes = valid;
+            }
+            journal.Close();
+
+            for (const auto& [key, currencies] : m_balances)
+            {
+                WalletState& wallet = wallets.emplace_back();
+                wallet.exchange = key.first;
+                wallet.account = key.second;
+                for (const auto& [currency, entry] : currencies)
+                {
+                    WalletBalance& balance = wallet.balances[currency];
+                    balance.currency = currency;
+                    balance.scale = entry.scale;
+                    balance.available = entry.available;
+                    balance.locked = entry.locked;
+                    balance.total = entry.available + entry.locked;
+                    balance.updateTime = FromNanoseconds(entry.timeNs);
+                    wallet.updateTime = std::max(wallet.updateTime, balance.updateTime);
+                }
+            }
+
+            // The restore itself went through the change stream; start journaling after it
+            m_sequence = std::max({m_sequence, lastSequence, result.snapshotSequence});
+            m_changeCursor = orders.GetChangeSequence();
+            m_identities.clear();
+            m_terminalSlots.clear();
+            orders.ForEachOrder([this, &orders](uint32_t slot, const OrderRecord& record) {
+                Remember(orders, slot);
+                if (IsTerminal(record.status))
+                    m_terminalSlots.push_back(slot);
+            });
+
+            result.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if (stats)
+                *stats = result;
+            return result.snapshotRecords + result.journalRecords > 0;
+        }
+
+        bool StateJournal::Start()
+        {
+            if (m_running)
+                return true;
+
+            std::error_code error;
+            std::filesystem::create_directories(m_options.directory, error);
+
+            // Sequences must keep rising past anything on disk, even without Recover()
+            size_t validBytes = 0;
+            uint64_t lastSequence = 0;
+            {
+                MappedFile snapshot;
+                const uint8_t* body = nullptr;
+                size_t bodyBytes = 0;
+                uint64_t snapshotSequence = 0;
+                if (snapshot.Open(GetSnapshotPath()) && ReadSnapshot(snapshot, snapshotSequence, body, bodyBytes))
+                    lastSequence = snapshotSequence;
+
+                MappedFile journal;
+                if (journal.Open(GetJournalPath()))
+                {
+                    uint64_t applied = 0;
+                    uint64_t skipped = 0;
+                    Replay(journal.GetData(), journal.GetSize(), 0, nullptr, applied, skipped, validBytes, lastSequence);
+                }
+            }
+            m_sequence = std::max(m_sequence, lastSequence);
+
+            // A crash mid-write leaves a partial record; appending after it would hide everything that follows
+            const std::string path = GetJournalPath();
+            if (std::filesystem::exists(path, error) && std::filesystem::file_size(path, error) > validBytes)
+                std::filesystem::resize_file(path, validBytes, error);
+
+            m_file = std::fopen(path.c_str(), "ab");
+            if (!m_file)
+                return false;
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = false;
+                m_durableSequence = m_sequence;
+                m_pendingSequence = m_sequence;
+            }
+            m_writer = std::thread(&StateJournal::WriterLoop, this);
+            m_running = true;
+            return true;
+        }
+
+        void StateJournal::Stop()
+        {
+            if (!m_running)
+                return;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            if (m_writer.joinable())
+                m_writer.join();
+            if (m_file)
+                std::fclose(m_file);
+            m_file = nullptr;
+            m_running = false;
+        }
+
+        void StateJournal::CaptureOrders(const OrderStore& orders)
+        {
+            if (!m_running)
+            {
+                m_changeCursor = orders.GetChangeSequence();
+                return;
+            }
+
+            const bool complete = orders.ReadChanges(m_changeCursor, m_changes);
+            if (complete && m_changes.empty())
+                return;
+
+            // Several changes to one order in a batch collapse into its current state
+            constexpr uint8_t TOUCHED = 1;
+            constexpr uint8_t REMOVED = 2;
+            constexpr uint8_t LIVE = 4;
+            m_touched.clear();
+            auto touch = [this](uint32_t slot, uint8_t flags) {
+                if (slot >= m_touchedFlags.size())
+                    m_touchedFlags.resize(static_cast<size_t>(slot) + 1, 0);
+                if (m_touchedFlags[slot] == 0)
+                    m_touched.push_back(slot);
+                m_touchedFlags[slot] |= flags;
+            };
+
+            size_t records = 0;
+            m_encodeBuffer.clear();
+            if (complete)
+            {
+                for (const OrderChange& change : m_changes)
+                    touch(change.slot, change.type == OrderChangeType::Removed ? TOUCHED | REMOVED : TOUCHED);
+                for (uint32_t slot : m_touched)
+                {
+                    records += CaptureSlot(orders, slot, orders.Get(slot).inUse != 0, (m_touchedFlags[slot] & REMOVED) != 0);
+                    m_touchedFlags[slot] = 0;
+                }
+            }
+            else
+            {
+                // The change stream overran: compare every live order with what was journaled
+                orders.ForEachOrder([&touch](uint32_t slot, const OrderRecord&) { touch(slot, TOUCHED | LIVE); });
+                for (uint32_t slot = 0; slot < m_identities.size(); slot++)
+                {
+                    const bool live = slot < m_touchedFlags.size() && (m_touchedFlags[slot] & LIVE);
+                    if (m_identities[slot].live && !live)
+                    {
+                        records += EncodeRemoved(m_identities[slot], m_encodeBuffer, 0);
+                        m_identities[slot].live = false;
+                    }
+                }
+                for (uint32_t slot : m_touched)
+                {
+                    records += CaptureSlot(orders, slot, true, false);
+                    m_touchedFlags[slot] = 0;
+                }
+            }
+
+            m_recordsSinceSnapshot += records;
+            Submit(m_encodeBuffer);
+        }
+
+        void StateJournal::RecordBalance(std::string_view account, std::string_view exchange, std::string_view currency,
+                                         Decimal available, Decimal locked, int scale, int64_t timeNs)
+        {
+            const BalanceEntry entry{available, locked, scale, timeNs};
+            const auto wallet = m_balances.try_emplace(WalletKey(exchange, account)).first;
+            if ((available + locked).IsZero())
+                wallet->second.erase(std::string(currency));
+            else
+                wallet->second[std::string(currency)] = entry;
+
+            if (!m_running)
+                return;
+            m_encodeBuffer.clear();
+            m_recordsSinceSnapshot += EncodeBalance(wallet->first, currency, entry, m_encodeBuffer, 0);
+            Submit(m_encodeBuffer);
+        }
+
+        size_t StateJournal::EvictTerminal(OrderStore& orders, int64_t nowNs)
+        {
+            // Stopped, the removal could not be journaled and the order would come back on restart
+            if (!m_running)
+                return 0;
+
+            const int64_t cutoff = nowNs - m_options.terminalRetentionMs * 1000000;
+            size_t evicted = 0;
+            for (size_t i = 0; i < m_terminalSlots.size();)
+            {
+                const uint32_t slot = m_terminalSlots[i];
+                const OrderRecord& record = orders.Get(slot);
+                if (record.inUse && IsTerminal(record.status) && record.updateTimeNs > cutoff)
+                {
+                    i++; // Still inside the window for late reports
+                    continue;
+                }
+                // Expired, already gone, or the slot now holds a working order
+                if (record.inUse && IsTerminal(record.status) && orders.Remove(slot))
+                    evicted++;
+                m_terminalSlots[i] = m_terminalSlots.back();
+                m_terminalSlots.pop_back();
+            }
+            return evicted;
+        }
+
+        void StateJournal::WriteSnapshot(const OrderStore& orders)
+        {
+            if (!m_running)
+                return;
+
+            // Every record in the image carries the snapshot's sequence, which must be nonzero
+            if (m_sequence == 0)
+                m_sequence = 1;
+            const uint64_t sequence = m_sequence;
+            std::string image(sizeof(SnapshotHeader), '\0');
+            orders.ForEachOrder([&](uint32_t slot, const OrderRecord&) {
+                EncodeOrder(orders, slot, image, sequence);
+                EncodeFills(orders, slot, OrderStore::NO_FILL, image, sequence);
+            });
+            for (const auto& [wallet, currencies] : m_balances)
+            {
+                for (const auto& [currency, entry] : currencies)
+                    EncodeBalance(wallet, currency, entry, image, sequence);
+            }
+
+            SnapshotHeader header{};
+            std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+            header.version = FORMAT_VERSION;
+            header.sequence = sequence;
+            header.bodyBytes = image.size() - sizeof(header);
+            header.checksum = HashBytes(image.data() + sizeof(header), image.size() - sizeof(header), 0xCBF29CE484222325ull);
+            std::memcpy(image.data(), &header, sizeof(header));
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                // Records queued so far are covered by the snapshot; later ones go to the fresh journal
+                m_snapshotImage.swap(image);
+                m_snapshotSplit = m_pending.size();
+                m_hasSnapshot = true;
+            }
+            m_wake.notify_one();
+            m_recordsSinceSnapshot = 0;
+        }
+
+        uint64_t StateJournal::GetDurableSequence() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_durableSequence;
+        }
+
+        bool StateJournal::WaitForDurable(uint64_t sequence)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_durable.wait(lock, [&] { return m_durableSequence >= sequence || m_stop || m_writeFailed; });
+            return m_durableSequence >= sequence;
+        }
+
+        bool StateJournal::GetWriteFailed() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_writeFailed;
+        }
+
+        std::string StateJournal::GetJournalPath() const
+        {
+            return (std::filesystem::path(m_options.directory) / "journal.bin").string();
+        }
+
+        std::string StateJournal::GetSnapshotPath() const
+        {
+            return (std::filesystem::path(m_options.directory) / "snapshot.bin").string();
+        }
+
+        size_t StateJournal::EncodeOrder(const OrderStore& orders, uint32_t slot, std::string& out, uint64_t sequence)
+        {
+            const OrderState order = orders.ToOrderState(slot);
+            const size_t start = BeginRecord(out);
+            PutString(out, order.exchange);
+            PutString(out, order.orderId);
+            PutString(out, order.clientOrderId);
+            PutString(out, order.account);
+            PutString(out, order.currencyPair);
+            PutString(out, order.side);
+            PutString(out, order.type);
+            PutString(out, order.status);
+            PutString(out, order.rejectReason);
+            Put<int32_t>(out, order.scale.price);
+            Put<int32_t>(out, order.scale.quantity);
+            PutDecimal(out, order.price);
+            PutDecimal(out, order.originalQuantity);
+            PutDecimal(out, order.filledQuantity);
+            Put<double>(out, order.averageFillPrice);
+            Put<int64_t>(out, ToNanoseconds(order.createTime));
+            Put<int64_t>(out, ToNanoseconds(order.updateTime));
+            Put<int64_t>(out, ToNanoseconds(order.lastFillTime));
+            EndRecord(out, start, JournalRecordType::OrderState, Sequence(sequence));
+            return 1;
+        }
+
+        size_t StateJournal::EncodeFills(const OrderStore& orders, uint32_t slot, uint32_t after, std::string& out,
+                                         uint64_t sequence)
+        {
+            // Fills are appended to one array, so those newer than `after` have higher indexes
+            size_t written = 0;
+            const OrderDetails& details = orders.GetDetails(slot);
+            const std::string& exchange = GetTradeStringTable().LookupName(orders.Get(slot).exchangeId);
+
+            m_fillChain.clear();
+            for (uint32_t fill = orders.Get(slot).lastFill;
+                 fill != OrderStore::NO_FILL && (after == OrderStore::NO_FILL || fill > after);
+                 fill = orders.GetFill(fill).previous)
+                m_fillChain.push_back(fill);
+
+            for (auto it = m_fillChain.rbegin(); it != m_fillChain.rend(); ++it)
+            {
+                const OrderFill& fill = orders.GetFill(*it);
+                const size_t start = BeginRecord(out);
+                PutString(out, exchange);
+                PutString(out, details.orderId);
+                PutString(out, details.clientOrderId);
+                PutString(out, orders.GetFillId(*it));
+                PutDecimal(out, fill.price);
+                PutDecimal(out, fill.quantity);
+                Put<int64_t>(out, fill.timeNs);
+                EndRecord(out, start, JournalRecordType::OrderFill, Sequence(sequence));
+                written++;
+            }
+            return written;
+        }
+
+        size_t StateJournal::EncodeRemoved(const OrderIdentity& identity, std::string& out, uint64_t sequence)
+        {
+            const size_t start = BeginRecord(out);
+            PutString(out, identity.exchange);
+            PutString(out, identity.orderId);
+            PutString(out, identity.clientOrderId);
+            EndRecord(out, start, JournalRecordType::OrderRemoved, Sequence(sequence));
+            return 1;
+        }
+
+        size_t StateJournal::EncodeBalance(const WalletKey& wallet, std::string_view currency, const BalanceEntry& entry,
+                                           std::string& out, uint64_t sequence)
+        {
+            const size_t start = BeginRecord(out);
+            PutString(out, wallet.second);
+            PutString(out, wallet.first);
+            PutString(out, currency);
+            Put<int32_t>(out, entry.scale);
+            PutDecimal(out, entry.available);
+            PutDecimal(out, entry.locked);
+            Put<int64_t>(out, entry.timeNs);
+            EndRecord(out, start, JournalRecordType::Balance, Sequence(sequence));
+            return 1;
+        }
+
+        size_t StateJournal::CaptureSlot(const OrderStore& orders, uint32_t slot, bool inUse, bool removed)
+        {
+            if (slot >= m_identities.size())
+                m_identities.resize(static_cast<size_t>(slot) + 1, OrderIdentity{{}, {}, {}, OrderStore::NO_FILL, false});
+            OrderIdentity& identity = m_identities[slot];
+
+            // The slot may have been freed and reused since it was journaled
+            bool sameOrder = identity.live && inUse && !removed;
+            if (sameOrder)
+            {
+                const OrderDetails& details = orders.GetDetails(slot);
+                sameOrder = GetTradeStringTable().LookupName(orders.Get(slot).exchangeId) == identity.exchange &&
+                            ((!identity.orderId.empty() && details.orderId == identity.orderId) ||
+                             (!identity.clientOrderId.empty() && details.clientOrderId == identity.clientOrderId));
+            }
+
+            size_t records = 0;
+            if (identity.live && !sameOrder)
+            {
+                records += EncodeRemoved(identity, m_encodeBuffer, 0);
+                identity.live = false;
+            }
+            if (inUse)
+            {
+                const uint32_t after = sameOrder ? identity.journaledFill : OrderStore::NO_FILL;
+                records += EncodeOrder(orders, slot, m_encodeBuffer, 0);
+                records += EncodeFills(orders, slot, after, m_encodeBuffer, 0);
+                Remember(orders, slot);
+                if (IsTerminal(orders.Get(slot).status))
+                    m_terminalSlots.push_back(slot);
+            }
+            return records;
+        }
+
+        void StateJournal::Remember(const OrderStore& orders, uint32_t slot)
+        {
+            if (slot >= m_identities.size())
+                m_identities.resize(static_cast<size_t>(slot) + 1, OrderIdentity{{}, {}, {}, OrderStore::NO_FILL, false});
+            OrderIdentity& identity = m_identities[slot];
+            const OrderRecord& record = orders.Get(slot);
+            const OrderDetails& details = orders.GetDetails(slot);
+            identity.exchange = GetTradeStringTable().LookupName(record.exchangeId);
+            identity.orderId = details.orderId;
+            identity.clientOrderId = details.clientOrderId;
+            identity.journaledFill = record.lastFill;
+            identity.live = true;
+        }
+
+        void StateJournal::Submit(std::string& records)
+        {
+            if (records.empty())
+                return;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_pending.empty())
+                    m_pending.swap(records);
+                else
+                    m_pending.append(records);
+                m_pendingSequence = m_sequence;
+            }
+            records.clear();
+            m_wake.notify_one();
+        }
+
+        void StateJournal::Replay(const uint8_t* data, size_t size, uint64_t after, OrderStore* orders,
+                                  uint64_t& applied, uint64_t& skipped, size_t& validBytes, uint64_t& lastSequence)
+        {
+            size_t offset = 0;
+            while (size - offset >= sizeof(JournalRecordHeader))
+            {
+                JournalRecordHeader header;
+                std::memcpy(&header, data + offset, sizeof(header));
+                const uint8_t* payload = data + offset + sizeof(header);
+                if (header.size > MAX_RECORD_BYTES || header.size > size - offset - sizeof(header) ||
+                    header.type < static_cast<uint16_t>(JournalRecordType::OrderState) ||
+                    header.type > static_cast<uint16_t>(JournalRecordType::Balance) ||
+                    RecordChecksum(header.sequence, header.type, payload, header.size) != header.checksum)
+                    break;
+
+                offset += sizeof(header) + header.size;
+                lastSequence = std::max(lastSequence, header.sequence);
+                if (header.sequence <= after)
+                {
+                    skipped++;
+                    continue;
+                }
+                if (!orders)
+                    continue;
+
+                PayloadReader reader{payload, payload + header.size, true};
+                switch (static_cast<JournalRecordType>(header.type))
+                {
+                    case JournalRecordType::OrderState:
+                    {
+                        OrderState order;
+                        order.exchange = reader.GetString();
+                        order.orderId = reader.GetString();
+                        order.clientOrderId = reader.GetString();
+                        order.account = reader.GetString();
+                        order.currencyPair = reader.GetString();
+                        order.side = reader.GetString();
+                        order.type = reader.GetString();
+                        order.status = reader.GetString();
+                        order.rejectReason = reader.GetString();
+                        const int32_t priceScale = reader.Get<int32_t>();
+                        const int32_t quantityScale = reader.Get<int32_t>();
+                        order.scale = DecimalScale(priceScale, quantityScale);
+                        order.price = reader.GetDecimal();
+                        order.originalQuantity = reader.GetDecimal();
+                        order.filledQuantity = reader.GetDecimal();
+                        order.remainingQuantity = order.originalQuantity - order.filledQuantity;
+                        order.averageFillPrice = reader.Get<double>();
+                        order.createTime = FromNanoseconds(reader.Get<int64_t>());
+                        order.updateTime = FromNanoseconds(reader.Get<int64_t>());
+                        order.lastFillTime = FromNanoseconds(reader.Get<int64_t>());
+                        if (reader.ok)
+                            orders->Restore(order);
+                        break;
+                    }
+                    case JournalRecordType::OrderFill:
+                    {
+                        const std::string_view exchange = reader.GetString();
+                        const std::string_view orderId = reader.GetString();
+                        const std::string_view clientOrderId = reader.GetString();
+                        const std::string_view fillId = reader.GetString();
+                        const Decimal price = reader.GetDecimal();
+                        const Decimal quantity = reader.GetDecimal();
+                        const int64_t timeNs = reader.Get<int64_t>();
+                        const uint32_t slot = reader.ok ? FindOrder(*orders, exchange, orderId, clientOrderId)
+                                                        : OrderStore::INVALID_SLOT;
+                        if (slot != OrderStore::INVALID_SLOT)
+                            orders->RestoreFill(slot, fillId, price, quantity, timeNs);
+                        break;
+                    }
+                    case JournalRecordType::OrderRemoved:
+                    {
+                        const std::string_view exchange = reader.GetString();
+                        const std::string_view orderId = reader.GetString();
+                        const std::string_view clientOrderId = reader.GetString();
+                        const uint32_t slot = reader.ok ? FindOrder(*orders, exchange, orderId, clientOrderId)
+                                                        : OrderStore::INVALID_SLOT;
+                        if (slot != OrderStore::INVALID_SLOT)
+                            orders->Remove(slot);
+                        break;
+                    }
+                    case JournalRecordType::Balance:
+                    {
+                        const std::string_view account = reader.GetString();
+                        const std::string_view exchange = reader.GetString();
+                        BalanceEntry entry;
+                        const std::string_view currency = reader.GetString();
+                        entry.scale = reader.Get<int32_t>();
+                        entry.available = reader.GetDecimal();
+                        entry.locked = reader.GetDecimal();
+                        entry.timeNs = reader.Get<int64_t>();
+                        if (!reader.ok)
+                            break;
+                        auto& currencies = m_balances[WalletKey(exchange, account)];
+                        if ((entry.available + entry.locked).IsZero())
+                            currencies.erase(std::string(currency));
+                        else
+                            currencies[std::string(currency)] = std::move(entry);
+                        break;
+                    }
+                }
+                applied++;
+            }
+            validBytes = offset;
+        }
+
+        void StateJournal::WriterLoop()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (true)
+            {
+                m_wake.wait(lock, [this] { return m_stop || !m_pending.empty() || m_hasSnapshot; });
+                if (m_pending.empty() && !m_hasSnapshot)
+                    break; // Stopping with nothing left to write
+
+                // Group commit: let the node thread add to this write for a moment
+                if (!m_stop && !m_hasSnapshot && m_options.groupCommitMs > 0)
+                    m_wake.wait_for(lock, std::chrono::milliseconds(m_options.groupCommitMs),
+                                    [this] { return m_stop || m_hasSnapshot; });
+
+                std::string batch;
+                batch.swap(m_pending);
+                const uint64_t batchSequence = m_pendingSequence;
+                std::string snapshot;
+                size_t split = batch.size();
+                const bool hasSnapshot = m_hasSnapshot;
+                if (hasSnapshot)
+                {
+                    snapshot.swap(m_snapshotImage);
+                    split = std::min(m_snapshotSplit, batch.size());
+                    m_hasSnapshot = false;
+                }
+                lock.unlock();
+
+                bool ok = m_file && std::fwrite(batch.data(), 1, split, m_file) == split;
+                if (hasSnapshot && ok)
+                {
+                    // The old journal stays until the snapshot is safely in place
+                    ok = SyncFile(m_file) && ReplaceFileContents(GetSnapshotPath(), snapshot.data(), snapshot.size());
+                    if (ok)
+                    {
+                        std::fclose(m_file);
+                        m_file = std::fopen(GetJournalPath().c_str(), "wb");
+                        ok = m_file != nullptr;
+                    }
+                }
+                if (m_file && split < batch.size())
+                    ok = std::fwrite(batch.data() + split, 1, batch.size() - split, m_file) == batch.size() - split && ok;
+                if (m_file)
+                    ok = (m_options.syncToDisk ? SyncFile(m_file) : std::fflush(m_file) == 0) && ok;
+
+                lock.lock();
+                if (ok)
+                    m_durableSequence = std::max(m_durableSequence, batchSequence);
+                m_writeFailed = m_writeFailed || !ok;
+                m_durable.notify_all();
+            }
+            m_durable.notify_all();
+        }
+
+        StateJournal& GetStateJournal()
+        {
+            static StateJournal journal;
+            return journal;
+        }
+    } // editor
+} // gui
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "Decimal.h"
+#include "OrderStore.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace gui::editor
+{
+    struct WalletState;
+
+    enum class JournalRecordType : uint16_t
+    {
+        OrderState = 1,   // Full order as after the change (upsert)
+        OrderFill = 2,    // One fill, re-linked without changing quantities
+        OrderRemoved = 3,
+        Balance = 4       // One currency of one account on one exchange; zero total removes it
+    };
+
+    struct JournalRecoveryStats
+    {
+        uint64_t snapshotSequence; // 0 when no usable snapshot
+        uint64_t snapshotRecords;
+        uint64_t journalRecords;   // Replayed from the tail
+        uint64_t skippedRecords;   // Already covered by the snapshot
+        uint64_t validJournalBytes; // Anything after this was torn by a crash
+        double elapsedMs;
+
+        JournalRecoveryStats() : snapshotSequence(0), snapshotRecords(0), journalRecords(0), skippedRecords(0),
+                                 validJournalBytes(0), elapsedMs(0.0) {}
+    };
+
+    // Crash-safe record of order and wallet state.
+    //
+    // journal.bin is append-only: every record is a 24-byte header (payload size,
+    // checksum, sequence, type) followed by its payload. The node thread encodes
+    // records into a pending buffer; a writer thread takes whatever accumulated
+    // (waiting up to groupCommitMs for more), writes it with one call and syncs once
+    // per group, so a burst of fills costs one fsync rather than one each.
+    //
+    // snapshot.bin holds the same records, compacted to one per live order, fill and
+    // balance, under a header naming the last sequence it covers. After the snapshot
+    // is in place the journal is truncated, so recovery maps the snapshot, replays it
+    // and then replays only the journal tail (records past the snapshot sequence,
+    // up to the first torn or corrupt record).
+    //
+    // Orders are captured from OrderStore's change stream, so the order updaters do
+    // not call the journal; balances are recorded by the wallet updaters. Finished
+    // orders are evicted from the store (EvictTerminal) once they have been journaled
+    // and left alone for terminalRetentionMs, so neither the store nor the snapshots
+    // grow with the order history.
+    class StateJournal
+    {
+    public:
+        static constexpr uint32_t FORMAT_VERSION = 1;
+
+        struct Options
+        {
+            std::string directory;
+            int groupCommitMs;             // Extra wait for more records before a write
+            bool syncToDisk;               // fsync each group; off trades durability for speed
+            uint64_t snapshotEveryRecords; // ShouldSnapshot() threshold
+            int64_t terminalRetentionMs;   // How long EvictTerminal() keeps finished orders for late reports
+
+            Options() : directory("journal"), groupCommitMs(2), syncToDisk(true), snapshotEveryRecords(100000),
+                        terminalRetentionMs(60000) {}
+        };
+
+        explicit StateJournal(Options options = Options());
+        ~StateJournal(); // Stop()
+
+        StateJournal(const StateJournal&) = delete;
+        StateJournal& operator=(const StateJournal&) = delete;
+
+        // Before Start(): loads snapshot and journal tail into the store and the wallets
+        // (one per exchange and account)
+        bool Recover(OrderStore& orders, std::vector<WalletState>& wallets, JournalRecoveryStats* stats = nullptr);
+        bool Start(); // Drops a torn tail, opens the journal for append and starts the writer
+        void Stop();  // Writes everything pending
+        bool IsRunning() const { return m_running; }
+
+        // Journals the orders changed since the last call (a full rescan if the change stream overran)
+        void CaptureOrders(const OrderStore& orders);
+        void RecordBalance(std::string_view account, std::string_view exchange, std::string_view currency,
+                           Decimal available, Decimal locked, int scale, int64_t timeNs);
+
+        // Removes orders that have been terminal and journaled for terminalRetentionMs. The
+        // removal reaches the journal through the next CaptureOrders(). Returns the count.
+        size_t EvictTerminal(OrderStore& orders, int64_t nowNs);
+
+        bool ShouldSnapshot() const { return m_recordsSinceSnapshot >= m_options.snapshotEveryRecords; }
+        void WriteSnapshot(const OrderStore& orders); // Built here, written by the writer thread
+
+        uint64_t GetSequence() const { return m_sequence; }
+        uint64_t GetDurableSequence() const;
+        bool WaitForDurable(uint64_t sequence); // False if the writer stopped first
+        bool GetWriteFailed() const;
+
+    private:
+        using WalletKey = std::pair<std::string, std::string>; // Exchange, account
+
+        struct BalanceEntry
+        {
+            Decimal available;
+            Decimal locked;
+            int scale;
+            int64_t timeNs;
+        };
+
+        struct OrderIdentity
+        {
+            std::string exchange;
+            std::string orderId;
+            std::string clientOrderId;
+            uint32_t journaledFill; // Newest fill already journaled (OrderStore::NO_FILL for none)
+            bool live;
+        };
+
+        std::string GetJournalPath() const;
+        std::string GetSnapshotPath() const;
+        uint64_t Sequence(uint64_t fixed) { return fixed != 0 ? fixed : ++m_sequence; }
+
+        // sequence 0 numbers each record from m_sequence; snapshots pass their own
+        size_t EncodeOrder(const OrderStore& orders, uint32_t slot, std::string& out, uint64_t sequence);
+        size_t EncodeFills(const OrderStore& orders, uint32_t slot, uint32_t after, std::string& out, uint64_t sequence);
+        size_t EncodeRemoved(const OrderIdentity& identity, std::string& out, uint64_t sequence);
+        size_t EncodeBalance(const WalletKey& wallet, std::string_view currency, const BalanceEntry& entry,
+                             std::string& out, uint64_t sequence);
+        size_t CaptureSlot(const OrderStore& orders, uint32_t slot, bool inUse, bool removed);
+        void Remember(const OrderStore& orders, uint32_t slot);
+        void Submit(std::string& records);
+
+        // Applies records with a sequence above `after` (orders may be null to only validate).
+        // Stops at the first torn or corrupt record; validBytes is where it stopped.
+        void Replay(const uint8_t* data, size_t size, uint64_t after, OrderStore* orders,
+                    uint64_t& applied, uint64_t& skipped, size_t& validBytes, uint64_t& lastSequence);
+        void WriterLoop();
+
+        Options m_options;
+
+        // Node thread
+        bool m_running;
+        uint64_t m_sequence;
+        uint64_t m_recordsSinceSnapshot;
+        uint64_t m_changeCursor;
+        std::vector<OrderIdentity> m_identities; // Per store slot
+        std::vector<uint32_t> m_touched;
+        std::vector<uint8_t> m_touchedFlags;     // Per store slot
+        std::vector<uint32_t> m_fillChain;
+        std::vector<uint32_t> m_terminalSlots;   // Journaled in a terminal state; EvictTerminal() candidates
+        std::map<WalletKey, std::unordered_map<std::string, BalanceEntry>> m_balances; // Wallet -> currency
+        std::string m_encodeBuffer;
+        std::vector<OrderChange> m_changes;
+
+        // Shared with the writer
+        mutable std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_durable;
+        std::string m_pending;
+        uint64_t m_pendingSequence;
+        std::string m_snapshotImage;
+        size_t m_snapshotSplit;        // Bytes of m_pending that precede the snapshot
+        bool m_hasSnapshot;
+        uint64_t m_durableSequence;
+        bool m_stop;
+        bool m_writeFailed;
+
+        std::FILE* m_file; // Owned by the writer while it runs
+        std::thread m_writer;
+    };
+
+    // Process-wide journal; Application recovers and starts it
+    StateJournal& GetStateJournal();
+}
@@ -3,10 +3,799 @@
 //
 
 #include "StateUpdaters.h"
+#include "OrderbookLevelParser.h"
+#include "StateJournal.h"
+
+#include <unordered_set>
 
 namespace gui
 {
     namespace editor
     {
+        namespace
+        {
+            constexpr float MIN_POLL_SECONDS = 1.0f; // Fastest adaptive poll; venues rate-limit below this
+            constexpr float CACHE_SAVE_SECONDS = 2.0f; // A burst of security definitions is saved once
+
+            int64_t NowNanoseconds()
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+            }
+
+            std::string_view CharView(const char& c)
+            {
+                return std::string_view(&c, c != '\0' ? 1 : 0);
+            }
+
+            // Values and journals the balances a push update changed; pushes only carry the
+            // currencies that moved, so a currency is gone only when the parser dropped it
+            void PublishBalanceChanges(const std::unordered_map<std::string, WalletBalance>& before,
+                                       WalletState& wallet, WalletValuation& valuation)
+            {
+                const int64_t now = NowNanoseconds();
+                StateJournal& journal = GetStateJournal();
+                auto publish = [&](const std::string& currency, const WalletBalance& balance) {
+                    valuation.SetBalance(wallet.exchange, wallet.account, currency, balance.total, balance.scale);
+                    journal.RecordBalance(wallet.account, wallet.exchange, currency, balance.available, balance.locked,
+                                          balance.scale, now);
+                };
+
+                bool changed = false;
+                for (const auto& [currency, balance] : wallet.balances)
+                {
+                    const auto previous = before.find(currency);
+                    if (previous != before.end() && previous->second.available == balance.available &&
+                        previous->second.locked == balance.locked && previous->second.scale == balance.scale)
+                        continue;
+                    publish(currency, balance);
+                    changed = true;
+                }
+                for (const auto& [currency, balance] : before)
+                {
+                    if (wallet.balances.count(currency) != 0)
+                        continue;
+                    WalletBalance removed;
+                    removed.scale = balance.scale;
+                    publish(currency, removed);
+                    changed = true;
+                }
+
+                if (changed)
+                {
+                    valuation.Revalue();
+                    wallet.totalValueUSD = valuation.GetAccountValue(wallet.exchange, wallet.account);
+                }
+            }
+
+            // Display/insert form of a decoded report; numbers stay at the wire scale
+            void ToOrderState(const FixExecutionReport& report, DecimalScale wireScale, OrderState& order)
+            {
+                order.orderId = report.orderId;
+                order.clientOrderId = report.clientOrderId;
+                order.currencyPair = report.symbol;
+                order.side = TradeSideToString(ParseTradeSide(CharView(report.side)));
+                order.type = OrderTypeToString(ParseOrderType(CharView(report.orderType)));
+                OrderStatus status;
+                order.status = ParseOrderStatus(CharView(report.orderStatus), status) ? OrderStatusToString(status)
+                                                                                       : std::string(CharView(report.orderStatus));
+                order.scale = wireScale;
+                order.originalQuantity = report.orderQty;
+                order.filledQuantity = report.cumQty;
+                order.remainingQuantity = report.leavesQty;
+                order.price = report.price;
+                order.averageFillPrice = report.avgPx.ToDouble(wireScale.price);
+                order.updateTime = std::chrono::system_clock::now();
+                if (report.orderStatus == '8')
+                    order.rejectReason = report.text;
+            }
+        }
+
+        TransitionAction StateUpdaterBase::ApplyOrderState(OrderStore& orders, const OrderState& report, int64_t timeNs)
+        {
+            const uint16_t exchangeId = GetTradeStringTable().FindName(report.exchange);
+            uint32_t slot = orders.FindByOrderId(exchangeId, report.orderId);
+            if (slot == OrderStore::INVALID_SLOT)
+                slot = orders.FindByClientOrderId(exchangeId, report.clientOrderId);
+            if (slot == OrderStore::INVALID_SLOT)
+            {
+                if (orders.Add(report) != OrderStore::INVALID_SLOT)
+                    return TransitionAction::Apply;
+                AddError("Could not add order " + report.orderId);
+                return TransitionAction::Reject;
+            }
+
+            const DecimalScale scale = orders.GetDetails(slot).scale;
+            Decimal filled;
+            if (!report.filledQuantity.Rescale(report.scale.quantity, scale.quantity, filled))
+            {
+                AddError("Order " + report.orderId + ": filled quantity does not fit the order's scale");
+                return TransitionAction::Reject;
+            }
+            if (!report.orderId.empty() && orders.GetDetails(slot).orderId != report.orderId)
+                orders.AssignOrderId(slot, report.orderId);
+
+            // A working order whose price or size moved was amended at the venue (or through another session)
+            Decimal price;
+            Decimal quantity;
+            const OrderRecord& record = orders.Get(slot);
+            if (!IsTerminal(record.status) && !report.price.IsZero() && !report.originalQuantity.IsZero() &&
+                report.price.Rescale(report.scale.price, scale.price, price) &&
+                report.originalQuantity.Rescale(report.scale.quantity, scale.quantity, quantity) &&
+                (price != record.price || quantity != record.originalQuantity))
+                orders.Amend(slot, price, quantity, timeNs);
+
+            OrderStatus status = OrderStatus::Open;
+            const bool knownStatus = ParseOrderStatus(report.status, status);
+            const OrderEvent event = EventFromStatus(status);
+            const OrderTransition transition = DecideTransition(orders.Get(slot), event, &filled);
+
+            // Executions are facts even when the status beside them is stale or contradictory.
+            // An average price that does not fit the scale is left unknown (zero).
+            Decimal averagePrice;
+            Decimal::FromDouble(report.averageFillPrice, scale.price, averagePrice);
+            orders.ReconcileFilled(slot, filled, averagePrice, timeNs);
+
+            if (!knownStatus)
+            {
+                // The executions above are kept; the status stays what it was
+                AddError("Order " + report.orderId + ": unrecognised status \"" + report.status + "\"");
+                return TransitionAction::Ignore;
+            }
+
+            switch (transition.action)
+            {
+                case TransitionAction::Reject:
+                    AddError("Order " + report.orderId + ": " + OrderEventToString(event) + " not possible while " +
+                             OrderStatusToString(orders.Get(slot).status));
+                    return transition.action;
+                case TransitionAction::Ignore:
+                case TransitionAction::Defer: // JSON channels resend the whole order; the next report supersedes this one
+                    return transition.action;
+                case TransitionAction::Apply:
+                    break;
+            }
+
+            // The fill above may already have completed the order
+            if (IsTerminal(orders.Get(slot).status) && !IsTerminal(transition.next))
+                return transition.action;
+            orders.SetStatus(slot, transition.next, timeNs,
+                             transition.next == OrderStatus::Rejected ? report.rejectReason : std::string_view());
+            return transition.action;
+        }
+
+        void RestOrderStateUpdater::Update(float deltaTime)
+        {
+            StateUpdaterBase::Update(deltaTime);
+            if (!m_enabled || !m_enablePolling)
+                return;
+
+            m_lastPollTime += deltaTime;
+            if (m_poll.IsPollDue(m_lastPollTime))
+            {
+                m_lastPollTime = 0.0f;
+                RequestOrderUpdate();
+            }
+        }
+
+        void RestOrderStateUpdater::ProcessRestResponse(const RestResponse& response)
+        {
+            if (!response.correlationId.empty())
+            {
+                if (response.status >= 200 && response.status < 300)
+                    ApplyOrderDetail(response.body);
+                else
+                    AddError("Order " + response.correlationId + " lookup failed with HTTP " +
+                             std::to_string(response.status));
+                return;
+            }
+
+            // A 304 or an identical body costs no parsing at all
+            if (m_poll.Reconcile(response.status, response.etag, response.lastModified, response.body, m_deltas))
+                ApplyOrderDeltas();
+        }
+
+        void RestOrderStateUpdater::ProcessRestOrderUpdate(const std::string& jsonResponse)
+        {
+            // Only orders whose JSON changed since the previous poll get parsed
+            if (m_poll.Reconcile(jsonResponse, m_deltas))
+                ApplyOrderDeltas();
+        }
+
+        void RestOrderStateUpdater::ApplyOrderDeltas()
+        {
+            const int64_t now = NowNanoseconds();
+            for (const RestEntityDelta& delta : m_deltas)
+            {
+                if (delta.change == RestEntityChange::Removed)
+                {
+                    // Gone from the open orders: filled or cancelled. If no stream has said which,
+                    // the detail endpoint does
+                    const uint32_t slot = m_orders.FindByOrderId(m_exchangeId, delta.key);
+                    if (slot != OrderStore::INVALID_SLOT && !IsTerminal(m_orders.Get(slot).status))
+                        RequestOrderUpdate(std::string(delta.key));
+                    continue;
+                }
+
+                // Polled state lags the streams, so it goes through the same lifecycle checks
+                OrderState order;
+                ParseOrderFromJson(std::string(delta.body), order);
+                if (order.exchange.empty())
+                    order.exchange = GetTradeStringTable().LookupName(m_exchangeId);
+                ApplyOrderState(m_orders, order, now);
+            }
+        }
+
+        void RestOrderStateUpdater::ApplyOrderDetail(const std::string& json)
+        {
+            OrderState order;
+            ParseOrderFromJson(json, order);
+            if (order.orderId.empty() && order.clientOrderId.empty())
+            {
+                AddError("Order detail without an order id");
+                return;
+            }
+            if (order.exchange.empty())
+                order.exchange = GetTradeStringTable().LookupName(m_exchangeId);
+            ApplyOrderState(m_orders, order, NowNanoseconds());
+        }
+
+        void RestOrderStateUpdater::RequestOrderUpdate(const std::string& orderId)
+        {
+            const char* endpoint = orderId.empty() ? m_ordersEndpoint : m_orderDetailEndpoint;
+            if (endpoint[0] == '\0')
+            {
+                AddError(orderId.empty() ? std::string("No orders endpoint configured")
+                                         : "No order detail endpoint configured; cannot resolve order " + orderId);
+                return;
+            }
+
+            if (!m_requests)
+            {
+                m_requests = std::make_shared<RestRequestData>();
+                m_requests->onResponse = [this](const RestResponse& response) { ProcessRestResponse(response); };
+            }
+            RestRequest& request = m_requests->requests.emplace_back();
+            request.method = "GET";
+            request.endpoint = endpoint;
+            if (orderId.empty())
+            {
+                m_poll.AddConditionalHeaders(request.headers);
+            }
+            else
+            {
+                const size_t placeholder = request.endpoint.find("{orderId}");
+                if (placeholder != std::string::npos)
+                    request.endpoint.replace(placeholder, 9, orderId);
+                else
+                    request.endpoint += (request.endpoint.find('?') == std::string::npos ? "?orderId=" : "&orderId=") + orderId;
+                request.correlationId = orderId;
+            }
+
+            if (Pin* pin = FindOutputPin("Poll Requests"))
+                SetOutputData(pin->id, m_requests);
+        }
+
+        void RestOrderStateUpdater::SelectExchange()
+        {
+            if (!GetTradeStringTable().InternName(m_exchange, m_exchangeId))
+                AddError(std::string("Too many exchange and account names to add ") + m_exchange);
+        }
+
+        void RestOrderStateUpdater::ApplyPollConfig()
+        {
+            m_poll.Configure(m_ordersArrayPath, m_orderIdField);
+            m_poll.SetIntervalBounds(MIN_POLL_SECONDS, static_cast<float>(m_pollingInterval));
+            m_lastPollTime = 0.0f;
+        }
+
+        void WebsocketOrderStateUpdater::ProcessWebsocketOrderUpdate(const std::string& jsonMessage)
+        {
+            OrderState order;
+            ParseOrderFromJson(jsonMessage, order);
+            if (order.orderId.empty() && order.clientOrderId.empty())
+            {
+                AddError("Order update without an order id");
+                return;
+            }
+            ApplyOrderState(m_orders, order, NowNanoseconds());
+        }
+
+        void RestWalletStateUpdater::Update(float deltaTime)
+        {
+            StateUpdaterBase::Update(deltaTime);
+            if (!m_enabled || !m_enablePolling)
+                return;
+
+            m_lastPollTime += deltaTime;
+            if (m_poll.IsPollDue(m_lastPollTime))
+            {
+                m_lastPollTime = 0.0f;
+                RequestWalletUpdate();
+            }
+        }
+
+        void RestWalletStateUpdater::ProcessRestResponse(const RestResponse& response)
+        {
+            if (m_poll.Reconcile(response.status, response.etag, response.lastModified, response.body, m_deltas))
+                ApplyBalanceDeltas();
+        }
+
+        void RestWalletStateUpdater::ProcessRestWalletUpdate(const std::string& jsonResponse)
+        {
+            if (m_poll.Reconcile(jsonResponse, m_deltas))
+                ApplyBalanceDeltas();
+        }
+
+        void RestWalletStateUpdater::RequestWalletUpdate()
+        {
+            if (m_balancesEndpoint[0] == '\0')
+            {
+                AddError("No balances endpoint configured");
+                return;
+            }
+
+            if (!m_requests)
+            {
+                m_requests = std::make_shared<RestRequestData>();
+                m_requests->onResponse = [this](const RestResponse& response) { ProcessRestResponse(response); };
+            }
+            RestRequest& request = m_requests->requests.emplace_back();
+            request.method = "GET";
+            request.endpoint = m_balancesEndpoint;
+            m_poll.AddConditionalHeaders(request.headers);
+
+            if (Pin* pin = FindOutputPin("Poll Requests"))
+                SetOutputData(pin->id, m_requests);
+        }
+
+        void RestWalletStateUpdater::ApplyPollConfig()
+        {
+            m_poll.Configure(m_balancesArrayPath, m_currencyField);
+            m_poll.SetIntervalBounds(MIN_POLL_SECONDS, static_cast<float>(m_pollingInterval));
+            m_lastPollTime = 0.0f;
+        }
+
+        void RestWalletStateUpdater::ApplyBalanceDeltas()
+        {
+            const auto now = std::chrono::system_clock::now();
+            for (const RestEntityDelta& delta : m_deltas)
+            {
+                const std::string currency(delta.key);
+                WalletBalance balance;
+                balance.currency = currency;
+                balance.updateTime = now;
+
+                if (delta.change != RestEntityChange::Removed)
+                {
+                    JsonScan::ObjectReader reader(delta.body);
+                    std::string_view key;
+                    std::string_view value;
+                    bool ok = true;
+                    while (reader.Next(key, value))
+                    {
+                        if (key == m_availableField)
+                            ok &= Decimal::Parse(JsonScan::Unquote(value), balance.scale, balance.available);
+                        else if (key == m_lockedField)
+                            ok &= Decimal::Parse(JsonScan::Unquote(value), balance.scale, balance.locked);
+                    }
+                    if (!ok)
+                    {
+                        // Keep the last good balance rather than journal and value a half-parsed one
+                        AddError("Unparsable balance for " + currency);
+                        continue;
+                    }
+                    balance.total = balance.available + balance.locked;
+                }
+
+                if (delta.change == RestEntityChange::Removed || (balance.total.IsZero() && !m_includeZeroBalances))
+                    m_walletState.balances.erase(currency);
+                else
+                    m_walletState.balances[currency] = balance;
+
+                if (m_calculateTotalValue)
+                    m_valuation.SetBalance(m_walletState.exchange, m_walletState.account, currency, balance.total,
+                                           balance.scale);
+                GetStateJournal().RecordBalance(m_walletState.account, m_walletState.exchange, currency,
+                                                balance.available, balance.locked, balance.scale,
+                                                std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count());
+            }
+
+            m_walletState.updateTime = now;
+            if (m_calculateTotalValue)
+            {
+                m_valuation.Revalue();
+                m_walletState.totalValueUSD = m_valuation.GetAccountValue(m_walletState.exchange, m_walletState.account);
+            }
+        }
+
+        void WebsocketWalletStateUpdater::ProcessWebsocketWalletUpdate(const std::string& jsonMessage)
+        {
+            const std::unordered_map<std::string, WalletBalance> before = m_walletState.balances;
+            ParseWalletFromJson(jsonMessage);
+            m_walletState.updateTime = std::chrono::system_clock::now();
+            PublishBalanceChanges(before, m_walletState, m_valuation);
+        }
+
+        void FIXWalletStateUpdater::ProcessFixWalletUpdate(const std::string& fixMessage)
+        {
+            const std::unordered_map<std::string, WalletBalance> before = m_walletState.balances;
+            ParseWalletFromFix(fixMessage);
+            m_walletState.updateTime = std::chrono::system_clock::now();
+            PublishBalanceChanges(before, m_walletState, m_valuation);
+        }
+
+        void RestInstrumentDataUpdater::Update(float deltaTime)
+        {
+            StateUpdaterBase::Update(deltaTime);
+            if (!m_enabled || !m_enablePolling)
+                return;
+
+            m_lastPollTime += deltaTime;
+            if (m_poll.IsPollDue(m_lastPollTime))
+            {
+                m_lastPollTime = 0.0f;
+                RequestInstrumentUpdate();
+            }
+        }
+
+        void RestInstrumentDataUpdater::ProcessRestResponse(const RestResponse& response)
+        {
+            // exchangeInfo changes rarely; most polls end at the 304 or the body hash
+            if (m_poll.Reconcile(response.status, response.etag, response.lastModified, response.body, m_deltas))
+                ApplyInstrumentDeltas();
+        }
+
+        void RestInstrumentDataUpdater::ProcessRestInstrumentUpdate(const std::string& jsonResponse)
+        {
+            // An unchanged symbol costs a hash, not a parse
+            if (m_poll.Reconcile(jsonResponse, m_deltas))
+                ApplyInstrumentDeltas();
+        }
+
+        void RestInstrumentDataUpdater::RequestInstrumentUpdate()
+        {
+            if (m_instrumentsEndpoint[0] == '\0')
+            {
+                AddError("No instruments endpoint configured");
+                return;
+            }
+
+            if (!m_requests)
+            {
+                m_requests = std::make_shared<RestRequestData>();
+                m_requests->onResponse = [this](const RestResponse& response) { ProcessRestResponse(response); };
+            }
+            RestRequest& request = m_requests->requests.emplace_back();
+            request.method = "GET";
+            request.endpoint = m_instrumentsEndpoint;
+            m_poll.AddConditionalHeaders(request.headers);
+
+            if (Pin* pin = FindOutputPin("Poll Requests"))
+                SetOutputData(pin->id, m_requests);
+        }
+
+        void RestInstrumentDataUpdater::ApplyPollConfig()
+        {
+            m_poll.Configure(m_symbolsArrayPath, m_symbolField);
+            m_poll.SetIntervalBounds(MIN_POLL_SECONDS, static_cast<float>(m_pollingInterval));
+            m_lastPollTime = 0.0f;
+        }
+
+        void RestInstrumentDataUpdater::ApplyInstrumentDeltas()
+        {
+            for (const RestEntityDelta& delta : m_deltas)
+            {
+                const std::string symbol(delta.key);
+                if (delta.change == RestEntityChange::Removed)
+                {
+                    m_instruments.erase(symbol);
+                    GetInstrumentRegistry().Remove(m_cacheExchange, symbol);
+                    continue;
+                }
+
+                InstrumentData instrument;
+                ParseInstrumentFromJson(std::string(delta.body), instrument);
+                if (instrument.exchange.empty())
+                    instrument.exchange = m_cacheExchange;
+                GetInstrumentRegistry().Publish(instrument);
+                if (!instrument.tradingEnabled && !m_includeInactiveInstruments)
+                    m_instruments.erase(symbol);
+                else
+                    m_instruments[symbol] = std::move(instrument);
+            }
+
+            if (!m_cacheReconciled)
+            {
+                // The first live answer lists every symbol as added; cached ones it lacks are delisted
+                std::unordered_set<std::string_view> live;
+                for (const RestEntityDelta& delta : m_deltas)
+                    live.insert(delta.key);
+                for (auto it = m_instruments.begin(); it != m_instruments.end();)
+                {
+                    if (live.count(it->first) != 0)
+                    {
+                        ++it;
+                        continue;
+                    }
+                    GetInstrumentRegistry().Remove(m_cacheExchange, it->first);
+                    it = m_instruments.erase(it);
+                }
+                m_cacheReconciled = true;
+            }
+            m_cache.SaveAsync(m_cacheExchange, m_instruments);
+        }
+
+        void RestInstrumentDataUpdater::SelectExchange()
+        {
+            // Another venue's instruments must not linger under this updater
+            for (const auto& [symbol, instrument] : m_instruments)
+                GetInstrumentRegistry().Remove(instrument.exchange, symbol);
+            m_instruments.clear();
+            if (m_cacheExchange[0] != '\0')
+                LoadCachedInstruments();
+        }
+
+        void RestInstrumentDataUpdater::LoadCachedInstruments()
+        {
+            // Mapped, copied and released: the writer thread replaces the file later.
+            // The reconciler forgets the last response, so the next one lists every live
+            // symbol as added and the cached ones it lacks can be told apart as delisted
+            m_cacheReconciled = false;
+            m_poll.Reset();
+            if (m_cache.Open(m_cacheExchange))
+            {
+                m_cache.CopyTo(m_instruments);
+                m_cache.Close();
+                for (const auto& [symbol, instrument] : m_instruments)
+                    GetInstrumentRegistry().Publish(instrument);
+            }
+        }
+
+        void FIXInstrumentDataUpdater::SelectExchange()
+        {
+            // Unsaved definitions belong to the previous venue, which m_cacheExchange no longer names
+            for (const auto& [symbol, instrument] : m_instruments)
+                GetInstrumentRegistry().Remove(instrument.exchange, symbol);
+            m_instruments.clear();
+            m_cacheDirty = false;
+            if (m_cacheExchange[0] != '\0')
+                LoadCachedInstruments();
+        }
+
+        void FIXInstrumentDataUpdater::LoadCachedInstruments()
+        {
+            m_cacheDirty = false;
+            if (m_cache.Open(m_cacheExchange))
+            {
+                m_cache.CopyTo(m_instruments);
+                m_cache.Close();
+                for (const auto& [symbol, instrument] : m_instruments)
+                    GetInstrumentRegistry().Publish(instrument);
+            }
+        }
+
+        void FIXInstrumentDataUpdater::ProcessFixInstrumentUpdate(const std::string& fixMessage)
+        {
+            InstrumentData instrument;
+            ParseInstrumentFromFix(fixMessage, instrument);
+            if (instrument.symbol.empty())
+            {
+                AddError("Security definition without a symbol");
+                return;
+            }
+            if (instrument.exchange.empty())
+                instrument.exchange = m_cacheExchange;
+            GetInstrumentRegistry().Publish(instrument);
+            const std::string symbol = instrument.symbol;
+            m_instruments[symbol] = std::move(instrument);
+            m_cacheDirty = true;
+        }
+
+        void FIXInstrumentDataUpdater::Update(float deltaTime)
+        {
+            StateUpdaterBase::Update(deltaTime);
+
+            // Definitions arrive one message per symbol; serialising the whole set for each would be quadratic
+            m_sinceCacheSave += deltaTime;
+            if (m_cacheDirty && m_sinceCacheSave >= CACHE_SAVE_SECONDS)
+            {
+                m_cache.SaveAsync(m_cacheExchange, m_instruments);
+                m_cacheDirty = false;
+                m_sinceCacheSave = 0.0f;
+            }
+        }
+
+        void FIXOrderStateUpdater::ProcessFixOrderUpdate(const std::string& fixMessage)
+        {
+            if (!m_reportDecoder.Decode(fixMessage, m_wireScale, m_report))
+            {
+                AddError("Malformed FIX order message");
+                return;
+            }
+
+            const bool wanted = (m_report.msgType == '8' && m_processExecutionReports) ||
+                                (m_report.msgType == '9' && m_processOrderCancelRejects);
+            if (!wanted)
+                return;
+
+            const TransitionAction action = ApplyExecutionReport(m_report);
+            if (action == TransitionAction::Defer)
+            {
+                if (m_deferredReports.size() < MAX_DEFERRED_REPORTS)
+                    m_deferredReports.push_back(fixMessage);
+                else
+                    AddError("Deferred FIX report queue full, dropping report for order " + std::string(m_report.orderId));
+            }
+            else if (action == TransitionAction::Apply && !m_deferredReports.empty())
+            {
+                RetryDeferredReports();
+            }
+        }
+
+        void FIXOrderStateUpdater::RetryDeferredReports()
+        {
+            // Each applied report may unblock others; repeat until a pass makes no progress
+            bool progress = true;
+            while (progress && !m_deferredReports.empty())
+            {
+                progress = false;
+                for (size_t i = 0; i < m_deferredReports.size();)
+                {
+                    FixExecutionReport report;
+                    TransitionAction action = TransitionAction::Ignore;
+                    if (m_reportDecoder.Decode(m_deferredReports[i], m_wireScale, report))
+                        action = ApplyExecutionReport(report);
+                    if (action == TransitionAction::Defer)
+                    {
+                        i++;
+                        continue;
+                    }
+                    progress |= action == TransitionAction::Apply;
+                    m_deferredReports[i] = std::move(m_deferredReports.back());
+                    m_deferredReports.pop_back();
+                }
+            }
+        }
+
+        void FIXOrderStateUpdater::ParseOrderFromFix(const std::string& fixMsg, OrderState& order)
+        {
+            FixExecutionReport report;
+            if (m_reportDecoder.Decode(fixMsg, m_wireScale, report))
+                ToOrderState(report, m_wireScale, order);
+        }
+
+        void FIXOrderStateUpdater::SelectExchange()
+        {
+            if (!GetTradeStringTable().InternName(m_exchange, m_exchangeId))
+                AddError(std::string("Too many exchange and account names to add ") + m_exchange);
+        }
+
+        TransitionAction FIXOrderStateUpdater::ApplyExecutionReport(const FixExecutionReport& report)
+        {
+            uint32_t slot = m_orders.FindByOrderId(m_exchangeId, report.orderId);
+            if (slot == OrderStore::INVALID_SLOT)
+                slot = m_orders.FindByClientOrderId(m_exchangeId, report.clientOrderId);
+            if (slot == OrderStore::INVALID_SLOT)
+                slot = m_orders.FindByClientOrderId(m_exchangeId, report.origClientOrderId); // OrigClOrdID (41): the ClOrdID before the replace
+
+            if (slot == OrderStore::INVALID_SLOT)
+            {
+                // First sight of an order placed elsewhere (another session, the web UI, ...)
+                if (report.msgType != '8')
+                    return TransitionAction::Ignore;
+                OrderState order;
+                ToOrderState(report, m_wireScale, order);
+                order.exchange = GetTradeStringTable().LookupName(m_exchangeId);
+                order.createTime = order.updateTime;
+                if (m_orders.Add(order) == OrderStore::INVALID_SLOT)
+                {
+                    AddError("Could not add order " + std::string(report.orderId));
+                    return TransitionAction::Reject;
+                }
+                return TransitionAction::Apply;
+            }
+
+            const int64_t now = NowNanoseconds();
+            const DecimalScale scale = m_orders.GetDetails(slot).scale;
+            bool scaled = true;
+            auto price = [&](Decimal value) { scaled = value.Rescale(m_wireScale.price, scale.price, value) && scaled; return value; };
+            auto quantity = [&](Decimal value) { scaled = value.Rescale(m_wireScale.quantity, scale.quantity, value) && scaled; return value; };
+            const Decimal cumQty = quantity(report.cumQty);
+            const Decimal lastPx = price(report.lastPx);
+            const Decimal lastQty = quantity(report.lastQty);
+            const Decimal orderQty = quantity(report.orderQty);
+            const Decimal avgPx = report.Has(FixOrderField::AvgPx) ? price(report.avgPx) : Decimal();
+            const Decimal newPrice = report.Has(FixOrderField::Price) ? price(report.price) : m_orders.Get(slot).price;
+            if (!scaled)
+            {
+                // A wrapped value would corrupt the order; the report is refused as a whole
+                AddError("Order " + std::string(report.orderId) + ": report values do not fit the order's scale");
+                return TransitionAction::Reject;
+            }
+
+            if (!report.orderId.empty() && m_orders.GetDetails(slot).orderId != report.orderId)
+                m_orders.AssignOrderId(slot, report.orderId);
+
+            if (report.msgType == '9')
+            {
+                // Cancel/replace rejected: OrdStatus (39) says where the order stands now, which
+                // ends PendingCancel/PendingReplace. Without it the order is still working.
+                OrderEvent event = OrderEvent::Acknowledged;
+                if (report.orderStatus != '\0' && !EventFromFix('\0', report.orderStatus, event))
+                {
+                    AddError("Order " + std::string(report.orderId) + ": unrecognised OrdStatus " +
+                             std::string(1, report.orderStatus));
+                    return TransitionAction::Ignore;
+                }
+                const OrderTransition transition = DecideTransition(m_orders.Get(slot), event, nullptr);
+                const OrderStatus status =
+                    transition.action == TransitionAction::Apply ? transition.next : m_orders.Get(slot).status;
+                m_orders.SetStatus(slot, status, now, report.text);
+                return TransitionAction::Apply;
+            }
+
+            OrderEvent event = OrderEvent::Restated;
+            const bool knownEvent = EventFromFix(report.execType, report.orderStatus, event);
+            const OrderTransition transition =
+                DecideTransition(m_orders.Get(slot), event, report.Has(FixOrderField::CumQty) ? &cumQty : nullptr);
+
+            // Executions are facts even when the status beside them is stale or contradictory, so
+            // they are applied whatever the table decides. Fills dedupe on ExecID (a deferred
+            // report retried later is not counted twice); one without it is left to CumQty.
+            if (report.lastQty.IsPositive() && !m_orders.ApplyFill(slot, report.execId, lastPx, lastQty, now) &&
+                report.execId.empty())
+                m_fillsWithoutExecId++;
+
+            // CumQty is the venue's running total: it catches executions whose reports were lost
+            if (report.Has(FixOrderField::CumQty))
+                m_orders.ReconcileFilled(slot, cumQty, avgPx, now);
+
+            if (!knownEvent)
+            {
+                // The executions above are kept; the status stays what it was
+                AddError("Order " + std::string(report.orderId) + ": unrecognised ExecType " +
+                         std::string(1, report.execType) + " / OrdStatus " + std::string(1, report.orderStatus));
+                return TransitionAction::Ignore;
+            }
+
+            switch (transition.action)
+            {
+                case TransitionAction::Defer:
+                    return transition.action;
+                case TransitionAction::Reject:
+                    m_rejectedTransitions++;
+                    AddError("Order " + std::string(report.orderId) + ": " + OrderEventToString(event) +
+                             " not possible while " + OrderStatusToString(m_orders.Get(slot).status));
+                    return transition.action;
+                case TransitionAction::Ignore:
+                case TransitionAction::Apply:
+                    break;
+            }
+
+            if (transition.action == TransitionAction::Ignore)
+            {
+                m_ignoredReports++;
+                return transition.action;
+            }
+
+            if (event == OrderEvent::Replaced)
+            {
+                if (report.Has(FixOrderField::OrderQty))
+                    m_orders.Amend(slot, newPrice, orderQty, now);
+                // The replacement order is known by the ClOrdID of the replace request from now on
+                if (!report.clientOrderId.empty() && !m_orders.AssignClientOrderId(slot, report.clientOrderId))
+                    AddError("Order " + std::string(report.orderId) + ": replaced ClOrdID " +
+                             std::string(report.clientOrderId) + " is already in use");
+            }
+
+            // The fill above may already have completed an order whose report still says partially filled
+            if (IsTerminal(m_orders.Get(slot).status) && !IsTerminal(transition.next))
+                return transition.action;
+
+            m_orders.SetStatus(slot, transition.next, now,
+                               transition.next == OrderStatus::Rejected ? report.text : std::string_view());
+            return transition.action;
+        }
     } // editor
-} // gui
\ No newline at end of file
+} // gui
@@ -1,6 +1,17 @@
 #pragma once
 
 #include "Node.h"
+#include "Decimal.h"
+#include "FixExecutionReport.h"
+#include "InstrumentCache.h"
+#include "InstrumentRegistry.h"
+#include "OrderLifecycle.h"
+#include "OrderStore.h"
+#include "RestPollReconciler.h"
+#include "RestRequest.h"
+#include "WalletState.h"
+#include "WalletValuation.h"
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -17,61 +28,19 @@ namespace gui::editor
         std::string side; // "buy" or "sell"
         std::string type; // "market", "limit", "stop", etc.
         std::string status; // "pending", "open", "filled", "cancelled", "rejected"
-        double originalQuantity;
-        double filledQuantity;
-        double remainingQuantity;
-        double price;
-        double averageFillPrice;
+        DecimalScale scale; // Instrument price/quantity precision
+        Decimal originalQuantity;
+        Decimal filledQuantity;
+        Decimal remainingQuantity;
+        Decimal price;
+        double averageFillPrice; // Derived ratio, may exceed the price precision
         std::chrono::system_clock::time_point createTime;
         std::chrono::system_clock::time_point updateTime;
         std::chrono::system_clock::time_point lastFillTime;
         std::vector<std::string> fills; // Fill IDs
         std::string rejectReason;
         
-        OrderState() : originalQuantity(0.0), filledQuantity(0.0), remainingQuantity(0.0), 
-                      price(0.0), averageFillPrice(0.0) {}
-    };
-
-    struct WalletBalance
-    {
-        std::string currency;
-        double available;
-        double locked;
-        double total;
-        std::chrono::system_clock::time_point updateTime;
-        
-        WalletBalance() : available(0.0), locked(0.0), total(0.0) {}
-    };
-
-    struct WalletState
-    {
-        std::string account;
-        std::string exchange;
-        std::unordered_map<std::string, WalletBalance> balances;
-        double totalValueUSD;
-        std::chrono::system_clock::time_point updateTime;
-        
-        WalletState() : totalValueUSD(0.0) {}
-    };
-
-    struct InstrumentData
-    {
-        std::string symbol;
-        std::string exchange;
-        std::string baseAsset;
-        std::string quoteAsset;
-        double minOrderSize;
-        double maxOrderSize;
-        double tickSize;
-        double lotSize;
-        int pricePrecision;
-        int quantityPrecision;
-        bool tradingEnabled;
-        std::string tradingStatus; // "TRADING", "HALT", "BREAK", etc.
-        std::chrono::system_clock::time_point updateTime;
-        
-        InstrumentData() : minOrderSize(0.0), maxOrderSize(0.0), tickSize(0.0), lotSize(0.0),
-                          pricePrecision(0), quantityPrecision(0), tradingEnabled(false) {}
+        OrderState() : averageFillPrice(0.0) {}
     };
 
     // Base class for state updaters
@@ -111,6 +80,12 @@ namespace gui::editor
         void UpdateStatistics(float updateTime, bool success);
         void AddError(const std::string& error);
         
+        // Applies an order report in OrderState form (WebSocket push or REST poll): finds or
+        // adds the order, raises its filled quantity to the reported cumulative one whatever
+        // the status beside it says, then moves the status through the lifecycle table
+        // (OrderLifecycle.h). Returns the table's decision.
+        TransitionAction ApplyOrderState(OrderStore& orders, const OrderState& report, int64_t timeNs);
+        
         std::string m_connectionType; // "REST", "WebSocket", "FIX"
         std::string m_dataType;       // "Order", "Wallet", "Instrument"
         
@@ -142,6 +117,11 @@ namespace gui::editor
         RestOrderStateUpdater(ax::NodeEditor::NodeId nodeId);
         virtual ~RestOrderStateUpdater() = default;
 
+        void Update(float deltaTime) override; // Queues a poll on "Poll Requests" when m_poll says one is due
+
+        // Answer to a request from RequestOrderUpdate(); detail answers carry the order id
+        void ProcessRestResponse(const RestResponse& response);
+
     protected:
         void ProcessStateUpdate(const std::string& message) override;
         void ValidateStateData() override;
@@ -150,21 +130,32 @@ namespace gui::editor
 
     private:
         void ProcessRestOrderUpdate(const std::string& jsonResponse);
+        void ApplyOrderDeltas();
+        void ApplyOrderDetail(const std::string& json);
         void RequestOrderUpdate(const std::string& orderId = "");
         void ParseOrderFromJson(const std::string& json, OrderState& order);
+        void SelectExchange();  // Call after editing m_exchange
+        void ApplyPollConfig(); // Call after editing the polling fields; forgets the previous response
         
-        std::unordered_map<std::string, OrderState> m_orders;
+        OrderStore& m_orders; // Shared by all order state updaters (GetOrderStore())
         
         // REST-specific configuration
+        char m_exchange[64];            // Venue name the polled orders belong to
+        uint16_t m_exchangeId;          // TradeStringTable name id of m_exchange
         char m_ordersEndpoint[256];     // e.g., "/api/v3/openOrders"
-        char m_orderDetailEndpoint[256]; // e.g., "/api/v3/order"
+        char m_orderDetailEndpoint[256]; // e.g., "/api/v3/order?orderId={orderId}"; without {orderId} it is appended
         bool m_fetchAllOrders;          // Fetch all orders or specific ones
         bool m_includeOrderHistory;     // Include filled/cancelled orders
         
         // Polling configuration
         bool m_enablePolling;
-        int m_pollingInterval; // seconds
-        float m_lastPollTime;
+        int m_pollingInterval; // seconds; slowest poll, m_poll speeds up while orders change
+        float m_lastPollTime;  // Seconds since the last poll request
+        char m_ordersArrayPath[64];           // Empty when the response is the array itself
+        char m_orderIdField[32];              // e.g. "orderId"
+        RestPollReconciler m_poll;            // Per-order hashes of the last response
+        std::vector<RestEntityDelta> m_deltas; // Reused
+        std::shared_ptr<RestRequestData> m_requests; // Drained by the connected RestConnectionNode
         
         // UI state
         bool m_ordersExpanded;
@@ -188,7 +179,7 @@ namespace gui::editor
         void SubscribeToOrderUpdates();
         void ParseOrderFromJson(const std::string& json, OrderState& order);
         
-        std::unordered_map<std::string, OrderState> m_orders;
+        OrderStore& m_orders; // Shared by all order state updaters (GetOrderStore())
         
         // WebSocket-specific configuration
         char m_orderUpdateChannel[128]; // e.g., "executionReport" or "orders"
@@ -220,9 +211,9 @@ namespace gui::editor
     private:
         void ProcessFixOrderUpdate(const std::string& fixMessage);
         void ParseOrderFromFix(const std::string& fixMsg, OrderState& order);
-        std::string GetFixField(const std::string& message, int tag);
+        std::string_view GetFixField(std::string_view message, int tag); // View into message
         
-        std::unordered_map<std::string, OrderState> m_orders;
+        OrderStore& m_orders; // Shared by all order state updaters (GetOrderStore())
         
         // FIX-specific configuration
         std::string m_expectedMsgType; // "8" for ExecutionReport
@@ -230,26 +221,24 @@ namespace gui::editor
         bool m_processOrderCancelRejects;
         bool m_processOrderReplaceRejects;
         
-        // FIX tag configuration
-        struct FixOrderTags
-        {
-            int orderIdTag;         // 37
-            int clientOrderIdTag;   // 11
-            int orderStatusTag;     // 39
-            int sideTag;            // 54
-            int orderTypeTag;       // 40
-            int orderQtyTag;        // 38
-            int priceTag;           // 44
-            int lastQtyTag;         // 32
-            int lastPxTag;          // 31
-            int avgPxTag;           // 6
-            int cumQtyTag;          // 14
-            int leavesQtyTag;       // 151
-            
-            FixOrderTags() : orderIdTag(37), clientOrderIdTag(11), orderStatusTag(39),
-                           sideTag(54), orderTypeTag(40), orderQtyTag(38), priceTag(44),
-                           lastQtyTag(32), lastPxTag(31), avgPxTag(6), cumQtyTag(14), leavesQtyTag(151) {}
-        } m_fixTags;
+        // FIX tag configuration; m_reportDecoder is rebuilt whenever it changes
+        FixOrderTags m_fixTags;
+        FixExecutionReportDecoder m_reportDecoder;
+        FixExecutionReport m_report;   // Reused; views point into the message being applied
+        DecimalScale m_wireScale;      // Scale numbers are decoded at before rescaling to the order
+        char m_exchange[64];           // Venue of this session, e.g. "Binance"
+        uint16_t m_exchangeId;         // m_exchange's TradeStringTable name id
+        void SelectExchange();         // Call after editing m_exchange
+        
+        TransitionAction ApplyExecutionReport(const FixExecutionReport& report);
+        void RetryDeferredReports();
+        
+        // Reports that arrived ahead of the event they depend on (see OrderLifecycle.h)
+        static constexpr size_t MAX_DEFERRED_REPORTS = 256;
+        std::vector<std::string> m_deferredReports;
+        uint64_t m_ignoredReports;      // Stale or duplicate
+        uint64_t m_rejectedTransitions; // Contradicted the order's state
+        uint64_t m_fillsWithoutExecId;  // Not applied as fills; counted through CumQty instead
         
         // UI state
         bool m_ordersExpanded;
@@ -263,6 +252,10 @@ namespace gui::editor
         RestWalletStateUpdater(ax::NodeEditor::NodeId nodeId);
         virtual ~RestWalletStateUpdater() = default;
 
+        void Update(float deltaTime) override; // Queues a poll on "Poll Requests" when m_poll says one is due
+
+        void ProcessRestResponse(const RestResponse& response); // Answer to RequestWalletUpdate()
+
     protected:
         void ProcessStateUpdate(const std::string& message) override;
         void ValidateStateData() override;
@@ -271,10 +264,13 @@ namespace gui::editor
 
     private:
         void ProcessRestWalletUpdate(const std::string& jsonResponse);
+        void ApplyBalanceDeltas();
         void RequestWalletUpdate();
         void ParseWalletFromJson(const std::string& json);
+        void ApplyPollConfig(); // Call after editing the polling fields; forgets the previous response
         
         WalletState m_walletState;
+        WalletValuation& m_valuation; // Shared across accounts (GetWalletValuation())
         
         // REST-specific configuration
         char m_balancesEndpoint[256];   // e.g., "/api/v3/account"
@@ -283,8 +279,15 @@ namespace gui::editor
         
         // Polling configuration
         bool m_enablePolling;
-        int m_pollingInterval;
-        float m_lastPollTime;
+        int m_pollingInterval; // seconds; slowest poll, m_poll speeds up while balances change
+        float m_lastPollTime;  // Seconds since the last poll request
+        char m_balancesArrayPath[64];         // e.g. "balances"
+        char m_currencyField[32];             // e.g. "asset"
+        RestPollReconciler m_poll;            // Per-currency hashes of the last response
+        std::vector<RestEntityDelta> m_deltas; // Reused
+        std::shared_ptr<RestRequestData> m_requests; // Drained by the connected RestConnectionNode
+        char m_availableField[32];            // e.g. "free"
+        char m_lockedField[32];               // e.g. "locked"
         
         // UI state
         bool m_balancesExpanded;
@@ -309,6 +312,7 @@ namespace gui::editor
         void ParseWalletFromJson(const std::string& json);
         
         WalletState m_walletState;
+        WalletValuation& m_valuation; // Shared across accounts (GetWalletValuation())
         
         // WebSocket-specific configuration
         char m_balanceUpdateChannel[128]; // e.g., "balanceUpdate" or "account"
@@ -336,6 +340,7 @@ namespace gui::editor
         void ParseWalletFromFix(const std::string& fixMsg);
         
         WalletState m_walletState;
+        WalletValuation& m_valuation; // Shared across accounts (GetWalletValuation())
         
         // FIX-specific configuration
         std::string m_expectedMsgType; // "j" for BusinessMessageReject or custom message
@@ -351,6 +356,10 @@ namespace gui::editor
         RestInstrumentDataUpdater(ax::NodeEditor::NodeId nodeId);
         virtual ~RestInstrumentDataUpdater() = default;
 
+        void Update(float deltaTime) override; // Queues a poll on "Poll Requests" when m_poll says one is due
+
+        void ProcessRestResponse(const RestResponse& response); // Answer to RequestInstrumentUpdate()
+
     protected:
         void ProcessStateUpdate(const std::string& message) override;
         void ValidateStateData() override;
@@ -359,8 +368,10 @@ namespace gui::editor
 
     private:
         void ProcessRestInstrumentUpdate(const std::string& jsonResponse);
+        void ApplyInstrumentDeltas();
         void RequestInstrumentUpdate();
         void ParseInstrumentFromJson(const std::string& json, InstrumentData& instrument);
+        void ApplyPollConfig(); // Call after editing the polling fields; forgets the previous response
         
         std::unordered_map<std::string, InstrumentData> m_instruments;
         
@@ -371,8 +382,20 @@ namespace gui::editor
         
         // Polling configuration
         bool m_enablePolling;
-        int m_pollingInterval;
-        float m_lastPollTime;
+        int m_pollingInterval; // seconds; slowest poll, m_poll speeds up while instruments change
+        float m_lastPollTime;  // Seconds since the last poll request
+        char m_symbolsArrayPath[64];          // e.g. "symbols"
+        char m_symbolField[32];               // e.g. "symbol"
+        RestPollReconciler m_poll;            // Per-symbol hashes of the last response
+        std::vector<RestEntityDelta> m_deltas; // Reused
+        std::shared_ptr<RestRequestData> m_requests; // Drained by the connected RestConnectionNode
+        
+        // Previous run's instruments, used until the first live response replaces them
+        InstrumentCache m_cache;
+        char m_cacheExchange[64] = {};  // Cache file key and venue of the instruments, e.g. "Binance"
+        bool m_cacheReconciled = false; // The first live response has delisted stale cached symbols
+        void SelectExchange();          // Call after editing m_cacheExchange; loads its cache
+        void LoadCachedInstruments();
         
         // UI state
         bool m_instrumentsExpanded;
@@ -414,6 +437,8 @@ namespace gui::editor
         FIXInstrumentDataUpdater(ax::NodeEditor::NodeId nodeId);
         virtual ~FIXInstrumentDataUpdater() = default;
 
+        void Update(float deltaTime) override; // Saves the cache once definitions stop changing it
+
     protected:
         void ProcessStateUpdate(const std::string& message) override;
         void ValidateStateData() override;
@@ -431,6 +456,14 @@ namespace gui::editor
         std::string m_expectedMsgType; // "d" for SecurityDefinition
         bool m_requestSecurityDefinitions;
         
+        // Previous run's instruments, used until the security definitions arrive
+        InstrumentCache m_cache;
+        char m_cacheExchange[64] = {};  // Cache file key and venue of the instruments, e.g. "Binance"
+        bool m_cacheDirty = false;      // Definitions arrived since the last save
+        float m_sinceCacheSave = 0.0f;  // Seconds
+        void SelectExchange();          // Call after editing m_cacheExchange; loads its cache
+        void LoadCachedInstruments();
+        
         // UI state
         bool m_instrumentsExpanded;
     };
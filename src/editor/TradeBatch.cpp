@@ -0,0 +1,178 @@
+#include "TradeBatch.h"
+
+namespace gui
+{
+    namespace editor
+    {
+        void TradeColumns::Clear()
+        {
+            price.clear();
+            quantity.clear();
+            timestampNs.clear();
+            symbolId.clear();
+            side.clear();
+            priceScale.clear();
+            quantityScale.clear();
+            tradeId.clear();
+            fee.clear();
+            orderRefsId.clear();
+            receiveDelayUs.clear();
+            exchangeId.clear();
+            sourceId.clear();
+            feeCurrencyId.clear();
+            flags.clear();
+        }
+
+        void TradeColumns::Reserve(size_t count)
+        {
+            price.reserve(count);
+            quantity.reserve(count);
+            timestampNs.reserve(count);
+            symbolId.reserve(count);
+            side.reserve(count);
+            priceScale.reserve(count);
+            quantityScale.reserve(count);
+            tradeId.reserve(count);
+            fee.reserve(count);
+            orderRefsId.reserve(count);
+            receiveDelayUs.reserve(count);
+            exchangeId.reserve(count);
+            sourceId.reserve(count);
+            feeCurrencyId.reserve(count);
+            flags.reserve(count);
+        }
+
+        void TradeColumns::Append(const TradeRecord& trade)
+        {
+            price.push_back(trade.price);
+            quantity.push_back(trade.quantity);
+            timestampNs.push_back(trade.timestampNs);
+            symbolId.push_back(trade.symbolId);
+            side.push_back(trade.side);
+            priceScale.push_back(trade.priceScale);
+            quantityScale.push_back(trade.quantityScale);
+            tradeId.push_back(trade.tradeId);
+            fee.push_back(trade.fee);
+            orderRefsId.push_back(trade.orderRefsId);
+            receiveDelayUs.push_back(trade.receiveDelayUs);
+            exchangeId.push_back(trade.exchangeId);
+            sourceId.push_back(trade.sourceId);
+            feeCurrencyId.push_back(trade.feeCurrencyId);
+            flags.push_back(trade.flags);
+        }
+
+        void TradeColumns::AppendRows(const std::vector<TradeRecord>& trades)
+        {
+            Reserve(Size() + trades.size());
+            for (const TradeRecord& trade : trades)
+                Append(trade);
+        }
+
+        void TradeColumns::GetRow(size_t index, TradeRecord& out) const
+        {
+            out = TradeRecord{};
+            out.price = price[index];
+            out.quantity = quantity[index];
+            out.timestampNs = timestampNs[index];
+            out.symbolId = symbolId[index];
+            out.side = side[index];
+            out.priceScale = priceScale[index];
+            out.quantityScale = quantityScale[index];
+            out.tradeId = tradeId[index];
+            out.fee = fee[index];
+            out.orderRefsId = orderRefsId[index];
+            out.receiveDelayUs = receiveDelayUs[index];
+            out.exchangeId = exchangeId[index];
+            out.sourceId = sourceId[index];
+            out.feeCurrencyId = feeCurrencyId[index];
+            out.flags = flags[index];
+        }
+
+        namespace TradeColumnKernels
+        {
+            namespace
+            {
+                // Reciprocal powers of ten so the hot loops multiply instead of divide
+                constexpr double INV_POW10[] = {
+                    1.0, 1e-1, 1e-2, 1e-3, 1e-4, 1e-5, 1e-6, 1e-7, 1e-8, 1e-9,
+                    1e-10, 1e-11, 1e-12, 1e-13, 1e-14, 1e-15, 1e-16, 1e-17, 1e-18
+                };
+
+                template<typename Predicate>
+                TradeColumnStats Accumulate(const TradeColumns& batch, Predicate include)
+                {
+                    TradeColumnStats stats;
+                    const size_t count = batch.Size();
+                    if (count == 0)
+                        return stats;
+
+                    const Decimal* prices = batch.price.data();
+                    const Decimal* quantities = batch.quantity.data();
+                    const uint8_t* priceScales = batch.priceScale.data();
+                    const uint8_t* quantityScales = batch.quantityScale.data();
+                    const TradeSide* sides = batch.side.data();
+
+                    double volume = 0.0;
+                    double notional = 0.0;
+                    size_t included = 0;
+                    size_t buys = 0;
+
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        const double mask = include(i) ? 1.0 : 0.0;
+                        const double qty = static_cast<double>(quantities[i].units) * INV_POW10[quantityScales[i]];
+                        const double px = static_cast<double>(prices[i].units) * INV_POW10[priceScales[i]];
+                        volume += mask * qty;
+                        notional += mask * qty * px;
+                        included += static_cast<size_t>(mask);
+                        buys += static_cast<size_t>(mask) & static_cast<size_t>(sides[i] == TradeSide::Buy);
+                    }
+
+                    stats.count = included;
+                    stats.buyCount = buys;
+                    stats.totalVolume = volume;
+                    stats.totalNotional = notional;
+                    stats.firstTimestampNs = batch.timestampNs.front();
+                    stats.lastTimestampNs = batch.timestampNs.back();
+                    return stats;
+                }
+            }
+
+            TradeColumnStats ComputeStats(const TradeColumns& batch)
+            {
+                return Accumulate(batch, [](size_t) { return true; });
+            }
+
+            TradeColumnStats ComputeStats(const TradeColumns& batch, uint32_t symbolId)
+            {
+                const uint32_t* symbols = batch.symbolId.data();
+                return Accumulate(batch, [symbols, symbolId](size_t i) { return symbols[i] == symbolId; });
+            }
+
+            size_t SelectByPrice(const TradeColumns& batch, uint32_t symbolId, Decimal minPrice, Decimal maxPrice,
+                                 std::vector<uint32_t>& selection)
+            {
+                const size_t count = batch.Size();
+                selection.resize(count); // Capacity is reused between batches
+
+                const Decimal* prices = batch.price.data();
+                const uint32_t* symbols = batch.symbolId.data();
+                uint32_t* out = selection.data();
+                size_t selected = 0;
+
+                // Branch-free compaction: always write, advance only on a match
+                for (size_t i = 0; i < count; i++)
+                {
+                    out[selected] = static_cast<uint32_t>(i);
+                    const bool match = (symbols[i] == symbolId) &
+                                       (prices[i].units >= minPrice.units) &
+                                       (prices[i].units <= maxPrice.units);
+                    selected += match ? 1 : 0;
+                }
+
+                selection.resize(selected);
+                return selected;
+            }
+        }
+    } // editor
+} // gui
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Decimal.h"
+#include "NodeData.h"
+#include "TradeRecord.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace gui::editor
+{
+    // Row vs column form of trades carried on MessageStream pins
+    enum class TradeBatchLayout
+    {
+        Rows,    // std::vector<TradeRecord>
+        Columns  // TradeColumns
+    };
+
+    // Structure-of-arrays trade batch. Every TradeRecord field has its own contiguous
+    // array, so aggregations and filters stream through exactly the bytes they use,
+    // while consumers that validate trades (dedup, sequencing) can rebuild the rows.
+    struct TradeColumns
+    {
+        std::vector<Decimal> price;
+        std::vector<Decimal> quantity;
+        std::vector<int64_t> timestampNs;
+        std::vector<uint32_t> symbolId;
+        std::vector<TradeSide> side;
+        std::vector<uint8_t> priceScale;
+        std::vector<uint8_t> quantityScale;
+
+        // Identity and bookkeeping; not touched by the kernels
+        std::vector<uint64_t> tradeId;
+        std::vector<double> fee;
+        std::vector<uint32_t> orderRefsId;
+        std::vector<int32_t> receiveDelayUs;
+        std::vector<uint16_t> exchangeId;
+        std::vector<uint16_t> sourceId;
+        std::vector<uint16_t> feeCurrencyId;
+        std::vector<uint8_t> flags;
+
+        size_t Size() const { return price.size(); }
+        bool Empty() const { return price.empty(); }
+
+        void Clear();            // Keeps capacity
+        void Reserve(size_t count);
+        void Append(const TradeRecord& trade);
+        void AppendRows(const std::vector<TradeRecord>& trades);
+        void GetRow(size_t index, TradeRecord& out) const; // Exact inverse of Append
+    };
+
+    // Results of one pass over a column batch
+    struct TradeColumnStats
+    {
+        size_t count;
+        size_t buyCount;
+        double totalVolume;
+        double totalNotional;
+        int64_t firstTimestampNs; // Span of the whole batch
+        int64_t lastTimestampNs;
+
+        TradeColumnStats()
+            : count(0), buyCount(0), totalVolume(0.0), totalNotional(0.0)
+            , firstTimestampNs(0), lastTimestampNs(0) {}
+
+        double GetVwap() const { return totalVolume > 0.0 ? totalNotional / totalVolume : 0.0; }
+    };
+
+    namespace TradeColumnKernels
+    {
+        TradeColumnStats ComputeStats(const TradeColumns& batch);
+
+        // Stats restricted to one symbol
+        TradeColumnStats ComputeStats(const TradeColumns& batch, uint32_t symbolId);
+
+        // Writes the indices of trades for symbolId with minPrice <= price <= maxPrice
+        // into selection (cleared first, capacity kept). Prices compare exactly in
+        // units, so all trades of one symbol must share a price scale.
+        size_t SelectByPrice(const TradeColumns& batch, uint32_t symbolId, Decimal minPrice, Decimal maxPrice,
+                             std::vector<uint32_t>& selection);
+    }
+
+    // Pin payloads. Producers pick one layout; consumers accept both.
+    class TradeRowBatchData : public NodeData
+    {
+    public:
+        std::vector<TradeRecord> trades;
+
+        std::unique_ptr<NodeData> Clone() const override { return std::make_unique<TradeRowBatchData>(*this); }
+        std::type_index GetTypeIndex() const override { return std::type_index(typeid(TradeRowBatchData)); }
+    };
+
+    class TradeColumnBatchData : public NodeData
+    {
+    public:
+        TradeColumns columns;
+
+        std::unique_ptr<NodeData> Clone() const override { return std::make_unique<TradeColumnBatchData>(*this); }
+        std::type_index GetTypeIndex() const override { return std::type_index(typeid(TradeColumnBatchData)); }
+    };
+
+    inline bool IsTradeBatchData(const NodeData* data)
+    {
+        return data && (data->As<TradeRowBatchData>() || data->As<TradeColumnBatchData>());
+    }
+}
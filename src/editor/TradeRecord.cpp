@@ -0,0 +1,323 @@
+#include "TradeRecord.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace gui
+{
+    namespace editor
+    {
+        namespace
+        {
+            constexpr int64_t ToNanoseconds(std::chrono::system_clock::time_point time)
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+            }
+
+            std::chrono::system_clock::time_point FromNanoseconds(int64_t ns)
+            {
+                return std::chrono::system_clock::time_point(
+                    std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(ns)));
+            }
+
+            uint64_t HashText(std::string_view text)
+            {
+                uint64_t hash = 14695981039346656037ull; // FNV-1a
+                for (char c : text)
+                {
+                    hash ^= static_cast<uint8_t>(c);
+                    hash *= 1099511628211ull;
+                }
+                return hash;
+            }
+        }
+
+        std::chrono::system_clock::time_point TradeRecord::GetTimestamp() const
+        {
+            return FromNanoseconds(timestampNs);
+        }
+
+        std::chrono::system_clock::time_point TradeRecord::GetReceivedTime() const
+        {
+            return FromNanoseconds(timestampNs + static_cast<int64_t>(receiveDelayUs) * 1000);
+        }
+
+        TradeStringTable::TradeStringTable()
+            : m_orderRefs(ORDER_REF_CAPACITY)
+            , m_lastOrderRefsId(0)
+        {
+            for (OrderRefsEntry& entry : m_orderRefs)
+                entry.refsId = 0;
+        }
+
+        uint32_t TradeStringTable::InternLocked(Pool& pool, std::string_view text)
+        {
+            auto it = pool.index.find(text);
+            if (it != pool.index.end())
+                return it->second;
+
+            const auto id = static_cast<uint32_t>(pool.strings.size());
+            const std::string& stored = pool.strings.emplace_back(text);
+            pool.index.emplace(std::string_view(stored), id);
+            return id;
+        }
+
+        uint32_t TradeStringTable::Intern(std::string_view text)
+        {
+            if (text.empty())
+                return 0;
+
+            {
+                std::shared_lock lock(m_mutex);
+                auto it = m_symbols.index.find(text);
+                if (it != m_symbols.index.end())
+                    return it->second;
+            }
+
+            std::unique_lock lock(m_mutex);
+            return InternLocked(m_symbols, text);
+        }
+
+        uint32_t TradeStringTable::Find(std::string_view text) const
+        {
+            std::shared_lock lock(m_mutex);
+            auto it = m_symbols.index.find(text);
+            return it != m_symbols.index.end() ? it->second : 0;
+        }
+
+        const std::string& TradeStringTable::Lookup(uint32_t id) const
+        {
+            std::shared_lock lock(m_mutex);
+            return id < m_symbols.strings.size() ? m_symbols.strings[id] : m_symbols.strings[0];
+        }
+
+        bool TradeStringTable::InternName(std::string_view text, uint16_t& id)
+        {
+            id = 0;
+            if (text.empty())
+                return true;
+
+            {
+                std::shared_lock lock(m_mutex);
+                auto it = m_names.index.find(text);
+                if (it != m_names.index.end())
+                {
+                    id = static_cast<uint16_t>(it->second);
+                    return true;
+                }
+            }
+
+            std::unique_lock lock(m_mutex);
+            auto it = m_names.index.find(text);
+            if (it == m_names.index.end() && m_names.strings.size() > UINT16_MAX)
+                return false; // Full: a wrapped id would name some other exchange or account
+            id = static_cast<uint16_t>(InternLocked(m_names, text));
+            return true;
+        }
+
+        uint16_t TradeStringTable::FindName(std::string_view text) const
+        {
+            std::shared_lock lock(m_mutex);
+            auto it = m_names.index.find(text);
+            return it != m_names.index.end() ? static_cast<uint16_t>(it->second) : 0;
+        }
+
+        const std::string& TradeStringTable::LookupName(uint16_t id) const
+        {
+            std::shared_lock lock(m_mutex);
+            return id < m_names.strings.size() ? m_names.strings[id] : m_names.strings[0];
+        }
+
+        uint32_t TradeStringTable::InternOrderRefs(std::string_view orderId, std::string_view buyOrderId,
+                                                   std::string_view sellOrderId)
+        {
+            if (orderId.empty() && buyOrderId.empty() && sellOrderId.empty())
+                return 0;
+
+            std::lock_guard<std::mutex> lock(m_orderRefsMutex);
+
+            // Partial fills of the same order repeat the same refs; reuse the last entry
+            if (m_lastOrderRefsId != 0)
+            {
+                const OrderRefsEntry& last = m_orderRefs[m_lastOrderRefsId % ORDER_REF_CAPACITY];
+                if (last.refsId == m_lastOrderRefsId && last.refs.orderId == orderId &&
+                    last.refs.buyOrderId == buyOrderId && last.refs.sellOrderId == sellOrderId)
+                    return m_lastOrderRefsId;
+            }
+
+            if (++m_lastOrderRefsId == 0)
+                m_lastOrderRefsId = 1;
+            // Assigning into the evicted entry reuses its string capacity
+            OrderRefsEntry& entry = m_orderRefs[m_lastOrderRefsId % ORDER_REF_CAPACITY];
+            entry.refsId = m_lastOrderRefsId;
+            entry.refs.orderId.assign(orderId);
+            entry.refs.buyOrderId.assign(buyOrderId);
+            entry.refs.sellOrderId.assign(sellOrderId);
+            return m_lastOrderRefsId;
+        }
+
+        bool TradeStringTable::GetOrderRefs(uint32_t refsId, OrderRefs& out) const
+        {
+            if (refsId == 0)
+                return false;
+
+            std::lock_guard<std::mutex> lock(m_orderRefsMutex);
+            const OrderRefsEntry& entry = m_orderRefs[refsId % ORDER_REF_CAPACITY];
+            if (entry.refsId != refsId)
+                return false;
+            out = entry.refs;
+            return true;
+        }
+
+        size_t TradeStringTable::GetSize() const
+        {
+            std::shared_lock lock(m_mutex);
+            return m_symbols.strings.size() + m_names.strings.size();
+        }
+
+        TradeStringTable& GetTradeStringTable()
+        {
+            static TradeStringTable table;
+            return table;
+        }
+
+        void EncodeTradeId(std::string_view text, TradeRecord& trade)
+        {
+            trade.flags &= ~(TradeFlags::InlineTradeId | TradeFlags::HashedTradeId);
+
+            // Plain numeric ids (most venues) are stored as-is
+            if (!text.empty() && text.size() <= 19 && (text.size() == 1 || text[0] != '0'))
+            {
+                uint64_t value = 0;
+                bool numeric = true;
+                for (char c : text)
+                {
+                    if (c < '0' || c > '9')
+                    {
+                        numeric = false;
+                        break;
+                    }
+                    value = value * 10 + static_cast<uint64_t>(c - '0');
+                }
+                if (numeric)
+                {
+                    trade.tradeId = value;
+                    return;
+                }
+            }
+
+            if (text.size() <= sizeof(trade.tradeId))
+            {
+                trade.tradeId = 0;
+                std::memcpy(&trade.tradeId, text.data(), text.size());
+                trade.flags |= TradeFlags::InlineTradeId;
+                return;
+            }
+
+            // Long ids (UUIDs etc.) are only needed for deduplication
+            trade.tradeId = HashText(text);
+            trade.flags |= TradeFlags::HashedTradeId;
+        }
+
+        std::string DecodeTradeId(const TradeRecord& trade)
+        {
+            if (trade.flags & TradeFlags::InlineTradeId)
+            {
+                char text[sizeof(trade.tradeId)];
+                std::memcpy(text, &trade.tradeId, sizeof(text));
+                return std::string(text, strnlen(text, sizeof(text)));
+            }
+
+            if (trade.flags & TradeFlags::HashedTradeId)
+            {
+                static constexpr char HEX[] = "0123456789abcdef";
+                std::string text(17, '#');
+                for (int i = 0; i < 16; i++)
+                    text[16 - i] = HEX[(trade.tradeId >> (i * 4)) & 0xF];
+                return text;
+            }
+
+            return std::to_string(trade.tradeId);
+        }
+
+        TradeSide ParseTradeSide(std::string_view side)
+        {
+            if (side.empty())
+                return TradeSide::Unknown;
+
+            switch (side[0])
+            {
+                case 'b': case 'B': case '1': return TradeSide::Buy;
+                case 's': case 'S': case '2': return TradeSide::Sell;
+                default: return TradeSide::Unknown;
+            }
+        }
+
+        const char* TradeSideToString(TradeSide side)
+        {
+            switch (side)
+            {
+                case TradeSide::Buy: return "buy";
+                case TradeSide::Sell: return "sell";
+                default: return "";
+            }
+        }
+
+        bool MakeTradeRecord(const NormalizedTrade& trade, TradeStringTable& strings, DecimalScale scale, TradeRecord& out)
+        {
+            TradeRecord record{};
+            EncodeTradeId(trade.tradeId, record);
+            record.timestampNs = ToNanoseconds(trade.timestamp);
+
+            const int64_t delayUs = (ToNanoseconds(trade.receivedTime) - record.timestampNs) / 1000;
+            record.receiveDelayUs = static_cast<int32_t>(std::clamp<int64_t>(delayUs, INT32_MIN, INT32_MAX));
+
+            record.priceScale = scale.price;
+            record.quantityScale = scale.quantity;
+            if (!Decimal::FromDouble(trade.price, scale.price, record.price) ||
+                !Decimal::FromDouble(trade.quantity, scale.quantity, record.quantity))
+                return false;
+            record.fee = trade.fee;
+            record.symbolId = strings.Intern(trade.currencyPair);
+            record.orderRefsId = strings.InternOrderRefs(trade.orderId, trade.buyOrderId, trade.sellOrderId);
+            if (!strings.InternName(trade.exchange, record.exchangeId) ||
+                !strings.InternName(trade.source, record.sourceId) ||
+                !strings.InternName(trade.feeCurrency, record.feeCurrencyId))
+                return false;
+            record.side = ParseTradeSide(trade.side);
+            if (trade.isMaker)
+                record.flags |= TradeFlags::IsMaker;
+            if (trade.fee != 0.0 || !trade.feeCurrency.empty())
+                record.flags |= TradeFlags::HasFee;
+            out = record;
+            return true;
+        }
+
+        NormalizedTrade ToNormalizedTrade(const TradeRecord& trade, const TradeStringTable& strings)
+        {
+            NormalizedTrade result;
+            result.tradeId = DecodeTradeId(trade);
+            result.currencyPair = strings.Lookup(trade.symbolId);
+            result.exchange = strings.LookupName(trade.exchangeId);
+            result.price = trade.GetPrice();
+            result.quantity = trade.GetQuantity();
+            result.side = TradeSideToString(trade.side);
+            result.timestamp = trade.GetTimestamp();
+            result.receivedTime = trade.GetReceivedTime();
+            result.source = strings.LookupName(trade.sourceId);
+
+            TradeStringTable::OrderRefs refs;
+            if (strings.GetOrderRefs(trade.orderRefsId, refs))
+            {
+                result.orderId = std::move(refs.orderId);
+                result.buyOrderId = std::move(refs.buyOrderId);
+                result.sellOrderId = std::move(refs.sellOrderId);
+            }
+
+            result.fee = trade.fee;
+            result.feeCurrency = strings.LookupName(trade.feeCurrencyId);
+            result.isMaker = trade.IsMaker();
+            return result;
+        }
+    } // editor
+} // gui
@@ -0,0 +1,201 @@
+#pragma once
+
+#include "Decimal.h"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace gui::editor
+{
+    // Display form of a trade; the pipeline itself carries TradeRecord
+    struct NormalizedTrade
+    {
+        std::string tradeId;
+        std::string currencyPair;
+        std::string exchange;
+        double price;
+        double quantity;
+        std::string side; // "buy" or "sell"
+        std::chrono::system_clock::time_point timestamp;
+        std::chrono::system_clock::time_point receivedTime;
+        std::string originalMessageId;
+        std::string source; // Connection source identifier
+        
+        // Optional fields
+        std::string orderId;
+        std::string buyOrderId;
+        std::string sellOrderId;
+        double fee;
+        std::string feeCurrency;
+        bool isMaker;
+        
+        NormalizedTrade() : price(0.0), quantity(0.0), fee(0.0), isMaker(false) {}
+    };
+
+    enum class TradeSide : uint8_t
+    {
+        Unknown,
+        Buy,
+        Sell
+    };
+
+    namespace TradeFlags
+    {
+        constexpr uint8_t IsMaker       = 1 << 0;
+        constexpr uint8_t HasFee        = 1 << 1;
+        constexpr uint8_t InlineTradeId = 1 << 2; // tradeId holds up to 8 raw characters
+        constexpr uint8_t HashedTradeId = 1 << 3; // tradeId holds a hash of a longer text id
+    }
+
+    // Compact trade record used on the hot path. Strings are replaced by interned IDs
+    // (see TradeStringTable); the readable form is only rebuilt for display.
+    struct TradeRecord
+    {
+        uint64_t tradeId;       // Numeric id, inline text or hash (see TradeFlags)
+        int64_t timestampNs;    // Exchange timestamp, ns since epoch
+        Decimal price;          // At priceScale
+        Decimal quantity;       // At quantityScale
+        double fee;
+        uint32_t symbolId;      // Interned currency pair
+        uint32_t orderRefsId;   // TradeStringTable order refs ring id (0 = none)
+        int32_t receiveDelayUs; // Local receive time minus exchange timestamp
+        uint16_t exchangeId;
+        uint16_t sourceId;      // Interned connection source
+        uint16_t feeCurrencyId;
+        TradeSide side;
+        uint8_t flags;
+        uint8_t priceScale;     // InstrumentData::pricePrecision
+        uint8_t quantityScale;  // InstrumentData::quantityPrecision
+
+        bool IsMaker() const { return (flags & TradeFlags::IsMaker) != 0; }
+        bool HasFee() const { return (flags & TradeFlags::HasFee) != 0; }
+        double GetPrice() const { return price.ToDouble(priceScale); }
+        double GetQuantity() const { return quantity.ToDouble(quantityScale); }
+
+        std::chrono::system_clock::time_point GetTimestamp() const;
+        std::chrono::system_clock::time_point GetReceivedTime() const;
+    };
+
+    static_assert(sizeof(TradeRecord) <= 64, "TradeRecord must fit in a cache line");
+    static_assert(std::is_trivially_copyable_v<TradeRecord>, "TradeRecord must stay POD");
+
+    // Key used for duplicate detection across exchanges. A numeric id, up to 8 raw
+    // characters and a hash can all produce the same 64 bits, so the id's kind is part
+    // of the key rather than folded into the id.
+    struct TradeDedupId
+    {
+        uint64_t tradeId;
+        uint16_t exchangeId;
+        uint8_t idKind; // flags & (InlineTradeId | HashedTradeId)
+
+        bool operator==(const TradeDedupId& other) const = default;
+    };
+
+    struct TradeDedupIdHash
+    {
+        size_t operator()(const TradeDedupId& id) const
+        {
+            uint64_t h = id.tradeId ^ ((static_cast<uint64_t>(id.exchangeId) << 8) | id.idKind) * 0x9E3779B97F4A7C15ull;
+            h ^= h >> 32;
+            h *= 0xD6E8FEB86659FD93ull;
+            return static_cast<size_t>(h ^ (h >> 32));
+        }
+    };
+
+    inline TradeDedupId TradeDedupKey(const TradeRecord& trade)
+    {
+        return TradeDedupId{trade.tradeId, trade.exchangeId,
+                            static_cast<uint8_t>(trade.flags & (TradeFlags::InlineTradeId | TradeFlags::HashedTradeId))};
+    }
+
+    // Key for per-stream state such as sequence tracking; trade ids only order one venue's symbol
+    inline uint64_t TradeStreamKey(uint16_t exchangeId, uint32_t symbolId)
+    {
+        return (static_cast<uint64_t>(exchangeId) << 32) | symbolId;
+    }
+
+    // Interns the strings referenced by TradeRecord. Symbols get 32-bit ids; exchanges,
+    // sources, currencies and accounts share a separate pool whose ids fit the 16-bit
+    // record fields, and which refuses new names once full rather than wrapping.
+    // Order ids are not interned: they are unbounded, so they go to a fixed ring
+    // (ORDER_REF_CAPACITY entries) and the oldest are evicted. IDs of the two pools
+    // are stable for the lifetime of the table.
+    class TradeStringTable
+    {
+    public:
+        static constexpr uint32_t ORDER_REF_CAPACITY = 8192;
+
+        struct OrderRefs
+        {
+            std::string orderId;
+            std::string buyOrderId;
+            std::string sellOrderId;
+        };
+
+        TradeStringTable();
+
+        // Symbols
+        uint32_t Intern(std::string_view text);
+        uint32_t Find(std::string_view text) const; // 0 when not interned
+        const std::string& Lookup(uint32_t id) const;
+
+        // Exchanges, sources, currencies, accounts. False (id 0) when the pool is full.
+        bool InternName(std::string_view text, uint16_t& id);
+        uint16_t FindName(std::string_view text) const; // 0 when not interned
+        const std::string& LookupName(uint16_t id) const;
+
+        // 0 when all three are empty
+        uint32_t InternOrderRefs(std::string_view orderId, std::string_view buyOrderId,
+                                 std::string_view sellOrderId);
+        bool GetOrderRefs(uint32_t refsId, OrderRefs& out) const; // False once evicted from the ring
+
+        size_t GetSize() const;
+
+    private:
+        struct Pool
+        {
+            std::deque<std::string> strings; // deque keeps references stable on growth
+            std::unordered_map<std::string_view, uint32_t> index;
+
+            Pool() { strings.emplace_back(); } // id 0 is the empty string
+        };
+
+        struct OrderRefsEntry
+        {
+            uint32_t refsId; // Owner of the ring slot (0 = empty)
+            OrderRefs refs;
+        };
+
+        uint32_t InternLocked(Pool& pool, std::string_view text);
+
+        mutable std::shared_mutex m_mutex;
+        Pool m_symbols;
+        Pool m_names;
+
+        mutable std::mutex m_orderRefsMutex; // Separate so order ids never block symbol lookups
+        std::vector<OrderRefsEntry> m_orderRefs;
+        uint32_t m_lastOrderRefsId;
+    };
+
+    TradeStringTable& GetTradeStringTable();
+
+    // Trade id encoding
+    void EncodeTradeId(std::string_view text, TradeRecord& trade);
+    std::string DecodeTradeId(const TradeRecord& trade);
+
+    TradeSide ParseTradeSide(std::string_view side);
+    const char* TradeSideToString(TradeSide side);
+
+    // Conversions to and from the display form. False when a name could not be interned
+    // or the price or quantity does not fit the scale.
+    bool MakeTradeRecord(const NormalizedTrade& trade, TradeStringTable& strings, DecimalScale scale, TradeRecord& out);
+    NormalizedTrade ToNormalizedTrade(const TradeRecord& trade, const TradeStringTable& strings);
+}
@@ -4,9 +4,111 @@
 
 #include "UDPConnectionNode.h"
 
+#include <algorithm>
+
 namespace gui
 {
     namespace editor
     {
+        bool RestConnectionNode::CanAcceptInput(ax::NodeEditor::PinId inputPin, const NodeData* outputData) const
+        {
+            (void)inputPin;
+            return outputData && outputData->As<RestRequestData>();
+        }
+
+        void RestConnectionNode::Update(float deltaTime)
+        {
+            (void)deltaTime;
+            DrainRequests();
+            DeliverResponses();
+        }
+
+        void RestConnectionNode::OnInputDisconnected(ax::NodeEditor::PinId pinId)
+        {
+            // The node behind the pin may be gone; its answers have nowhere to go
+            m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(),
+                                           [pinId](const PendingRequest& pending) { return pending.source == pinId; }),
+                            m_pending.end());
+        }
+
+        void RestConnectionNode::SendGetRequest(const std::string& endpoint,
+                                                const std::unordered_map<std::string, std::string>& headers)
+        {
+            // Per-request headers (If-None-Match, ...) ride with the configured ones for this call only
+            const size_t configured = m_config.headers.size();
+            for (const auto& [name, value] : headers)
+                m_config.headers.push_back(name + ": " + value);
+            SendGetRequest(endpoint);
+            m_config.headers.resize(configured);
+        }
+
+        uint64_t RestConnectionNode::SendRequest(const RestRequest& request, RestResponseHandler handler,
+                                                 ax::NodeEditor::PinId source)
+        {
+            const uint64_t id = m_nextRequestId++;
+            m_pending.push_back(PendingRequest{id, source, request.correlationId, std::move(handler),
+                                               std::chrono::steady_clock::now()});
+
+            m_sendingRequestId = id;
+            if (request.method == "GET")
+                SendGetRequest(request.endpoint, request.headers);
+            else if (request.method == "DELETE")
+                SendDeleteRequest(request.endpoint);
+            else
+                m_lastError = "Unsupported queued request method " + request.method;
+            m_sendingRequestId = 0;
+            return id;
+        }
+
+        void RestConnectionNode::OnResponse(uint64_t requestId, RestResponse response)
+        {
+            std::lock_guard<std::mutex> lock(m_responseMutex);
+            m_responses.emplace_back(requestId, std::move(response));
+        }
+
+        void RestConnectionNode::DrainRequests()
+        {
+            for (const Pin& pin : GetInputPins())
+            {
+                const std::shared_ptr<NodeData> data = GetInputData(pin.id);
+                RestRequestData* queue = data ? data->As<RestRequestData>() : nullptr;
+                if (!queue || queue->requests.empty())
+                    continue;
+
+                // Cleared in place: the queue is the updater's own, shared through the link
+                for (const RestRequest& request : queue->requests)
+                    SendRequest(request, queue->onResponse, pin.id);
+                queue->requests.clear();
+            }
+        }
+
+        void RestConnectionNode::DeliverResponses()
+        {
+            std::vector<std::pair<uint64_t, RestResponse>> responses;
+            {
+                std::lock_guard<std::mutex> lock(m_responseMutex);
+                responses.swap(m_responses);
+            }
+
+            for (auto& [id, response] : responses)
+            {
+                const auto pending = std::find_if(m_pending.begin(), m_pending.end(),
+                                                  [id = id](const PendingRequest& entry) { return entry.id == id; });
+                if (pending == m_pending.end())
+                    continue; // Its requester was disconnected
+
+                m_responsesReceived++;
+                m_lastResponseCode = response.status;
+                const float elapsedMs =
+                    std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - pending->sentTime).count();
+                m_averageResponseTime += (elapsedMs - m_averageResponseTime) / static_cast<float>(m_responsesReceived);
+
+                response.correlationId = pending->correlationId;
+                const RestResponseHandler handler = std::move(pending->handler);
+                m_pending.erase(pending);
+                if (handler)
+                    handler(response);
+            }
+        }
     } // editor
 } // gui
\ No newline at end of file
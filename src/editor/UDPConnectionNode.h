@@ -1,6 +1,10 @@
 #pragma once
 
 #include "Node.h"
+#include "RestRequest.h"
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
 
 namespace gui::editor
 {
@@ -105,12 +109,24 @@ namespace gui::editor
         void OnInputDisconnected(ax::NodeEditor::PinId pinId) override;
         bool IsValid() const override;
 
+        // Accepts RestRequestData from updaters (depth snapshots, conditional polls)
+        bool CanAcceptInput(ax::NodeEditor::PinId inputPin, const NodeData* outputData) const override;
+
         // Request methods
         void SendGetRequest(const std::string& endpoint);
+        void SendGetRequest(const std::string& endpoint, const std::unordered_map<std::string, std::string>& headers);
+        // Sends a queued request; its response goes to the handler. Returns the request id.
+        uint64_t SendRequest(const RestRequest& request, RestResponseHandler handler = {},
+                             ax::NodeEditor::PinId source = 0);
         void SendPostRequest(const std::string& endpoint, const std::string& data);
         void SendPutRequest(const std::string& endpoint, const std::string& data);
         void SendDeleteRequest(const std::string& endpoint);
 
+        // Completion of the transfer the transport started for requestId. Safe from any
+        // thread; the handler runs in the next Update().
+        void OnResponse(uint64_t requestId, RestResponse response);
+        uint64_t GetSendingRequestId() const { return m_sendingRequestId; } // Set while a Send*Request runs
+
         RestConnectionState GetState() const { return m_state; }
         const RestConfiguration& GetConfiguration() const { return m_config; }
         void SetConfiguration(const RestConfiguration& config) { m_config = config; }
@@ -124,6 +140,25 @@ namespace gui::editor
         void RenderRequestBuilder();
         void RenderStatusDisplay();
 
+        // Requests queued on the input pins are sent and cleared; answers are delivered
+        void DrainRequests();
+        void DeliverResponses();
+
+        struct PendingRequest
+        {
+            uint64_t id;
+            ax::NodeEditor::PinId source; // Input pin that queued it; 0 for the request builder
+            std::string correlationId;
+            RestResponseHandler handler;
+            std::chrono::steady_clock::time_point sentTime;
+        };
+        std::vector<PendingRequest> m_pending;
+        uint64_t m_nextRequestId = 1;
+        uint64_t m_sendingRequestId = 0; // Tags the transfer the verb method starts
+
+        std::mutex m_responseMutex;
+        std::vector<std::pair<uint64_t, RestResponse>> m_responses; // Completed, not yet delivered
+
         RestConfiguration m_config;
         RestConnectionState m_state;
         bool m_configExpanded;
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Decimal.h"
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+
+namespace gui::editor
+{
+    struct WalletBalance
+    {
+        std::string currency;
+        int scale; // Currency precision
+        Decimal available;
+        Decimal locked;
+        Decimal total;
+        std::chrono::system_clock::time_point updateTime;
+        
+        WalletBalance() : scale(8) {}
+    };
+
+    struct WalletState
+    {
+        std::string account;
+        std::string exchange;
+        std::unordered_map<std::string, WalletBalance> balances;
+        double totalValueUSD; // From WalletValuation, which keeps it incrementally
+        std::chrono::system_clock::time_point updateTime;
+        
+        WalletState() : totalValueUSD(0.0) {}
+    };
+}
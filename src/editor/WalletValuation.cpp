@@ -0,0 +1,407 @@
+#include "WalletValuation.h"
+#include "InstrumentRegistry.h"
+#include "WalletState.h"
+
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+
+namespace gui
+{
+    namespace editor
+    {
+        namespace
+        {
+            const char* const USD_PEGGED[] = {"USD", "USDT", "USDC", "DAI", "FDUSD", "TUSD", "USDP", "PYUSD"};
+
+            void EraseValue(std::vector<uint32_t>& values, uint32_t value)
+            {
+                const auto it = std::find(values.begin(), values.end(), value);
+                if (it != values.end())
+                {
+                    *it = values.back();
+                    values.pop_back();
+                }
+            }
+        }
+
+        WalletValuation::WalletValuation(size_t initialCapacity)
+            : m_currencyIndex(initialCapacity)
+            , m_accountIndex(64)
+            , m_positionIndex(initialCapacity * 2)
+            , m_symbolIndex(initialCapacity)
+            , m_totalValue(0.0)
+            , m_updatesSinceResum(0)
+            , m_routeGeneration(0)
+        {
+            m_currencies.reserve(initialCapacity);
+            m_positions.reserve(initialCapacity * 2);
+            SetPeggedPrices();
+        }
+
+        void WalletValuation::SetFixedPrice(std::string_view currency, double priceUsd)
+        {
+            const uint32_t index = GetCurrency(currency);
+            Unroute(index);
+            Currency& entry = m_currencies[index];
+            entry.fixed = true;
+            entry.fixedPrice = priceUsd;
+            MarkDirty(index);
+        }
+
+        void WalletValuation::SetConversion(std::string_view currency, std::string_view pair, bool inverted,
+                                            std::string_view viaCurrency)
+        {
+            const uint32_t index = GetCurrency(currency);
+            const uint32_t via = viaCurrency.empty() ? NO_CURRENCY : GetCurrency(viaCurrency);
+            Unroute(index);
+            if (via == index)
+                return; // Left unpriced rather than routed through itself
+
+            const uint32_t symbolId = GetTradeStringTable().Intern(pair);
+            uint32_t subscription = m_symbolIndex.Find(symbolId);
+            if (subscription == FlatHashIndex::NOT_FOUND)
+            {
+                subscription = static_cast<uint32_t>(m_subscriptions.size());
+                m_subscriptions.push_back(Subscription{symbolId, 0.0, {}});
+                m_symbolIndex.Insert(symbolId, subscription);
+            }
+            m_subscriptions[subscription].currencies.push_back(index);
+            if (via != NO_CURRENCY)
+                m_currencies[via].dependents.push_back(index);
+
+            Currency& entry = m_currencies[index];
+            entry.subscription = subscription;
+            entry.via = via;
+            entry.inverted = inverted;
+            MarkDirty(index);
+        }
+
+        bool WalletValuation::SyncRoutes(const InstrumentRegistry& registry)
+        {
+            if (registry.GetGeneration() == m_routeGeneration)
+                return false;
+            m_routeGeneration = registry.GetGeneration();
+
+            // Routes of delisted pairs must not survive, so every derived route is rebuilt
+            std::unordered_set<std::string> reached;
+            for (uint32_t index = 0; index < m_currencies.size(); index++)
+            {
+                const Currency& currency = m_currencies[index];
+                if (currency.fixed)
+                    reached.insert(GetTradeStringTable().Lookup(currency.nameId));
+                else if (currency.subscription != NO_SUBSCRIPTION)
+                    Unroute(index);
+            }
+
+            // Breadth first from the fixed prices, so each asset takes its shortest route.
+            // A route of n pairs resolves n levels deep, within MAX_ROUTE_DEPTH.
+            struct Route
+            {
+                std::string currency;
+                std::string pair;
+                std::string via;
+                bool inverted;
+            };
+            std::vector<Route> level;
+            for (int depth = 1; depth < MAX_ROUTE_DEPTH; depth++)
+            {
+                level.clear();
+                registry.ForEach([&](const InstrumentData& instrument) {
+                    if (instrument.baseAsset.empty() || instrument.quoteAsset.empty())
+                        return;
+                    const bool base = reached.count(instrument.baseAsset) != 0;
+                    const bool quote = reached.count(instrument.quoteAsset) != 0;
+                    if (quote && !base)
+                        level.push_back(Route{instrument.baseAsset, instrument.symbol, instrument.quoteAsset, false});
+                    else if (base && !quote)
+                        level.push_back(Route{instrument.quoteAsset, instrument.symbol, instrument.baseAsset, true});
+                });
+                if (level.empty())
+                    break;
+                for (const Route& route : level)
+                {
+                    // Several pairs may reach the same asset at this depth; the first is kept
+                    if (reached.insert(route.currency).second)
+                        SetConversion(route.currency, route.pair, route.inverted, route.via);
+                }
+            }
+            return true;
+        }
+
+        void WalletValuation::OnMidPrice(uint32_t symbolId, double mid)
+        {
+            const uint32_t index = m_symbolIndex.Find(symbolId);
+            if (index == FlatHashIndex::NOT_FOUND || !(mid > 0.0))
+                return;
+            Subscription& subscription = m_subscriptions[index];
+            if (subscription.mid == mid)
+                return;
+            subscription.mid = mid;
+            for (uint32_t currency : subscription.currencies)
+                MarkDirty(currency);
+        }
+
+        void WalletValuation::SetBalance(std::string_view exchange, std::string_view account, std::string_view currency,
+                                         Decimal total, int scale)
+        {
+            const uint32_t accountIndex = GetAccount(exchange, account);
+            if (accountIndex == FlatHashIndex::NOT_FOUND)
+                return;
+            const uint32_t currencyIndex = GetCurrency(currency);
+            Position& position = m_positions[GetPosition(accountIndex, currencyIndex)];
+            position.total = total;
+            position.scale = scale;
+            Reprice(position, m_currencies[currencyIndex]);
+        }
+
+        double WalletValuation::SyncWallet(const WalletState& wallet)
+        {
+            const uint32_t accountIndex = GetAccount(wallet.exchange, wallet.account);
+            if (accountIndex == FlatHashIndex::NOT_FOUND)
+                return 0.0;
+            const uint32_t generation = ++m_accounts[accountIndex].generation;
+
+            for (const auto& [name, balance] : wallet.balances)
+            {
+                const uint32_t currencyIndex = GetCurrency(balance.currency.empty() ? name : balance.currency);
+                Position& position = m_positions[GetPosition(accountIndex, currencyIndex)];
+                position.total = balance.total;
+                position.scale = balance.scale;
+                position.generation = generation;
+                Reprice(position, m_currencies[currencyIndex]);
+            }
+
+            // Kept as zero rather than removed: a balance that comes back reuses its slot
+            for (uint32_t slot : m_accounts[accountIndex].positions)
+            {
+                Position& position = m_positions[slot];
+                if (position.generation != generation && !position.total.IsZero())
+                {
+                    position.total = Decimal();
+                    Reprice(position, m_currencies[position.currency]);
+                }
+            }
+
+            Revalue();
+            return m_accounts[accountIndex].value;
+        }
+
+        size_t WalletValuation::Revalue()
+        {
+            size_t repriced = 0;
+            // Dependents are appended while walking, so a route is settled in the same pass
+            for (size_t i = 0; i < m_dirty.size(); i++)
+            {
+                const uint32_t index = m_dirty[i];
+                m_currencies[index].dirty = false;
+
+                double price = 0.0;
+                const bool priced = ResolvePrice(index, 0, price);
+                Currency& currency = m_currencies[index];
+                if (priced == currency.priced && price == currency.price)
+                    continue;
+                currency.priced = priced;
+                currency.price = price;
+                for (uint32_t slot : currency.positions)
+                    Reprice(m_positions[slot], currency);
+                for (uint32_t dependent : currency.dependents)
+                    MarkDirty(dependent);
+                repriced++;
+            }
+            m_dirty.clear();
+
+            if (m_updatesSinceResum >= RESUM_INTERVAL)
+                Resum();
+            return repriced;
+        }
+
+        double WalletValuation::GetAccountValue(std::string_view exchange, std::string_view account) const
+        {
+            const uint32_t index = FindAccount(exchange, account);
+            return index == FlatHashIndex::NOT_FOUND ? 0.0 : m_accounts[index].value;
+        }
+
+        double WalletValuation::GetPrice(std::string_view currency) const
+        {
+            const uint32_t index = FindCurrency(currency);
+            return index == FlatHashIndex::NOT_FOUND || !m_currencies[index].priced ? 0.0 : m_currencies[index].price;
+        }
+
+        size_t WalletValuation::GetUnpricedCount() const
+        {
+            size_t count = 0;
+            for (const Currency& currency : m_currencies)
+            {
+                if (!currency.priced && !currency.positions.empty())
+                    count++;
+            }
+            return count;
+        }
+
+        void WalletValuation::Clear()
+        {
+            m_currencies.clear();
+            m_positions.clear();
+            m_accounts.clear();
+            m_subscriptions.clear();
+            m_currencyIndex.Clear();
+            m_accountIndex.Clear();
+            m_positionIndex.Clear();
+            m_symbolIndex.Clear();
+            m_dirty.clear();
+            m_totalValue = 0.0;
+            m_updatesSinceResum = 0;
+            m_routeGeneration = 0;
+            SetPeggedPrices();
+        }
+
+        void WalletValuation::SetPeggedPrices()
+        {
+            for (const char* currency : USD_PEGGED)
+                SetFixedPrice(currency, 1.0);
+        }
+
+        uint32_t WalletValuation::GetCurrency(std::string_view name)
+        {
+            const uint32_t nameId = GetTradeStringTable().Intern(name);
+            uint32_t index = m_currencyIndex.Find(nameId);
+            if (index == FlatHashIndex::NOT_FOUND)
+            {
+                index = static_cast<uint32_t>(m_currencies.size());
+                m_currencies.push_back(Currency{nameId, NO_SUBSCRIPTION, NO_CURRENCY, 0.0, 0.0,
+                                                false, false, false, false, {}, {}});
+                m_currencyIndex.Insert(nameId, index);
+            }
+            return index;
+        }
+
+        uint32_t WalletValuation::GetAccount(std::string_view exchange, std::string_view account)
+        {
+            TradeStringTable& strings = GetTradeStringTable();
+            uint16_t exchangeId = 0;
+            uint16_t accountId = 0;
+            if (!strings.InternName(exchange, exchangeId) || !strings.InternName(account, accountId))
+                return FlatHashIndex::NOT_FOUND;
+
+            const uint64_t key = static_cast<uint64_t>(exchangeId) << 16 | accountId;
+            uint32_t index = m_accountIndex.Find(key);
+            if (index == FlatHashIndex::NOT_FOUND)
+            {
+                index = static_cast<uint32_t>(m_accounts.size());
+                m_accounts.push_back(Account{exchangeId, accountId, 0.0, 0, {}});
+                m_accountIndex.Insert(key, index);
+            }
+            return index;
+        }
+
+        uint32_t WalletValuation::GetPosition(uint32_t account, uint32_t currency)
+        {
+            const uint64_t key = static_cast<uint64_t>(account) << 32 | currency;
+            uint32_t slot = m_positionIndex.Find(key);
+            if (slot == FlatHashIndex::NOT_FOUND)
+            {
+                slot = static_cast<uint32_t>(m_positions.size());
+                m_positions.push_back(Position{account, currency, Decimal(), 8, 0.0, 0});
+                m_positionIndex.Insert(key, slot);
+                m_accounts[account].positions.push_back(slot);
+                m_currencies[currency].positions.push_back(slot);
+            }
+            return slot;
+        }
+
+        uint32_t WalletValuation::FindCurrency(std::string_view name) const
+        {
+            const uint32_t nameId = GetTradeStringTable().Find(name);
+            return nameId == 0 ? FlatHashIndex::NOT_FOUND : m_currencyIndex.Find(nameId);
+        }
+
+        uint32_t WalletValuation::FindAccount(std::string_view exchange, std::string_view account) const
+        {
+            const TradeStringTable& strings = GetTradeStringTable();
+            const uint16_t exchangeId = strings.FindName(exchange);
+            const uint16_t accountId = strings.FindName(account);
+            if ((exchangeId == 0 && !exchange.empty()) || (accountId == 0 && !account.empty()))
+                return FlatHashIndex::NOT_FOUND;
+            return m_accountIndex.Find(static_cast<uint64_t>(exchangeId) << 16 | accountId);
+        }
+
+        void WalletValuation::MarkDirty(uint32_t currency)
+        {
+            if (!m_currencies[currency].dirty)
+            {
+                m_currencies[currency].dirty = true;
+                m_dirty.push_back(currency);
+            }
+        }
+
+        void WalletValuation::Unroute(uint32_t currency)
+        {
+            Currency& entry = m_currencies[currency];
+            if (entry.subscription != NO_SUBSCRIPTION)
+                EraseValue(m_subscriptions[entry.subscription].currencies, currency);
+            if (entry.via != NO_CURRENCY)
+                EraseValue(m_currencies[entry.via].dependents, currency);
+            entry.subscription = NO_SUBSCRIPTION;
+            entry.via = NO_CURRENCY;
+            entry.inverted = false;
+            entry.fixed = false;
+            MarkDirty(currency);
+        }
+
+        bool WalletValuation::ResolvePrice(uint32_t currency, int depth, double& price)
+        {
+            const Currency& entry = m_currencies[currency];
+            if (entry.fixed)
+            {
+                price = entry.fixedPrice;
+                return true;
+            }
+            if (entry.subscription == NO_SUBSCRIPTION)
+                return false;
+
+            const double mid = m_subscriptions[entry.subscription].mid;
+            if (!(mid > 0.0))
+                return false;
+            price = entry.inverted ? 1.0 / mid : mid;
+            if (entry.via == NO_CURRENCY)
+                return true;
+
+            // Mids are stored as they arrive, so the route is read fresh even if the via currency is dirty
+            double viaPrice = 0.0;
+            if (depth + 1 >= MAX_ROUTE_DEPTH || !ResolvePrice(entry.via, depth + 1, viaPrice))
+                return false;
+            price *= viaPrice;
+            return true;
+        }
+
+        void WalletValuation::Reprice(Position& position, const Currency& currency)
+        {
+            const double value = currency.priced ? position.total.ToDouble(position.scale) * currency.price : 0.0;
+            const double delta = value - position.contribution;
+            position.contribution = value;
+            m_accounts[position.account].value += delta;
+            m_totalValue += delta;
+            m_updatesSinceResum++;
+        }
+
+        void WalletValuation::Resum()
+        {
+            for (Account& account : m_accounts)
+                account.value = 0.0;
+            m_totalValue = 0.0;
+            for (const Position& position : m_positions)
+            {
+                m_accounts[position.account].value += position.contribution;
+                m_totalValue += position.contribution;
+            }
+            m_updatesSinceResum = 0;
+        }
+
+        WalletValuation& GetWalletValuation()
+        {
+            static WalletValuation valuation;
+            return valuation;
+        }
+    } // editor
+} // gui
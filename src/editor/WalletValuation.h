@@ -0,0 +1,164 @@
+#pragma once
+
+#include "Decimal.h"
+#include "FlatHashIndex.h"
+#include "TradeRecord.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace gui::editor
+{
+    class InstrumentRegistry;
+    struct WalletState;
+
+    // USD valuation of every balance of every account, kept incrementally. Accounts
+    // are per venue: (exchange, account) names one wallet. Each (wallet, currency) position holds its current contribution; a balance change
+    // reprices that one position, and a price change marks its currency dirty so the
+    // next Revalue() reprices only the positions in that currency (and currencies
+    // routed through it). Account and grand totals are adjusted by the difference,
+    // with a periodic exact resum so floating error cannot build up.
+    //
+    // Prices come from book mids: SetConversion subscribes a currency to a pair, and
+    // OrderbookUpdater forwards mids of subscribed pairs through OnMidPrice and calls
+    // Revalue() once per pass. USD and the USD stablecoins have fixed prices; every
+    // other asset is routed to them by SyncRoutes from the instrument registry's
+    // base/quote pairs. Currencies without a route (or whose pair has not ticked
+    // yet) are unpriced and count zero.
+    // Not thread-safe: use from the node update thread.
+    class WalletValuation
+    {
+    public:
+        static constexpr uint32_t NO_CURRENCY = FlatHashIndex::NOT_FOUND;
+        static constexpr uint32_t NO_SUBSCRIPTION = FlatHashIndex::NOT_FOUND;
+        static constexpr int MAX_ROUTE_DEPTH = 4;        // e.g. XYZ -> BTC -> USDT -> USD
+        static constexpr uint32_t RESUM_INTERVAL = 4096; // Incremental updates between exact resums
+
+        explicit WalletValuation(size_t initialCapacity = 256);
+
+        // Routes: value = mid(pair), or 1 / mid(pair) when inverted, times the price of
+        // viaCurrency (USD when empty). Fixed prices suit USD itself and pegged coins.
+        void SetFixedPrice(std::string_view currency, double priceUsd);
+        void SetConversion(std::string_view currency, std::string_view pair, bool inverted = false,
+                           std::string_view viaCurrency = {});
+
+        // Routes every asset of the registry's instruments through the fewest pairs to a
+        // fixed-price currency: a pair prices its base from its quote, or its quote from
+        // its base (inverted). Fixed prices are kept. Returns false, doing nothing, when
+        // the registry has not changed since the last call.
+        bool SyncRoutes(const InstrumentRegistry& registry);
+
+        bool IsSubscribed(uint32_t symbolId) const { return m_symbolIndex.Find(symbolId) != FlatHashIndex::NOT_FOUND; }
+        void OnMidPrice(uint32_t symbolId, double mid); // Deferred until Revalue()
+
+        // Balances are repriced immediately at the currency's current price
+        void SetBalance(std::string_view exchange, std::string_view account, std::string_view currency,
+                        Decimal total, int scale);
+        // Full snapshot of one account: currencies missing from it drop to zero.
+        // Revalues and returns the account value.
+        double SyncWallet(const WalletState& wallet);
+
+        // Applies pending price changes; returns the number of currencies repriced
+        size_t Revalue();
+
+        double GetAccountValue(std::string_view exchange, std::string_view account) const;
+        double GetTotalValue() const { return m_totalValue; }
+        double GetPrice(std::string_view currency) const; // 0 when unpriced
+        size_t GetUnpricedCount() const;                  // Currencies held without a price
+        size_t GetPendingCount() const { return m_dirty.size(); }
+
+        // Calls fn(std::string_view currency, Decimal total, int scale, double valueUsd) for each position
+        template<typename Fn>
+        void ForEachPosition(std::string_view exchange, std::string_view account, Fn&& fn) const;
+
+        void Clear();
+
+    private:
+        struct Currency
+        {
+            uint32_t nameId;                  // TradeStringTable id
+            uint32_t subscription;            // m_subscriptions entry, NO_SUBSCRIPTION when not routed
+            uint32_t via;                     // Currency index, NO_CURRENCY for USD
+            double fixedPrice;
+            double price;                     // USD per unit, valid when priced
+            bool inverted;
+            bool fixed;
+            bool priced;
+            bool dirty;
+            std::vector<uint32_t> positions;  // Holders of this currency
+            std::vector<uint32_t> dependents; // Currencies routed via this one
+        };
+
+        struct Subscription
+        {
+            uint32_t symbolId;
+            double mid;                       // 0 until the first tick
+            std::vector<uint32_t> currencies; // Priced from this pair
+        };
+
+        struct Position
+        {
+            uint32_t account;
+            uint32_t currency;
+            Decimal total;
+            int scale;
+            double contribution; // USD value included in the totals
+            uint32_t generation; // Last SyncWallet that listed it
+        };
+
+        struct Account
+        {
+            uint16_t exchangeId; // TradeStringTable name ids
+            uint16_t accountId;
+            double value;
+            uint32_t generation;
+            std::vector<uint32_t> positions;
+        };
+
+        void SetPeggedPrices(); // USD and the USD stablecoins at 1
+        uint32_t GetCurrency(std::string_view name);
+        uint32_t GetAccount(std::string_view exchange, std::string_view account); // NOT_FOUND when the name pool is full
+        uint32_t GetPosition(uint32_t account, uint32_t currency);
+        uint32_t FindCurrency(std::string_view name) const;
+        uint32_t FindAccount(std::string_view exchange, std::string_view account) const;
+
+        void MarkDirty(uint32_t currency);
+        void Unroute(uint32_t currency);
+        bool ResolvePrice(uint32_t currency, int depth, double& price);
+        void Reprice(Position& position, const Currency& currency);
+        void Resum();
+
+        std::vector<Currency> m_currencies;
+        std::vector<Position> m_positions;
+        std::vector<Account> m_accounts;
+        std::vector<Subscription> m_subscriptions;
+
+        FlatHashIndex m_currencyIndex; // nameId -> currency
+        FlatHashIndex m_accountIndex;  // exchangeId << 16 | accountId -> account
+        FlatHashIndex m_positionIndex; // account << 32 | currency -> position
+        FlatHashIndex m_symbolIndex;   // symbolId -> subscription
+
+        std::vector<uint32_t> m_dirty;
+        double m_totalValue;
+        uint32_t m_updatesSinceResum;
+        uint64_t m_routeGeneration; // Registry generation the routes were built from
+    };
+
+    WalletValuation& GetWalletValuation();
+
+    template<typename Fn>
+    void WalletValuation::ForEachPosition(std::string_view exchange, std::string_view account, Fn&& fn) const
+    {
+        const uint32_t index = FindAccount(exchange, account);
+        if (index == FlatHashIndex::NOT_FOUND)
+            return;
+        for (uint32_t slot : m_accounts[index].positions)
+        {
+            const Position& position = m_positions[slot];
+            fn(std::string_view(GetTradeStringTable().Lookup(m_currencies[position.currency].nameId)),
+               position.total, position.scale, position.contribution);
+        }
+    }
+}
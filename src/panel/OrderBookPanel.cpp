@@ -4,6 +4,8 @@
 
 #include "OrderBookPanel.h"
 
+#include "editor/BookConflator.h"
+
 #include <algorithm>
 
 namespace gui {
@@ -18,6 +20,7 @@ OrderBookPanel::OrderBookPanel()
     , m_showMarketDepth(true)
     , m_autoUpdate(true)
 {
+    m_conflatedView = std::make_unique<gui::editor::ConflatedBookView>();
 }
 
 OrderBookPanel::~OrderBookPanel()
@@ -34,6 +37,9 @@ bool OrderBookPanel::Initialize()
 
 void OrderBookPanel::Render(bool* p_open)
 {
+    if (m_autoUpdate)
+        ConsumePublishedSnapshot();
+
     if (ImGui::Begin("Order Book", p_open))
     {
         RenderMarketInfo();
@@ -165,6 +171,48 @@ void OrderBookPanel::UpdateOrderBook(const std::vector<OrderBookEntry>& buyOrder
     }
 }
 
+void OrderBookPanel::ConsumePublishedSnapshot()
+{
+    if (!m_published.Consume())
+        return;
+
+    // Only the render thread touches these; capacity is reused frame to frame
+    const BookSnapshot& snapshot = m_published.Front();
+    m_buyOrders.clear();
+    m_sellOrders.clear();
+    for (int i = 0; i < snapshot.bidCount; i++)
+        m_buyOrders.emplace_back(snapshot.bids[i].price, snapshot.bids[i].size, true);
+    for (int i = 0; i < snapshot.askCount; i++)
+        m_sellOrders.emplace_back(snapshot.asks[i].price, snapshot.asks[i].size, false);
+
+    if (snapshot.lastPrice > 0.0)
+        m_lastPrice = snapshot.lastPrice;
+    if (snapshot.bidCount > 0 && snapshot.askCount > 0)
+    {
+        const double bestBid = snapshot.bids[0].price;
+        m_spreadPercentage = ((snapshot.asks[0].price - bestBid) / bestBid) * 100.0;
+    }
+}
+
+void OrderBookPanel::ApplyConflatedBook(const gui::editor::NormalizedOrderbook& read)
+{
+    m_conflatedView->Apply(read);
+
+    const gui::editor::DecimalScale scale = m_conflatedView->GetScale();
+    const auto& bids = m_conflatedView->GetBids();
+    const auto& asks = m_conflatedView->GetAsks();
+
+    BookSnapshot& snapshot = AcquireSnapshot();
+    snapshot.bidCount = std::min(static_cast<int>(bids.size()), BookSnapshot::MAX_LEVELS);
+    snapshot.askCount = std::min(static_cast<int>(asks.size()), BookSnapshot::MAX_LEVELS);
+    for (int i = 0; i < snapshot.bidCount; i++)
+        snapshot.bids[i] = { bids[i].price.ToDouble(scale.price), bids[i].quantity.ToDouble(scale.quantity) };
+    for (int i = 0; i < snapshot.askCount; i++)
+        snapshot.asks[i] = { asks[i].price.ToDouble(scale.price), asks[i].quantity.ToDouble(scale.quantity) };
+    snapshot.lastPrice = 0.0; // Trades are not part of the book feed
+    PublishSnapshot();
+}
+
 void OrderBookPanel::GenerateSampleData()
 {
     m_buyOrders.clear();
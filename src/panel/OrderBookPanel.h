@@ -1,10 +1,17 @@
 #pragma once
 
 #include "imgui.h"
+#include "TripleBuffer.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
+namespace gui::editor {
+    struct NormalizedOrderbook;
+    class ConflatedBookView;
+}
+
 namespace gui {
 namespace panel {
 
@@ -19,6 +26,22 @@ public:
         OrderBookEntry(double p, double s, bool buy) : price(p), size(s), isBuy(buy) {}
     };
 
+    // Fixed-size top-of-book published from an engine thread
+    struct BookSnapshot {
+        static constexpr int MAX_LEVELS = 50;
+
+        struct Level {
+            double price;
+            double size;
+        };
+
+        Level bids[MAX_LEVELS]; // Best (highest) first
+        Level asks[MAX_LEVELS]; // Best (lowest) first
+        int bidCount = 0;
+        int askCount = 0;
+        double lastPrice = 0.0;
+    };
+
     OrderBookPanel();
     ~OrderBookPanel();
 
@@ -31,16 +54,28 @@ public:
     void UpdateOrderBook(const std::vector<OrderBookEntry>& buyOrders,
                         const std::vector<OrderBookEntry>& sellOrders);
     void SetLastPrice(double price) { m_lastPrice = price; }
+
+    // Lock-free hand-off from one engine thread: fill AcquireSnapshot() in place,
+    // then PublishSnapshot(). Never blocks; Render() picks up the latest one.
+    BookSnapshot& AcquireSnapshot() { return m_published.WriteSlot(); }
+    void PublishSnapshot() { m_published.Publish(); }
+
+    // Engine thread: applies a conflated read (OrderbookUpdater::SubscribeConflatedBook)
+    // to the mirrored top of book and publishes it
+    void ApplyConflatedBook(const gui::editor::NormalizedOrderbook& read);
     void Set24hVolume(double volume) { m_volume24h = volume; }
 
 private:
     void RenderOrderBookTable();
     void RenderMarketInfo();
     void GenerateSampleData(); // For testing
+    void ConsumePublishedSnapshot();
 
     std::string m_currencyPair;
     std::vector<OrderBookEntry> m_buyOrders;
     std::vector<OrderBookEntry> m_sellOrders;
+    TripleBuffer<BookSnapshot> m_published;
+    std::unique_ptr<gui::editor::ConflatedBookView> m_conflatedView; // Engine thread only
 
     // Market data
     double m_lastPrice;
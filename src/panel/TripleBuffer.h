@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace gui {
+namespace panel {
+
+// Single-writer / single-reader triple buffer. The writer fills its back slot and
+// swaps it with the shared slot; the reader swaps the shared slot with its front
+// slot when something new was published. Both swaps are one atomic exchange, so
+// neither side ever waits for the other and the reader always sees the latest
+// complete value (intermediate ones are skipped).
+template<typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer()
+        : m_shared(1)
+        , m_back(0)
+        , m_front(2)
+    {
+    }
+
+    // Writer side
+    T& WriteSlot() { return m_slots[m_back]; }
+    void Publish()
+    {
+        const uint8_t previous = m_shared.exchange(static_cast<uint8_t>(m_back | FRESH), std::memory_order_acq_rel);
+        m_back = previous & INDEX_MASK;
+    }
+
+    // Reader side: returns true when Front() changed since the last call
+    bool Consume()
+    {
+        if (!(m_shared.load(std::memory_order_relaxed) & FRESH))
+            return false;
+        const uint8_t previous = m_shared.exchange(m_front, std::memory_order_acq_rel);
+        m_front = previous & INDEX_MASK;
+        return true;
+    }
+    const T& Front() const { return m_slots[m_front]; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH = 0x4; // Shared slot holds a value the reader has not taken
+
+    T m_slots[3];
+    std::atomic<uint8_t> m_shared;
+    uint8_t m_back;  // Owned by the writer
+    uint8_t m_front; // Owned by the reader
+};
+
+} // namespace panel
+} // namespace gui
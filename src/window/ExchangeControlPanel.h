@@ -41,6 +41,9 @@ public:
     // Set exchange information
     void SetExchangeInfo(const std::string& exchangeName, const std::string& currencyPair);
 
+    // For subscribing the panel to OrderbookUpdater's conflated book of the current pair
+    gui::panel::OrderBookPanel* GetOrderBookPanel() { return m_orderBookPanel.get(); }
+
 private:
     void RenderDockSpace();
     void RenderMenuBar();
@@ -0,0 +1,113 @@
+// Checks BarAggregator's sealing rules: a 1s bar stays open for the lateness
+// window, late trades are dropped only once their second is sealed, parents are
+// built from sealed children, gaps in a stream lose nothing, and streams of
+// different exchanges never mix.
+
+#include "editor/BarAggregator.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace gui::editor;
+
+namespace
+{
+    int g_failures = 0;
+
+    void Check(bool condition, const char* what)
+    {
+        if (!condition)
+        {
+            std::fprintf(stderr, "FAILED: %s\n", what);
+            g_failures++;
+        }
+    }
+
+    constexpr int64_t SECOND = 1000000000;
+    constexpr int64_t BASE = 1699999200 * SECOND; // Whole hour
+
+    TradeRecord MakeTrade(uint16_t exchangeId, uint32_t symbolId, int64_t timestampNs, int64_t price)
+    {
+        TradeRecord trade{};
+        trade.exchangeId = exchangeId;
+        trade.symbolId = symbolId;
+        trade.timestampNs = timestampNs;
+        trade.price = Decimal(price);
+        trade.quantity = Decimal(1);
+        trade.priceScale = 2;
+        trade.quantityScale = 0;
+        trade.side = TradeSide::Buy;
+        return trade;
+    }
+}
+
+int main()
+{
+    BarAggregator bars(16, 2 * SECOND);
+    std::vector<OhlcvBar> history;
+    OhlcvBar bar;
+
+    // Second 0 is still open while the watermark is within two seconds of its end
+    Check(bars.AddTrade(MakeTrade(1, 7, BASE + 100, 100)), "first trade accepted");
+    Check(bars.AddTrade(MakeTrade(1, 7, BASE + 2 * SECOND + 500, 102)), "trade two seconds later accepted");
+    Check(bars.AddTrade(MakeTrade(1, 7, BASE + 900, 99)), "trade inside the lateness window accepted");
+    Check(bars.CopyHistory(1, 7, BarTimeframe::Second1, 0, history) == 0, "nothing sealed yet");
+    Check(bars.GetCurrentBar(1, 7, BarTimeframe::Minute1, bar) && bar.tradeCount == 3 && bar.startNs == BASE &&
+          bar.open.units == 100 && bar.close.units == 102, "current 1m bar merges the pending seconds in order");
+
+    // Watermark passes 3s: second 0 is sealed, with the late trade in it
+    Check(bars.AddTrade(MakeTrade(1, 7, BASE + 3 * SECOND, 103)), "trade at 3s accepted");
+    Check(bars.CopyHistory(1, 7, BarTimeframe::Second1, 0, history) == 1, "second 0 sealed");
+    Check(history[0].startNs == BASE && history[0].tradeCount == 2 && history[0].low.units == 99 &&
+          history[0].close.units == 99, "sealed second holds the late trade");
+    Check(!bars.AddTrade(MakeTrade(1, 7, BASE + 500, 98)), "trade for a sealed second dropped");
+    Check(bars.GetLateTradeCount() == 1, "late trade counted");
+
+    // Same symbol on another exchange is a separate stream
+    Check(bars.AddTrade(MakeTrade(2, 7, BASE + 100, 500)), "other exchange accepted");
+    Check(bars.GetStreamCount() == 2, "two streams");
+    Check(bars.GetCurrentBar(2, 7, BarTimeframe::Second1, bar) && bar.tradeCount == 1 && bar.open.units == 500,
+          "other exchange has its own bar");
+
+    // The clock seals idle streams; the minute closes once its last second is sealed
+    bars.CloseElapsed(BASE + 62 * SECOND);
+    Check(bars.CopyHistory(1, 7, BarTimeframe::Second1, 0, history) == 3, "all seconds sealed");
+    Check(bars.CopyHistory(1, 7, BarTimeframe::Minute1, 0, history) == 1, "minute sealed");
+    Check(history[0].startNs == BASE && history[0].tradeCount == 4 && history[0].open.units == 100 &&
+          history[0].close.units == 103 && history[0].high.units == 103 && history[0].low.units == 99,
+          "minute built from its seconds");
+    Check(!bars.GetCurrentBar(1, 7, BarTimeframe::Minute1, bar), "no minute in progress");
+    Check(bars.GetCurrentBar(1, 7, BarTimeframe::Minute5, bar) && bar.tradeCount == 4 && bar.startNs == BASE,
+          "open 5m bar holds the sealed minute");
+
+    // Zero lateness seals a second as soon as a later one trades
+    bars.Configure(16, 0);
+    Check(bars.GetStreamCount() == 0, "configure clears");
+    bars.AddTrade(MakeTrade(1, 7, BASE + 100, 100));
+    bars.AddTrade(MakeTrade(1, 7, BASE + SECOND, 101));
+    Check(bars.CopyHistory(1, 7, BarTimeframe::Second1, 0, history) == 1, "previous second sealed at once");
+    Check(!bars.AddTrade(MakeTrade(1, 7, BASE + 200, 100)), "no lateness allowed");
+
+    // A gap longer than the pending ring: the old seconds are still sealed, in order
+    bars.Configure(16, 0);
+    bars.AddTrade(MakeTrade(1, 7, BASE + SECOND / 2, 100));
+    bars.AddTrade(MakeTrade(1, 7, BASE + 10 * SECOND + SECOND / 2, 110));
+    bars.AddTrade(MakeTrade(1, 7, BASE + 20 * SECOND + SECOND / 2, 120));
+    for (int64_t second = 21; second <= 24; second++)
+        bars.AddTrade(MakeTrade(1, 7, BASE + second * SECOND + SECOND / 2, 100 + second));
+    Check(bars.CopyHistory(1, 7, BarTimeframe::Second1, 0, history) == 6, "gapped seconds all sealed");
+    Check(history.size() == 6 && history[5].startNs == BASE && history[4].startNs == BASE + 10 * SECOND &&
+          history[0].startNs == BASE + 23 * SECOND && history[0].close.units == 123, "sealed in time order");
+    Check(bars.GetCurrentBar(1, 7, BarTimeframe::Second1, bar) && bar.startNs == BASE + 24 * SECOND &&
+          bar.tradeCount == 1, "newest second still open");
+    Check(bars.GetCurrentBar(1, 7, BarTimeframe::Minute1, bar) && bar.tradeCount == 7 && bar.open.units == 100 &&
+          bar.close.units == 124, "minute holds every trade across the gap");
+
+    if (g_failures != 0)
+    {
+        std::fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("BarAggregatorTest passed\n");
+    return 0;
+}
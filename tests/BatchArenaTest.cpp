@@ -0,0 +1,150 @@
+// Checks that the steady-state parse path makes no calls into the global allocator:
+// after one warm-up batch has sized the thread arena and the reused buffers,
+// further batches must not allocate at all.
+
+#include "editor/BatchArena.h"
+#include "editor/OrderbookLevelParser.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::atomic<size_t> g_allocations{0};
+
+    void* CountedAllocate(size_t size)
+    {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        if (void* p = std::malloc(size ? size : 1))
+            return p;
+        throw std::bad_alloc();
+    }
+
+    void* CountedAllocateAligned(size_t size, std::align_val_t alignment)
+    {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        const size_t align = static_cast<size_t>(alignment);
+        if (void* p = std::aligned_alloc(align, (size + align - 1) / align * align))
+            return p;
+        throw std::bad_alloc();
+    }
+
+    int g_failures = 0;
+
+    void Check(bool condition, const char* what)
+    {
+        if (!condition)
+        {
+            std::fprintf(stderr, "FAILED: %s\n", what);
+            g_failures++;
+        }
+    }
+}
+
+void* operator new(size_t size) { return CountedAllocate(size); }
+void* operator new[](size_t size) { return CountedAllocate(size); }
+void* operator new(size_t size, std::align_val_t alignment) { return CountedAllocateAligned(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return CountedAllocateAligned(size, alignment); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+
+using namespace gui::editor;
+
+namespace
+{
+    struct ParsedBook
+    {
+        std::string symbol; // Keeps its capacity between messages
+        std::vector<NormalizedOrderbookLevel> bids;
+        std::vector<NormalizedOrderbookLevel> asks;
+    };
+
+    // Same steps as JSONOrderbookProcessor's generic path, one batch per call
+    bool ParseBatch(const std::vector<std::string>& batch, const JsonLevelLayout& layout, ParsedBook& book)
+    {
+        BatchArenaScope scope;
+        bool parsed = true;
+        for (const std::string& message : batch)
+        {
+            const std::string_view json(message);
+            book.symbol.assign(JsonScan::Unescape(JsonScan::FindField(json, "data.symbol"), scope.GetArena()));
+            parsed &= OrderbookLevelParser::Parse(JsonScan::FindField(json, "data.bids"), layout, DecimalScale(2, 8), book.bids);
+            parsed &= OrderbookLevelParser::Parse(JsonScan::FindField(json, "data.asks"), layout, DecimalScale(2, 8), book.asks);
+
+            // Per-message scratch that needs owned storage
+            ArenaVector<Decimal> prices;
+            prices.reserve(book.bids.size() + book.asks.size());
+            for (const NormalizedOrderbookLevel& level : book.bids)
+                prices.push_back(level.price);
+            for (const NormalizedOrderbookLevel& level : book.asks)
+                prices.push_back(level.price);
+            ArenaString key(book.symbol.begin(), book.symbol.end());
+            key += ":book";
+            parsed &= prices.size() == book.bids.size() + book.asks.size() && key.size() == book.symbol.size() + 5;
+        }
+        return parsed;
+    }
+
+    std::vector<std::string> MakeBatch(size_t messages)
+    {
+        std::vector<std::string> batch;
+        for (size_t i = 0; i < messages; i++)
+        {
+            std::string message = "{\"data\":{\"symbol\":\"BTC\\/USD\\u00e9 with a name long enough to skip SSO\",\"bids\":[";
+            for (size_t level = 0; level < 20; level++)
+                message += (level ? ",[\"" : "[\"") + std::to_string(30000 - level) + ".5\",\"0.25\"]";
+            message += "],\"asks\":[";
+            for (size_t level = 0; level < 20; level++)
+                message += (level ? ",[\"" : "[\"") + std::to_string(30001 + level) + ".5\",\"1.5\"]";
+            message += "]}}";
+            batch.push_back(std::move(message));
+        }
+        return batch;
+    }
+}
+
+int main()
+{
+    JsonLevelLayout layout;
+    layout.price = JsonLevelField::FromMapping("0");
+    layout.quantity = JsonLevelField::FromMapping("1");
+    layout.maxLevels = 20;
+
+    const std::vector<std::string> batch = MakeBatch(64);
+    ParsedBook book;
+    book.bids.reserve(layout.maxLevels);
+    book.asks.reserve(layout.maxLevels);
+
+    Check(ParseBatch(batch, layout, book), "warm-up batch parses");
+    Check(book.symbol == "BTC/USD\xc3\xa9 with a name long enough to skip SSO", "escapes are decoded");
+    Check(book.bids.size() == 20 && book.asks.size() == 20, "both sides parsed");
+
+    const size_t before = g_allocations.load();
+    bool parsed = true;
+    for (int i = 0; i < 100; i++)
+        parsed &= ParseBatch(batch, layout, book);
+    const size_t allocations = g_allocations.load() - before;
+
+    Check(parsed, "steady-state batches parse");
+    Check(allocations == 0, "steady-state batches do not allocate");
+    Check(GetThreadArena().GetBytesUsed() == 0, "arena is reset after each batch");
+    Check(GetThreadArena().GetHighWaterMark() > 0, "arena was used");
+
+    if (g_failures != 0)
+    {
+        std::fprintf(stderr, "%d check(s) failed, %zu steady-state allocation(s)\n", g_failures, allocations);
+        return 1;
+    }
+    std::printf("BatchArenaTest passed\n");
+    return 0;
+}
@@ -0,0 +1,82 @@
+// Checks PriceLadderBook's tick handling: an inferred tick refines to any grid the
+// prices need, however high they are, and an explicit tick (the instrument's
+// tickSize) keys the book exactly and rejects off-grid prices.
+
+#include "editor/InstrumentRegistry.h"
+#include "editor/PriceLadderBook.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace gui::editor;
+
+namespace
+{
+    int g_failures = 0;
+
+    void Check(bool condition, const char* what)
+    {
+        if (!condition)
+        {
+            std::fprintf(stderr, "FAILED: %s\n", what);
+            g_failures++;
+        }
+    }
+
+    constexpr int SCALE = 8;
+    constexpr int64_t UNIT = 100000000; // 1.0 at scale 8
+
+    NormalizedOrderbookLevel Level(int64_t units, int64_t quantity)
+    {
+        NormalizedOrderbookLevel level;
+        level.price = Decimal(units);
+        level.quantity = Decimal(quantity);
+        level.orderCount = 1;
+        return level;
+    }
+}
+
+int main()
+{
+    // BTC around 100000 at scale 8 with a 0.01 tick: every level is kept
+    {
+        PriceLadderBook book;
+        const std::vector<NormalizedOrderbookLevel> bids = {
+            Level(100000 * UNIT, 5), Level(99999 * UNIT + 99 * UNIT / 100, 3), Level(99999 * UNIT + 98 * UNIT / 100, 2)};
+        const std::vector<NormalizedOrderbookLevel> asks = {
+            Level(100000 * UNIT + UNIT / 100, 4), Level(100000 * UNIT + 2 * UNIT / 100, 1),
+            Level(100000 * UNIT + 5 * UNIT / 100, 7)};
+        Check(book.ApplySnapshot(bids, asks) == 0, "high-priced snapshot fully accepted");
+        Check(book.GetLevelCount(true) == 3 && book.GetLevelCount(false) == 3, "three levels per side");
+        Check(book.GetTickUnits() == UNIT / 100, "inferred tick is 0.01");
+
+        // A finer price later refines the tick rather than being dropped
+        Check(book.SetLevel(false, Decimal(100000 * UNIT + 3 * UNIT / 1000), Decimal(9), 1), "finer price accepted");
+        Check(book.GetTickUnits() == UNIT / 1000 && book.GetLevelCount(false) == 4, "tick refined, levels kept");
+        NormalizedOrderbookLevel best;
+        Check(book.GetBestAsk(best) && best.price.units == 100000 * UNIT + 3 * UNIT / 1000, "refined level is best");
+        Check(book.GetBestBid(best) && best.price.units == 100000 * UNIT, "best bid survives the rebuild");
+    }
+
+    // The instrument's tick keys the book and off-grid prices are rejected
+    {
+        InstrumentData instrument;
+        instrument.tickSize = 0.01;
+        Check(instrument.GetTickUnits(SCALE) == UNIT / 100, "tick units at scale 8");
+        Check(instrument.GetTickUnits(1) == 0, "tick finer than the scale is no grid");
+
+        PriceLadderBook book;
+        book.SetTickUnits(instrument.GetTickUnits(SCALE));
+        Check(book.SetLevel(true, Decimal(250000 * UNIT + 7 * UNIT / 100), Decimal(1), 1), "on-grid high price");
+        Check(!book.SetLevel(true, Decimal(250000 * UNIT + 7 * UNIT / 1000), Decimal(1), 1), "off-grid price rejected");
+        Check(book.GetRejectedCount() == 1 && book.GetTickUnits() == UNIT / 100, "fixed tick not refined");
+    }
+
+    if (g_failures != 0)
+    {
+        std::fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("PriceLadderBookTest passed\n");
+    return 0;
+}
@@ -0,0 +1,114 @@
+// Checks SequenceWindow's classification and hole expiry: in-order and ahead
+// sequences, duplicates above and below the base, late fills of open holes, and
+// holes declared missing once their timeout passes, with a later hole getting its
+// own timeout after the oldest one is filled.
+
+#include "editor/SequenceWindow.h"
+
+#include <cstdio>
+
+using namespace gui::editor;
+
+namespace
+{
+    int g_failures = 0;
+
+    void Check(bool condition, const char* what)
+    {
+        if (!condition)
+        {
+            std::fprintf(stderr, "FAILED: %s\n", what);
+            g_failures++;
+        }
+    }
+
+    using Clock = SequenceWindow::Clock;
+    constexpr auto TIMEOUT = std::chrono::milliseconds(100);
+}
+
+int main()
+{
+    const Clock::time_point start = Clock::now();
+
+    // In order: nothing is ever late, missing or held back
+    {
+        SequenceWindow window(64);
+        Check(window.Record(10, start).status == SequenceStatus::First, "first sequence");
+        bool inOrder = true;
+        for (uint64_t sequence = 11; sequence < 300; sequence++)
+            inOrder &= window.Record(sequence, start).status == SequenceStatus::InOrder;
+        Check(inOrder, "consecutive sequences are in order across the ring");
+        Check(!window.HasHoles(), "no holes in order");
+        Check(window.GetNextExpected() == 300, "base follows the stream");
+        uint64_t first = 0;
+        Check(window.ExpireHoles(start + TIMEOUT * 2, TIMEOUT, first) == 0, "nothing to expire in order");
+    }
+
+    // Duplicates: at the base's left and inside the window above it
+    {
+        SequenceWindow window(64);
+        window.Record(1, start);
+        window.Record(2, start);
+        window.Record(5, start);
+        Check(window.Record(2, start).status == SequenceStatus::Duplicate, "repeat below the base");
+        Check(window.Record(5, start).status == SequenceStatus::Duplicate, "repeat above a hole");
+        Check(window.GetDuplicateCount() == 2, "duplicates counted");
+        Check(window.GetLateCount() == 0, "duplicates are not late");
+    }
+
+    // Late fill: holes close in any order and the base moves past the received run
+    {
+        SequenceWindow window(64);
+        window.Record(1, start);
+        Check(window.Record(4, start).status == SequenceStatus::Ahead, "gap leaves a hole");
+        Check(window.GetNextExpected() == 2, "base waits at the hole");
+        const SequenceResult late = window.Record(3, start);
+        Check(late.status == SequenceStatus::Late && late.lateDistance == 1, "late fill above the base");
+        Check(window.GetNextExpected() == 2, "base still waits for 2");
+        Check(window.Record(2, start).status == SequenceStatus::Late, "late fill at the base");
+        Check(window.GetNextExpected() == 5 && !window.HasHoles(), "base moves past the filled run");
+        Check(window.GetLateCount() == 2 && window.GetMaxLateDistance() == 2, "late totals");
+    }
+
+    // Expiry: the oldest hole is declared missing after the timeout, then reports expired
+    {
+        SequenceWindow window(64);
+        window.Record(1, start);
+        window.Record(5, start);
+        uint64_t first = 0;
+        Check(window.ExpireHoles(start + TIMEOUT / 2, TIMEOUT, first) == 0, "hole kept within the timeout");
+        Check(window.ExpireHoles(start + TIMEOUT, TIMEOUT, first) == 3 && first == 2, "2..4 declared missing");
+        Check(window.GetMissingCount() == 3 && !window.HasHoles(), "missing counted, no holes left");
+        Check(window.Record(3, start + TIMEOUT).status == SequenceStatus::Expired, "missing sequence is expired");
+        Check(window.GetDuplicateCount() == 0, "expired is not a duplicate");
+    }
+
+    // Filling the oldest hole restarts the timer for the next one
+    {
+        SequenceWindow window(64);
+        window.Record(1, start);
+        window.Record(3, start);               // Hole at 2 opens at start
+        window.Record(5, start + TIMEOUT / 2); // Hole at 4
+        Check(window.Record(2, start + TIMEOUT * 3 / 4).status == SequenceStatus::Late, "oldest hole filled");
+        Check(window.GetNextExpected() == 4, "base at the next hole");
+        uint64_t first = 0;
+        Check(window.ExpireHoles(start + TIMEOUT, TIMEOUT, first) == 0, "next hole not expired on the old timer");
+        Check(window.ExpireHoles(start + TIMEOUT * 7 / 4, TIMEOUT, first) == 1 && first == 4,
+              "next hole expires on its own timeout");
+
+        // Filling part of a hole keeps its timer
+        window.Record(9, start + TIMEOUT * 2); // Hole 6..8
+        window.Record(6, start + TIMEOUT * 5 / 2);
+        Check(window.GetNextExpected() == 7, "base inside the same hole");
+        Check(window.ExpireHoles(start + TIMEOUT * 3, TIMEOUT, first) == 2 && first == 7,
+              "rest of the hole expires on its original timer");
+    }
+
+    if (g_failures != 0)
+    {
+        std::fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("SequenceWindowTest passed\n");
+    return 0;
+}
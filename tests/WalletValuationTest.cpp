@@ -0,0 +1,119 @@
+// Values wallets through routes built from instrument definitions: direct pairs,
+// a two-pair route, an inverted pair and a stablecoin, then checks that mids and
+// balance changes move the totals and that a delisted pair unprices its asset.
+
+#include "editor/InstrumentRegistry.h"
+#include "editor/TradeRecord.h"
+#include "editor/WalletState.h"
+#include "editor/WalletValuation.h"
+
+#include <cmath>
+#include <cstdio>
+
+using namespace gui::editor;
+
+namespace
+{
+    int g_failures = 0;
+
+    void Check(bool condition, const char* what)
+    {
+        if (!condition)
+        {
+            std::fprintf(stderr, "FAILED: %s\n", what);
+            g_failures++;
+        }
+    }
+
+    bool Near(double value, double expected)
+    {
+        return std::fabs(value - expected) <= 1e-6 * std::fmax(1.0, std::fabs(expected));
+    }
+
+    void Publish(InstrumentRegistry& registry, const char* symbol, const char* base, const char* quote)
+    {
+        InstrumentData instrument;
+        instrument.exchange = "Binance";
+        instrument.symbol = symbol;
+        instrument.baseAsset = base;
+        instrument.quoteAsset = quote;
+        registry.Publish(instrument);
+    }
+
+    void Mid(WalletValuation& valuation, const char* pair, double mid)
+    {
+        const uint32_t symbolId = GetTradeStringTable().Find(pair);
+        Check(symbolId != 0 && valuation.IsSubscribed(symbolId), "pair is subscribed");
+        valuation.OnMidPrice(symbolId, mid);
+    }
+
+    void Balance(WalletState& wallet, const char* currency, int64_t units)
+    {
+        WalletBalance& balance = wallet.balances[currency];
+        balance.currency = currency;
+        balance.scale = 8;
+        balance.total = Decimal(units * 100000000);
+    }
+}
+
+int main()
+{
+    InstrumentRegistry registry;
+    Publish(registry, "BTCUSDT", "BTC", "USDT");
+    Publish(registry, "ETHBTC", "ETH", "BTC");   // Two pairs: ETH -> BTC -> USDT
+    Publish(registry, "USDTTRY", "USDT", "TRY"); // Only a quote: priced inverted
+    Publish(registry, "SOLETH", "SOL", "ETH");   // Three pairs
+
+    WalletValuation valuation;
+    valuation.Revalue();
+    Check(valuation.GetPrice("USD") == 1.0 && valuation.GetPrice("USDC") == 1.0, "pegged prices");
+    Check(valuation.SyncRoutes(registry), "routes built");
+    Check(!valuation.SyncRoutes(registry), "unchanged registry is a no-op");
+
+    WalletState wallet;
+    wallet.exchange = "Binance";
+    wallet.account = "main";
+    Balance(wallet, "BTC", 2);
+    Balance(wallet, "ETH", 10);
+    Balance(wallet, "TRY", 4000);
+    Balance(wallet, "USDC", 500);
+    Balance(wallet, "SOL", 100);
+    Balance(wallet, "XYZ", 7); // No pair at all
+    Check(Near(valuation.SyncWallet(wallet), 500.0), "only the stablecoin is priced before any mid");
+
+    Mid(valuation, "BTCUSDT", 50000.0);
+    Mid(valuation, "ETHBTC", 0.05);
+    Mid(valuation, "USDTTRY", 40.0);
+    Mid(valuation, "SOLETH", 0.1);
+    valuation.Revalue();
+    Check(Near(valuation.GetPrice("ETH"), 2500.0), "ETH through BTC");
+    Check(Near(valuation.GetPrice("TRY"), 0.025), "TRY inverted");
+    Check(Near(valuation.GetPrice("SOL"), 250.0), "SOL through ETH and BTC");
+    // 100000 BTC + 25000 ETH + 100 TRY + 500 USDC + 25000 SOL
+    Check(Near(valuation.GetAccountValue("Binance", "main"), 150600.0), "account value");
+    Check(Near(valuation.GetTotalValue(), 150600.0), "total value");
+    Check(valuation.GetUnpricedCount() == 1, "XYZ unpriced");
+
+    // A BTC move reprices everything routed through it
+    Mid(valuation, "BTCUSDT", 60000.0);
+    Check(valuation.Revalue() >= 3, "BTC, ETH and SOL repriced");
+    Check(Near(valuation.GetTotalValue(), 120000.0 + 30000.0 + 100.0 + 500.0 + 30000.0), "total after BTC move");
+
+    valuation.SetBalance("Binance", "main", "BTC", Decimal(100000000), 8);
+    Check(Near(valuation.GetTotalValue(), 60000.0 + 30000.0 + 100.0 + 500.0 + 30000.0), "total after balance change");
+
+    // Delisting ETHBTC leaves ETH, and SOL behind it, without a route
+    registry.Remove("Binance", "ETHBTC");
+    Check(valuation.SyncRoutes(registry), "routes rebuilt");
+    valuation.Revalue();
+    Check(valuation.GetPrice("ETH") == 0.0 && valuation.GetPrice("SOL") == 0.0, "delisted route unpriced");
+    Check(Near(valuation.GetTotalValue(), 60000.0 + 100.0 + 500.0), "total without ETH and SOL");
+
+    if (g_failures != 0)
+    {
+        std::fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("WalletValuationTest passed\n");
+    return 0;
+}